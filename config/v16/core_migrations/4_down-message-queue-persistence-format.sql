@@ -0,0 +1,5 @@
+-- Binary encoded messages can not be read without the MESSAGE_FORMAT column
+DELETE FROM NORMAL_QUEUE WHERE MESSAGE_FORMAT != 'JSON';
+DELETE FROM TRANSACTION_QUEUE WHERE MESSAGE_FORMAT != 'JSON';
+ALTER TABLE NORMAL_QUEUE DROP COLUMN MESSAGE_FORMAT;
+ALTER TABLE TRANSACTION_QUEUE DROP COLUMN MESSAGE_FORMAT;
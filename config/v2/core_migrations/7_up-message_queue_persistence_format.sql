@@ -0,0 +1,3 @@
+-- Encoding of MESSAGE: 'JSON' is stored as text, 'CBOR' and 'MessagePack' as blob
+ALTER TABLE NORMAL_QUEUE ADD COLUMN MESSAGE_FORMAT TEXT NOT NULL DEFAULT 'JSON';
+ALTER TABLE TRANSACTION_QUEUE ADD COLUMN MESSAGE_FORMAT TEXT NOT NULL DEFAULT 'JSON';
@@ -0,0 +1 @@
+DROP TABLE IF EXISTS TLS_SESSIONS;
@@ -0,0 +1,5 @@
+-- Serialized TLS sessions of the websocket connection to the CSMS, used to resume the session after a restart
+CREATE TABLE IF NOT EXISTS TLS_SESSIONS (
+    SESSION_KEY TEXT PRIMARY KEY NOT NULL,
+    SESSION BLOB NOT NULL
+);
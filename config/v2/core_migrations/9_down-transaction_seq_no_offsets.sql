@@ -0,0 +1 @@
+DROP TABLE IF EXISTS TRANSACTION_SEQ_NO_OFFSETS;
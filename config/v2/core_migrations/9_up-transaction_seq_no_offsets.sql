@@ -0,0 +1,6 @@
+-- Number of TransactionEvent messages per transaction that were merged by the compaction of the transaction message
+-- queue. Sequence numbers of later messages of the transaction are reduced by this offset
+CREATE TABLE IF NOT EXISTS TRANSACTION_SEQ_NO_OFFSETS (
+    TRANSACTION_ID TEXT PRIMARY KEY NOT NULL,
+    SEQ_NO_OFFSET INT NOT NULL
+);
@@ -0,0 +1,4 @@
+DROP TABLE IF EXISTS COMPONENT_CONFIG_HASH;
+
+ALTER TABLE COMPONENT
+DROP COLUMN CONFIG_HASH;
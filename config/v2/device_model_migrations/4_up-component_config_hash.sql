@@ -0,0 +1,9 @@
+-- Hash of the component config file a component was read from, to skip unchanged components on startup
+ALTER TABLE COMPONENT
+ADD CONFIG_HASH TEXT;
+
+-- Hash of all component config files the device model was initialized with, to skip unchanged configs on startup
+CREATE TABLE IF NOT EXISTS COMPONENT_CONFIG_HASH (
+    ID INTEGER PRIMARY KEY CHECK (ID = 0),
+    HASH TEXT NOT NULL
+);
@@ -3,8 +3,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <sqlite3.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <ocpp/common/support_older_cpp_versions.hpp>
 
@@ -12,6 +19,45 @@
 
 namespace ocpp::common {
 
+/// \brief Journal modes of SQLite, see https://www.sqlite.org/pragma.html#pragma_journal_mode
+enum class DatabaseJournalMode {
+    Delete,
+    Truncate,
+    Persist,
+    Memory,
+    WAL,
+    Off
+};
+
+/// \brief Synchronous settings of SQLite, see https://www.sqlite.org/pragma.html#pragma_synchronous
+enum class DatabaseSynchronousMode {
+    Off,
+    Normal,
+    Full,
+    Extra
+};
+
+/// \brief Settings that are applied every time a database connection is opened. PRAGMAs that are not set keep the
+/// defaults of SQLite
+struct DatabaseTuningProfile {
+    std::optional<DatabaseJournalMode> journal_mode;    ///< PRAGMA journal_mode
+    std::optional<DatabaseSynchronousMode> synchronous; ///< PRAGMA synchronous
+    std::optional<std::int64_t> cache_size_kib;         ///< PRAGMA cache_size, in KiB
+    std::optional<std::int64_t> mmap_size;              ///< PRAGMA mmap_size, in bytes
+    /// Number of read-only connections that are opened in addition to the connection used for writing. Queries are
+    /// distributed over them, so that they are not blocked by long running statements of other threads. Switches the
+    /// database to the WAL journal mode. 0 uses a single connection
+    std::size_t read_connections = 0;
+};
+
+/// \brief Returns the predefined tuning profile \p name:
+/// - "Default" keeps the defaults of SQLite
+/// - "WAL" uses a write-ahead log with synchronous=NORMAL, so a commit does not wait for the data to be synced to the
+/// storage. The database stays consistent on power loss, but the last commits may be lost
+/// - "Flash" is "WAL" with an 8 MiB page cache and 64 MiB of memory mapped I/O
+/// \throws StringToEnumException if there is no profile named \p name
+DatabaseTuningProfile get_database_tuning_profile(const std::string& name);
+
 /// \brief Helper class for transactions. Will lock the database interface from new transaction until commit() or
 /// rollback() is called or the object destroyed
 class DatabaseTransactionInterface {
@@ -40,10 +86,14 @@ public:
     /// \note This function can block until the previous transaction is finished.
     [[nodiscard]] virtual std::unique_ptr<DatabaseTransactionInterface> begin_transaction() = 0;
 
+    /// \brief Returns true if the calling thread holds the transaction started with begin_transaction()
+    virtual bool is_transaction_owner() const = 0;
+
     /// \brief Immediately executes \p statement. Returns true if succeeded.
     virtual bool execute_statement(const std::string& statement) = 0;
 
-    /// \brief Returns a new SQLiteStatementInterface to be used to perform more advanced sql statements.
+    /// \brief Returns a new SQLiteStatementInterface to be used to perform more advanced sql statements. The statement
+    /// is not bound and not stepped, even if it has been used before.
     /// \note Will throw an std::runtime_error if the statement can't be prepared
     virtual std::unique_ptr<SQLiteStatementInterface> new_statement(const std::string& sql) = 0;
 
@@ -61,19 +111,53 @@ public:
 
     /// \brief Helper function to get the user version of the database.
     virtual uint32_t get_user_version() = 0;
+
+    /// \brief Sets the tuning profile that is applied when the connection is opened. An already opened connection is
+    /// not changed
+    virtual void set_tuning_profile(const DatabaseTuningProfile& profile) = 0;
 };
 
+/// \brief Default number of prepared statements a DatabaseConnection keeps for reuse
+constexpr std::size_t DEFAULT_STATEMENT_CACHE_SIZE = 64;
+
+class PreparedStatementCache;
+
 class DatabaseConnection : public DatabaseConnectionInterface {
 private:
+    /// \brief Read-only connection to the same database, see DatabaseTuningProfile::read_connections
+    struct ReadConnection {
+        sqlite3* db;
+        std::shared_ptr<PreparedStatementCache> statement_cache;
+    };
+
     sqlite3* db;
     const fs::path database_file_path;
     std::atomic_uint32_t open_count;
     std::timed_mutex transaction_mutex;
+    /// Thread that holds the transaction_mutex. It keeps using the writing connection for queries, so that it sees the
+    /// changes of its transaction
+    std::atomic<std::thread::id> transaction_owner;
+    std::shared_ptr<PreparedStatementCache> statement_cache;
+    DatabaseTuningProfile tuning_profile;
+    /// Guards read_connections and next_read_connection, they are replaced when the connection is opened or closed
+    /// while other threads create statements
+    std::mutex read_connections_mutex;
+    std::vector<ReadConnection> read_connections;
+    std::size_t next_read_connection;
 
     bool close_connection_internal(bool force_close);
+    void apply_tuning_profile();
+    void open_read_connections();
+    void close_read_connections();
 
 public:
-    explicit DatabaseConnection(const fs::path& database_file_path) noexcept;
+    /// \brief Creates a connection to the database at \p database_file_path. Statements returned by new_statement()
+    /// are kept prepared after their destruction and reused for the same SQL text, up to \p statement_cache_size
+    /// statements per connection. 0 disables the reuse. The settings of \p tuning_profile are applied whenever the
+    /// connection is opened
+    explicit DatabaseConnection(const fs::path& database_file_path,
+                                std::size_t statement_cache_size = DEFAULT_STATEMENT_CACHE_SIZE,
+                                const DatabaseTuningProfile& tuning_profile = {}) noexcept;
 
     virtual ~DatabaseConnection();
 
@@ -82,6 +166,8 @@ public:
 
     [[nodiscard]] std::unique_ptr<DatabaseTransactionInterface> begin_transaction() override;
 
+    bool is_transaction_owner() const override;
+
     bool execute_statement(const std::string& statement) override;
     std::unique_ptr<SQLiteStatementInterface> new_statement(const std::string& sql) override;
 
@@ -93,6 +179,8 @@ public:
 
     uint32_t get_user_version() override;
     void set_user_version(uint32_t version) override;
+
+    void set_tuning_profile(const DatabaseTuningProfile& profile) override;
 };
 
 } // namespace ocpp::common
@@ -3,8 +3,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <ocpp/common/database/database_connection.hpp>
@@ -21,7 +30,63 @@ struct DBTransactionMessage {
     std::string unique_id;
 };
 
+/// \brief Configuration of the write-behind batching of the message queue tables
+struct MessageQueueWriteBehindConfig {
+    /// Maximum time an insert or remove stays buffered before it is written to the database. All buffered operations
+    /// are written in a single transaction. A value of 0 disables the batching and every operation is written
+    /// immediately
+    std::chrono::milliseconds flush_interval{0};
+    /// Number of buffered operations that triggers an early flush. Together with the flush_interval this bounds the
+    /// number of queue changes that can be lost on power loss
+    std::size_t max_pending_operations{100};
+};
+
 class DatabaseHandlerCommon {
+private:
+    /// \brief Insert or remove operation on a message queue table that has not been written yet
+    struct PendingMessageQueueOperation {
+        QueueType queue_type;
+        std::string unique_id;
+        /// set for inserts, empty for removes
+        std::optional<DBTransactionMessage> message;
+        /// set if a buffered insert was removed again before it was written
+        bool cancelled{false};
+    };
+
+    MessageQueueWriteBehindConfig message_queue_write_behind_config;
+    std::vector<PendingMessageQueueOperation> pending_message_queue_operations;
+    /// index of the buffered insert per queue table and unique id, used to cancel insert/remove pairs
+    std::unordered_map<std::string, std::size_t> pending_message_queue_inserts;
+    std::size_t pending_message_queue_operation_count{0};
+    /// latest session per key that has not been written yet
+    std::map<std::string, std::vector<std::uint8_t>> pending_tls_sessions;
+    /// guards the buffered writes and the state of the database worker
+    std::mutex database_worker_mutex;
+    /// serializes flushes so that batches are written in the order they were buffered
+    std::mutex message_queue_flush_mutex;
+    std::condition_variable database_worker_cv;
+    /// writes the buffered message queue operations and TLS sessions while the connection is open
+    std::thread database_worker_thread;
+    bool database_worker_running{false};
+    bool database_worker_wakeup_requested{false};
+    bool database_worker_config_changed{false};
+    std::atomic_bool message_queue_write_behind_enabled{false};
+    std::atomic<std::size_t> message_queue_write_transactions{0};
+    std::atomic<MessageQueuePersistenceFormat> message_queue_persistence_format{MessageQueuePersistenceFormat::Json};
+    /// unique ids of buffered operations that could not be written and have not been reported to a caller yet
+    std::vector<std::string> failed_message_queue_operations;
+
+    void database_worker();
+    void start_database_worker();
+    void stop_database_worker();
+    void write_tls_sessions();
+    void buffer_message_queue_operation(PendingMessageQueueOperation&& operation);
+    void execute_message_queue_operation(const PendingMessageQueueOperation& operation);
+    bool write_message_queue_operations();
+
+    void insert_message_queue_message_internal(const DBTransactionMessage& message, const QueueType queue_type);
+    void remove_message_queue_message_internal(const std::string& unique_id, const QueueType queue_type);
+
 protected:
     std::unique_ptr<DatabaseConnectionInterface> database;
     const fs::path sql_migration_files_path;
@@ -30,6 +95,11 @@ protected:
     /// \brief Perform the initialization needed to use the database. Will be called by open_connection()
     virtual void init_sql() = 0;
 
+    /// \brief Stops the database worker and writes all buffered message queue operations and TLS sessions. Derived
+    /// classes call this in their destructor, while the database is still fully usable. Operations that could not be
+    /// written are reported by get_failed_message_queue_operations()
+    void close();
+
 public:
     /// \brief Common database handler class
     /// Class handles some common database functionality like inserting and removing transaction messages.
@@ -40,27 +110,59 @@ public:
     explicit DatabaseHandlerCommon(std::unique_ptr<DatabaseConnectionInterface> database,
                                    const fs::path& sql_migration_files_path, uint32_t target_schema_version) noexcept;
 
-    ~DatabaseHandlerCommon() = default;
+    /// \brief Stops the database worker. Writes that are still buffered because close() was not called are lost
+    virtual ~DatabaseHandlerCommon();
 
-    /// \brief Opens connection to database file and performs the initialization by calling init_sql()
+    /// \brief Opens connection to database file, performs the initialization by calling init_sql() and starts the
+    /// database worker that writes buffered message queue operations and TLS sessions
     void open_connection();
 
-    /// \brief Closes the database connection.
+    /// \brief Stops the database worker, writes all buffered message queue operations and TLS sessions and closes the
+    /// database connection. Operations that could not be written are reported by get_failed_message_queue_operations()
     void close_connection();
 
-    /// \brief Get messages from messages queue table specified by \p queue_type
+    /// \brief Sets the tuning profile that is applied to the database connection when it is opened. Has to be called
+    /// before open_connection() to take effect
+    void set_tuning_profile(const DatabaseTuningProfile& profile);
+
+    /// \brief Enables, reconfigures or (with a flush_interval of 0) disables the write-behind batching of inserts and
+    /// removes on the message queue tables. Operations that are already buffered are written first.
+    void set_message_queue_write_behind_config(const MessageQueueWriteBehindConfig& config);
+
+    /// \brief Writes all buffered message queue operations in a single transaction. If the transaction fails the
+    /// operations are written one by one and the ones that fail are reported by get_failed_message_queue_operations()
+    /// \return True if all operations buffered at the time of the call were written
+    bool flush_message_queue();
+
+    /// \brief Get the unique ids of buffered message queue operations that could not be written since the last call,
+    /// either by flush_message_queue() or by the write-behind worker. The reported failures are cleared
+    std::vector<std::string> get_failed_message_queue_operations();
+
+    /// \brief Sets the encoding of messages that are inserted into the message queue tables from now on. Binary formats
+    /// are smaller and faster to restore than JSON text. Persisted messages are always read in the format they were
+    /// written in
+    void set_message_queue_persistence_format(const MessageQueuePersistenceFormat format);
+
+    /// \brief Number of write transactions (and therefore syncs to disk) issued for the message queue tables
+    std::size_t get_message_queue_write_transaction_count() const;
+
+    /// \brief Get messages from messages queue table specified by \p queue_type. Buffered operations are written first.
     /// \param queue_type , defaults to QueueType::Transaction
     /// \return The transaction messages.
     virtual std::vector<DBTransactionMessage>
     get_message_queue_messages(const QueueType queue_type = QueueType::Transaction);
 
-    /// \brief Insert a new message into messages queue table specified by \p queue_type
+    /// \brief Insert a new message into messages queue table specified by \p queue_type. The insert is buffered if the
+    /// write-behind batching is enabled. A failure to write it later is reported by
+    /// get_failed_message_queue_operations()
     /// \param message  The message to be stored.
     /// \param queue_type , defaults to QueueType::Transaction
     virtual void insert_message_queue_message(const DBTransactionMessage& message,
                                               const QueueType queue_type = QueueType::Transaction);
 
-    /// \brief Remove a message from the messages queue table specified by \p queue_type
+    /// \brief Remove a message from the messages queue table specified by \p queue_type. A buffered insert of the same
+    /// message is dropped instead, so messages that are acknowledged within one flush interval never hit the disk.
+    /// Failures of buffered removes are reported like for insert_message_queue_message
     /// \param unique_id    The unique id of the transaction message
     /// \param queue_type , defaults to QueueType::Transaction
     /// \return True on success.
@@ -70,6 +172,37 @@ public:
     /// \brief Deletes all entries from message queue table specified by \p queue_type
     /// \param queue_type , defaults to QueueType::Transaction
     virtual void clear_message_queue(const QueueType queue_type = QueueType::Transaction);
+
+    /// \brief Inserts or replaces the serialized TLS \p session that is stored under \p key.
+    ///
+    /// A serialized session contains the secret a session is resumed with, in plain text. Anyone who can read the
+    /// database can resume the session in place of the charging station and, for TLS 1.2, decrypt recorded traffic of
+    /// the connection. The database has to be protected like the private key of the client certificate
+    virtual void insert_or_update_tls_session(const std::string& key, const std::vector<std::uint8_t>& session);
+
+    /// \brief Hands the serialized TLS \p session over to the database worker, which inserts or replaces it like
+    /// insert_or_update_tls_session(). Does not wait for the database, so it can be called from the thread that runs
+    /// the TLS handshake. If the worker is not running, the session is written right away. Failures are logged
+    void insert_or_update_tls_session_async(const std::string& key, const std::vector<std::uint8_t>& session);
+
+    /// \brief Get all stored TLS sessions
+    /// \return Pairs of key and serialized session
+    virtual std::vector<std::pair<std::string, std::vector<std::uint8_t>>> get_tls_sessions();
+
+    /// \brief Deletes all stored TLS sessions
+    virtual void clear_tls_sessions();
+
+    /// \brief Inserts or replaces the sequence number \p offset of the transaction with the given \p transaction_id.
+    /// Only available for OCPP2.0.1 databases
+    virtual void insert_or_update_transaction_seq_no_offset(const std::string& transaction_id, const int32_t offset);
+
+    /// \brief Get the sequence number offsets of all transactions. Only available for OCPP2.0.1 databases
+    /// \return Map of transaction id and sequence number offset
+    virtual std::map<std::string, int32_t> get_transaction_seq_no_offsets();
+
+    /// \brief Deletes the sequence number offset of the transaction with the given \p transaction_id. Only available
+    /// for OCPP2.0.1 databases
+    virtual void remove_transaction_seq_no_offset(const std::string& transaction_id);
 };
 
 } // namespace ocpp::common
@@ -4,7 +4,10 @@
 #ifndef SQLITE_STATEMENT_HPP
 #define SQLITE_STATEMENT_HPP
 
+#include <cstdint>
+#include <functional>
 #include <sqlite3.h>
+#include <vector>
 
 #include <everest/logging.hpp>
 #include <ocpp/common/types.hpp>
@@ -38,6 +41,10 @@ public:
     virtual int bind_double(const std::string& param, const double val) = 0;
     virtual int bind_null(const int idx) = 0;
     virtual int bind_null(const std::string& param) = 0;
+    virtual int bind_blob(const int idx, const std::vector<std::uint8_t>& val,
+                          SQLiteString lifetime = SQLiteString::Static) = 0;
+    virtual int bind_blob(const std::string& param, const std::vector<std::uint8_t>& val,
+                          SQLiteString lifetime = SQLiteString::Static) = 0;
 
     virtual int get_number_of_rows() = 0;
     virtual int column_type(const int idx) = 0;
@@ -46,16 +53,24 @@ public:
     virtual int column_int(const int idx) = 0;
     virtual ocpp::DateTime column_datetime(const int idx) = 0;
     virtual double column_double(const int idx) = 0;
+    virtual std::vector<std::uint8_t> column_blob(const int idx) = 0;
 };
 
 /// \brief RAII wrapper class that handles finalization, step, binding and column access of sqlite3_stmt
 class SQLiteStatement : public SQLiteStatementInterface {
+public:
+    /// \brief Called instead of sqlite3_finalize when the statement is destroyed, e.g. to return it to a cache
+    using ReleaseCallback = std::function<void(sqlite3_stmt* stmt)>;
+
 private:
     sqlite3_stmt* stmt;
     sqlite3* db;
+    ReleaseCallback release_callback;
 
 public:
     SQLiteStatement(sqlite3* db, const std::string& query);
+    /// \brief Wraps the already prepared \p stmt, which is handed to \p release_callback on destruction
+    SQLiteStatement(sqlite3* db, sqlite3_stmt* stmt, ReleaseCallback release_callback);
     ~SQLiteStatement();
 
     int step() override;
@@ -73,6 +88,10 @@ public:
     int bind_double(const std::string& param, const double val) override;
     int bind_null(const int idx) override;
     int bind_null(const std::string& param) override;
+    int bind_blob(const int idx, const std::vector<std::uint8_t>& val,
+                  SQLiteString lifetime = SQLiteString::Static) override;
+    int bind_blob(const std::string& param, const std::vector<std::uint8_t>& val,
+                  SQLiteString lifetime = SQLiteString::Static) override;
 
     int get_number_of_rows() override;
     int column_type(const int idx) override;
@@ -81,6 +100,7 @@ public:
     int column_int(const int idx) override;
     ocpp::DateTime column_datetime(const int idx) override;
     double column_double(const int idx) override;
+    std::vector<std::uint8_t> column_blob(const int idx) override;
 };
 
 } // namespace ocpp::common
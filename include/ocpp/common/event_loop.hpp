@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+namespace ocpp {
+
+/// \brief Runs the handlers of one component on an event loop, i.e. a boost::asio::io_context that is run by a single
+/// thread. The handlers of all components sharing the event loop run one after the other in the order they were
+/// posted, so no additional threads and no locking between these components are needed.
+///
+/// After shutdown() no handler of the component runs anymore, even if it has been posted before. Handlers may
+/// therefore capture the component they belong to, as long as the component shuts the executor down before it is
+/// destroyed.
+class EventLoopExecutor {
+public:
+    explicit EventLoopExecutor(boost::asio::io_context& io_context) :
+        io_context(io_context), active(std::make_shared<std::atomic_bool>(true)) {
+    }
+
+    EventLoopExecutor(const EventLoopExecutor&) = delete;
+    EventLoopExecutor& operator=(const EventLoopExecutor&) = delete;
+
+    ~EventLoopExecutor() {
+        this->shutdown();
+    }
+
+    /// \returns the io_context of the event loop, e.g. to run timers on it
+    boost::asio::io_context& get_io_context() {
+        return this->io_context;
+    }
+
+    /// \returns true if called from the thread running the event loop
+    bool running_in_this_thread() const {
+        return this->io_context.get_executor().running_in_this_thread();
+    }
+
+    /// \brief Queues \p handler to run on the event loop
+    /// \returns false if the executor has been shut down, the handler is dropped in that case
+    template <typename Handler> bool post(Handler&& handler) {
+        if (!this->active->load()) {
+            return false;
+        }
+        boost::asio::post(this->io_context,
+                          [active = this->active, handler = std::forward<Handler>(handler)]() mutable {
+                              if (active->load()) {
+                                  handler();
+                              }
+                          });
+        return true;
+    }
+
+    /// \brief Drops all handlers that have not run yet and rejects new ones. Waits until a handler that is currently
+    /// running has finished, unless called from a handler on the event loop itself
+    void shutdown() {
+        if (!this->active->exchange(false)) {
+            return;
+        }
+        if (this->running_in_this_thread() or this->io_context.stopped()) {
+            return;
+        }
+
+        // handlers run in order, so all handlers posted before have finished once this one runs
+        std::promise<void> barrier;
+        auto barrier_reached = barrier.get_future();
+        boost::asio::post(this->io_context, [&barrier]() { barrier.set_value(); });
+        barrier_reached.wait();
+    }
+
+private:
+    boost::asio::io_context& io_context;
+    std::shared_ptr<std::atomic_bool> active;
+};
+
+} // namespace ocpp
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace ocpp {
+
+using json = nlohmann::json;
+
+/// \brief Exception used when a JSON document fed to an IncrementalJsonParser is invalid
+class JsonParseException : public std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+/// \brief Parses a JSON document that arrives in fragments, e.g. the fragments of a websocket message.
+///
+/// Every fragment is tokenized as soon as it is fed and the values are added to the resulting document right away. Only
+/// a token that is cut off at the end of a fragment is buffered, so the fragments do not have to be concatenated to the
+/// complete message before it can be parsed.
+class IncrementalJsonParser {
+public:
+    IncrementalJsonParser();
+
+    /// \brief Parses the next \p fragment of the document
+    /// \throws JsonParseException if the fragment makes the document invalid, the parser has to be reset afterwards
+    void feed(std::string_view fragment);
+
+    /// \brief Completes the document after the last fragment has been fed and resets the parser
+    /// \returns the parsed document
+    /// \throws JsonParseException if the document is incomplete
+    json finish();
+
+    /// \brief Discards the document that is currently parsed
+    void reset();
+
+    /// \returns the number of bytes fed since the last reset
+    std::size_t get_parsed_bytes() const;
+
+private:
+    enum class State {
+        Value,          ///< expecting a value
+        ValueOrEnd,     ///< expecting a value or the end of an empty array
+        KeyOrEnd,       ///< expecting a key or the end of an empty object
+        Key,            ///< expecting a key after a comma
+        Colon,          ///< expecting the colon after a key
+        AfterValue,     ///< expecting a comma or the end of the current container
+        String,         ///< inside a string
+        StringEscape,   ///< after a backslash inside a string
+        StringUnicode,  ///< inside the four hex digits of a \u escape
+        Number,         ///< inside a number
+        Literal,        ///< inside true, false or null
+        Done,           ///< the document is complete, only whitespace may follow
+    };
+
+    State state;
+    bool string_is_key;
+    std::string token;
+    std::uint32_t unicode_code_point;
+    int unicode_digits;
+    std::uint32_t high_surrogate;
+    std::size_t parsed_bytes;
+
+    json document;
+    std::vector<json*> containers;
+    std::string key;
+
+    /// \brief Feeds a single character, \returns false if the character has to be processed again in the new state
+    bool process(char c);
+
+    void begin_value(char c);
+    json& add_value(json&& value);
+    void end_container(char c);
+    void finish_string();
+    void finish_number();
+    void finish_literal();
+    void append_code_point(std::uint32_t code_point);
+
+    [[noreturn]] void fail(const std::string& reason) const;
+};
+
+} // namespace ocpp
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace ocpp {
+
+/// \brief Bounded multi producer / multi consumer queue. Pushing and popping does not take a lock, each element costs
+/// one compare-and-swap on each side. The cells of the ring buffer carry a sequence number that tells producers and
+/// consumers whether the cell is free or holds an element of the current lap (cf. Dmitry Vyukov's bounded MPMC queue).
+///
+/// Waiting for an element or a custom event still uses a condition variable, but producers and consumers only touch
+/// its mutex if a thread is actually waiting. The waiting interface is the same as the one of SafeQueue
+template <typename T> class LockFreeQueue {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+    /// \brief Creates a queue that holds up to \p capacity elements, rounded up to the next power of two
+    explicit LockFreeQueue(std::size_t capacity = DEFAULT_CAPACITY) {
+        std::size_t rounded_capacity = 2;
+        while (rounded_capacity < capacity) {
+            rounded_capacity *= 2;
+        }
+        this->mask = rounded_capacity - 1;
+        this->cells = std::make_unique<Cell[]>(rounded_capacity);
+        for (std::size_t i = 0; i < rounded_capacity; i++) {
+            this->cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    ~LockFreeQueue() {
+        while (this->try_pop().has_value()) {
+        }
+    }
+
+    /// \return the maximum number of elements in the queue
+    inline std::size_t capacity() const {
+        return this->mask + 1;
+    }
+
+    /// \return True if the queue is empty. Only a snapshot if other threads push or pop at the same time
+    inline bool empty() const {
+        const auto position = this->dequeue_position.load(std::memory_order_relaxed);
+        const auto sequence = this->cells[position & this->mask].sequence.load(std::memory_order_acquire);
+        return sequence != position + 1;
+    }
+
+    /// \brief Queues an element if there is space left and notifies any threads waiting on the queue
+    /// \return false if the queue is full, \p value is left untouched in that case
+    template <typename U> inline bool try_push(U&& value) {
+        Cell* cell = nullptr;
+        auto position = this->enqueue_position.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &this->cells[position & this->mask];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0) {
+                if (this->enqueue_position.compare_exchange_weak(position, position + 1,
+                                                                 std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // the cell still holds the element of the previous lap
+                return false;
+            } else {
+                position = this->enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+        new (&cell->storage) T(std::forward<U>(value));
+        cell->sequence.store(position + 1, std::memory_order_release);
+
+        this->notify_if_waiting();
+        return true;
+    }
+
+    /// \brief Queues an element and notifies any threads waiting on the queue. Waits for a free cell if the queue is
+    /// full, so it must not be called from a thread the consumers might wait for. Use try_push there instead
+    template <typename U> inline void push(U&& value) {
+        // a full queue is usually drained quickly by the consumer, so yield a few times before going to sleep
+        for (int i = 0; i < FULL_QUEUE_YIELDS; i++) {
+            if (this->try_push(std::forward<U>(value))) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        while (!this->try_push(std::forward<U>(value))) {
+            // popping an element notifies the waiting producer
+            this->wait_on_custom_event([this]() { return !this->full(); }, std::chrono::milliseconds(10));
+        }
+    }
+
+    /// \return retrieves and removes the first element in the queue, std::nullopt if the queue is empty
+    inline std::optional<T> try_pop() {
+        Cell* cell = nullptr;
+        auto position = this->dequeue_position.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &this->cells[position & this->mask];
+            const auto sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0) {
+                if (this->dequeue_position.compare_exchange_weak(position, position + 1,
+                                                                 std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return std::nullopt;
+            } else {
+                position = this->dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+        auto* element = std::launder(reinterpret_cast<T*>(&cell->storage));
+        std::optional<T> value(std::move(*element));
+        element->~T();
+        cell->sequence.store(position + this->mask + 1, std::memory_order_release);
+
+        this->notify_if_waiting();
+        return value;
+    }
+
+    /// \brief Clears the queue
+    inline void clear() {
+        while (this->try_pop().has_value()) {
+        }
+        this->notify_waiting_thread();
+    }
+
+    /// \brief Waits for the queue to receive an element
+    /// \param timeout to wait for an element, pass in a value <= 0 to wait indefinitely
+    inline void wait_on_queue_element(std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        wait_on_queue_element_or_predicate([]() { return false; }, timeout);
+    }
+
+    /// \brief Same as 'wait_on_queue' but receives an additional predicate to wait upon
+    template <class Predicate>
+    inline void wait_on_queue_element_or_predicate(Predicate pred,
+                                                   std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        wait_on_custom_event([&]() { return !this->empty() or pred(); }, timeout);
+    }
+
+    /// \brief Waits on the queue for a custom event. The predicate is evaluated again whenever an element is pushed or
+    /// popped or notify_waiting_thread is called
+    /// \param timeout to wait for an element, pass in a value <= 0 to wait indefinitely
+    template <class Predicate>
+    inline void wait_on_custom_event(Predicate pred, std::chrono::milliseconds timeout = std::chrono::milliseconds(0)) {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->waiters.fetch_add(1, std::memory_order_relaxed);
+        // pairs with the fence in notify_if_waiting: either the producer sees this waiter or the predicate sees the
+        // element
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (timeout.count() > 0) {
+            this->cv.wait_for(lock, timeout, [&]() { return pred(); });
+        } else {
+            this->cv.wait(lock, [&]() { return pred(); });
+        }
+        this->waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /// \brief Notifies all waiting threads to wake up
+    inline void notify_waiting_thread() {
+        {
+            // waiters evaluate their predicate under the lock, so taking it here ensures that the notification is not
+            // sent in between their check and their wait
+            std::lock_guard<std::mutex> lock(this->mutex);
+        }
+        this->cv.notify_all();
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+    };
+
+    // keep producers and consumers on different cache lines
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+    static constexpr int FULL_QUEUE_YIELDS = 64;
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_position{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> waiters{0};
+
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    inline bool full() const {
+        const auto position = this->enqueue_position.load(std::memory_order_relaxed);
+        const auto sequence = this->cells[position & this->mask].sequence.load(std::memory_order_acquire);
+        return sequence != position;
+    }
+
+    inline void notify_if_waiting() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (this->waiters.load(std::memory_order_relaxed) > 0) {
+            this->notify_waiting_thread();
+        }
+    }
+};
+
+} // namespace ocpp
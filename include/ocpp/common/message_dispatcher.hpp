@@ -27,6 +27,14 @@ public:
     ///         result of type T.
     virtual std::future<ocpp::EnhancedMessage<T>> dispatch_call_async(const json& call, bool triggered = false) = 0;
 
+    /// \brief Indicates if the caller may block on the future returned by dispatch_call_async until the response
+    /// arrives. This is not the case on the event loop of the single-threaded mode, which handles the response only
+    /// after the calling handler returned. Callers that would block have to give up without sending the call then.
+    /// \return true if waiting for the response is possible
+    virtual bool can_wait_for_response() const {
+        return true;
+    }
+
     /// \brief Dispatches a CallResult message.
     /// \param call_result the OCPP CallResult message.
     virtual void dispatch_call_result(const json& call_result) = 0;
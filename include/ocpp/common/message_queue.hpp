@@ -3,10 +3,13 @@
 #ifndef OCPP_COMMON_MESSAGE_QUEUE_HPP
 #define OCPP_COMMON_MESSAGE_QUEUE_HPP
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <future>
+#include <map>
 #include <mutex>
 #include <queue>
 #include <set>
@@ -16,6 +19,9 @@
 
 #include <ocpp/common/call_types.hpp>
 #include <ocpp/common/database/database_handler_common.hpp>
+#include <ocpp/common/event_loop.hpp>
+#include <ocpp/common/message_queue_eviction_strategy.hpp>
+#include <ocpp/common/message_queue_scheduler.hpp>
 #include <ocpp/common/types.hpp>
 #include <ocpp/v16/messages/StopTransaction.hpp>
 #include <ocpp/v16/types.hpp>
@@ -43,6 +49,27 @@ template <typename M> struct MessageQueueConfig {
         60; // interval for BootNotification.req in case response by CSMS is CALLERROR or CSMS does not respond at all
             // (within specified MessageTimeout)
 
+    // maximum number of CALLs that are awaiting a response at the same time. A value of 1 keeps the strict
+    // one-message-in-flight behavior; higher values pipeline non-transactional messages once the registration status is
+    // accepted. Transaction related messages are always sent one at a time to preserve their order
+    int max_messages_in_flight = 1;
+
+    // threshold for the accumulated size of the serialized messages in the queues in bytes. Exceeding it drops messages
+    // like exceeding queues_total_size_threshold does. 0 disables the byte threshold
+    std::size_t queues_total_size_threshold_bytes = 0;
+
+    // if greater than 0, transaction update messages are thinned out by time starting with this resolution instead of
+    // dropping every second update message once the queues exceed their thresholds
+    int transaction_update_thinning_resolution_seconds = 0;
+
+    // number of queued transaction messages that triggers merging consecutive transaction update messages of the same
+    // transaction, e.g. while offline. 0 disables the compaction
+    int transaction_message_compaction_threshold = 0;
+
+    // meter values of merged transaction update messages are aggregated to one meter value per interval. 0 keeps all
+    // meter values of the merged messages
+    int transaction_message_compaction_interval_seconds = 900;
+
     /// \brief Returns true if the given \p message_type shall be queued based on the configuration of
     /// queue_all_messages and message_types_discard_for_queueing
     bool check_queue(const M& message_type) {
@@ -57,7 +84,8 @@ template <typename M> struct EnhancedMessage {
     MessageId uniqueId;               ///< The unique ID of the json message
     M messageType = M::InternalError; ///< The OCPP message type
     MessageTypeId messageTypeId;      ///< The OCPP message type ID (CALL/CALLRESULT/CALLERROR)
-    json call_message;    ///< If the message is a CALLRESULT or CALLERROR this can contain the original CALL message
+    json call_message; ///< If the message is a CALLRESULT or CALLERROR this can contain the original CALL message. For
+                       ///< a CALL it is empty, the CALL itself is in message
     bool offline = false; ///< A flag indicating if the connection to the central system is offline
 };
 
@@ -70,6 +98,10 @@ template <typename M> struct ControlMessage {
     DateTime timestamp;                       ///< A timestamp that shows when this message can be sent
     MessageId initial_unique_id;
     bool stall_until_accepted; // if true, message shall be sent only if registration status is accepted
+    std::size_t message_size = 0; ///< size of the serialized message in bytes, only set if the queues have a byte
+                                  ///< threshold
+    bool compacted = false; ///< true if the meter values of this message might already be aggregated by a compaction
+                            ///< of the transaction message queue, so they must not be aggregated again
 
     /// \brief Creates a new ControlMessage object from the provided \p message
     explicit ControlMessage(const json& message, const bool stall_until_accepted = false);
@@ -163,15 +195,26 @@ bool allowed_to_send_message(const ControlMessage<M>& message, const DateTime& t
 /// \brief contains a message queue that makes sure that OCPPs synchronicity requirements are met
 template <typename M> class MessageQueue {
 private:
+    /// \brief A CALL that has been sent and waits for its CALLRESULT or CALLERROR
+    struct InFlightMessage {
+        std::shared_ptr<ControlMessage<M>> message;
+        std::chrono::steady_clock::time_point timeout;
+    };
+
     MessageQueueConfig<M> config;
     std::shared_ptr<ocpp::common::DatabaseHandlerCommon> database_handler;
 
     std::thread worker_thread;
     /// message deque for transaction related messages
     std::deque<std::shared_ptr<ControlMessage<M>>> transaction_message_queue;
-    /// message queue for non-transaction related messages
-    std::deque<std::shared_ptr<ControlMessage<M>>> normal_message_queue;
-    std::shared_ptr<ControlMessage<M>> in_flight;
+    /// message queue for non-transaction related messages, indexed by readiness so the next sendable message can be
+    /// selected without scanning the whole queue
+    MessageQueueScheduler<ControlMessage<M>> normal_message_queue;
+    /// messages in flight keyed by their unique id
+    std::map<MessageId, InFlightMessage> in_flight_messages;
+    /// accumulated size of the messages in both queues in bytes
+    std::size_t queued_message_bytes = 0;
+    std::unique_ptr<MessageQueueEvictionStrategy<ControlMessage<M>>> eviction_strategy;
     std::recursive_mutex message_mutex;
     std::condition_variable_any cv;
     std::function<bool(json message)> send_callback;
@@ -185,11 +228,17 @@ private:
     std::recursive_mutex next_message_mutex;
     std::optional<MessageId> next_message_to_send;
 
-    Everest::SteadyTimer in_flight_timeout_timer;
-    Everest::SteadyTimer notify_queue_timer;
+    std::unique_ptr<Everest::SteadyTimer> in_flight_timeout_timer;
+    std::unique_ptr<Everest::SteadyTimer> notify_queue_timer;
 
     // This timer schedules the resumption of the message queue
-    Everest::SteadyTimer resume_timer;
+    std::unique_ptr<Everest::SteadyTimer> resume_timer;
+
+    // set if the queue is processed on an event loop instead of the worker thread
+    std::unique_ptr<EventLoopExecutor> event_loop;
+    // true while a processing handler is posted to the event loop, so notifications in a row post only one handler
+    std::atomic_bool processing_posted{false};
+
     // Counts the number of pause()/resume() calls.
     // Used by the resume timer callback to abort itself in case the timer triggered before it could be cancelled.
     u_int64_t pause_resume_ctr = 0;
@@ -200,6 +249,14 @@ private:
     // StopTransaction.req
     std::map<std::string, int32_t> message_id_transaction_id_map;
 
+    // key is a transaction id and the value is the number of messages of this transaction that were merged into others
+    // by compact_transaction_message_queue. Sequence numbers of messages of this transaction that are queued later are
+    // reduced by this offset to keep them without gaps. The offsets are persisted, since the transaction can continue
+    // after a restart
+    std::map<std::string, int32_t> transaction_seq_no_offsets;
+    // size of the transaction message queue that triggers the next compaction
+    std::size_t next_transaction_compaction_size = 0;
+
     // key is the message id of a StartTransaction.req and value is a list of MeterValue.req message ids. It is used to
     // replace the transactionId within the MeterValue.req in case the transactionId was unknown at the time the message
     // was queued. This can happen when the CP has not received a StartTransaction.conf from the CSMS.
@@ -209,12 +266,13 @@ private:
     std::function<void(const std::string& new_message_id, const std::string& old_message_id)>
         start_transaction_message_retry_callback;
 
-    MessageId getMessageId(const json::array_t& json_message) {
+    // these take the json by reference on purpose: binding it to a json::array_t would copy the whole message
+    MessageId getMessageId(const json& json_message) {
         return MessageId(json_message.at(MESSAGE_ID).get<std::string>());
     }
-    MessageTypeId getMessageTypeId(const json::array_t& json_message) {
-        if (json_message.size() > 0) {
-            auto messageTypeId = json_message.at(MESSAGE_TYPE_ID);
+    MessageTypeId getMessageTypeId(const json& json_message) {
+        if (json_message.is_array() and json_message.size() > 0) {
+            const auto& messageTypeId = json_message.at(MESSAGE_TYPE_ID);
             if (messageTypeId == MessageTypeId::CALL) {
                 return MessageTypeId::CALL;
             }
@@ -228,7 +286,7 @@ private:
 
         return MessageTypeId::UNKNOWN;
     }
-    bool isValidMessageType(const json::array_t& json_message) {
+    bool isValidMessageType(const json& json_message) {
         if (this->getMessageTypeId(json_message) != MessageTypeId::UNKNOWN) {
             return true;
         }
@@ -245,6 +303,7 @@ private:
             } else {
                 this->normal_message_queue.push_back(message);
             }
+            this->account_queued_message(message);
             if (this->config.check_queue(message->messageType)) {
                 ocpp::common::DBTransactionMessage db_message{
                     message->message, messagetype_to_string(message->messageType), message->message_attempts,
@@ -258,14 +317,16 @@ private:
             this->new_message = true;
             this->check_queue_sizes();
         }
-        this->cv.notify_all();
+        this->notify_worker();
         EVLOG_debug << "Notified message queue worker";
     }
     void add_to_transaction_message_queue(std::shared_ptr<ControlMessage<M>> message) {
         EVLOG_debug << "Adding message to transaction message queue";
         {
             std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+            this->renumber_transaction_message(*message);
             this->transaction_message_queue.push_back(message);
+            this->account_queued_message(message);
             ocpp::common::DBTransactionMessage db_message{message->message, messagetype_to_string(message->messageType),
                                                           message->message_attempts, message->timestamp,
                                                           message->uniqueId()};
@@ -275,37 +336,126 @@ private:
                 EVLOG_warning << "Could not insert message into transaction queue: " << e.what();
             }
             this->new_message = true;
+            this->check_transaction_message_compaction();
             this->check_queue_sizes();
         }
-        this->cv.notify_all();
+        this->notify_worker();
         EVLOG_debug << "Notified message queue worker";
     }
 
+    /// \brief Compacts the transaction message queue once it reached the configured compaction threshold. The next
+    /// compaction is triggered after another threshold of messages has been queued, so a backlog that cannot be
+    /// compacted any further is not scanned on every new message
+    void check_transaction_message_compaction() {
+        if (this->config.transaction_message_compaction_threshold <= 0) {
+            return;
+        }
+        const auto threshold = static_cast<std::size_t>(this->config.transaction_message_compaction_threshold);
+        if (this->transaction_message_queue.size() < std::max(threshold, this->next_transaction_compaction_size)) {
+            return;
+        }
+        this->compact_transaction_message_queue();
+        this->next_transaction_compaction_size = this->transaction_message_queue.size() + threshold;
+    }
+
+    /// \brief Merges consecutive transaction update messages of the same transaction in the transaction message queue
+    /// and renumbers the sequence numbers of the following messages. Only implemented for OCPP 2.0.1, where this merges
+    /// periodic TransactionEvent(Updated) messages
+    void compact_transaction_message_queue() {
+    }
+
+    /// \brief Applies the sequence number offset of its transaction to the newly queued \p message
+    void renumber_transaction_message([[maybe_unused]] ControlMessage<M>& message) {
+    }
+
+    /// \brief Restores the sequence number offsets of transactions whose messages have been compacted before a restart
+    void restore_transaction_seq_no_offsets() {
+    }
+
+    /// \brief Writes the changed \p message to the database and updates its size in queued_message_bytes
+    void update_queued_transaction_message(const std::shared_ptr<ControlMessage<M>>& message) {
+        this->account_dequeued_message(message);
+        message->message_size = 0;
+        this->account_queued_message(message);
+        try {
+            this->database_handler->remove_message_queue_message(message->initial_unique_id);
+            this->database_handler->insert_message_queue_message(ocpp::common::DBTransactionMessage{
+                message->message, messagetype_to_string(message->messageType), message->message_attempts,
+                message->timestamp, message->initial_unique_id});
+        } catch (const QueryExecutionException& e) {
+            EVLOG_warning << "Could not update message in transaction queue: " << e.what();
+        }
+    }
+
+    /// \brief Adds the size of \p message that has just been added to one of the queues to queued_message_bytes
+    void account_queued_message(const std::shared_ptr<ControlMessage<M>>& message) {
+        if (this->config.queues_total_size_threshold_bytes == 0) {
+            return;
+        }
+        if (message->message_size == 0) {
+            // a json::array_t can not be dumped itself, so its elements are dumped instead of a copy of the whole
+            // message: two brackets, the commas between the elements and the elements
+            std::size_t message_size = message->message.empty() ? 2 : message->message.size() + 1;
+            for (const auto& element : message->message) {
+                message_size += element.dump().size();
+            }
+            message->message_size = message_size;
+        }
+        this->queued_message_bytes += message->message_size;
+    }
+
+    /// \brief Subtracts the size of \p message that has just been removed from one of the queues from
+    /// queued_message_bytes
+    void account_dequeued_message(const std::shared_ptr<ControlMessage<M>>& message) {
+        this->queued_message_bytes -= std::min(this->queued_message_bytes, message->message_size);
+    }
+
+    /// \returns the number of messages and bytes by which the queues exceed their thresholds
+    MessageQueueEvictionTarget get_queue_size_excess() const {
+        MessageQueueEvictionTarget excess{0, 0};
+        const auto message_count = this->transaction_message_queue.size() + this->normal_message_queue.size();
+        const auto message_threshold = static_cast<std::size_t>(std::max(this->config.queues_total_size_threshold, 0));
+        if (message_count > message_threshold) {
+            excess.messages = message_count - message_threshold;
+        }
+        if (this->config.queues_total_size_threshold_bytes > 0 and
+            this->queued_message_bytes > this->config.queues_total_size_threshold_bytes) {
+            excess.bytes = this->queued_message_bytes - this->config.queues_total_size_threshold_bytes;
+        }
+        return excess;
+    }
+
+    bool queues_exceed_threshold() const {
+        const auto excess = this->get_queue_size_excess();
+        return excess.messages > 0 or excess.bytes > 0;
+    }
+
     void check_queue_sizes() {
-        if (this->transaction_message_queue.size() + this->normal_message_queue.size() <=
-            this->config.queues_total_size_threshold) {
+        if (!this->queues_exceed_threshold()) {
             return;
         }
-        EVLOG_warning << "Queue sizes exceed threshold (" << this->config.queues_total_size_threshold << ") with "
+        EVLOG_warning << "Queue sizes exceed threshold (" << this->config.queues_total_size_threshold << " messages, "
+                      << this->config.queues_total_size_threshold_bytes << " bytes) with "
                       << this->transaction_message_queue.size() << " transaction and "
-                      << this->normal_message_queue.size() << " normal messages in queue";
+                      << this->normal_message_queue.size() << " normal messages (" << this->queued_message_bytes
+                      << " bytes) in queue";
 
-        while (this->transaction_message_queue.size() + this->normal_message_queue.size() >
-                   this->config.queues_total_size_threshold &&
-               !this->normal_message_queue.empty()) {
+        while (this->queues_exceed_threshold() && !this->normal_message_queue.empty()) {
             this->drop_messages_from_normal_message_queue();
         }
 
-        while (this->transaction_message_queue.size() + this->normal_message_queue.size() >
-                   this->config.queues_total_size_threshold &&
-               this->drop_update_messages_from_transactional_message_queue()) {
+        while (this->queues_exceed_threshold() && this->drop_update_messages_from_transactional_message_queue()) {
         }
     }
 
     void drop_messages_from_normal_message_queue() {
-        // try to drop approx 10% of the allowed size (at least 1)
-        int number_of_dropped_messages = std::min((int)this->normal_message_queue.size(),
+        // try to drop approx 10% of the allowed size (at least 1). If only the byte threshold is exceeded, messages are
+        // dropped one by one until it is met again
+        int number_of_dropped_messages = 1;
+        if (this->get_queue_size_excess().messages > 0) {
+            number_of_dropped_messages = std::min((int)this->normal_message_queue.size(),
                                                   std::max(this->config.queues_total_size_threshold / 10, 1));
+        }
 
         EVLOG_warning << "Dropping " << number_of_dropped_messages << " messages from normal message queue.";
 
@@ -320,26 +470,28 @@ private:
                     EVLOG_warning << "Could not delete message from transaction queue: " << e.what();
                 }
             }
+            this->account_dequeued_message(this->normal_message_queue.front());
             this->normal_message_queue.pop_front();
         }
     }
 
-    /**
-     *  Heuristically drops every second update messag.
-     *  Drops every first, third, ... update message in between two non-update message; disregards transaction
-     * ids etc!
-     * Cf. OCPP 2.0.1. specification 2.1.9 "QueueAllMessages"
-     */
+    /// \brief Drops the transaction update messages selected by the eviction strategy
+    /// \returns true if at least one message was dropped
     bool drop_update_messages_from_transactional_message_queue() {
+        const auto selected = this->eviction_strategy->select_transaction_messages_to_drop(
+            this->transaction_message_queue, this->get_queue_size_excess());
+
         int drop_count = 0;
         std::deque<std::shared_ptr<ControlMessage<M>>> temporary_swap_queue;
-        bool remove_next_update_message = true;
-        while (!transaction_message_queue.empty()) {
-            auto element = transaction_message_queue.front();
-            transaction_message_queue.pop_front();
-            // drop every second update message (except last one)
-            if (remove_next_update_message && element->is_transaction_update_message() &&
-                transaction_message_queue.size() > 1) {
+        auto next_selected = selected.begin();
+        for (std::size_t i = 0; i < this->transaction_message_queue.size(); i++) {
+            auto& element = this->transaction_message_queue.at(i);
+            const auto is_selected = next_selected != selected.end() and *next_selected == i;
+            if (is_selected) {
+                next_selected++;
+            }
+            // messages starting or ending a transaction are never dropped
+            if (is_selected and element->is_transaction_update_message()) {
                 EVLOG_debug << "Drop transactional message " << element->initial_unique_id;
                 try {
                     database_handler->remove_message_queue_message(element->initial_unique_id);
@@ -348,11 +500,10 @@ private:
                 } catch (const std::exception& e) {
                     EVLOG_warning << "Could not delete message from transaction queue: " << e.what();
                 }
+                this->account_dequeued_message(element);
                 drop_count++;
-                remove_next_update_message = false;
             } else {
-                remove_next_update_message = true;
-                temporary_swap_queue.push_back(element);
+                temporary_swap_queue.push_back(std::move(element));
             }
         }
 
@@ -373,7 +524,7 @@ private:
         if (this->pause_resume_ctr == expected_pause_resume_ctr) {
             this->paused = false;
             this->resuming = false;
-            this->cv.notify_one();
+            this->notify_worker();
             EVLOG_debug << "resume() notified message queue";
         }
     }
@@ -384,6 +535,352 @@ private:
                                     (this->config.transaction_message_retry_interval * attempt));
     }
 
+    // Number of messages that may be in flight at the same time. Pipelining only starts once the registration status is
+    // accepted, so the BootNotification.req is never overtaken
+    std::size_t in_flight_window() const {
+        if (!this->is_registration_status_accepted) {
+            return 1;
+        }
+        return static_cast<std::size_t>(std::max(this->config.max_messages_in_flight, 1));
+    }
+
+    bool can_send_message() const {
+        return this->in_flight_messages.size() < this->in_flight_window();
+    }
+
+    bool is_transaction_message_in_flight() const {
+        return std::any_of(this->in_flight_messages.begin(), this->in_flight_messages.end(),
+                           [](const auto& entry) { return is_transaction_message(*entry.second.message); });
+    }
+
+    void add_in_flight_message(const std::shared_ptr<ControlMessage<M>>& message) {
+        const auto timeout =
+            std::chrono::steady_clock::now() + this->current_message_timeout(message->message_attempts);
+        this->in_flight_messages[message->uniqueId()] = InFlightMessage{message, timeout};
+        this->arm_in_flight_timeout_timer();
+    }
+
+    /// \brief Removes the message with the given \p unique_id from the messages in flight
+    /// \returns the removed message or nullptr if no message with this id is in flight
+    std::shared_ptr<ControlMessage<M>> take_in_flight_message(const MessageId& unique_id) {
+        const auto it = this->in_flight_messages.find(unique_id);
+        if (it == this->in_flight_messages.end()) {
+            return nullptr;
+        }
+        auto message = it->second.message;
+        this->in_flight_messages.erase(it);
+        this->arm_in_flight_timeout_timer();
+        // a slot in the window has been freed
+        this->new_message = true;
+        return message;
+    }
+
+    // Arms the timeout timer for the message in flight that times out first
+    void arm_in_flight_timeout_timer() {
+        if (this->in_flight_messages.empty()) {
+            this->in_flight_timeout_timer->stop();
+            return;
+        }
+        const auto first_timeout =
+            std::min_element(this->in_flight_messages.begin(), this->in_flight_messages.end(),
+                             [](const auto& lhs, const auto& rhs) { return lhs.second.timeout < rhs.second.timeout; })
+                ->second.timeout;
+        const auto remaining = std::max(first_timeout - std::chrono::steady_clock::now(),
+                                        std::chrono::steady_clock::duration::zero());
+        this->in_flight_timeout_timer->timeout([this]() { this->handle_in_flight_timeouts(); },
+                                               std::chrono::duration_cast<std::chrono::milliseconds>(remaining));
+    }
+
+    void handle_in_flight_timeouts() {
+        std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+        const auto now = std::chrono::steady_clock::now();
+        std::vector<MessageId> timed_out_ids;
+        for (const auto& [unique_id, in_flight_message] : this->in_flight_messages) {
+            if (in_flight_message.timeout <= now) {
+                timed_out_ids.push_back(unique_id);
+            }
+        }
+        for (const auto& unique_id : timed_out_ids) {
+            auto message = this->take_in_flight_message(unique_id);
+            this->handle_timeout_or_callerror_internal(message, std::nullopt);
+        }
+        this->arm_in_flight_timeout_timer();
+    }
+
+    // Wakes up the worker once the next delayed message of one of the queues is due
+    void schedule_wakeup_for_delayed_messages(const DateTime& now) {
+        std::optional<DateTime> next_due = this->normal_message_queue.next_due();
+        if (!this->transaction_message_queue.empty()) {
+            const auto& timestamp = this->transaction_message_queue.front()->timestamp;
+            if (timestamp > now and (!next_due.has_value() or timestamp < next_due.value())) {
+                next_due = timestamp;
+            }
+        }
+        if (!next_due.has_value()) {
+            return;
+        }
+        this->notify_queue_timer->at(
+            [this]() {
+                this->new_message = true;
+                this->notify_worker();
+            },
+            next_due.value().to_time_point());
+    }
+
+    /// \brief Handles a message timeout or a CALLERROR of the given \p message that has already been removed from the
+    /// messages in flight. \p enhanced_message_opt is set only in case of CALLERROR
+    void handle_timeout_or_callerror_internal(const std::shared_ptr<ControlMessage<M>>& message,
+                                              const std::optional<EnhancedMessage<M>>& enhanced_message_opt) {
+        // We got a timeout iff enhanced_message_opt is empty. Otherwise, enhanced_message_opt contains the CallError.
+        bool timeout = !enhanced_message_opt.has_value();
+        if (timeout) {
+            EVLOG_warning << "Message timeout for: " << message->messageType << " (" << message->uniqueId() << ")";
+        } else {
+            EVLOG_warning << "CALLERROR for: " << message->messageType << " (" << message->uniqueId() << ")";
+        }
+
+        const auto queue_type = is_transaction_message(*message) ? QueueType::Transaction : QueueType::Normal;
+        if (is_transaction_message(*message) or this->config.check_queue(message->messageType)) {
+            if (message->message_attempts < this->config.transaction_message_attempts) {
+                EVLOG_warning << "Message shall be persisted and will therefore be sent again";
+                // Generate a new message ID for the retry
+                const auto old_message_id = message->message[MESSAGE_ID];
+                message->message[MESSAGE_ID] = ocpp::create_message_id();
+                if (this->config.transaction_message_retry_interval > 0) {
+                    // exponential backoff
+                    message->timestamp =
+                        DateTime(message->timestamp.to_time_point() +
+                                 std::chrono::seconds(this->config.transaction_message_retry_interval) *
+                                     message->message_attempts);
+                    EVLOG_debug << "Retry interval > 0: " << this->config.transaction_message_retry_interval
+                                << " attempting to retry message at: " << message->timestamp;
+                } else {
+                    // immediate retry
+                    message->timestamp = DateTime();
+                    EVLOG_debug << "Retry interval of 0 means immediate retry";
+                }
+
+                EVLOG_warning << "Attempt: " << message->message_attempts + 1 << "/"
+                              << this->config.transaction_message_attempts << " will be sent at "
+                              << message->timestamp;
+
+                if (queue_type == QueueType::Transaction) {
+                    this->transaction_message_queue.push_front(message);
+                } else if (queue_type == QueueType::Normal) {
+                    this->normal_message_queue.push_front(message);
+                }
+                this->account_queued_message(message);
+                if (is_start_transaction_message(*message)) {
+                    this->start_transaction_message_retry_callback(message->message[MESSAGE_ID], old_message_id);
+                }
+            } else {
+                EVLOG_error << "Could not deliver message within the configured amount of attempts, "
+                               "dropping message";
+                if (enhanced_message_opt) {
+                    message->promise.set_value(enhanced_message_opt.value());
+                } else {
+                    EnhancedMessage<M> enhanced_message;
+                    enhanced_message.offline = true;
+                    message->promise.set_value(enhanced_message);
+                }
+                try {
+                    // also drop the message from the database
+                    this->database_handler->remove_message_queue_message(message->initial_unique_id, queue_type);
+                } catch (const QueryExecutionException& e) {
+                    EVLOG_warning << "Could not delete message from transaction queue: " << e.what();
+                } catch (const std::exception& e) {
+                    EVLOG_warning << "Could not delete message from transaction queue: " << e.what();
+                }
+            }
+        } else if (is_boot_notification_message(message->messageType)) {
+            EVLOG_warning << "Message is BootNotification.req and will therefore be sent again";
+            // Generate a new message ID for the retry
+            message->message[MESSAGE_ID] = ocpp::create_message_id();
+            // Spec does not define how to handle retries for BootNotification.req: We use the
+            // the boot_notification_retry_interval_seconds
+            message->timestamp = DateTime(message->timestamp.to_time_point() +
+                                          std::chrono::seconds(this->config.boot_notification_retry_interval_seconds));
+            this->normal_message_queue.push_front(message);
+            this->account_queued_message(message);
+        } else {
+            EVLOG_warning << "Message is not transaction related, dropping it";
+            if (enhanced_message_opt) {
+                message->promise.set_value(enhanced_message_opt.value());
+            } else {
+                EnhancedMessage<M> enhanced_message;
+                enhanced_message.offline = true;
+                message->promise.set_value(enhanced_message);
+            }
+        }
+        // the worker schedules its own wakeup in case the requeued message is not due yet
+        this->new_message = true;
+        this->notify_worker();
+    }
+
+    /// \brief Selects the next message that is due and sends it. The message_mutex has to be held by the caller
+    /// \returns false if no message could be sent, i.e. the queue cannot make progress until it is notified again
+    bool send_next_message() {
+        if (this->transaction_message_queue.empty() && this->normal_message_queue.empty()) {
+            // There is nothing in the message queue, not progressing further
+            this->new_message = false;
+            return false;
+        }
+        EVLOG_debug << "There are " << this->normal_message_queue.size() << " messages in the normal message queue.";
+        EVLOG_debug << "There are " << this->transaction_message_queue.size()
+                    << " messages in the transaction message queue.";
+
+        if (this->paused) {
+            // Message queue is paused, not progressing further
+            return false;
+        }
+
+        if (!this->can_send_message()) {
+            // The maximum number of messages is in flight, not progressing further
+            return false;
+        } else {
+            EVLOG_debug << "There are " << this->in_flight_messages.size()
+                        << " messages in flight, checking message queue for a new message.";
+        }
+
+        // prioritize the message with the oldest timestamp
+        std::shared_ptr<ControlMessage<M>> message = nullptr;
+        QueueType queue_type = QueueType::None;
+        const auto now = DateTime();
+
+        // Find the first allowed normal message
+        message = this->normal_message_queue.next_ready(now);
+        if (message != nullptr) {
+            queue_type = QueueType::Normal;
+        }
+
+        auto is_transaction_message_available = [&](const std::shared_ptr<ControlMessage<M>>& msg) {
+            if (!allowed_to_send_message(*msg, now, this->is_registration_status_accepted)) {
+                return false;
+            }
+            // no message selected from normal message queue, so select transaction message
+            if (message == nullptr) {
+                return true;
+            }
+            // message from normal message queue is BootNotification, this is prioritized
+            if (message->messageType == M::BootNotification) {
+                return false;
+            }
+            // transaction messages is older than normal message, so select transaction message
+            if (msg->timestamp <= message->timestamp) {
+                return true;
+            }
+            return false;
+        };
+
+        // Transaction messages must persist the order, so only check the first in the queue and only if no
+        // other transaction message is still waiting for its response
+        auto selected_transaction_message_it =
+            (!transaction_message_queue.empty() and !this->is_transaction_message_in_flight() and
+             is_transaction_message_available(transaction_message_queue.front()))
+                ? transaction_message_queue.begin()
+                : transaction_message_queue.end();
+
+        if (selected_transaction_message_it != transaction_message_queue.end()) {
+            message = *selected_transaction_message_it;
+            queue_type = QueueType::Transaction;
+        }
+
+        if (message == nullptr) {
+            EVLOG_debug << "No message in queue ready to be sent yet";
+            this->new_message = false;
+            this->schedule_wakeup_for_delayed_messages(now);
+            return false;
+        }
+
+        {
+            std::lock_guard<std::recursive_mutex> lk(this->next_message_mutex);
+            if (next_message_to_send.has_value()) {
+                if (next_message_to_send.value() != message->uniqueId()) {
+                    EVLOG_debug << "Message with id " << message->uniqueId()
+                                << " held back because message with id " << next_message_to_send.value()
+                                << " should be sent first";
+                    return false;
+                }
+            }
+        }
+
+        EVLOG_debug << "Attempting to send message to central system. UID: " << message->uniqueId()
+                    << " attempt#: " << message->message_attempts;
+        message->message_attempts += 1;
+
+        if (this->message_id_transaction_id_map.count(message->message.at(1))) {
+            EVLOG_debug << "Replacing transaction id";
+            message->message.at(3)["transactionId"] = this->message_id_transaction_id_map.at(message->message.at(1));
+            this->message_id_transaction_id_map.erase(message->message.at(1));
+        }
+
+        if (!this->send_callback(message->message)) {
+            this->paused = true;
+            EVLOG_error << "Could not send message, this is most likely because the charge point is offline.";
+            if (is_transaction_message(*message)) {
+                EVLOG_info << "The message in flight is transaction related and will be sent again once the "
+                              "connection can be established again.";
+                if (message->message.at(CALL_ACTION) == "TransactionEvent") {
+                    message->message.at(CALL_PAYLOAD)["offline"] = true;
+                }
+            } else if (this->config.check_queue(message->messageType)) {
+                EVLOG_info << "The message in flight  will be sent again once the connection can be "
+                              "established again since QueueAllMessages is set to 'true'.";
+            } else {
+                EVLOG_info << "The message in flight is not transaction related and will be dropped";
+                if (queue_type == QueueType::Normal) {
+                    EnhancedMessage<M> enhanced_message;
+                    enhanced_message.offline = true;
+                    message->promise.set_value(enhanced_message);
+                    this->normal_message_queue.erase(message);
+                    this->account_dequeued_message(message);
+                }
+            }
+        } else {
+            EVLOG_debug << "Successfully sent message. UID: " << message->uniqueId();
+            this->add_in_flight_message(message);
+            if (queue_type != QueueType::None) {
+                this->account_dequeued_message(message);
+            }
+            switch (queue_type) {
+            case QueueType::Normal:
+                this->normal_message_queue.erase(message);
+                break;
+            case QueueType::Transaction:
+                this->transaction_message_queue.erase(selected_transaction_message_it);
+                break;
+            case QueueType::None:
+                // do nothing
+                break;
+            }
+        }
+        if (this->transaction_message_queue.empty() && this->normal_message_queue.empty()) {
+            this->new_message = false;
+        }
+        return true;
+    }
+
+    /// \brief Wakes up the worker thread or, if the queue is processed on an event loop, posts the processing
+    void notify_worker() {
+        this->cv.notify_all();
+        if (this->event_loop != nullptr and !this->processing_posted.exchange(true)) {
+            this->event_loop->post([this]() {
+                this->processing_posted = false;
+                this->process_messages();
+            });
+        }
+    }
+
+    /// \brief Sends messages on the event loop as long as the queue makes progress, replaces the worker thread
+    void process_messages() {
+        std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+        while (this->running and !this->paused and this->new_message and this->can_send_message()) {
+            if (!this->send_next_message()) {
+                break;
+            }
+        }
+    }
+
 public:
     /// \brief Creates a new MessageQueue object with the provided \p configuration and \p send_callback
     MessageQueue(
@@ -403,7 +900,15 @@ public:
         start_transaction_message_retry_callback(start_transaction_message_retry_callback) {
 
         this->send_callback = send_callback;
-        this->in_flight = nullptr;
+        this->in_flight_timeout_timer = std::make_unique<Everest::SteadyTimer>();
+        this->notify_queue_timer = std::make_unique<Everest::SteadyTimer>();
+        this->resume_timer = std::make_unique<Everest::SteadyTimer>();
+        if (this->config.transaction_update_thinning_resolution_seconds > 0) {
+            this->eviction_strategy = std::make_unique<ThinUpdatesByTimeEvictionStrategy<ControlMessage<M>>>(
+                std::chrono::seconds(this->config.transaction_update_thinning_resolution_seconds));
+        } else {
+            this->eviction_strategy = std::make_unique<DropEveryOtherUpdateEvictionStrategy<ControlMessage<M>>>();
+        }
     }
 
     MessageQueue(const std::function<bool(json message)>& send_callback, const MessageQueueConfig<M>& config,
@@ -413,7 +918,6 @@ public:
 
     void start() {
         this->worker_thread = std::thread([this]() {
-            // TODO(kai): implement message timeout
             while (this->running) {
                 EVLOG_debug << "Waiting for a message from the message queue";
 
@@ -421,159 +925,48 @@ public:
                 using namespace std::chrono_literals;
                 // It's safe to wait on the cv here because we're guaranteed to only lock this->message_mutex once
                 this->cv.wait(lk, [this]() {
-                    return !this->running || (!this->paused && this->new_message && this->in_flight == nullptr);
+                    return !this->running || (!this->paused && this->new_message && this->can_send_message());
                 });
-                if (this->transaction_message_queue.empty() && this->normal_message_queue.empty()) {
-                    // There is nothing in the message queue, not progressing further
-                    continue;
-                }
-                EVLOG_debug << "There are " << this->normal_message_queue.size()
-                            << " messages in the normal message queue.";
-                EVLOG_debug << "There are " << this->transaction_message_queue.size()
-                            << " messages in the transaction message queue.";
-
-                if (this->paused) {
-                    // Message queue is paused, not progressing further
-                    continue;
-                }
-
-                if (this->in_flight != nullptr) {
-                    // There already is a message in flight, not progressing further
-                    continue;
-                } else {
-                    EVLOG_debug << "There is no message in flight, checking message queue for a new message.";
-                }
-
-                // prioritize the message with the oldest timestamp
-                std::shared_ptr<ControlMessage<M>> message = nullptr;
-                QueueType queue_type = QueueType::None;
-                const auto now = DateTime();
-
-                // Find the first allowed normal message
-                auto selected_normal_message_it =
-                    std::find_if(normal_message_queue.begin(), normal_message_queue.end(),
-                                 [&](const std::shared_ptr<ControlMessage<M>>& msg) {
-                                     return allowed_to_send_message(*msg, now, this->is_registration_status_accepted);
-                                 });
-
-                if (selected_normal_message_it != normal_message_queue.end()) {
-                    message = *selected_normal_message_it;
-                    queue_type = QueueType::Normal;
-                }
-
-                auto is_transaction_message_available = [&](const std::shared_ptr<ControlMessage<M>>& msg) {
-                    if (!allowed_to_send_message(*msg, now, this->is_registration_status_accepted)) {
-                        return false;
-                    }
-                    // no message selected from normal message queue, so select transaction message
-                    if (message == nullptr) {
-                        return true;
-                    }
-                    // message from normal message queue is BootNotification, this is prioritized
-                    if (message->messageType == M::BootNotification) {
-                        return false;
-                    }
-                    // transaction messages is older than normal message, so select transaction message
-                    if (msg->timestamp <= message->timestamp) {
-                        return true;
-                    }
-                    return false;
-                };
-
-                // Transaction messages must persist the order, so only check the first in the queue
-                auto selected_transaction_message_it =
-                    (!transaction_message_queue.empty() and
-                     is_transaction_message_available(transaction_message_queue.front()))
-                        ? transaction_message_queue.begin()
-                        : transaction_message_queue.end();
-
-                if (selected_transaction_message_it != transaction_message_queue.end()) {
-                    message = *selected_transaction_message_it;
-                    queue_type = QueueType::Transaction;
-                }
-
-                if (message == nullptr) {
-                    EVLOG_debug << "No message in queue ready to be sent yet";
-                    this->new_message = false;
-                    continue;
+                if (this->send_next_message()) {
+                    lk.unlock();
+                    cv.notify_one();
                 }
-
-                {
-                    std::lock_guard<std::recursive_mutex> lk(this->next_message_mutex);
-                    if (next_message_to_send.has_value()) {
-                        if (next_message_to_send.value() != message->uniqueId()) {
-                            EVLOG_debug << "Message with id " << message->uniqueId()
-                                        << " held back because message with id " << next_message_to_send.value()
-                                        << " should be sent first";
-                            continue;
-                        }
-                    }
-                }
-
-                EVLOG_debug << "Attempting to send message to central system. UID: " << message->uniqueId()
-                            << " attempt#: " << message->message_attempts;
-                this->in_flight = message;
-                this->in_flight->message_attempts += 1;
-
-                if (this->message_id_transaction_id_map.count(this->in_flight->message.at(1))) {
-                    EVLOG_debug << "Replacing transaction id";
-                    this->in_flight->message.at(3)["transactionId"] =
-                        this->message_id_transaction_id_map.at(this->in_flight->message.at(1));
-                    this->message_id_transaction_id_map.erase(this->in_flight->message.at(1));
-                }
-
-                if (!this->send_callback(this->in_flight->message)) {
-                    this->paused = true;
-                    EVLOG_error << "Could not send message, this is most likely because the charge point is offline.";
-                    if (this->in_flight && is_transaction_message(*this->in_flight)) {
-                        EVLOG_info << "The message in flight is transaction related and will be sent again once the "
-                                      "connection can be established again.";
-                        if (this->in_flight->message.at(CALL_ACTION) == "TransactionEvent") {
-                            this->in_flight->message.at(CALL_PAYLOAD)["offline"] = true;
-                        }
-                    } else if (this->config.check_queue(this->in_flight->messageType)) {
-                        EVLOG_info << "The message in flight  will be sent again once the connection can be "
-                                      "established again since QueueAllMessages is set to 'true'.";
-                    } else {
-                        EVLOG_info << "The message in flight is not transaction related and will be dropped";
-                        if (queue_type == QueueType::Normal) {
-                            EnhancedMessage<M> enhanced_message;
-                            enhanced_message.offline = true;
-                            this->in_flight->promise.set_value(enhanced_message);
-                            this->normal_message_queue.pop_front();
-                        }
-                    }
-                    this->reset_in_flight();
-                } else {
-                    EVLOG_debug << "Successfully sent message. UID: " << this->in_flight->uniqueId();
-                    this->in_flight_timeout_timer.timeout([this]() { this->handle_timeout_or_callerror(std::nullopt); },
-                                                          this->current_message_timeout(message->message_attempts));
-                    switch (queue_type) {
-                    case QueueType::Normal:
-                        this->normal_message_queue.erase(selected_normal_message_it);
-                        break;
-                    case QueueType::Transaction:
-                        this->transaction_message_queue.erase(selected_transaction_message_it);
-                        break;
-                    case QueueType::None:
-                        // do nothing
-                        break;
-                    }
-                }
-                if (this->transaction_message_queue.empty() && this->normal_message_queue.empty()) {
-                    this->new_message = false;
-                }
-                lk.unlock();
-                cv.notify_one();
             }
             EVLOG_info << "Message queue stopped processing messages";
         });
     }
 
+    /// \brief Starts processing the queue on the given event loop instead of a worker thread. All messages are sent
+    /// and all timeouts are handled by handlers on \p io_context, which has to be run by a single thread. Handlers on
+    /// this event loop must not block on the response of a message, since the response is handled on the same loop
+    void start(boost::asio::io_context& io_context) {
+        {
+            std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+            this->in_flight_timeout_timer = std::make_unique<Everest::SteadyTimer>(&io_context);
+            this->notify_queue_timer = std::make_unique<Everest::SteadyTimer>(&io_context);
+            this->resume_timer = std::make_unique<Everest::SteadyTimer>(&io_context);
+            this->event_loop = std::make_unique<EventLoopExecutor>(io_context);
+        }
+        // process messages that have been queued before the start
+        this->notify_worker();
+    }
+
+    /// \returns true if called from a handler on the event loop the queue has been started on. Such a handler must not
+    /// wait for the response to a CALL, since the response can only be handled after the handler returned
+    bool is_event_loop_thread() const {
+        return this->event_loop != nullptr and this->event_loop->running_in_this_thread();
+    }
+
     /// \brief Resets next message to send. Can be used in situation when we dont want to reply to a CALL message
     void reset_next_message_to_send() {
-        std::lock_guard<std::recursive_mutex> lk(this->next_message_mutex);
-        this->next_message_to_send.reset();
+        {
+            std::lock_guard<std::recursive_mutex> lk(this->next_message_mutex);
+            this->next_message_to_send.reset();
+        }
+        // a message that has been held back may be sent now
+        if (this->event_loop != nullptr) {
+            this->notify_worker();
+        }
     }
 
     /// \brief Gets all persisted messages of normal message queue and persisted message queue from the database
@@ -606,13 +999,17 @@ public:
                         if (queue_type == QueueType::Normal) {
                             normal_message_queue.push_back(message);
                         } else if (queue_type == QueueType::Transaction) {
+                            // it is unknown whether a restored message has been compacted before
+                            message->compacted = true;
                             transaction_message_queue.push_back(message);
                         }
+                        this->account_queued_message(message);
                     }
                 }
                 this->new_message = true;
             }
         }
+        this->restore_transaction_seq_no_offsets();
 
         if (!this->config.queue_all_messages) {
             // make sure to clear normal message queue table in case queue_all_messages is false, since without clearing
@@ -642,7 +1039,7 @@ public:
                 this->add_to_normal_message_queue(control_message);
             }
         }
-        this->cv.notify_all();
+        this->notify_worker();
     }
 
     /// \brief Sends a new \p call_result message over the websocket
@@ -660,7 +1057,7 @@ public:
             }
         }
 
-        this->cv.notify_all();
+        this->notify_worker();
     }
 
     /// \brief Sends a new \p call_error message over the websocket
@@ -679,7 +1076,7 @@ public:
             }
         }
 
-        this->cv.notify_all();
+        this->notify_worker();
     }
 
     /// \brief pushes a new \p call message onto the message queue
@@ -713,24 +1110,31 @@ public:
 
     /// \brief Enhances a received \p json_message with additional meta information, checks if it is a valid CallResult
     /// with a corresponding Call message on top of the queue
-    /// \returns the enhanced message
+    /// \returns the enhanced message. The message is parsed exactly once and not copied afterwards
     EnhancedMessage<M> receive(std::string_view message) {
-        EnhancedMessage<M> enhanced_message;
+        return this->receive(json::parse(message), message.size());
+    }
 
-        enhanced_message.message = json::parse(message);
-        enhanced_message.uniqueId = this->getMessageId(enhanced_message.message);
-        enhanced_message.messageTypeId = this->getMessageTypeId(enhanced_message.message);
+    /// \brief Same as receive(std::string_view) for a \p message that has already been parsed, e.g. incrementally
+    /// while its fragments were received. \p message_size is the size of the serialized message in bytes
+    EnhancedMessage<M> receive(json&& message, std::size_t message_size) {
+        EnhancedMessage<M> enhanced_message;
 
+        // the meta information is read before the message is taken over, so an invalid message is left untouched
+        enhanced_message.uniqueId = this->getMessageId(message);
+        enhanced_message.messageTypeId = this->getMessageTypeId(message);
         if (enhanced_message.messageTypeId == MessageTypeId::CALL) {
-            enhanced_message.messageType = this->string_to_messagetype(enhanced_message.message.at(CALL_ACTION));
-            enhanced_message.call_message = enhanced_message.message;
+            const auto& action = message.at(CALL_ACTION).template get_ref<const std::string&>();
+            enhanced_message.messageType = this->string_to_messagetype(action);
+        }
+        enhanced_message.message = std::move(message);
+        enhanced_message.message_size = message_size;
 
-            {
-                std::lock_guard<std::recursive_mutex> lk(this->next_message_mutex);
-                // save the uid of the message we just received to ensure the next message we send is a response to
-                // this message
-                next_message_to_send.emplace(enhanced_message.uniqueId);
-            }
+        if (enhanced_message.messageTypeId == MessageTypeId::CALL) {
+            std::lock_guard<std::recursive_mutex> lk(this->next_message_mutex);
+            // save the uid of the message we just received to ensure the next message we send is a response to this
+            // message
+            next_message_to_send.emplace(enhanced_message.uniqueId);
         }
 
         // TODO(kai): what happens if we receive a CallResult or CallError out of order?
@@ -744,19 +1148,20 @@ public:
 
             // TODO(kai): we need to do some error handling in the CallError case
             std::unique_lock<std::recursive_mutex> lk(this->message_mutex);
-            if (this->in_flight == nullptr) {
+            if (this->in_flight_messages.empty()) {
                 EVLOG_error << "Received a CALLRESULT OR CALLERROR without a message in flight, this should not happen";
                 return enhanced_message;
             }
-            if (this->in_flight->uniqueId() != enhanced_message.uniqueId) {
-                EVLOG_error << "Received a CALLRESULT OR CALLERROR with mismatching uid: "
-                            << this->in_flight->uniqueId() << " != " << enhanced_message.uniqueId;
+            const auto in_flight_it = this->in_flight_messages.find(enhanced_message.uniqueId);
+            if (in_flight_it == this->in_flight_messages.end()) {
+                EVLOG_error << "Received a CALLRESULT OR CALLERROR with mismatching uid: " << enhanced_message.uniqueId
+                            << " is not in flight";
                 return enhanced_message;
             }
             if (enhanced_message.messageTypeId == MessageTypeId::CALLERROR) {
                 EVLOG_error << "Received a CALLERROR for message with UID: " << enhanced_message.uniqueId;
                 // make sure the original call message is attached to the callerror
-                enhanced_message.call_message = this->in_flight->message;
+                enhanced_message.call_message = in_flight_it->second.message->message;
                 lk.unlock();
                 this->handle_timeout_or_callerror(enhanced_message);
             } else {
@@ -767,150 +1172,77 @@ public:
         return enhanced_message;
     }
 
+    /// \brief Forgets about all messages in flight, their responses will be ignored
     void reset_in_flight() {
-        this->in_flight = nullptr;
-        this->in_flight_timeout_timer.stop();
+        std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+        this->in_flight_messages.clear();
+        this->in_flight_timeout_timer->stop();
     }
 
     void handle_call_result(EnhancedMessage<M>& enhanced_message) {
-        if (this->in_flight->uniqueId() == enhanced_message.uniqueId) {
-            enhanced_message.call_message = this->in_flight->message;
-            enhanced_message.messageType = this->string_to_messagetype(
-                this->in_flight->message.at(CALL_ACTION).template get<std::string>() + std::string("Response"));
-            this->in_flight->promise.set_value(enhanced_message);
-
-            const auto queue_type =
-                is_transaction_message(*this->in_flight) ? QueueType::Transaction : QueueType::Normal;
-            if (is_transaction_message(*this->in_flight) or this->config.check_queue(this->in_flight->messageType)) {
-                try {
-                    // We only remove the message as soon as a response is received. Otherwise we might miss a message
-                    // if the charging station just boots after sending, but before receiving the result.
-                    this->database_handler->remove_message_queue_message(this->in_flight->initial_unique_id,
-                                                                         queue_type);
-                } catch (const QueryExecutionException& e) {
-                    EVLOG_warning << "Could not delete message from message queue: " << e.what();
-                } catch (const std::exception& e) {
-                    EVLOG_warning << "Could not delete message from message queue: " << e.what();
-                }
-            }
-            this->reset_in_flight();
-
-            // we want the start transaction response handler to be executed before the next message will be
-            // send in order to be able to replace the transaction id if necessary
-            // start transaction response handler will notify
-            if (std::find(this->external_notify.begin(), this->external_notify.end(), enhanced_message.messageType) ==
-                this->external_notify.end()) {
-                this->cv.notify_one();
+        std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+        const auto message = this->take_in_flight_message(enhanced_message.uniqueId);
+        if (message == nullptr) {
+            return;
+        }
+
+        enhanced_message.messageType = this->string_to_messagetype(
+            message->message.at(CALL_ACTION).template get<std::string>() + std::string("Response"));
+        // the call is answered and will not be sent again, so its json can be handed over instead of copied
+        enhanced_message.call_message = std::move(message->message);
+        message->promise.set_value(enhanced_message);
+
+        const auto queue_type = is_transaction_message(*message) ? QueueType::Transaction : QueueType::Normal;
+        if (is_transaction_message(*message) or this->config.check_queue(message->messageType)) {
+            try {
+                // We only remove the message as soon as a response is received. Otherwise we might miss a message
+                // if the charging station just boots after sending, but before receiving the result.
+                this->database_handler->remove_message_queue_message(message->initial_unique_id, queue_type);
+            } catch (const QueryExecutionException& e) {
+                EVLOG_warning << "Could not delete message from message queue: " << e.what();
+            } catch (const std::exception& e) {
+                EVLOG_warning << "Could not delete message from message queue: " << e.what();
             }
         }
+
+        // we want the start transaction response handler to be executed before the next message will be
+        // send in order to be able to replace the transaction id if necessary
+        // start transaction response handler will notify
+        if (std::find(this->external_notify.begin(), this->external_notify.end(), enhanced_message.messageType) ==
+            this->external_notify.end()) {
+            this->notify_worker();
+        }
     }
 
-    /// \brief Handles a message timeout or a CALLERROR. \p enhanced_message_opt is set only in case of CALLERROR
+    /// \brief Handles a CALLERROR of a message in flight. \p enhanced_message_opt is set only in case of CALLERROR,
+    /// otherwise all messages in flight that exceeded their timeout are handled
     void handle_timeout_or_callerror(const std::optional<EnhancedMessage<M>>& enhanced_message_opt) {
         std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
-        // We got a timeout iff enhanced_message_opt is empty. Otherwise, enhanced_message_opt contains the CallError.
-        bool timeout = !enhanced_message_opt.has_value();
-        if (timeout) {
-            EVLOG_warning << "Message timeout for: " << this->in_flight->messageType << " ("
-                          << this->in_flight->uniqueId() << ")";
-        } else {
-            EVLOG_warning << "CALLERROR for: " << this->in_flight->messageType << " (" << this->in_flight->uniqueId()
-                          << ")";
+        if (!enhanced_message_opt.has_value()) {
+            this->handle_in_flight_timeouts();
+            return;
         }
-
-        const auto queue_type = is_transaction_message(*this->in_flight) ? QueueType::Transaction : QueueType::Normal;
-        if (is_transaction_message(*this->in_flight) or this->config.check_queue(this->in_flight->messageType)) {
-            if (this->in_flight->message_attempts < this->config.transaction_message_attempts) {
-                EVLOG_warning << "Message shall be persisted and will therefore be sent again";
-                // Generate a new message ID for the retry
-                const auto old_message_id = this->in_flight->message[MESSAGE_ID];
-                this->in_flight->message[MESSAGE_ID] = ocpp::create_message_id();
-                if (this->config.transaction_message_retry_interval > 0) {
-                    // exponential backoff
-                    this->in_flight->timestamp =
-                        DateTime(this->in_flight->timestamp.to_time_point() +
-                                 std::chrono::seconds(this->config.transaction_message_retry_interval) *
-                                     this->in_flight->message_attempts);
-                    EVLOG_debug << "Retry interval > 0: " << this->config.transaction_message_retry_interval
-                                << " attempting to retry message at: " << this->in_flight->timestamp;
-                } else {
-                    // immediate retry
-                    this->in_flight->timestamp = DateTime();
-                    EVLOG_debug << "Retry interval of 0 means immediate retry";
-                }
-
-                EVLOG_warning << "Attempt: " << this->in_flight->message_attempts + 1 << "/"
-                              << this->config.transaction_message_attempts << " will be sent at "
-                              << this->in_flight->timestamp;
-
-                if (queue_type == QueueType::Transaction) {
-                    this->transaction_message_queue.push_front(this->in_flight);
-                } else if (queue_type == QueueType::Normal) {
-                    this->normal_message_queue.push_front(this->in_flight);
-                }
-                if (is_start_transaction_message(*this->in_flight)) {
-                    this->start_transaction_message_retry_callback(this->in_flight->message[MESSAGE_ID],
-                                                                   old_message_id);
-                }
-                this->notify_queue_timer.at(
-                    [this]() {
-                        this->new_message = true;
-                        this->cv.notify_all();
-                    },
-                    this->in_flight->timestamp.to_time_point());
-            } else {
-                EVLOG_error << "Could not deliver message within the configured amount of attempts, "
-                               "dropping message";
-                if (enhanced_message_opt) {
-                    this->in_flight->promise.set_value(enhanced_message_opt.value());
-                } else {
-                    EnhancedMessage<M> enhanced_message;
-                    enhanced_message.offline = true;
-                    this->in_flight->promise.set_value(enhanced_message);
-                }
-                try {
-                    // also drop the message from the database
-                    this->database_handler->remove_message_queue_message(this->in_flight->initial_unique_id,
-                                                                         queue_type);
-                } catch (const QueryExecutionException& e) {
-                    EVLOG_warning << "Could not delete message from transaction queue: " << e.what();
-                } catch (const std::exception& e) {
-                    EVLOG_warning << "Could not delete message from transaction queue: " << e.what();
-                }
-            }
-        } else if (is_boot_notification_message(this->in_flight->messageType)) {
-            EVLOG_warning << "Message is BootNotification.req and will therefore be sent again";
-            // Generate a new message ID for the retry
-            this->in_flight->message[MESSAGE_ID] = ocpp::create_message_id();
-            // Spec does not define how to handle retries for BootNotification.req: We use the
-            // the boot_notification_retry_interval_seconds
-            this->in_flight->timestamp =
-                DateTime(this->in_flight->timestamp.to_time_point() +
-                         std::chrono::seconds(this->config.boot_notification_retry_interval_seconds));
-            this->normal_message_queue.push_front(this->in_flight);
-            this->notify_queue_timer.at(
-                [this]() {
-                    this->new_message = true;
-                    this->cv.notify_all();
-                },
-                this->in_flight->timestamp.to_time_point());
-        } else {
-            EVLOG_warning << "Message is not transaction related, dropping it";
-            if (enhanced_message_opt) {
-                this->in_flight->promise.set_value(enhanced_message_opt.value());
-            } else {
-                EnhancedMessage<M> enhanced_message;
-                enhanced_message.offline = true;
-                this->in_flight->promise.set_value(enhanced_message);
-            }
+        const auto message = this->take_in_flight_message(enhanced_message_opt->uniqueId);
+        if (message == nullptr) {
+            // the message already timed out in the meantime
+            return;
         }
-        this->reset_in_flight();
-        this->cv.notify_all();
+        this->handle_timeout_or_callerror_internal(message, enhanced_message_opt);
     }
 
     /// \brief Stops the message queue
     void stop() {
         EVLOG_debug << "stop()";
+        if (this->event_loop != nullptr) {
+            {
+                std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+                this->running = false;
+            }
+            // waits for a processing handler that is currently running and drops the pending ones
+            this->event_loop->shutdown();
+            EVLOG_debug << "stop() shut down message queue processing on the event loop";
+            return;
+        }
         // stop the running thread
         this->running = false;
         this->cv.notify_one();
@@ -923,10 +1255,10 @@ public:
         EVLOG_debug << "pause()";
         std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
         this->pause_resume_ctr++;
-        this->resume_timer.stop();
+        this->resume_timer->stop();
         this->paused = true;
         this->resuming = false;
-        this->cv.notify_one();
+        this->notify_worker();
         EVLOG_debug << "pause() notified message queue";
     }
 
@@ -943,19 +1275,35 @@ public:
             this->resuming = true;
             EVLOG_debug << "Delaying message queue resume by " << delay_on_reconnect.count() << " seconds";
             u_int64_t expected_pause_resume_ctr = this->pause_resume_ctr;
-            this->resume_timer.timeout(
+            this->resume_timer->timeout(
                 [this, expected_pause_resume_ctr] { this->resume_now(expected_pause_resume_ctr); }, delay_on_reconnect);
         } else {
             this->resume_now(this->pause_resume_ctr);
         }
     }
 
+    /// \brief Replaces the strategy that selects the transaction update messages which are dropped once the queues
+    /// exceed their thresholds
+    void set_eviction_strategy(std::unique_ptr<MessageQueueEvictionStrategy<ControlMessage<M>>> eviction_strategy) {
+        std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+        this->eviction_strategy = std::move(eviction_strategy);
+    }
+
+    /// \returns the accumulated size of the queued messages in bytes. Only tracked if the queues have a byte threshold
+    std::size_t get_queued_message_bytes() {
+        std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
+        return this->queued_message_bytes;
+    }
+
     void set_registration_status_accepted() {
         {
             std::lock_guard<std::recursive_mutex> lk(this->message_mutex);
             this->is_registration_status_accepted = true;
+            this->normal_message_queue.set_registration_status_accepted();
+            // stalled messages may be sent now and the in flight window may have grown
+            this->new_message = true;
         }
-        this->cv.notify_all();
+        this->notify_worker();
     }
 
     bool is_transaction_message_queue_empty() {
@@ -1025,7 +1373,7 @@ public:
 
     void notify_start_transaction_handled(const std::string& start_transaction_message_id,
                                           const int32_t transaction_id) {
-        this->cv.notify_one();
+        this->notify_worker();
 
         // replace transaction id in meter values if start_transaction_message_id is present in map
         // this is necessary when the chargepoint queued MeterValue.req for a transaction with unknown transaction_id
@@ -1049,5 +1397,10 @@ public:
     std::string messagetype_to_string(M m);
 };
 
+template <> void MessageQueue<v2::MessageType>::compact_transaction_message_queue();
+template <>
+void MessageQueue<v2::MessageType>::renumber_transaction_message(ControlMessage<v2::MessageType>& message);
+template <> void MessageQueue<v2::MessageType>::restore_transaction_seq_no_offsets();
+
 } // namespace ocpp
 #endif // OCPP_COMMON_MESSAGE_QUEUE_HPP
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <ocpp/common/types.hpp>
+
+namespace ocpp {
+
+/// \brief The amount of queued data that has to be dropped to get back below the queue size thresholds
+struct MessageQueueEvictionTarget {
+    std::size_t messages; ///< number of messages that exceed the message count threshold
+    std::size_t bytes;    ///< number of bytes that exceed the byte threshold
+};
+
+/// \brief Decides which messages of the transaction message queue are dropped once the queues exceed their thresholds.
+///
+/// Only transaction update messages (e.g. MeterValues.req or TransactionEvent(Updated)) shall be selected, the messages
+/// that start and end a transaction are always kept.
+///
+/// \tparam T message type that provides a \c timestamp (DateTime), a \c message_size (std::size_t) and an
+/// \c is_transaction_update_message() member
+template <typename T> class MessageQueueEvictionStrategy {
+public:
+    virtual ~MessageQueueEvictionStrategy() = default;
+
+    /// \brief Selects the messages of \p queue that shall be dropped to reach \p target
+    /// \returns the indices of the selected messages in ascending order. The queue calls this again as long as it still
+    /// exceeds its thresholds, an empty result means that there is nothing left to drop
+    virtual std::vector<std::size_t> select_transaction_messages_to_drop(const std::deque<std::shared_ptr<T>>& queue,
+                                                                         const MessageQueueEvictionTarget& target) = 0;
+};
+
+/// \brief Drops every second update message in between two non-update messages, regardless of \p target.
+/// Cf. OCPP 2.0.1. specification 2.1.9 "QueueAllMessages"
+template <typename T> class DropEveryOtherUpdateEvictionStrategy : public MessageQueueEvictionStrategy<T> {
+public:
+    std::vector<std::size_t> select_transaction_messages_to_drop(const std::deque<std::shared_ptr<T>>& queue,
+                                                                 const MessageQueueEvictionTarget& target) override {
+        std::vector<std::size_t> selected;
+        bool remove_next_update_message = true;
+        for (std::size_t i = 0; i < queue.size(); i++) {
+            // drop every second update message (except the last two messages of the queue)
+            if (remove_next_update_message and queue.at(i)->is_transaction_update_message() and
+                i + 2 < queue.size()) {
+                selected.push_back(i);
+                remove_next_update_message = false;
+            } else {
+                remove_next_update_message = true;
+            }
+        }
+        return selected;
+    }
+};
+
+/// \brief Thins out update messages by time: of the update messages in between two non-update messages only those are
+/// kept that are at least a resolution apart from the previously kept message.
+///
+/// Starting with \p initial_resolution, the resolution is doubled until enough messages are selected to reach the
+/// target. Since the first update message after a non-update message is always kept, the remaining updates cover the
+/// whole transaction with a coarser interval instead of leaving gaps.
+template <typename T> class ThinUpdatesByTimeEvictionStrategy : public MessageQueueEvictionStrategy<T> {
+private:
+    std::chrono::seconds initial_resolution;
+
+    std::vector<std::size_t> select(const std::deque<std::shared_ptr<T>>& queue, const std::chrono::seconds resolution,
+                                    MessageQueueEvictionTarget& selected_amount) const {
+        std::vector<std::size_t> selected;
+        selected_amount = {0, 0};
+        std::optional<DateTime> last_kept;
+        for (std::size_t i = 0; i < queue.size(); i++) {
+            const auto& message = queue.at(i);
+            if (!message->is_transaction_update_message()) {
+                last_kept.reset();
+                continue;
+            }
+            if (last_kept.has_value() and
+                message->timestamp.to_time_point() < last_kept->to_time_point() + resolution) {
+                selected.push_back(i);
+                selected_amount.messages++;
+                selected_amount.bytes += message->message_size;
+            } else {
+                last_kept = message->timestamp;
+            }
+        }
+        return selected;
+    }
+
+public:
+    explicit ThinUpdatesByTimeEvictionStrategy(const std::chrono::seconds initial_resolution) :
+        initial_resolution(std::max(initial_resolution, std::chrono::seconds(1))) {
+    }
+
+    std::vector<std::size_t> select_transaction_messages_to_drop(const std::deque<std::shared_ptr<T>>& queue,
+                                                                 const MessageQueueEvictionTarget& target) override {
+        if (queue.empty()) {
+            return {};
+        }
+        const auto [earliest, latest] =
+            std::minmax_element(queue.begin(), queue.end(),
+                                [](const auto& lhs, const auto& rhs) { return lhs->timestamp < rhs->timestamp; });
+        const auto span = (*latest)->timestamp.to_time_point() - (*earliest)->timestamp.to_time_point();
+
+        MessageQueueEvictionTarget selected_amount{0, 0};
+        std::vector<std::size_t> selected;
+        for (auto resolution = this->initial_resolution;; resolution *= 2) {
+            selected = this->select(queue, resolution, selected_amount);
+            if (selected_amount.messages >= target.messages and selected_amount.bytes >= target.bytes) {
+                break;
+            }
+            // once the resolution exceeds the span of the queue only the first update messages are kept anyway
+            if (resolution > span) {
+                break;
+            }
+        }
+        return selected;
+    }
+};
+
+} // namespace ocpp
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ocpp/common/types.hpp>
+
+namespace ocpp {
+
+/// \brief Indexed queue that selects the next sendable message of the normal message queue in O(log n).
+///
+/// Messages keep their queue order (push_front / push_back) like in a deque. Internally every message lives in exactly
+/// one of three partitions:
+///  - stalled: the message may only be sent once the registration status is accepted and it is not accepted yet
+///  - delayed: a min-heap on the message timestamp for messages that are not due yet
+///  - ready: messages that are due and allowed to be sent, ordered by their queue position
+///
+/// Since time and the registration status only move forward, messages only ever move from stalled to delayed to ready.
+/// Entries of erased messages are removed lazily from the heap.
+///
+/// \tparam T message type that provides a \c timestamp (DateTime) and a \c stall_until_accepted (bool) member
+template <typename T> class MessageQueueScheduler {
+private:
+    using Sequence = std::int64_t;
+    using TimePoint = std::chrono::time_point<date::utc_clock>;
+    using HeapEntry = std::pair<TimePoint, Sequence>;
+
+    /// all queued messages in queue order
+    std::map<Sequence, std::shared_ptr<T>> messages;
+    /// reverse index used to erase a message in O(log n)
+    std::unordered_map<const T*, Sequence> sequences;
+
+    std::set<Sequence> ready;
+    std::set<Sequence> stalled;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> delayed;
+
+    Sequence next_front_sequence{-1};
+    Sequence next_back_sequence{0};
+    bool registration_status_accepted{false};
+
+    void insert(const std::shared_ptr<T>& message, const Sequence sequence) {
+        // a message can only be queued once
+        this->erase(message);
+        this->messages.emplace(sequence, message);
+        this->sequences[message.get()] = sequence;
+        if (message->stall_until_accepted and !this->registration_status_accepted) {
+            this->stalled.insert(sequence);
+        } else {
+            this->delayed.emplace(message->timestamp.to_time_point(), sequence);
+        }
+    }
+
+    /// \brief Moves all messages that are due at \p now from the delayed heap into the ready set
+    void promote_due_messages(const TimePoint& now) {
+        while (!this->delayed.empty() and this->delayed.top().first <= now) {
+            const auto sequence = this->delayed.top().second;
+            this->delayed.pop();
+            // entries of erased messages are skipped here
+            if (this->messages.count(sequence) != 0) {
+                this->ready.insert(sequence);
+            }
+        }
+    }
+
+public:
+    /// \brief Adds \p message to the end of the queue
+    void push_back(const std::shared_ptr<T>& message) {
+        this->insert(message, this->next_back_sequence++);
+    }
+
+    /// \brief Adds \p message to the front of the queue
+    void push_front(const std::shared_ptr<T>& message) {
+        this->insert(message, this->next_front_sequence--);
+    }
+
+    /// \brief Returns the first message in queue order that is allowed to be sent at \p now or nullptr if there is none
+    std::shared_ptr<T> next_ready(const DateTime& now) {
+        this->promote_due_messages(now.to_time_point());
+        if (this->ready.empty()) {
+            return nullptr;
+        }
+        return this->messages.at(*this->ready.begin());
+    }
+
+    /// \brief Returns the timestamp of the next delayed message that is not due yet, if any
+    std::optional<DateTime> next_due() {
+        while (!this->delayed.empty() and this->messages.count(this->delayed.top().second) == 0) {
+            this->delayed.pop();
+        }
+        if (this->delayed.empty()) {
+            return std::nullopt;
+        }
+        return DateTime(this->delayed.top().first);
+    }
+
+    /// \brief Releases all messages that were held back until the registration status is accepted
+    void set_registration_status_accepted() {
+        if (this->registration_status_accepted) {
+            return;
+        }
+        this->registration_status_accepted = true;
+        for (const auto sequence : this->stalled) {
+            this->delayed.emplace(this->messages.at(sequence)->timestamp.to_time_point(), sequence);
+        }
+        this->stalled.clear();
+    }
+
+    /// \brief Removes \p message from the queue
+    /// \returns true if the message was part of the queue
+    bool erase(const std::shared_ptr<T>& message) {
+        const auto it = this->sequences.find(message.get());
+        if (it == this->sequences.end()) {
+            return false;
+        }
+        const auto sequence = it->second;
+        this->sequences.erase(it);
+        this->messages.erase(sequence);
+        if (this->ready.erase(sequence) == 0) {
+            this->stalled.erase(sequence);
+        }
+        return true;
+    }
+
+    /// \returns the first message in queue order. Undefined behavior if the queue is empty
+    const std::shared_ptr<T>& front() const {
+        return this->messages.begin()->second;
+    }
+
+    /// \brief Removes the first message in queue order. Undefined behavior if the queue is empty
+    void pop_front() {
+        // copy, since erase() invalidates the reference
+        const auto message = this->front();
+        this->erase(message);
+    }
+
+    /// \brief Calls \p func for every queued message in queue order
+    template <typename Func> void for_each(Func func) const {
+        for (const auto& [sequence, message] : this->messages) {
+            func(message);
+        }
+    }
+
+    std::size_t size() const {
+        return this->messages.size();
+    }
+
+    bool empty() const {
+        return this->messages.empty();
+    }
+};
+
+} // namespace ocpp
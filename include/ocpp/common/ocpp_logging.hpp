@@ -10,6 +10,7 @@
 #include <memory>
 #include <mutex>
 #include <ocpp/common/types.hpp>
+#include <string_view>
 #include <thread>
 
 namespace ocpp {
@@ -81,7 +82,7 @@ private:
     std::string html_encode(const std::string& msg);
 
     /// \brief Format the given \p json_str with the given \p message_type
-    FormattedMessageWithType format_message(const std::string& message_type, const std::string& json_str);
+    FormattedMessageWithType format_message(const std::string& message_type, std::string_view json_str);
 
     /// \brief Add opening html tags to the given stream \p os
     void open_html_tags(std::ofstream& os);
@@ -126,11 +127,15 @@ public:
     ~MessageLogging();
 
     /// \brief Log a message originating from the charge point
-    void charge_point(const std::string& message_type, const std::string& json_str);
+    void charge_point(const std::string& message_type, std::string_view json_str);
 
     /// \brief Log a message originating from the central system
     void central_system(const std::string& message_type, const std::string& json_str);
 
+    /// \brief Log a message originating from the central system that has already been parsed. The \p message is only
+    /// serialized if it is actually logged
+    void central_system(const std::string& message_type, const json& message);
+
     /// \brief Log a system message
     void sys(const std::string& msg);
 
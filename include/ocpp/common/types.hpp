@@ -832,6 +832,23 @@ enum class QueueType {
     None,
 };
 
+/// \brief Encoding of the messages that are persisted from the message queues
+enum class MessageQueuePersistenceFormat {
+    Json,
+    Cbor,
+    MessagePack,
+};
+
+namespace conversions {
+/// \brief Converts the given MessageQueuePersistenceFormat \p e to std::string
+/// \returns a string representation of the MessageQueuePersistenceFormat
+std::string message_queue_persistence_format_to_string(MessageQueuePersistenceFormat e);
+
+/// \brief Converts the given std::string \p s to MessageQueuePersistenceFormat
+/// \returns a MessageQueuePersistenceFormat from a string representation
+MessageQueuePersistenceFormat string_to_message_queue_persistence_format(const std::string& s);
+} // namespace conversions
+
 /// \brief Struct containing default limits for amps, watts and number of phases
 struct CompositeScheduleDefaultLimits {
     int32_t amps;
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <chrono>
+#include <random>
+#include <string>
+
+namespace ocpp {
+
+/// \brief Parameters of the delay between websocket connection attempts
+struct ReconnectBackoffOptions {
+    std::chrono::milliseconds wait_minimum{0}; ///< Minimum delay before the first reconnect
+    std::chrono::milliseconds random_range{0}; ///< Upper bound of the random part added to every delay
+    int repeat_times = 0;                      ///< Number of times the delay grows before it stays constant
+    bool decorrelated_jitter = false; ///< If true every delay is drawn between the minimum and three times the previous
+                                      ///< delay, instead of doubling the previous delay. The delays then grow up to
+                                      ///< the maximum instead of repeat_times times
+    std::chrono::milliseconds maximum{0}; ///< Upper bound of every delay, 0 disables the cap
+    std::chrono::milliseconds spread{0};  ///< Window across which the first reconnect of different stations is spread,
+                                          ///< 0 disables spreading
+};
+
+///
+/// \brief Calculates the delays between connection attempts. By default the first delay is the minimum wait plus a
+/// random part, every following delay is twice the previous one plus a random part, until the delay has grown
+/// repeat_times times.
+///
+/// Stations that have lost the connection at the same time, e.g. because the CSMS went down, would reconnect at almost
+/// the same time. Decorrelated jitter and the spread distribute their connection attempts over time. The random numbers
+/// are drawn from a generator seeded with the \p seed, which should identify the station (e.g. its charge point id), so
+/// that every station has its own, reproducible offset within the spread window.
+///
+class ReconnectBackoff {
+private:
+    ReconnectBackoffOptions options;
+    std::mt19937 generator;
+    std::chrono::milliseconds spread_offset;
+    std::chrono::milliseconds previous_delay;
+    int attempts;
+
+    std::chrono::milliseconds random_between(std::chrono::milliseconds min, std::chrono::milliseconds max);
+
+public:
+    explicit ReconnectBackoff(const ReconnectBackoffOptions& options = {}, const std::string& seed = "");
+
+    /// \returns the delay before the next connection attempt
+    std::chrono::milliseconds next_delay();
+
+    /// \brief Starts over with the first delay, e.g. after a successful connection
+    void reset();
+
+    /// \returns the offset of this station within the spread window
+    std::chrono::milliseconds get_spread_offset() const;
+};
+
+} // namespace ocpp
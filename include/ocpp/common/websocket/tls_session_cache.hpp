@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ssl_st;
+struct ssl_ctx_st;
+struct ssl_session_st;
+
+namespace ocpp {
+
+/// \brief Client side cache of TLS sessions (session tickets and session ids) that lets the websocket resume the TLS
+/// session of an earlier connection instead of doing a full handshake. The cache is independent of the SSL_CTX, so the
+/// sessions survive the SSL_CTX being recreated on every reconnect. Sessions can be serialized to persist them across
+/// restarts.
+///
+/// A session is only resumed by an SSL_CTX that has been attached with the same \p context, which has to identify the
+/// client certificate and the trust anchors the session has been authenticated with, and to the same server.
+class TlsSessionCache : public std::enable_shared_from_this<TlsSessionCache> {
+public:
+    /// \brief Called with the key and the serialized session whenever a new session has been received from the server
+    using SessionStoredCallback = std::function<void(const std::string& key, const std::vector<std::uint8_t>& session)>;
+
+    TlsSessionCache();
+    ~TlsSessionCache();
+
+    TlsSessionCache(const TlsSessionCache&) = delete;
+    TlsSessionCache& operator=(const TlsSessionCache&) = delete;
+
+    /// \brief Stores the sessions of all client connections made with \p ssl_ctx in this cache and resumes them on the
+    /// next connection to the same server. The SSL_CTX keeps the cache alive until it is freed
+    void attach(ssl_ctx_st* ssl_ctx, const std::string& context);
+
+    /// \brief Adds the serialized \p session that has been stored under \p key, e.g. by a SessionStoredCallback
+    /// before a restart
+    /// \returns false if the session can not be decoded or is not resumable anymore
+    bool restore(const std::string& key, const std::vector<std::uint8_t>& session);
+
+    /// \brief register a \p callback that is called whenever a new session has been stored, called from the thread
+    /// running the TLS handshake
+    void register_session_stored_callback(const SessionStoredCallback& callback);
+
+    /// \brief Removes all sessions, the next connection does a full handshake
+    void clear();
+
+    /// \returns the number of cached sessions
+    std::size_t size();
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<ssl_session_st>> sessions;
+    SessionStoredCallback session_stored_callback;
+
+    void store(const std::string& key, ssl_session_st* session);
+    std::shared_ptr<ssl_session_st> find(const std::string& key);
+
+    static int new_session_callback(ssl_st* ssl, ssl_session_st* session);
+    static void info_callback(const ssl_st* ssl, int where, int ret);
+};
+
+} // namespace ocpp
@@ -57,6 +57,10 @@ public:
     /// \brief register a \p callback that is called when the websocket receives a message
     void register_message_callback(const std::function<void(const std::string& message)>& callback);
 
+    /// \brief register a \p callback that is called with the parsed message if incremental message parsing is enabled
+    void register_parsed_message_callback(
+        const std::function<void(json&& message, std::size_t message_size)>& callback);
+
     /// \brief register a \p callback that is called when the websocket could not connect with a specific reason
     void register_connection_failed_callback(const std::function<void(ConnectionFailedReason)>& callback);
 
@@ -64,11 +68,18 @@ public:
     /// \returns true if the message was sent successfully
     bool send(const std::string& message);
 
+    /// \brief serializes \p message directly into a send buffer of the websocket and sends it without copying
+    /// \returns true if the message was sent successfully
+    bool send(const json& message);
+
     /// \brief set the websocket ping interval \p interval_s in seconds
     void set_websocket_ping_interval(int32_t interval_s);
 
     /// \brief set the \p authorization_key of the connection_options
     void set_authorization_key(const std::string& authorization_key);
+
+    /// \brief dispatch the callbacks of the websocket on the event loop \p io_context instead of dedicated threads
+    void set_event_loop(boost::asio::io_context& io_context);
 };
 
 } // namespace ocpp
@@ -6,15 +6,31 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
 
 #include <everest/timer.hpp>
 
+#include <ocpp/common/event_loop.hpp>
 #include <ocpp/common/types.hpp>
+#include <ocpp/common/websocket/reconnect_backoff.hpp>
+#include <ocpp/common/websocket/tls_session_cache.hpp>
 #include <ocpp/common/websocket/websocket_uri.hpp>
 
 namespace ocpp {
 
+/// \brief Parameters of the permessage-deflate websocket extension (RFC 7692) that are offered to the CSMS
+struct PerMessageDeflateOptions {
+    bool client_no_context_takeover = false; ///< Reset the compression context after every message we send
+    bool server_no_context_takeover = false; ///< Ask the CSMS to reset its context after every message it sends
+    int client_max_window_bits = 15;         ///< LZ77 window size (8 - 15) used to compress messages we send
+    int server_max_window_bits = 15;         ///< LZ77 window size (8 - 15) the CSMS may use for messages it sends
+};
+
+/// \brief Builds the Sec-WebSocket-Extensions offer for the given permessage-deflate \p options
+std::string get_permessage_deflate_offer(const PerMessageDeflateOptions& options);
+
 struct WebsocketConnectionOptions {
     std::vector<OcppProtocolVersion> ocpp_versions; // List of allowed protocols ordered by preference
     Uri csms_uri;                                   // the URI of the CSMS
@@ -38,6 +54,70 @@ struct WebsocketConnectionOptions {
     std::optional<std::string> iface; // Optional interface where the socket is created. Only usable for libwebsocket
     bool enable_tls_keylog = false;   ///< If set to true enables logging of TLS secrets to the keylog_file
     std::optional<std::filesystem::path> keylog_file; ///< Optional path to a keylog file
+    std::size_t message_fragment_size = 0; ///< Messages larger than this are sent in fragments of this size, 0 disables
+                                           ///< fragmentation
+    std::optional<PerMessageDeflateOptions> permessage_deflate; ///< If set the permessage-deflate extension is offered
+    bool incremental_message_parsing = false; ///< If set to true received messages are parsed fragment by fragment
+                                              ///< as they arrive instead of after the complete message was received
+    bool shared_context = false; ///< If set to true the connection shares one libwebsockets context and service
+                                 ///< thread with all other connections of the process that set this option
+    std::shared_ptr<TlsSessionCache> tls_session_cache; ///< If set TLS sessions are stored in this cache and resumed
+                                                        ///< on reconnect instead of doing a full handshake
+    bool retry_backoff_decorrelated_jitter = false; ///< If true reconnect delays are drawn with decorrelated jitter
+    int retry_backoff_maximum_s = 0; ///< Upper bound of the reconnect delay, 0 disables the cap
+    int retry_backoff_spread_s = 0;  ///< Window across which the first reconnect of different stations is spread,
+                                     ///< seeded with the charge point id. 0 disables spreading
+};
+
+/// \brief Part of an outgoing message that is written to the websocket as a single frame
+struct WebsocketFragment {
+    char* data;       ///< Start of the fragment inside the send buffer
+    std::size_t size; ///< Size of the fragment in bytes
+    bool first;       ///< True if this is the first frame of the message
+    bool last;        ///< True if this is the final frame of the message
+};
+
+///
+/// \brief Buffer of an outgoing websocket message. A number of bytes in front of the payload is reserved for the
+/// websocket implementation (e.g. the LWS_PRE bytes libwebsockets needs to prepend the frame header), so the payload
+/// can be serialized directly into the buffer that is written to the socket
+///
+class WebsocketSendBuffer {
+private:
+    std::string storage;
+    std::size_t headroom_size;
+
+public:
+    /// \brief Creates an empty buffer with \p headroom bytes in front of the payload and reserves space for a payload
+    /// of \p payload_size_hint bytes
+    explicit WebsocketSendBuffer(std::size_t headroom = 0, std::size_t payload_size_hint = 0);
+
+    /// \brief Replaces the payload with the serialized \p message
+    void assign(const json& message);
+
+    /// \brief Replaces the payload with a copy of \p message
+    void assign(const std::string& message);
+
+    /// \returns the payload without the headroom
+    std::string_view payload() const;
+
+    /// \returns a pointer to the payload, the headroom bytes in front of it may be written to as well
+    char* payload_data();
+
+    /// \returns the size of the payload in bytes
+    std::size_t size() const;
+
+    /// \returns the number of bytes reserved in front of the payload
+    std::size_t headroom() const;
+
+    /// \returns the fragment of the payload that starts at \p offset and is at most \p max_fragment_size bytes long. A
+    /// \p max_fragment_size of 0 returns the remaining payload as a single fragment.
+    ///
+    /// Since the headroom is only in front of the first fragment, a websocket implementation that writes a frame header
+    /// in front of a later fragment overwrites the end of the previous one. This is fine as long as the previous
+    /// fragment has been handed over to the websocket implementation already, the payload does not have to be copied
+    /// for each fragment.
+    WebsocketFragment fragment(std::size_t offset, std::size_t max_fragment_size);
 };
 
 ///
@@ -51,15 +131,19 @@ protected:
     std::function<void()> disconnected_callback;
     std::function<void(const WebsocketCloseReason reason)> stopped_connecting_callback;
     std::function<void(const std::string& message)> message_callback;
+    std::function<void(json&& message, std::size_t message_size)> parsed_message_callback;
     std::function<void(ConnectionFailedReason)> connection_failed_callback;
     std::shared_ptr<boost::asio::steady_timer> reconnect_timer;
     std::unique_ptr<Everest::SteadyTimer> ping_timer;
+    std::unique_ptr<EventLoopExecutor> event_loop; ///< Set if callbacks are dispatched on an event loop
     std::mutex reconnect_mutex;
     std::mutex connection_mutex;
-    std::atomic_int reconnect_backoff_ms;
+    ReconnectBackoff reconnect_backoff;
+    std::mutex reconnect_backoff_mutex;
     std::atomic_int connection_attempts;
     std::atomic_bool shutting_down;
     std::atomic_bool reconnecting;
+    std::atomic_size_t send_buffer_size_hint;
 
     /// \brief Indicates if the required callbacks are registered
     /// \returns true if the websocket is properly initialized
@@ -71,8 +155,8 @@ protected:
     /// \brief Logs websocket connection error
     void log_on_fail(const std::error_code& ec, const boost::system::error_code& transport_ec, const int http_status);
 
-    /// \brief Calculates and returns the reconnect interval based on int retry_backoff_random_range_s,
-    /// retry_backoff_repeat_times, int retry_backoff_wait_minimum_s of the WebsocketConnectionOptions
+    /// \brief Calculates and returns the reconnect interval in ms based on the retry_backoff options of the
+    /// WebsocketConnectionOptions. The backoff starts over if connection_attempts is 1
     long get_reconnect_interval();
 
     // \brief cancels the reconnect timer
@@ -124,6 +208,12 @@ public:
     /// \brief register a \p callback that is called when the websocket receives a message
     void register_message_callback(const std::function<void(const std::string& message)>& callback);
 
+    /// \brief register a \p callback that is called instead of the message callback with the parsed message if
+    /// incremental_message_parsing is enabled. Messages that are not valid JSON are still passed to the message
+    /// callback
+    void register_parsed_message_callback(
+        const std::function<void(json&& message, std::size_t message_size)>& callback);
+
     /// \brief register a \p callback that is called when the websocket could not connect with a specific reason
     void register_connection_failed_callback(const std::function<void(ConnectionFailedReason)>& callback);
 
@@ -131,11 +221,23 @@ public:
     /// \returns true if the message was sent successfully
     virtual bool send(const std::string& message) = 0;
 
+    /// \brief creates a buffer for an outgoing message with the headroom this websocket implementation requires. Space
+    /// is reserved for a payload as large as the last message that was sent
+    virtual WebsocketSendBuffer create_send_buffer();
+
+    /// \brief send the payload of \p buffer over the websocket without copying it
+    /// \returns true if the message was sent successfully
+    virtual bool send(WebsocketSendBuffer&& buffer) = 0;
+
     /// \brief starts a timer that sends a websocket ping at the given \p interval_s
     void set_websocket_ping_interval(int32_t interval_s);
 
     /// \brief set the \p authorization_key of the connection_options
     void set_authorization_key(const std::string& authorization_key);
+
+    /// \brief dispatches received messages, deferred callbacks and the ping timer on the event loop \p io_context
+    /// instead of dedicated threads. Has to be called before start_connecting()
+    void set_event_loop(boost::asio::io_context& io_context);
 };
 
 } // namespace ocpp
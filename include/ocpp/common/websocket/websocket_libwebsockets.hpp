@@ -4,19 +4,37 @@
 #define OCPP_WEBSOCKET_TLS_TPM_HPP
 
 #include <ocpp/common/evse_security.hpp>
+#include <ocpp/common/incremental_json_parser.hpp>
+#include <ocpp/common/lock_free_queue.hpp>
 #include <ocpp/common/safe_queue.hpp>
 #include <ocpp/common/websocket/websocket_base.hpp>
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
 struct ssl_ctx_st;
+struct lws;
+struct lws_context;
+struct lws_vhost;
+struct lws_sorted_usec_list;
 
 namespace ocpp {
 
 struct ConnectionData;
 struct WebsocketMessage;
+class SharedLwsContext;
+struct SharedVhostSettings;
+
+/// \brief A message received over the websocket, either as text or already parsed while its fragments were received
+struct ReceivedMessage {
+    std::string message;                ///< The message text, empty if the message has been parsed
+    std::optional<json> parsed_message; ///< The parsed message if incremental message parsing is enabled
+    std::size_t message_size = 0;       ///< Size of the received message in bytes
+};
 
 /// \brief Experimental libwebsockets TLS connection
 class WebsocketLibwebsockets final : public WebsocketBase {
@@ -37,6 +55,10 @@ public:
 
     bool send(const std::string& message) override;
 
+    WebsocketSendBuffer create_send_buffer() override;
+
+    bool send(WebsocketSendBuffer&& buffer) override;
+
     void ping() override;
 
     /// \brief Indicates if the websocket has a valid connection data and is trying to
@@ -59,9 +81,53 @@ private:
     bool tls_init(struct ssl_ctx_st* ctx, const std::string& path_chain, const std::string& path_key, bool custom_key,
                   std::optional<std::string>& password);
 
+    /// \brief Gets the client side certificate \p path_chain, its \p path_key and \p password for security profile 3
+    /// \return True if a valid certificate is installed, false otherwise
+    bool get_client_certificate(std::string& path_chain, std::string& path_key, std::optional<std::string>& password);
+
+    /// \brief Creates the TLS context for security profile 2 and 3
+    /// \return The new context or nullptr if it could not be created
+    struct ssl_ctx_st* create_ssl_context(const std::string& path_chain, const std::string& path_key,
+                                          std::optional<std::string>& password);
+
+    /// \brief Starts a connection attempt on \p context, using the TLS context of \p vhost if set
+    /// \return The new wsi or nullptr if the attempt could not be started
+    lws* connect_client(ConnectionData* conn_data, lws_context* context, lws_vhost* vhost);
+
+    /// \brief Decides if the connection is attempted again after an attempt has ended
+    /// \return The delay in ms before the next attempt or std::nullopt if no further attempt is made
+    std::optional<long> get_internal_reconnect_delay(ConnectionData* conn_data);
+
     /// \brief Websocket processing thread loop
     void thread_websocket_client_loop(std::shared_ptr<ConnectionData> local_data);
 
+    /// \brief Prepares the vhost settings of the next connection attempt on the shared context with the deferred
+    /// callbacks and starts the attempt on the service thread afterwards. Nothing that can block is done on the
+    /// service thread, since it serves all connections
+    void schedule_shared_attempt(std::shared_ptr<ConnectionData> local_data);
+
+    /// \brief Starts a connection attempt on the shared context with the vhost for \p settings. Called on its service
+    /// thread, the attempt fails if \p settings is nullptr
+    void shared_connect(std::shared_ptr<ConnectionData> local_data, std::shared_ptr<SharedVhostSettings> settings);
+
+    /// \brief Fills \p settings with the security settings of this connection, including the SSL_CTX
+    /// \return False if the security settings could not be initialized
+    bool prepare_shared_vhost(SharedVhostSettings& settings);
+
+    /// \brief Handles the end of the current connection attempt on the shared context once, after the running
+    /// libwebsockets callback has returned
+    void end_shared_attempt(ConnectionData* conn_data);
+
+    /// \brief Reconnects or stops after a connection attempt on the shared context has ended
+    void on_shared_attempt_ended(std::shared_ptr<ConnectionData> local_data);
+
+    /// \brief Closes the wsi of the connection on the shared context right away and releases its vhost. Called on the
+    /// service thread, no callback for the connection is made afterwards unless it is attempted again
+    void release_shared_connection(ConnectionData* conn_data);
+
+    /// \brief Called on the service thread of the shared context when the reconnect delay of a connection has passed
+    static void on_reconnect_timer(struct lws_sorted_usec_list* sul);
+
     /// \brief Function to handle received messages. Required since from the received message
     ///        callback we also send messages that must block and wait on the client thread
     void thread_websocket_message_recv_loop(std::shared_ptr<ConnectionData> local_data);
@@ -78,18 +144,44 @@ private:
     /// \brief Called when a TLS websocket connection fails to be established
     void on_conn_fail(ConnectionData* conn_data);
 
+    /// \brief Called when no further connection attempt is made, gives back control to the application
+    void on_conn_stopped(ConnectionData* conn_data);
+
     /// \brief When the connection can send data
-    void on_conn_writable();
+    /// \return false if a message could not be written and the connection has to be closed
+    bool on_conn_writable();
 
-    /// \brief Called when a message is received over the TLS websocket, calls the message callback
-    void on_conn_message(std::string&& message);
+    /// \brief Called when a fragment of a message is received over the TLS websocket. \p final_fragment is true for the
+    /// last fragment of the message
+    void on_conn_receive(std::string_view fragment, bool final_fragment);
+
+    /// \brief Called when a message is received over the TLS websocket, queues it for the message callback
+    void on_conn_message(ReceivedMessage&& message);
+
+    /// \brief Takes the next received message from the received message queue or, once that is empty, from the overflow
+    /// queue. Resumes receiving if it was paused and the overflow queue has been drained
+    std::optional<ReceivedMessage> pop_received_message();
+
+    /// \brief Re-enables receiving on the websocket client thread after it was paused because of a full received
+    /// message queue
+    void resume_receive();
+
+    /// \brief Calls the parsed message callback or the message callback with the received \p message
+    void dispatch_message(ReceivedMessage&& message);
 
     /// \brief Requests a message write, awakes the websocket loop from 'poll'
     void request_write();
 
-    void poll_message(const std::shared_ptr<WebsocketMessage>& msg);
+    /// \brief True if a message is queued or the message in progress has not been confirmed as sent yet. Only called
+    /// on the websocket client thread
+    bool is_write_pending() const;
+
+    /// \brief Queues \p msg for the websocket client thread and waits until it was written
+    /// \return True if the message was sent, false if it could not be queued or written
+    bool poll_message(const std::shared_ptr<WebsocketMessage>& msg);
 
-    /// \brief Add a callback to the queue of callbacks to be executed. All will be executed from a single thread
+    /// \brief Add a callback to the queue of callbacks to be executed. All will be executed from a single thread, the
+    /// event loop if one is set
     void push_deferred_callback(const std::function<void()>& callback);
 
     // \brief Safely closes the already running connection threads
@@ -105,15 +197,32 @@ private:
     Everest::SteadyTimer reconnect_timer_tpm;
     std::unique_ptr<std::thread> websocket_thread;
     std::shared_ptr<ConnectionData> conn_data;
+    // Context shared with other connections if the shared_context option is set, kept until destruction
+    std::shared_ptr<SharedLwsContext> shared_context;
 
     // Queue of outgoing messages, notify thread only when we remove messages
-    SafeQueue<std::shared_ptr<WebsocketMessage>> message_queue;
+    LockFreeQueue<std::shared_ptr<WebsocketMessage>> message_queue;
+    // Message taken from message_queue that is being written, only accessed on the websocket client thread
+    std::shared_ptr<WebsocketMessage> message_in_progress;
 
     std::unique_ptr<std::thread> recv_message_thread;
-    SafeQueue<std::string> recv_message_queue;
+    LockFreeQueue<ReceivedMessage> recv_message_queue;
+    // Received messages that did not fit into recv_message_queue. Receiving is paused with 'lws_rx_flow_control' while
+    // it is not empty, so it only holds what libwebsockets had already read
+    std::deque<ReceivedMessage> recv_overflow_queue;
+    std::mutex recv_overflow_mutex;
+    bool recv_paused{false};
+    // Set if receiving should be resumed on the websocket client thread of a connection that has its own context
+    std::atomic_bool recv_resume_requested{false};
     std::string recv_buffered_message;
+    // Parser of the message that is received if incremental message parsing is enabled, only accessed on the websocket
+    // client thread
+    IncrementalJsonParser recv_message_parser;
+    std::size_t recv_message_size;
+    std::optional<std::string> recv_parse_error;
 
     std::unique_ptr<std::thread> deferred_callback_thread;
+    // Unbounded, since the websocket client thread must not wait for the callbacks to be executed
     SafeQueue<std::function<void()>> deferred_callback_queue;
     std::atomic_bool stop_deferred_handler;
 
@@ -148,6 +148,30 @@ public:
 
     int32_t getWebsocketPongTimeout();
     KeyValue getWebsocketPongTimeoutKeyValue();
+    std::optional<int> getWebsocketMessageFragmentSize();
+    std::optional<KeyValue> getWebsocketMessageFragmentSizeKeyValue();
+    std::optional<bool> getWebsocketPermessageDeflate();
+    std::optional<KeyValue> getWebsocketPermessageDeflateKeyValue();
+    std::optional<bool> getWebsocketPermessageDeflateNoContextTakeover();
+    std::optional<KeyValue> getWebsocketPermessageDeflateNoContextTakeoverKeyValue();
+    std::optional<int> getWebsocketPermessageDeflateMaxWindowBits();
+    std::optional<KeyValue> getWebsocketPermessageDeflateMaxWindowBitsKeyValue();
+    std::optional<bool> getWebsocketIncrementalMessageParsing();
+    std::optional<KeyValue> getWebsocketIncrementalMessageParsingKeyValue();
+    std::optional<bool> getWebsocketSharedContext();
+    std::optional<KeyValue> getWebsocketSharedContextKeyValue();
+    std::optional<bool> getWebsocketTlsSessionResumption();
+    std::optional<KeyValue> getWebsocketTlsSessionResumptionKeyValue();
+    std::optional<bool> getWebsocketPersistTlsSessions();
+    std::optional<KeyValue> getWebsocketPersistTlsSessionsKeyValue();
+    std::optional<bool> getRetryBackoffDecorrelatedJitter();
+    std::optional<KeyValue> getRetryBackoffDecorrelatedJitterKeyValue();
+    std::optional<int> getRetryBackoffMaximum();
+    std::optional<KeyValue> getRetryBackoffMaximumKeyValue();
+    std::optional<int> getRetryBackoffSpread();
+    std::optional<KeyValue> getRetryBackoffSpreadKeyValue();
+    std::optional<bool> getSingleThreadedEventLoop();
+    std::optional<KeyValue> getSingleThreadedEventLoopKeyValue();
 
     std::optional<std::string> getHostName();
     std::optional<KeyValue> getHostNameKeyValue();
@@ -164,6 +188,30 @@ public:
     std::optional<int> getMessageQueueSizeThreshold();
     std::optional<KeyValue> getMessageQueueSizeThresholdKeyValue();
 
+    std::optional<int> getMessageQueueMaxMessagesInFlight();
+    std::optional<KeyValue> getMessageQueueMaxMessagesInFlightKeyValue();
+
+    std::optional<int> getMessageQueueSizeThresholdBytes();
+    std::optional<KeyValue> getMessageQueueSizeThresholdBytesKeyValue();
+
+    std::optional<int> getMessageQueueUpdateThinningResolution();
+    std::optional<KeyValue> getMessageQueueUpdateThinningResolutionKeyValue();
+
+    std::optional<int> getMessageQueuePersistenceFlushInterval();
+    std::optional<KeyValue> getMessageQueuePersistenceFlushIntervalKeyValue();
+
+    std::optional<int> getMessageQueuePersistenceMaxPendingOperations();
+    std::optional<KeyValue> getMessageQueuePersistenceMaxPendingOperationsKeyValue();
+
+    std::optional<std::string> getMessageQueuePersistenceFormat();
+    std::optional<KeyValue> getMessageQueuePersistenceFormatKeyValue();
+
+    std::optional<std::string> getDatabaseTuningProfile();
+    std::optional<KeyValue> getDatabaseTuningProfileKeyValue();
+
+    std::optional<int> getDatabaseReadConnections();
+    std::optional<KeyValue> getDatabaseReadConnectionsKeyValue();
+
     // Core Profile - optional
     std::optional<bool> getAllowOfflineTxForUnknownId();
     void setAllowOfflineTxForUnknownId(bool enabled);
@@ -110,6 +110,7 @@ private:
     std::unique_ptr<ChargePointStates> status;
     std::shared_ptr<ChargePointConfiguration> configuration;
     std::shared_ptr<ocpp::v16::DatabaseHandler> database_handler;
+    std::shared_ptr<TlsSessionCache> tls_session_cache;
     std::unique_ptr<Everest::SteadyTimer> boot_notification_timer;
     std::unique_ptr<Everest::SteadyTimer> heartbeat_timer;
     std::unique_ptr<ClockAlignedTimer> clock_aligned_meter_values_timer;
@@ -206,8 +207,19 @@ private:
     void init_websocket();
     void init_state_machine(const std::map<int, ChargePointStatus>& connector_status_map);
     WebsocketConnectionOptions get_ws_connection_options();
+    /// \brief Creates the cache of TLS sessions that are resumed on reconnect. If WebsocketPersistTlsSessions is set
+    /// the sessions stored in the database are restored and new sessions are stored in it
+    std::shared_ptr<TlsSessionCache> create_tls_session_cache();
     std::unique_ptr<ocpp::MessageQueue<v16::MessageType>> create_message_queue();
     void message_callback(const std::string& message);
+    void parsed_message_callback(json&& message, std::size_t message_size);
+    /// \brief Calls \p receive to pass a received message to the message queue and responds with a CALLERROR if it is
+    /// invalid
+    std::optional<EnhancedMessage<v16::MessageType>>
+    receive_message(const std::function<EnhancedMessage<v16::MessageType>()>& receive);
+    /// \brief Handles a received message, \p raw_message provides the message text for error reports
+    void process_received_message(const EnhancedMessage<v16::MessageType>& enhanced_message,
+                                  const std::function<std::string()>& raw_message);
     void handle_message(const EnhancedMessage<v16::MessageType>& message);
     void heartbeat(bool initiated_by_trigger_message = false);
     void boot_notification(bool initiated_by_trigger_message = false);
@@ -52,6 +52,9 @@ public:
     DatabaseHandler(std::unique_ptr<common::DatabaseConnectionInterface> database,
                     const fs::path& sql_migration_files_path, int32_t number_of_connectors);
 
+    /// \brief Writes all buffered message queue operations before the handler is destroyed
+    ~DatabaseHandler() override;
+
     // transactions
     /// \brief Inserts a transaction with the given parameter to the TRANSACTIONS table.
     void insert_transaction(const std::string& session_id, const int32_t transaction_id, const int32_t connector,
@@ -17,6 +17,7 @@ public:
         message_queue(message_queue), configuration(configuration), registration_status(registration_status){};
     void dispatch_call(const json& call, bool triggered = false) override;
     std::future<ocpp::EnhancedMessage<MessageType>> dispatch_call_async(const json& call, bool triggered) override;
+    bool can_wait_for_response() const override;
     void dispatch_call_result(const json& call_result) override;
     void dispatch_call_error(const json& call_error) override;
 
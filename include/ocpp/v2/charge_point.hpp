@@ -416,6 +416,16 @@ private:
                                       const ConnectorStatusEnum status);
 
     void message_callback(const std::string& message);
+    void parsed_message_callback(json&& message, std::size_t message_size);
+
+    /// \brief Calls \p receive to pass a received message to the message queue and reports it as invalid if that
+    /// fails. \p raw_message provides the message text for the report
+    std::optional<EnhancedMessage<v2::MessageType>>
+    receive_message(const std::function<EnhancedMessage<v2::MessageType>()>& receive,
+                    const std::function<std::string()>& raw_message);
+
+    /// \brief Handles a message that has been received by the message queue
+    void process_received_message(const EnhancedMessage<v2::MessageType>& enhanced_message);
 
     /// \brief Get the value optional offline flag
     /// \return true if the charge point is offline. std::nullopt if it is online;
@@ -425,6 +435,10 @@ private:
     /// @param message_log_path path to file logging
     void configure_message_logging_format(const std::string& message_log_path);
 
+    /// \brief Creates the cache of TLS sessions that are resumed on reconnect. If WebsocketPersistTlsSessions is set
+    /// the sessions stored in the database are restored and new sessions are stored in it
+    std::shared_ptr<TlsSessionCache> create_tls_session_cache();
+
     /* OCPP message requests */
 
     /* OCPP message handlers */
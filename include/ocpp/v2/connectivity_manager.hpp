@@ -100,6 +100,11 @@ public:
     ///
     virtual bool send_to_websocket(const std::string& message) = 0;
 
+    /// \brief serialize \p message directly into the send buffer of the websocket and send it
+    /// \returns true if the message was sent successfully
+    ///
+    virtual bool send_to_websocket(const json& message) = 0;
+
     ///
     /// \brief Can be called when a network is disconnected, for example when an ethernet cable is removed.
     ///
@@ -130,6 +135,12 @@ private:
     std::unique_ptr<Websocket> websocket;
     /// \brief The message callback
     std::function<void(const std::string& message)> message_callback;
+    /// \brief The callback for messages that have been parsed incrementally while they were received
+    std::function<void(json&& message, std::size_t message_size)> parsed_message_callback;
+    /// \brief Event loop the websocket callbacks are dispatched on, nullptr if the websocket uses its own threads
+    boost::asio::io_context* event_loop;
+    /// \brief Cache of the TLS sessions that are resumed on reconnect, nullptr if sessions are not resumed
+    std::shared_ptr<TlsSessionCache> tls_session_cache;
     /// \brief Callback that is called when the websocket is connected successfully
     std::optional<WebsocketConnectionCallback> websocket_connected_callback;
     /// \brief Callback that is called when the websocket connection is disconnected
@@ -153,7 +164,10 @@ private:
 public:
     ConnectivityManager(DeviceModel& device_model, std::shared_ptr<EvseSecurity> evse_security,
                         std::shared_ptr<MessageLogging> logging,
-                        const std::function<void(const std::string& message)>& message_callback);
+                        const std::function<void(const std::string& message)>& message_callback,
+                        const std::function<void(json&& message, std::size_t message_size)>& parsed_message_callback,
+                        boost::asio::io_context* event_loop = nullptr,
+                        std::shared_ptr<TlsSessionCache> tls_session_cache = nullptr);
 
     void set_websocket_authorization_key(const std::string& authorization_key) override;
     void set_websocket_connection_options(const WebsocketConnectionOptions& connection_options) override;
@@ -170,6 +184,7 @@ public:
     void connect(std::optional<int32_t> network_profile_slot = std::nullopt) override;
     void disconnect() override;
     bool send_to_websocket(const std::string& message) override;
+    bool send_to_websocket(const json& message) override;
     void on_network_disconnected(OCPPInterfaceEnum ocpp_interface) override;
     void on_charging_station_certificate_changed() override;
     void confirm_successful_connection() override;
@@ -184,6 +199,11 @@ private:
     ///
     std::optional<WebsocketConnectionOptions> get_ws_connection_options(const int32_t configuration_slot);
 
+    /// \brief Get the permessage-deflate options from the device model
+    /// \return the options if the extension is enabled, else std::nullopt
+    ///
+    std::optional<PerMessageDeflateOptions> get_permessage_deflate_options();
+
     /// \brief Calls the configuration callback to get the interface to use, if there is a callback
     /// \param slot The configuration slot to get the interface for
     /// \param profile The network connection profile to get the interface for
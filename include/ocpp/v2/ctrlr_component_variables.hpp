@@ -4,16 +4,272 @@
 #ifndef OCPP_V2_CTRLR_COMPONENT_VARIABLES
 #define OCPP_V2_CTRLR_COMPONENT_VARIABLES
 
+#include <array>
+#include <functional>
 #include <set>
 
 #include <ocpp/v2/ocpp_types.hpp>
 
 namespace ocpp {
 namespace v2 {
+///
+/// \brief Dense ids of the variables of ControllerComponentVariables. Every variable of that namespace is defined with
+/// its own id, so a variable without an entry here does not compile. Count is the number of variables
+///
+enum class ControllerComponentVariableId : std::size_t {
+    InternalCtrlrEnabled,
+    ChargePointId,
+    NetworkConnectionProfiles,
+    ChargeBoxSerialNumber,
+    ChargePointModel,
+    ChargePointSerialNumber,
+    ChargePointVendor,
+    FirmwareVersion,
+    ICCID,
+    IMSI,
+    MeterSerialNumber,
+    MeterType,
+    SupportedCiphers12,
+    SupportedCiphers13,
+    AuthorizeConnectorZeroOnConnectorOne,
+    LogMessages,
+    LogMessagesFormat,
+    LogRotation,
+    LogRotationDateSuffix,
+    LogRotationMaximumFileSize,
+    LogRotationMaximumFileCount,
+    SupportedCriteria,
+    RoundClockAlignedTimestamps,
+    NetworkConfigTimeout,
+    SupportedChargingProfilePurposeTypes,
+    MaxCompositeScheduleDuration,
+    NumberOfConnectors,
+    UseSslDefaultVerifyPaths,
+    VerifyCsmsCommonName,
+    UseTPM,
+    UseTPMSeccLeafCertificate,
+    VerifyCsmsAllowWildcards,
+    IFace,
+    EnableTLSKeylog,
+    TLSKeylogFile,
+    OcspRequestInterval,
+    WebsocketPingPayload,
+    WebsocketPongTimeout,
+    WebsocketMessageFragmentSize,
+    WebsocketPermessageDeflate,
+    WebsocketPermessageDeflateNoContextTakeover,
+    WebsocketPermessageDeflateMaxWindowBits,
+    WebsocketIncrementalMessageParsing,
+    WebsocketSharedContext,
+    WebsocketTlsSessionResumption,
+    WebsocketPersistTlsSessions,
+    RetryBackOffDecorrelatedJitter,
+    RetryBackOffMaximum,
+    RetryBackOffSpread,
+    SingleThreadedEventLoop,
+    MonitorsProcessingInterval,
+    MaxCustomerInformationDataLength,
+    V2GCertificateExpireCheckInitialDelaySeconds,
+    V2GCertificateExpireCheckIntervalSeconds,
+    ClientCertificateExpireCheckInitialDelaySeconds,
+    ClientCertificateExpireCheckIntervalSeconds,
+    MessageQueueSizeThreshold,
+    MessageQueueMaxMessagesInFlight,
+    MessageQueueSizeThresholdBytes,
+    MessageQueueUpdateThinningResolution,
+    MessageQueueTransactionCompactionThreshold,
+    MessageQueueTransactionCompactionInterval,
+    MessageQueuePersistenceFlushInterval,
+    MessageQueuePersistenceMaxPendingOperations,
+    MessageQueuePersistenceFormat,
+    DatabaseTuningProfile,
+    DatabaseReadConnections,
+    TransactionWriteBehind,
+    TransactionWriteBehindMaxQueueSize,
+    MaxMessageSize,
+    ResumeTransactionsOnBoot,
+    AllowCSMSRootCertInstallWithUnsecureConnection,
+    AllowMFRootCertInstallWithUnsecureConnection,
+    AllowSecurityLevelZeroConnections,
+    SupportedOcppVersions,
+    AlignedDataCtrlrEnabled,
+    AlignedDataCtrlrAvailable,
+    AlignedDataInterval,
+    AlignedDataMeasurands,
+    AlignedDataSendDuringIdle,
+    AlignedDataSignReadings,
+    AlignedDataTxEndedInterval,
+    AlignedDataTxEndedMeasurands,
+    AuthCacheCtrlrAvailable,
+    AuthCacheDisablePostAuthorize,
+    AuthCacheCtrlrEnabled,
+    AuthCacheLifeTime,
+    AuthCachePolicy,
+    AuthCacheStorage,
+    AuthCtrlrEnabled,
+    AdditionalInfoItemsPerMessage,
+    AuthorizeRemoteStart,
+    LocalAuthorizeOffline,
+    LocalPreAuthorize,
+    DisableRemoteAuthorization,
+    MasterPassGroupId,
+    OfflineTxForUnknownIdEnabled,
+    AllowNewSessionsPendingFirmwareUpdate,
+    ChargingStationAvailabilityState,
+    ChargingStationAvailable,
+    ChargingStationSupplyPhases,
+    ClockCtrlrDateTime,
+    NextTimeOffsetTransitionDateTime,
+    NtpServerUri,
+    NtpSource,
+    TimeAdjustmentReportingThreshold,
+    TimeOffset,
+    TimeOffsetNextTransition,
+    TimeSource,
+    TimeZone,
+    CustomImplementationEnabled,
+    CustomImplementationCaliforniaPricingEnabled,
+    CustomImplementationMultiLanguageEnabled,
+    BytesPerMessageGetReport,
+    BytesPerMessageGetVariables,
+    BytesPerMessageSetVariables,
+    ConfigurationValueSize,
+    ItemsPerMessageGetReport,
+    ItemsPerMessageGetVariables,
+    ItemsPerMessageSetVariables,
+    ReportingValueSize,
+    DisplayMessageCtrlrAvailable,
+    NumberOfDisplayMessages,
+    DisplayMessageSupportedFormats,
+    DisplayMessageSupportedPriorities,
+    DisplayMessageSupportedStates,
+    DisplayMessageQRCodeDisplayCapable,
+    DisplayMessageLanguage,
+    CentralContractValidationAllowed,
+    ContractValidationOffline,
+    RequestMeteringReceipt,
+    ISO15118CtrlrSeccId,
+    ISO15118CtrlrCountryName,
+    ISO15118CtrlrOrganizationName,
+    PnCEnabled,
+    V2GCertificateInstallationEnabled,
+    ContractCertificateInstallationEnabled,
+    LocalAuthListCtrlrAvailable,
+    BytesPerMessageSendLocalList,
+    LocalAuthListCtrlrEnabled,
+    LocalAuthListCtrlrEntries,
+    ItemsPerMessageSendLocalList,
+    LocalAuthListCtrlrStorage,
+    LocalAuthListDisablePostAuthorize,
+    MonitoringCtrlrAvailable,
+    BytesPerMessageClearVariableMonitoring,
+    BytesPerMessageSetVariableMonitoring,
+    MonitoringCtrlrEnabled,
+    ActiveMonitoringBase,
+    ActiveMonitoringLevel,
+    ItemsPerMessageClearVariableMonitoring,
+    ItemsPerMessageSetVariableMonitoring,
+    OfflineQueuingSeverity,
+    ActiveNetworkProfile,
+    FileTransferProtocols,
+    HeartbeatInterval,
+    MessageTimeout,
+    MessageAttemptInterval,
+    MessageAttempts,
+    NetworkConfigurationPriority,
+    NetworkProfileConnectionAttempts,
+    OfflineThreshold,
+    QueueAllMessages,
+    MessageTypesDiscardForQueueing,
+    ResetRetries,
+    RetryBackOffRandomRange,
+    RetryBackOffRepeatTimes,
+    RetryBackOffWaitMinimum,
+    UnlockOnEVSideDisconnect,
+    WebSocketPingInterval,
+    ReservationCtrlrAvailable,
+    ReservationCtrlrEnabled,
+    ReservationCtrlrNonEvseSpecific,
+    SampledDataCtrlrAvailable,
+    SampledDataCtrlrEnabled,
+    SampledDataSignReadings,
+    SampledDataTxEndedInterval,
+    SampledDataTxEndedMeasurands,
+    SampledDataTxStartedMeasurands,
+    SampledDataTxUpdatedInterval,
+    SampledDataTxUpdatedMeasurands,
+    AdditionalRootCertificateCheck,
+    BasicAuthPassword,
+    CertificateEntries,
+    CertSigningRepeatTimes,
+    CertSigningWaitMinimum,
+    SecurityCtrlrIdentity,
+    MaxCertificateChainSize,
+    UpdateCertificateSymlinks,
+    OrganizationName,
+    SecurityProfile,
+    ACPhaseSwitchingSupported,
+    SmartChargingCtrlrAvailable,
+    SmartChargingCtrlrEnabled,
+    EntriesChargingProfiles,
+    ExternalControlSignalsEnabled,
+    LimitChangeSignificance,
+    NotifyChargingLimitWithSchedules,
+    PeriodsPerSchedule,
+    CompositeScheduleDefaultLimitAmps,
+    CompositeScheduleDefaultLimitWatts,
+    CompositeScheduleDefaultNumberPhases,
+    SupplyVoltage,
+    Phases3to1,
+    ChargingProfileMaxStackLevel,
+    ChargingScheduleChargingRateUnit,
+    IgnoredProfilePurposesOffline,
+    TariffCostCtrlrAvailableTariff,
+    TariffCostCtrlrAvailableCost,
+    TariffCostCtrlrCurrency,
+    TariffCostCtrlrEnabledTariff,
+    TariffCostCtrlrEnabledCost,
+    TariffFallbackMessage,
+    TotalCostFallbackMessage,
+    NumberOfDecimalsForCostValues,
+    EVConnectionTimeOut,
+    MaxEnergyOnInvalidId,
+    StopTxOnEVSideDisconnect,
+    StopTxOnInvalidId,
+    TxBeforeAcceptedEnabled,
+    TxStartPoint,
+    TxStopPoint,
+    Count
+};
+
+///
+/// \brief ComponentVariable of ControllerComponentVariables that knows its dense id. The DeviceModel reads these
+/// variables by their id instead of looking them up by their component and variable.
+///
+struct ControllerComponentVariable : ComponentVariable {
+    ControllerComponentVariable() = default;
+
+    ///
+    /// \brief ControllerComponentVariable
+    /// \param id           Dense id of the variable
+    /// \param component    Component
+    /// \param variable     Variable
+    ///
+    ControllerComponentVariable(const ControllerComponentVariableId id, const Component component,
+                                const std::optional<Variable> variable) :
+        ComponentVariable(), id(static_cast<std::size_t>(id)) {
+        this->component = component;
+        this->variable = variable;
+    };
+
+    /// \brief Dense id of the variable, std::nullopt if it is not one of ControllerComponentVariables
+    std::optional<std::size_t> id;
+};
+
 ///
 /// \brief Required ComponentVariable.
 ///
-struct RequiredComponentVariable : ComponentVariable {
+struct RequiredComponentVariable : ControllerComponentVariable {
     /// \brief Constructor
     RequiredComponentVariable() : required_for({OcppProtocolVersion::v201, OcppProtocolVersion::v21}){};
 
@@ -28,12 +284,23 @@ struct RequiredComponentVariable : ComponentVariable {
                               const std::optional<CustomData> custom_data = std::nullopt,
                               const std::set<OcppProtocolVersion>& required_for = {OcppProtocolVersion::v201,
                                                                                    OcppProtocolVersion::v21}) :
-        ComponentVariable(), required_for(required_for) {
+        ControllerComponentVariable(), required_for(required_for) {
         this->component = component;
         this->variable = variable;
         this->customData = custom_data;
     };
 
+    ///
+    /// \brief RequiredComponentVariable of ControllerComponentVariables
+    /// \param id           Dense id of the variable
+    /// \param component    Component
+    /// \param variable     Variable
+    ///
+    RequiredComponentVariable(const ControllerComponentVariableId id, const Component component,
+                              const std::optional<Variable> variable) :
+        ControllerComponentVariable(id, component, variable),
+        required_for({OcppProtocolVersion::v201, OcppProtocolVersion::v21}){};
+
     /// \brief For which ocpp protocol version(s) this component variable is required.
     std::set<OcppProtocolVersion> required_for;
 };
@@ -93,204 +360,235 @@ extern const Variable Fallback;
 
 // Provides access to standardized variables of OCPP2.0.1 spec
 namespace ControllerComponentVariables {
-extern const ComponentVariable InternalCtrlrEnabled;
+extern const ControllerComponentVariable InternalCtrlrEnabled;
 extern const RequiredComponentVariable ChargePointId;
 extern const RequiredComponentVariable NetworkConnectionProfiles;
 extern const RequiredComponentVariable ChargeBoxSerialNumber;
 extern const RequiredComponentVariable ChargePointModel;
-extern const ComponentVariable ChargePointSerialNumber;
+extern const ControllerComponentVariable ChargePointSerialNumber;
 extern const RequiredComponentVariable ChargePointVendor;
 extern const RequiredComponentVariable FirmwareVersion;
-extern const ComponentVariable ICCID;
-extern const ComponentVariable IMSI;
-extern const ComponentVariable MeterSerialNumber;
-extern const ComponentVariable MeterType;
+extern const ControllerComponentVariable ICCID;
+extern const ControllerComponentVariable IMSI;
+extern const ControllerComponentVariable MeterSerialNumber;
+extern const ControllerComponentVariable MeterType;
 extern const RequiredComponentVariable SupportedCiphers12;
 extern const RequiredComponentVariable SupportedCiphers13;
-extern const ComponentVariable AuthorizeConnectorZeroOnConnectorOne;
-extern const ComponentVariable LogMessages;
+extern const ControllerComponentVariable AuthorizeConnectorZeroOnConnectorOne;
+extern const ControllerComponentVariable LogMessages;
 extern const RequiredComponentVariable LogMessagesFormat;
-extern const ComponentVariable LogRotation;
-extern const ComponentVariable LogRotationDateSuffix;
-extern const ComponentVariable LogRotationMaximumFileSize;
-extern const ComponentVariable LogRotationMaximumFileCount;
-extern const ComponentVariable SupportedChargingProfilePurposeTypes;
-extern const ComponentVariable SupportedCriteria;
-extern const ComponentVariable RoundClockAlignedTimestamps;
-extern const ComponentVariable NetworkConfigTimeout;
-extern const ComponentVariable MaxCompositeScheduleDuration;
+extern const ControllerComponentVariable LogRotation;
+extern const ControllerComponentVariable LogRotationDateSuffix;
+extern const ControllerComponentVariable LogRotationMaximumFileSize;
+extern const ControllerComponentVariable LogRotationMaximumFileCount;
+extern const ControllerComponentVariable SupportedChargingProfilePurposeTypes;
+extern const ControllerComponentVariable SupportedCriteria;
+extern const ControllerComponentVariable RoundClockAlignedTimestamps;
+extern const ControllerComponentVariable NetworkConfigTimeout;
+extern const ControllerComponentVariable MaxCompositeScheduleDuration;
 extern const RequiredComponentVariable NumberOfConnectors;
-extern const ComponentVariable UseSslDefaultVerifyPaths;
-extern const ComponentVariable VerifyCsmsCommonName;
-extern const ComponentVariable UseTPM;
-extern const ComponentVariable UseTPMSeccLeafCertificate;
-extern const ComponentVariable VerifyCsmsAllowWildcards;
-extern const ComponentVariable IFace;
-extern const ComponentVariable EnableTLSKeylog;
-extern const ComponentVariable TLSKeylogFile;
-extern const ComponentVariable OcspRequestInterval;
-extern const ComponentVariable WebsocketPingPayload;
-extern const ComponentVariable WebsocketPongTimeout;
-extern const ComponentVariable MonitorsProcessingInterval;
-extern const ComponentVariable MaxCustomerInformationDataLength;
-extern const ComponentVariable V2GCertificateExpireCheckInitialDelaySeconds;
-extern const ComponentVariable V2GCertificateExpireCheckIntervalSeconds;
-extern const ComponentVariable ClientCertificateExpireCheckInitialDelaySeconds;
-extern const ComponentVariable ClientCertificateExpireCheckIntervalSeconds;
-extern const ComponentVariable MessageQueueSizeThreshold;
-extern const ComponentVariable MaxMessageSize;
-extern const ComponentVariable ResumeTransactionsOnBoot;
-extern const ComponentVariable AllowSecurityLevelZeroConnections;
+extern const ControllerComponentVariable UseSslDefaultVerifyPaths;
+extern const ControllerComponentVariable VerifyCsmsCommonName;
+extern const ControllerComponentVariable UseTPM;
+extern const ControllerComponentVariable UseTPMSeccLeafCertificate;
+extern const ControllerComponentVariable VerifyCsmsAllowWildcards;
+extern const ControllerComponentVariable IFace;
+extern const ControllerComponentVariable EnableTLSKeylog;
+extern const ControllerComponentVariable TLSKeylogFile;
+extern const ControllerComponentVariable OcspRequestInterval;
+extern const ControllerComponentVariable WebsocketPingPayload;
+extern const ControllerComponentVariable WebsocketPongTimeout;
+extern const ControllerComponentVariable WebsocketMessageFragmentSize;
+extern const ControllerComponentVariable WebsocketPermessageDeflate;
+extern const ControllerComponentVariable WebsocketPermessageDeflateNoContextTakeover;
+extern const ControllerComponentVariable WebsocketPermessageDeflateMaxWindowBits;
+extern const ControllerComponentVariable WebsocketIncrementalMessageParsing;
+extern const ControllerComponentVariable WebsocketSharedContext;
+extern const ControllerComponentVariable WebsocketTlsSessionResumption;
+extern const ControllerComponentVariable WebsocketPersistTlsSessions;
+extern const ControllerComponentVariable RetryBackOffDecorrelatedJitter;
+extern const ControllerComponentVariable RetryBackOffMaximum;
+extern const ControllerComponentVariable RetryBackOffSpread;
+extern const ControllerComponentVariable SingleThreadedEventLoop;
+extern const ControllerComponentVariable MonitorsProcessingInterval;
+extern const ControllerComponentVariable MaxCustomerInformationDataLength;
+extern const ControllerComponentVariable V2GCertificateExpireCheckInitialDelaySeconds;
+extern const ControllerComponentVariable V2GCertificateExpireCheckIntervalSeconds;
+extern const ControllerComponentVariable ClientCertificateExpireCheckInitialDelaySeconds;
+extern const ControllerComponentVariable ClientCertificateExpireCheckIntervalSeconds;
+extern const ControllerComponentVariable MessageQueueSizeThreshold;
+extern const ControllerComponentVariable MessageQueueMaxMessagesInFlight;
+extern const ControllerComponentVariable MessageQueueSizeThresholdBytes;
+extern const ControllerComponentVariable MessageQueueUpdateThinningResolution;
+extern const ControllerComponentVariable MessageQueueTransactionCompactionThreshold;
+extern const ControllerComponentVariable MessageQueueTransactionCompactionInterval;
+extern const ControllerComponentVariable MessageQueuePersistenceFlushInterval;
+extern const ControllerComponentVariable MessageQueuePersistenceMaxPendingOperations;
+extern const ControllerComponentVariable MessageQueuePersistenceFormat;
+extern const ControllerComponentVariable DatabaseTuningProfile;
+extern const ControllerComponentVariable DatabaseReadConnections;
+extern const ControllerComponentVariable TransactionWriteBehind;
+extern const ControllerComponentVariable TransactionWriteBehindMaxQueueSize;
+extern const ControllerComponentVariable MaxMessageSize;
+extern const ControllerComponentVariable ResumeTransactionsOnBoot;
+extern const ControllerComponentVariable AllowSecurityLevelZeroConnections;
 extern const RequiredComponentVariable SupportedOcppVersions;
-extern const ComponentVariable AlignedDataCtrlrEnabled;
-extern const ComponentVariable AlignedDataCtrlrAvailable;
+extern const ControllerComponentVariable AlignedDataCtrlrEnabled;
+extern const ControllerComponentVariable AlignedDataCtrlrAvailable;
 extern const RequiredComponentVariable AlignedDataInterval;
 extern const RequiredComponentVariable AlignedDataMeasurands;
-extern const ComponentVariable AlignedDataSendDuringIdle;
-extern const ComponentVariable AlignedDataSignReadings;
+extern const ControllerComponentVariable AlignedDataSendDuringIdle;
+extern const ControllerComponentVariable AlignedDataSignReadings;
 extern const RequiredComponentVariable AlignedDataTxEndedInterval;
 extern const RequiredComponentVariable AlignedDataTxEndedMeasurands;
-extern const ComponentVariable AuthCacheCtrlrAvailable;
-extern const ComponentVariable AuthCacheCtrlrEnabled;
-extern const ComponentVariable AuthCacheDisablePostAuthorize;
-extern const ComponentVariable AuthCacheLifeTime;
-extern const ComponentVariable AuthCachePolicy;
-extern const ComponentVariable AuthCacheStorage;
-extern const ComponentVariable AuthCtrlrEnabled;
-extern const ComponentVariable AdditionalInfoItemsPerMessage;
+extern const ControllerComponentVariable AuthCacheCtrlrAvailable;
+extern const ControllerComponentVariable AuthCacheCtrlrEnabled;
+extern const ControllerComponentVariable AuthCacheDisablePostAuthorize;
+extern const ControllerComponentVariable AuthCacheLifeTime;
+extern const ControllerComponentVariable AuthCachePolicy;
+extern const ControllerComponentVariable AuthCacheStorage;
+extern const ControllerComponentVariable AuthCtrlrEnabled;
+extern const ControllerComponentVariable AdditionalInfoItemsPerMessage;
 extern const RequiredComponentVariable AuthorizeRemoteStart;
 extern const RequiredComponentVariable LocalAuthorizeOffline;
 extern const RequiredComponentVariable LocalPreAuthorize;
-extern const ComponentVariable DisableRemoteAuthorization;
-extern const ComponentVariable MasterPassGroupId;
-extern const ComponentVariable OfflineTxForUnknownIdEnabled;
-extern const ComponentVariable AllowNewSessionsPendingFirmwareUpdate;
+extern const ControllerComponentVariable DisableRemoteAuthorization;
+extern const ControllerComponentVariable MasterPassGroupId;
+extern const ControllerComponentVariable OfflineTxForUnknownIdEnabled;
+extern const ControllerComponentVariable AllowNewSessionsPendingFirmwareUpdate;
 extern const RequiredComponentVariable ChargingStationAvailabilityState;
 extern const RequiredComponentVariable ChargingStationAvailable;
 extern const RequiredComponentVariable ChargingStationSupplyPhases;
 extern const RequiredComponentVariable ClockCtrlrDateTime;
-extern const ComponentVariable NextTimeOffsetTransitionDateTime;
-extern const ComponentVariable NtpServerUri;
-extern const ComponentVariable NtpSource;
-extern const ComponentVariable TimeAdjustmentReportingThreshold;
-extern const ComponentVariable TimeOffset;
-extern const ComponentVariable TimeOffsetNextTransition;
+extern const ControllerComponentVariable NextTimeOffsetTransitionDateTime;
+extern const ControllerComponentVariable NtpServerUri;
+extern const ControllerComponentVariable NtpSource;
+extern const ControllerComponentVariable TimeAdjustmentReportingThreshold;
+extern const ControllerComponentVariable TimeOffset;
+extern const ControllerComponentVariable TimeOffsetNextTransition;
 extern const RequiredComponentVariable TimeSource;
-extern const ComponentVariable TimeZone;
-extern const ComponentVariable CustomImplementationEnabled;
-extern const ComponentVariable CustomImplementationCaliforniaPricingEnabled;
-extern const ComponentVariable CustomImplementationMultiLanguageEnabled;
+extern const ControllerComponentVariable TimeZone;
+extern const ControllerComponentVariable CustomImplementationEnabled;
+extern const ControllerComponentVariable CustomImplementationCaliforniaPricingEnabled;
+extern const ControllerComponentVariable CustomImplementationMultiLanguageEnabled;
 extern const RequiredComponentVariable BytesPerMessageGetReport;
 extern const RequiredComponentVariable BytesPerMessageGetVariables;
 extern const RequiredComponentVariable BytesPerMessageSetVariables;
-extern const ComponentVariable ConfigurationValueSize;
+extern const ControllerComponentVariable ConfigurationValueSize;
 extern const RequiredComponentVariable ItemsPerMessageGetReport;
 extern const RequiredComponentVariable ItemsPerMessageGetVariables;
 extern const RequiredComponentVariable ItemsPerMessageSetVariables;
-extern const ComponentVariable ReportingValueSize;
-extern const ComponentVariable DisplayMessageCtrlrAvailable;
+extern const ControllerComponentVariable ReportingValueSize;
+extern const ControllerComponentVariable DisplayMessageCtrlrAvailable;
 extern const RequiredComponentVariable NumberOfDisplayMessages;
 extern const RequiredComponentVariable DisplayMessageSupportedFormats;
 extern const RequiredComponentVariable DisplayMessageSupportedPriorities;
-extern const ComponentVariable DisplayMessageSupportedStates;
-extern const ComponentVariable DisplayMessageQRCodeDisplayCapable;
-extern const ComponentVariable DisplayMessageLanguage;
-extern const ComponentVariable CentralContractValidationAllowed;
+extern const ControllerComponentVariable DisplayMessageSupportedStates;
+extern const ControllerComponentVariable DisplayMessageQRCodeDisplayCapable;
+extern const ControllerComponentVariable DisplayMessageLanguage;
+extern const ControllerComponentVariable CentralContractValidationAllowed;
 extern const RequiredComponentVariable ContractValidationOffline;
-extern const ComponentVariable RequestMeteringReceipt;
-extern const ComponentVariable ISO15118CtrlrSeccId;
-extern const ComponentVariable ISO15118CtrlrCountryName;
-extern const ComponentVariable ISO15118CtrlrOrganizationName;
-extern const ComponentVariable PnCEnabled;
-extern const ComponentVariable V2GCertificateInstallationEnabled;
-extern const ComponentVariable ContractCertificateInstallationEnabled;
-extern const ComponentVariable LocalAuthListCtrlrAvailable;
+extern const ControllerComponentVariable RequestMeteringReceipt;
+extern const ControllerComponentVariable ISO15118CtrlrSeccId;
+extern const ControllerComponentVariable ISO15118CtrlrCountryName;
+extern const ControllerComponentVariable ISO15118CtrlrOrganizationName;
+extern const ControllerComponentVariable PnCEnabled;
+extern const ControllerComponentVariable V2GCertificateInstallationEnabled;
+extern const ControllerComponentVariable ContractCertificateInstallationEnabled;
+extern const ControllerComponentVariable LocalAuthListCtrlrAvailable;
 extern const RequiredComponentVariable BytesPerMessageSendLocalList;
-extern const ComponentVariable LocalAuthListCtrlrEnabled;
+extern const ControllerComponentVariable LocalAuthListCtrlrEnabled;
 extern const RequiredComponentVariable LocalAuthListCtrlrEntries;
 extern const RequiredComponentVariable ItemsPerMessageSendLocalList;
-extern const ComponentVariable LocalAuthListCtrlrStorage;
-extern const ComponentVariable LocalAuthListDisablePostAuthorize;
-extern const ComponentVariable MonitoringCtrlrAvailable;
-extern const ComponentVariable BytesPerMessageClearVariableMonitoring;
+extern const ControllerComponentVariable LocalAuthListCtrlrStorage;
+extern const ControllerComponentVariable LocalAuthListDisablePostAuthorize;
+extern const ControllerComponentVariable MonitoringCtrlrAvailable;
+extern const ControllerComponentVariable BytesPerMessageClearVariableMonitoring;
 extern const RequiredComponentVariable BytesPerMessageSetVariableMonitoring;
-extern const ComponentVariable MonitoringCtrlrEnabled;
-extern const ComponentVariable ActiveMonitoringBase;
-extern const ComponentVariable ActiveMonitoringLevel;
-extern const ComponentVariable ItemsPerMessageClearVariableMonitoring;
+extern const ControllerComponentVariable MonitoringCtrlrEnabled;
+extern const ControllerComponentVariable ActiveMonitoringBase;
+extern const ControllerComponentVariable ActiveMonitoringLevel;
+extern const ControllerComponentVariable ItemsPerMessageClearVariableMonitoring;
 extern const RequiredComponentVariable ItemsPerMessageSetVariableMonitoring;
-extern const ComponentVariable OfflineQueuingSeverity;
-extern const ComponentVariable ActiveNetworkProfile;
+extern const ControllerComponentVariable OfflineQueuingSeverity;
+extern const ControllerComponentVariable ActiveNetworkProfile;
 extern const RequiredComponentVariable FileTransferProtocols;
-extern const ComponentVariable HeartbeatInterval;
+extern const ControllerComponentVariable HeartbeatInterval;
 extern const RequiredComponentVariable MessageTimeout;
 extern const RequiredComponentVariable MessageAttemptInterval;
 extern const RequiredComponentVariable MessageAttempts;
 extern const RequiredComponentVariable NetworkConfigurationPriority;
 extern const RequiredComponentVariable NetworkProfileConnectionAttempts;
 extern const RequiredComponentVariable OfflineThreshold;
-extern const ComponentVariable QueueAllMessages;
-extern const ComponentVariable MessageTypesDiscardForQueueing;
+extern const ControllerComponentVariable QueueAllMessages;
+extern const ControllerComponentVariable MessageTypesDiscardForQueueing;
 extern const RequiredComponentVariable ResetRetries;
 extern const RequiredComponentVariable RetryBackOffRandomRange;
 extern const RequiredComponentVariable RetryBackOffRepeatTimes;
 extern const RequiredComponentVariable RetryBackOffWaitMinimum;
 extern const RequiredComponentVariable UnlockOnEVSideDisconnect;
 extern const RequiredComponentVariable WebSocketPingInterval;
-extern const ComponentVariable ReservationCtrlrAvailable;
-extern const ComponentVariable ReservationCtrlrEnabled;
-extern const ComponentVariable ReservationCtrlrNonEvseSpecific;
-extern const ComponentVariable SampledDataCtrlrAvailable;
-extern const ComponentVariable SampledDataCtrlrEnabled;
-extern const ComponentVariable SampledDataSignReadings;
+extern const ControllerComponentVariable ReservationCtrlrAvailable;
+extern const ControllerComponentVariable ReservationCtrlrEnabled;
+extern const ControllerComponentVariable ReservationCtrlrNonEvseSpecific;
+extern const ControllerComponentVariable SampledDataCtrlrAvailable;
+extern const ControllerComponentVariable SampledDataCtrlrEnabled;
+extern const ControllerComponentVariable SampledDataSignReadings;
 extern const RequiredComponentVariable SampledDataTxEndedInterval;
 extern const RequiredComponentVariable SampledDataTxEndedMeasurands;
 extern const RequiredComponentVariable SampledDataTxStartedMeasurands;
 extern const RequiredComponentVariable SampledDataTxUpdatedInterval;
 extern const RequiredComponentVariable SampledDataTxUpdatedMeasurands;
-extern const ComponentVariable AdditionalRootCertificateCheck;
-extern const ComponentVariable BasicAuthPassword;
+extern const ControllerComponentVariable AdditionalRootCertificateCheck;
+extern const ControllerComponentVariable BasicAuthPassword;
 extern const RequiredComponentVariable CertificateEntries;
-extern const ComponentVariable CertSigningRepeatTimes;
-extern const ComponentVariable CertSigningWaitMinimum;
+extern const ControllerComponentVariable CertSigningRepeatTimes;
+extern const ControllerComponentVariable CertSigningWaitMinimum;
 extern const RequiredComponentVariable SecurityCtrlrIdentity;
-extern const ComponentVariable MaxCertificateChainSize;
-extern const ComponentVariable UpdateCertificateSymlinks;
+extern const ControllerComponentVariable MaxCertificateChainSize;
+extern const ControllerComponentVariable UpdateCertificateSymlinks;
 extern const RequiredComponentVariable OrganizationName;
 extern const RequiredComponentVariable SecurityProfile;
-extern const ComponentVariable AllowCSMSRootCertInstallWithUnsecureConnection;
-extern const ComponentVariable AllowMFRootCertInstallWithUnsecureConnection;
-extern const ComponentVariable ACPhaseSwitchingSupported;
-extern const ComponentVariable SmartChargingCtrlrAvailable;
-extern const ComponentVariable SmartChargingCtrlrEnabled;
+extern const ControllerComponentVariable AllowCSMSRootCertInstallWithUnsecureConnection;
+extern const ControllerComponentVariable AllowMFRootCertInstallWithUnsecureConnection;
+extern const ControllerComponentVariable ACPhaseSwitchingSupported;
+extern const ControllerComponentVariable SmartChargingCtrlrAvailable;
+extern const ControllerComponentVariable SmartChargingCtrlrEnabled;
 extern const RequiredComponentVariable EntriesChargingProfiles;
-extern const ComponentVariable ExternalControlSignalsEnabled;
+extern const ControllerComponentVariable ExternalControlSignalsEnabled;
 extern const RequiredComponentVariable LimitChangeSignificance;
-extern const ComponentVariable NotifyChargingLimitWithSchedules;
+extern const ControllerComponentVariable NotifyChargingLimitWithSchedules;
 extern const RequiredComponentVariable PeriodsPerSchedule;
 extern const RequiredComponentVariable CompositeScheduleDefaultLimitAmps;
 extern const RequiredComponentVariable CompositeScheduleDefaultLimitWatts;
 extern const RequiredComponentVariable CompositeScheduleDefaultNumberPhases;
 extern const RequiredComponentVariable SupplyVoltage;
-extern const ComponentVariable Phases3to1;
+extern const ControllerComponentVariable Phases3to1;
 extern const RequiredComponentVariable ChargingProfileMaxStackLevel;
 extern const RequiredComponentVariable ChargingScheduleChargingRateUnit;
-extern const ComponentVariable IgnoredProfilePurposesOffline;
-extern const ComponentVariable TariffCostCtrlrAvailableTariff;
-extern const ComponentVariable TariffCostCtrlrAvailableCost;
+extern const ControllerComponentVariable IgnoredProfilePurposesOffline;
+extern const ControllerComponentVariable TariffCostCtrlrAvailableTariff;
+extern const ControllerComponentVariable TariffCostCtrlrAvailableCost;
 extern const RequiredComponentVariable TariffCostCtrlrCurrency;
-extern const ComponentVariable TariffCostCtrlrEnabledTariff;
-extern const ComponentVariable TariffCostCtrlrEnabledCost;
+extern const ControllerComponentVariable TariffCostCtrlrEnabledTariff;
+extern const ControllerComponentVariable TariffCostCtrlrEnabledCost;
 extern const RequiredComponentVariable TariffFallbackMessage;
 extern const RequiredComponentVariable TotalCostFallbackMessage;
-extern const ComponentVariable NumberOfDecimalsForCostValues;
+extern const ControllerComponentVariable NumberOfDecimalsForCostValues;
 extern const RequiredComponentVariable EVConnectionTimeOut;
-extern const ComponentVariable MaxEnergyOnInvalidId;
+extern const ControllerComponentVariable MaxEnergyOnInvalidId;
 extern const RequiredComponentVariable StopTxOnEVSideDisconnect;
 extern const RequiredComponentVariable StopTxOnInvalidId;
-extern const ComponentVariable TxBeforeAcceptedEnabled;
+extern const ControllerComponentVariable TxBeforeAcceptedEnabled;
 extern const RequiredComponentVariable TxStartPoint;
 extern const RequiredComponentVariable TxStopPoint;
+
+/// \brief Number of variables declared in this namespace
+constexpr std::size_t number_of_variables = static_cast<std::size_t>(ControllerComponentVariableId::Count);
+
+/// \brief All variables of this namespace. The list does not compile if it has more or less entries than
+/// \ref number_of_variables
+extern const std::array<std::reference_wrapper<const ControllerComponentVariable>, number_of_variables> all;
 } // namespace ControllerComponentVariables
 
 namespace EvseComponentVariables {
@@ -5,8 +5,14 @@
 
 #include "ocpp/v2/types.hpp"
 #include "sqlite3.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <ocpp/common/support_older_cpp_versions.hpp>
+#include <thread>
 
 #include <ocpp/common/database/database_connection.hpp>
 #include <ocpp/common/database/database_handler_common.hpp>
@@ -24,6 +30,16 @@ struct AuthorizationCacheEntry {
     DateTime last_used;
 };
 
+/// \brief Configuration of the asynchronous writing of transaction updates
+struct TransactionWriteBehindConfig {
+    /// If true sequence numbers, charging states, the id token sent flag and meter values of transactions are written
+    /// by a worker thread in the order they were requested, instead of by the calling thread
+    bool enabled{false};
+    /// Number of queued updates at which callers wait for the worker. This bounds the memory use and the number of
+    /// updates that can be lost on power loss
+    std::size_t max_queue_size{1000};
+};
+
 class DatabaseHandlerInterface {
 public:
     virtual ~DatabaseHandlerInterface() = default;
@@ -203,6 +219,39 @@ public:
 
 class DatabaseHandler : public DatabaseHandlerInterface, public common::DatabaseHandlerCommon {
 private:
+    TransactionWriteBehindConfig transaction_write_behind_config;
+    std::deque<std::function<void()>> transaction_write_behind_queue;
+    /// number of updates the worker took from the queue and has not written yet
+    std::size_t transaction_write_behind_in_flight{0};
+    std::size_t transaction_write_behind_peak_queue_depth{0};
+    /// errors of the updates the worker could not write that have not been reported to a caller yet
+    std::vector<std::string> transaction_write_behind_errors;
+    mutable std::mutex transaction_write_behind_mutex;
+    /// notifies the worker about new updates
+    std::condition_variable transaction_write_behind_cv;
+    /// notifies waiting callers that the worker wrote a batch
+    std::condition_variable transaction_write_behind_written_cv;
+    std::thread transaction_write_behind_thread;
+    bool transaction_write_behind_running{false};
+    std::atomic_bool transaction_write_behind_enabled{false};
+
+    void transaction_write_behind_worker();
+    void stop_transaction_write_behind();
+    /// \brief Throws a std::logic_error if the calling thread holds a database transaction, waiting for the worker
+    /// would deadlock then
+    void throw_if_transaction_owner() const;
+    /// \brief Queues \p update for the worker. Must not be called by the thread that holds a database transaction,
+    /// since the worker needs one to write the update
+    /// \returns false if the write-behind is disabled and the caller has to write the update itself
+    bool queue_transaction_update(std::function<void()>&& update);
+
+    void transaction_metervalues_insert_internal(const std::string& transaction_id, const MeterValue& meter_value,
+                                                 ReadingContextEnum context);
+    void transaction_update_seq_no_internal(const std::string& transaction_id, int32_t seq_no);
+    void transaction_update_charging_state_internal(const std::string& transaction_id,
+                                                    const ChargingStateEnum charging_state);
+    void transaction_update_id_token_sent_internal(const std::string& transaction_id, bool id_token_sent);
+
     void init_sql() override;
 
     void inintialize_enum_tables();
@@ -221,6 +270,30 @@ public:
     DatabaseHandler(std::unique_ptr<common::DatabaseConnectionInterface> database,
                     const fs::path& sql_migration_files_path);
 
+    /// \brief Writes all queued transaction updates and buffered message queue operations before the handler is
+    /// destroyed
+    ~DatabaseHandler() override;
+
+    /// \brief Enables, reconfigures or disables the asynchronous writing of transaction updates. Updates that are
+    /// already queued are written first
+    void set_transaction_write_behind_config(const TransactionWriteBehindConfig& config);
+
+    /// \brief Blocks until all queued transaction updates are written. Reads and inserts or deletes of transactions and
+    /// their meter values do this implicitly, so they always see the updates that were requested before them. Updates
+    /// that could not be written are reported by get_transaction_write_behind_errors()
+    /// \throws std::logic_error if called by the thread that holds a database transaction
+    void flush_transaction_updates();
+
+    /// \brief Get the errors of queued transaction updates that could not be written since the last call. The
+    /// reported errors are cleared
+    std::vector<std::string> get_transaction_write_behind_errors();
+
+    /// \brief Number of transaction updates that are queued or being written
+    std::size_t get_transaction_write_behind_queue_depth() const;
+
+    /// \brief Highest number of transaction updates that were queued at the same time
+    std::size_t get_transaction_write_behind_peak_queue_depth() const;
+
     // Authorization cache management
     void authorization_cache_insert_entry(const std::string& id_token_hash, const IdTokenInfo& id_token_info) override;
     void authorization_cache_update_last_used(const std::string& id_token_hash) override;
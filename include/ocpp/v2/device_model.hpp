@@ -4,7 +4,10 @@
 #ifndef DEVICE_MODEL_HPP
 #define DEVICE_MODEL_HPP
 
+#include <array>
+#include <mutex>
 #include <type_traits>
+#include <unordered_map>
 
 #include <everest/logging.hpp>
 
@@ -100,6 +103,35 @@ private:
     DeviceModelMap device_model_map;
     std::unique_ptr<DeviceModelStorageInterface> device_model;
 
+    /// \brief Identifies a variable by pointers to its Component and Variable, so it can be looked up without copying
+    /// them. The keys of variable_attributes point into device_model_map
+    using ComponentVariableKey = std::pair<const Component*, const Variable*>;
+
+    /// \brief Hash of the names, instances and EVSE of a ComponentVariableKey
+    struct ComponentVariableKeyHash {
+        std::size_t operator()(const ComponentVariableKey& key) const;
+    };
+
+    /// \brief Compares ComponentVariableKey(s) in the same (case sensitive) way as the ordering of device_model_map
+    struct ComponentVariableKeyEqual {
+        bool operator()(const ComponentVariableKey& lhs, const ComponentVariableKey& rhs) const;
+    };
+
+    /// \brief Copy of the VariableAttribute(s) of every variable in the storage. It is filled on construction and
+    /// updated by set_value, which writes through to the storage, so values can be read without querying the storage.
+    /// Its keys do not change after construction, only the VariableAttribute(s) are updated
+    std::unordered_map<ComponentVariableKey, std::vector<VariableAttribute>, ComponentVariableKeyHash,
+                       ComponentVariableKeyEqual>
+        variable_attributes;
+    /// \brief Guards the VariableAttribute(s) in variable_attributes
+    mutable std::mutex variable_attributes_mutex;
+    /// \brief Held while a value is written to the storage and then to variable_attributes
+    std::mutex storage_write_mutex;
+    /// \brief Entries of variable_attributes for the variables of ControllerComponentVariables, indexed by their id.
+    /// nullptr if the variable is not part of the device model
+    std::array<const std::vector<VariableAttribute>*, ControllerComponentVariables::number_of_variables>
+        controller_variable_attributes{};
+
     /// \brief Listener for the internal change of a variable
     on_variable_changed variable_listener;
     /// \brief Listener for the internal update of a monitor
@@ -118,6 +150,50 @@ private:
                                                  const AttributeEnum& attribute_enum, std::string& value,
                                                  bool allow_write_only) const;
 
+    /// \brief Same as request_value_internal() above. Variables of ControllerComponentVariables are looked up by their
+    /// id instead of by their component and variable
+    GetVariableStatusEnum request_value_internal(const ControllerComponentVariable& component_variable,
+                                                 const AttributeEnum& attribute_enum, std::string& value,
+                                                 bool allow_write_only) const;
+
+    /// \brief Sets \p value to the value of the attribute of type \p attribute_enum in \p attributes , which is an
+    /// entry of variable_attributes
+    GetVariableStatusEnum request_value_internal(const std::vector<VariableAttribute>& attributes,
+                                                 const AttributeEnum& attribute_enum, std::string& value,
+                                                 bool allow_write_only) const;
+
+    /// \brief Status of a request for a variable that is not present in variable_attributes
+    GetVariableStatusEnum get_unknown_variable_status(const Component& component_id,
+                                                      const Variable& variable_id) const;
+
+    /// \brief Gets a copy of the cached VariableAttribute of the given \p component_id , \p variable_id and
+    /// \p attribute_enum
+    /// \return The VariableAttribute or std::nullopt if it is not present in the storage
+    std::optional<VariableAttribute> get_variable_attribute(const Component& component_id, const Variable& variable_id,
+                                                            const AttributeEnum& attribute_enum) const;
+
+    /// \brief Gets a copy of all cached VariableAttribute(s) of the given \p component_id and \p variable_id
+    std::vector<VariableAttribute> get_variable_attributes(const Component& component_id,
+                                                           const Variable& variable_id) const;
+
+    /// \brief Checks with the device model representation in memory if \p value may be set for the given
+    /// \p component_id , \p variable_id and \p attribute_enum
+    /// \return SetVariableStatusEnum::Accepted if the value may be set, else the status of the rejection
+    SetVariableStatusEnum validate_set_value(const Component& component_id, const Variable& variable_id,
+                                             const AttributeEnum& attribute_enum, const std::string& value,
+                                             const bool allow_read_only) const;
+
+    /// \brief Sets the value of the cached VariableAttribute after it has been written to the storage. The caller must
+    /// hold variable_attributes_mutex
+    /// \return The VariableAttribute before it was changed or std::nullopt if it is not present
+    std::optional<VariableAttribute> set_cached_value(const Component& component_id, const Variable& variable_id,
+                                                      const AttributeEnum& attribute_enum, const std::string& value);
+
+    /// \brief Triggers the variable listener if the Actual value of \p attribute has changed to \p value and the
+    /// variable has monitors
+    void notify_variable_changed(const Component& component_id, const Variable& variable_id,
+                                 const VariableAttribute& attribute, const std::string& value);
+
     /// \brief Iterates over the given \p component_criteria and converts this to the variable names
     /// (Active,Available,Enabled,Problem). If any of the variables can not be found as part of a component this
     /// function returns false. If any of those variable's value is true, this function returns true (except for
@@ -183,8 +259,7 @@ public:
         std::string value;
         auto response = GetVariableStatusEnum::UnknownVariable;
         if (component_variable.variable.has_value()) {
-            response = this->request_value_internal(component_variable.component, component_variable.variable.value(),
-                                                    attribute_enum, value, true);
+            response = this->request_value_internal(component_variable, attribute_enum, value, true);
         }
         if (response == GetVariableStatusEnum::Accepted) {
             return to_specific_type<T>(value);
@@ -218,6 +293,22 @@ public:
         }
     }
 
+    /// \brief Same as get_optional_value() above. Variables of ControllerComponentVariables are read by their id
+    template <typename T>
+    std::optional<T> get_optional_value(const ControllerComponentVariable& component_variable,
+                                        const AttributeEnum& attribute_enum = AttributeEnum::Actual) const {
+        std::string value;
+        auto response = GetVariableStatusEnum::UnknownVariable;
+        if (component_variable.variable.has_value()) {
+            response = this->request_value_internal(component_variable, attribute_enum, value, true);
+        }
+        if (response == GetVariableStatusEnum::Accepted) {
+            return to_specific_type<T>(value);
+        } else {
+            return std::nullopt;
+        }
+    }
+
     /// \brief Requests a value of a VariableAttribute specified by combination of \p component_id and \p variable_id
     /// from the device model
     /// \tparam T datatype of the value that is requested
@@ -239,6 +330,12 @@ public:
         }
     }
 
+    /// \brief Requests the values of all \p get_variable_data from the device model, like request_value() does for
+    /// a single one. The whole request is resolved at once, so no value can be changed while it is resolved
+    /// \param get_variable_data
+    /// \return A GetVariableResult for every element of \p get_variable_data , in the same order
+    std::vector<GetVariableResult> request_values(const std::vector<GetVariableData>& get_variable_data) const;
+
     /// \brief Get the mutability for the given component, variable and attribute_enum
     /// \param component_id
     /// \param variable_id
@@ -260,6 +357,17 @@ public:
     SetVariableStatusEnum set_value(const Component& component_id, const Variable& variable_id,
                                     const AttributeEnum& attribute_enum, const std::string& value,
                                     const std::string& source, const bool allow_read_only = false);
+
+    /// \brief Sets the values of all \p set_variable_data , like set_value() does for a single one. All accepted values
+    /// are written to the storage in a single transaction
+    /// \param set_variable_data
+    /// \param source           The source of the values (for example 'csms' or 'default').
+    /// \param allow_read_only If this is true, read-only variables can be changed,
+    ///                        otherwise only non read-only variables can be changed. Defaults to false
+    /// \return Result of the requested operation for every element of \p set_variable_data , in the same order
+    std::vector<SetVariableStatusEnum> set_values(const std::vector<SetVariableData>& set_variable_data,
+                                                  const std::string& source, const bool allow_read_only = false);
+
     /// \brief Sets the variable_id attribute \p value specified by \p component_id , \p variable_id and \p
     /// attribute_enum for read only variables only. Only works on certain allowed components.
     /// \param component_id
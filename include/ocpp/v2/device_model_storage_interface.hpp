@@ -36,6 +36,15 @@ struct VariableMetaData {
     std::optional<std::string> source;
 };
 
+/// \brief Helper struct that holds a value of a VariableAttribute that is to be set in the storage
+struct VariableAttributeUpdate {
+    Component component;
+    Variable variable;
+    AttributeEnum attribute_enum;
+    std::string value;
+    std::string source;
+};
+
 using VariableMap = std::map<Variable, VariableMetaData>;
 using DeviceModelMap = std::map<Component, VariableMap>;
 
@@ -98,6 +107,14 @@ public:
                                               const AttributeEnum& attribute_enum, const std::string& value,
                                               const std::string& source) = 0;
 
+    /// \brief Sets the values of all VariableAttribute(s) of \p updates that are present. All values are written in a
+    /// single transaction: if one of them can not be written because of an error of the storage, none of them is
+    /// written
+    /// \param updates
+    /// \return std::vector<bool> with an element for every element of \p updates that is true if the value could be set
+    /// in the storage, else false
+    virtual std::vector<bool> set_variable_attribute_values(const std::vector<VariableAttributeUpdate>& updates) = 0;
+
     /// \brief Inserts or replaces a variable monitor in the database
     /// \param data Monitor data to set
     /// \return true if the value could be inserted, or valse otherwise
@@ -33,9 +33,11 @@ public:
     ///                             `init_db` is true)
     /// \param config_path          Path to the device model config (only needs to be set if `init_db` is true)
     /// \param init_db              True to initialize the database
+    /// \param tuning_profile       PRAGMAs that are applied to the database connection when it is opened
     ///
     explicit DeviceModelStorageSqlite(const fs::path& db_path, const std::filesystem::path& migration_files_path = "",
-                                      const std::filesystem::path& config_path = "", const bool init_db = false);
+                                      const std::filesystem::path& config_path = "", const bool init_db = false,
+                                      const ocpp::common::DatabaseTuningProfile& tuning_profile = {});
 
     ~DeviceModelStorageSqlite() = default;
 
@@ -51,6 +53,8 @@ public:
                                       const AttributeEnum& attribute_enum, const std::string& value,
                                       const std::string& source) final;
 
+    std::vector<bool> set_variable_attribute_values(const std::vector<VariableAttributeUpdate>& updates) final;
+
     std::optional<VariableMonitoringMeta> set_monitoring_data(const SetMonitoringData& data,
                                                               const VariableMonitorType type) final;
 
@@ -27,6 +27,10 @@
 /// The config values are updated every startup as well, as long as the initial / default values are set in the
 /// database. If the value is set by the user or csms or some other process, the value will not be overwritten.
 ///
+/// To keep the startup fast, a hash of every component config file and of all files together is stored in the
+/// database. If no file has changed since the last initialization, the database is not touched at all. Otherwise only
+/// the components of changed files are compared with the database.
+///
 /// Almost every function throws exceptions, because this class should be used only when initializing the chargepoint
 /// and the database must be correct before starting the application.
 ///
@@ -45,11 +49,12 @@ namespace ocpp::v2 {
 /// When the component is read from the database, the component id will be set.
 ///
 struct ComponentKey {
-    std::optional<uint64_t> db_id;       ///< \brief Component id in the database.
-    std::string name;                    ///< \brief Component name.
-    std::optional<std::string> instance; ///< \brief Component instance.
-    std::optional<int32_t> evse_id;      ///< \brief Component evse id.
-    std::optional<int32_t> connector_id; ///< \brief Component connector id.
+    std::optional<uint64_t> db_id;          ///< \brief Component id in the database.
+    std::string name;                       ///< \brief Component name.
+    std::optional<std::string> instance;    ///< \brief Component instance.
+    std::optional<int32_t> evse_id;         ///< \brief Component evse id.
+    std::optional<int32_t> connector_id;    ///< \brief Component connector id.
+    std::optional<std::string> config_hash; ///< \brief Hash of the component config file the component was read from.
 
     ///
     /// \brief operator <, needed to add this class as key in a map.
@@ -60,6 +65,15 @@ struct ComponentKey {
     friend bool operator<(const ComponentKey& l, const ComponentKey& r);
 };
 
+///
+/// \brief Struct that holds a component config file.
+///
+struct ComponentConfigFile {
+    std::filesystem::path path; ///< \brief Path of the file, relative to the component config directory.
+    std::string content;        ///< \brief Content of the file.
+    std::string hash;           ///< \brief Hash of the content of the file.
+};
+
 ///
 /// \brief Struct that holds a VariableAttribute struct and an database id.
 ///
@@ -181,12 +195,23 @@ private: // Functions
     std::vector<std::filesystem::path> get_component_config_from_directory(const std::filesystem::path& directory);
 
     ///
-    /// \brief Read all component config files from the given directory and create a map holding the structure.
-    /// \param directory    The parent directory containing the standardized and custom component config files.
+    /// \brief Read all component config files (*.json) from a directory.
+    /// \param config_path  Parent directory holding the standardized and custom component config's.
+    /// \param directory    The directory to read, relative to \p config_path.
+    /// \return The component config files with the hash of their content.
+    ///
+    std::vector<ComponentConfigFile> read_component_config_files(const std::filesystem::path& config_path,
+                                                                 const std::filesystem::path& directory);
+
+    ///
+    /// \brief Parse all component config files and create a map holding the structure.
+    /// \param standardized_files   The standardized component config files.
+    /// \param custom_files         The custom component config files.
     /// \return A map with the device model components, variables, characteristics and attributes.
     ///
     std::map<ComponentKey, std::vector<DeviceModelVariable>>
-    get_all_component_configs(const std::filesystem::path& directory);
+    get_all_component_configs(const std::vector<ComponentConfigFile>& standardized_files,
+                              const std::vector<ComponentConfigFile>& custom_files);
 
     ///
     /// \brief Insert components, including variables, characteristics and attributes, to the database.
@@ -208,11 +233,11 @@ private: // Functions
 
     ///
     /// \brief Read component config from given files.
-    /// \param components_config_path   The paths to the component config files.
+    /// \param component_config_files   The component config files.
     /// \return A map holding the components with its variables, characteristics and attributes.
     ///
     std::map<ComponentKey, std::vector<DeviceModelVariable>>
-    read_component_config(const std::vector<std::filesystem::path>& components_config_path);
+    read_component_config(const std::vector<ComponentConfigFile>& component_config_files);
 
     ///
     /// \brief Get all component properties (variables) from the given (component) json.
@@ -422,6 +447,31 @@ private: // Functions
     update_component_variables(const std::pair<ComponentKey, std::vector<DeviceModelVariable>>& db_component_variables,
                                const std::vector<DeviceModelVariable>& variables);
 
+    ///
+    /// \brief Set the hash of the component config file a component was read from in the database.
+    /// \param db_component The component in the database.
+    /// \param config_hash  The hash of the component config file.
+    ///
+    /// \throws InitDeviceModelDbError If the hash could not be set
+    ///
+    void update_component_config_hash(const ComponentKey& db_component, const std::optional<std::string>& config_hash);
+
+    ///
+    /// \brief Get the hash of all component config files the database was initialized with.
+    /// \return The hash or std::nullopt if the database was not initialized with a hash yet.
+    ///
+    /// \throws InitDeviceModelDbError If the hash could not be read
+    ///
+    std::optional<std::string> get_config_hash_from_db();
+
+    ///
+    /// \brief Store the hash of all component config files the database is initialized with.
+    /// \param config_hash  The hash of all component config files.
+    ///
+    /// \throws InitDeviceModelDbError If the hash could not be stored
+    ///
+    void set_config_hash_in_db(const std::string& config_hash);
+
     ///
     /// \brief Get variable attributes belonging to a specific variable from the database.
     /// \param variable_id  The id of the variable to get the attributes from.
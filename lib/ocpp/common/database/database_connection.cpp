@@ -6,19 +6,106 @@
 
 #include <everest/logging.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <list>
+#include <unordered_map>
+
 using namespace std::chrono_literals;
 using namespace std::string_literals;
 
 namespace ocpp::common {
 
+namespace {
+
+std::string journal_mode_to_string(DatabaseJournalMode mode) {
+    switch (mode) {
+    case DatabaseJournalMode::Delete:
+        return "delete";
+    case DatabaseJournalMode::Truncate:
+        return "truncate";
+    case DatabaseJournalMode::Persist:
+        return "persist";
+    case DatabaseJournalMode::Memory:
+        return "memory";
+    case DatabaseJournalMode::WAL:
+        return "wal";
+    case DatabaseJournalMode::Off:
+        return "off";
+    }
+    throw EnumToStringException{mode, "DatabaseJournalMode"};
+}
+
+std::string synchronous_mode_to_string(DatabaseSynchronousMode mode) {
+    switch (mode) {
+    case DatabaseSynchronousMode::Off:
+        return "off";
+    case DatabaseSynchronousMode::Normal:
+        return "normal";
+    case DatabaseSynchronousMode::Full:
+        return "full";
+    case DatabaseSynchronousMode::Extra:
+        return "extra";
+    }
+    throw EnumToStringException{mode, "DatabaseSynchronousMode"};
+}
+
+bool execute(sqlite3* db, const std::string& statement) {
+    char* err_msg = nullptr;
+    if (sqlite3_exec(db, statement.c_str(), NULL, NULL, &err_msg) != SQLITE_OK) {
+        EVLOG_error << "Could not execute statement \"" << statement << "\": " << err_msg;
+        sqlite3_free(err_msg);
+        return false;
+    }
+    return true;
+}
+
+/// \returns true if \p sql starts with a keyword of a query. Only queries are sent to the read connections
+bool is_query(const std::string& sql) {
+    const auto start = std::find_if_not(sql.begin(), sql.end(), [](unsigned char c) { return std::isspace(c); });
+    const auto starts_with = [&sql, start](const std::string& keyword) {
+        return static_cast<std::size_t>(sql.end() - start) >= keyword.size() and
+               std::equal(keyword.begin(), keyword.end(), start,
+                          [](char a, char b) { return a == std::toupper(static_cast<unsigned char>(b)); });
+    };
+    return starts_with("SELECT") or starts_with("WITH");
+}
+
+} // namespace
+
+DatabaseTuningProfile get_database_tuning_profile(const std::string& name) {
+    DatabaseTuningProfile profile;
+    if (name == "Default") {
+        return profile;
+    }
+    if (name == "WAL" or name == "Flash") {
+        profile.journal_mode = DatabaseJournalMode::WAL;
+        profile.synchronous = DatabaseSynchronousMode::Normal;
+        if (name == "Flash") {
+            profile.cache_size_kib = 8 * 1024;
+            profile.mmap_size = 64 * 1024 * 1024;
+        }
+        return profile;
+    }
+    throw StringToEnumException{name, "DatabaseTuningProfile"};
+}
+
 class DatabaseTransaction : public DatabaseTransactionInterface {
 private:
     DatabaseConnection& database;
     std::unique_lock<std::timed_mutex> mutex;
+    std::atomic<std::thread::id>& owner;
+
+    void release() {
+        this->owner = std::thread::id();
+        this->mutex.unlock();
+    }
 
 public:
-    DatabaseTransaction(DatabaseConnection& database, std::unique_lock<std::timed_mutex> mutex) :
-        database{database}, mutex{std::move(mutex)} {
+    DatabaseTransaction(DatabaseConnection& database, std::unique_lock<std::timed_mutex> mutex,
+                        std::atomic<std::thread::id>& owner) :
+        database{database}, mutex{std::move(mutex)}, owner{owner} {
+        this->owner = std::this_thread::get_id();
         this->database.execute_statement("BEGIN TRANSACTION");
     }
 
@@ -31,22 +118,138 @@ public:
 
     void commit() override {
         const auto retval = this->database.execute_statement("COMMIT TRANSACTION");
-        this->mutex.unlock();
+        this->release();
         if (retval == false) {
             throw QueryExecutionException(this->database.get_error_message());
         }
     }
     void rollback() override {
         const auto retval = this->database.execute_statement("ROLLBACK TRANSACTION");
-        this->mutex.unlock();
+        this->release();
         if (retval == false) {
             throw QueryExecutionException(this->database.get_error_message());
         }
     }
 };
 
-DatabaseConnection::DatabaseConnection(const fs::path& database_file_path) noexcept :
-    db(nullptr), database_file_path(database_file_path), open_count(0) {
+/// \brief LRU cache of idle prepared statements, keyed by their SQL text. A statement that is in use is not part of the
+/// cache, so the same SQL can be used by several statements at the same time
+class PreparedStatementCache {
+private:
+    std::mutex mutex;
+    const std::size_t capacity;
+    // Incremented whenever the connection finalizes all statements, statements of older generations are not valid
+    std::uint64_t generation;
+    // Most recently used first
+    std::list<std::pair<std::string, sqlite3_stmt*>> statements;
+    std::unordered_map<std::string, std::list<std::pair<std::string, sqlite3_stmt*>>::iterator> index;
+
+public:
+    explicit PreparedStatementCache(std::size_t capacity) : capacity(capacity), generation(0) {
+    }
+
+    std::size_t get_capacity() const {
+        return this->capacity;
+    }
+
+    /// \brief Removes the idle statement for \p sql from the cache
+    /// \returns the statement or nullptr if there is none, and the generation a new statement belongs to
+    std::pair<sqlite3_stmt*, std::uint64_t> take(const std::string& sql) {
+        std::lock_guard lock(this->mutex);
+        const auto it = this->index.find(sql);
+        if (it == this->index.end()) {
+            return {nullptr, this->generation};
+        }
+
+        sqlite3_stmt* stmt = it->second->second;
+        this->statements.erase(it->second);
+        this->index.erase(it);
+        return {stmt, this->generation};
+    }
+
+    /// \brief Resets \p stmt and adds it to the cache. The least recently used statement is finalized if the cache is
+    /// full
+    void release(const std::string& sql, sqlite3_stmt* stmt, std::uint64_t generation) {
+        std::lock_guard lock(this->mutex);
+        if (generation != this->generation) {
+            // Already finalized when the connection was closed
+            return;
+        }
+
+        // Unbinds text and blobs that were bound without a copy, they are not valid anymore
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+
+        if (this->capacity == 0 or this->index.find(sql) != this->index.end()) {
+            sqlite3_finalize(stmt);
+            return;
+        }
+
+        this->statements.emplace_front(sql, stmt);
+        this->index.emplace(sql, this->statements.begin());
+
+        if (this->statements.size() > this->capacity) {
+            sqlite3_finalize(this->statements.back().second);
+            this->index.erase(this->statements.back().first);
+            this->statements.pop_back();
+        }
+    }
+
+    /// \brief Finalizes all idle statements, statements that are in use are finalized by the connection
+    void clear() {
+        std::lock_guard lock(this->mutex);
+        for (const auto& [sql, stmt] : this->statements) {
+            sqlite3_finalize(stmt);
+        }
+        this->statements.clear();
+        this->index.clear();
+        this->generation++;
+    }
+};
+
+namespace {
+
+/// \brief Prepares \p sql on \p db, reusing an idle statement of \p cache if there is one
+/// \returns the statement or nullptr if \p read_only is set and the statement would write to the database
+std::unique_ptr<SQLiteStatement> prepare_statement(sqlite3* db, const std::shared_ptr<PreparedStatementCache>& cache,
+                                                   const std::string& sql, bool read_only) {
+    const auto cached = cache->take(sql);
+    sqlite3_stmt* stmt = cached.first;
+    const auto generation = cached.second;
+    if (stmt == nullptr and sqlite3_prepare_v2(db, sql.c_str(), sql.size(), &stmt, nullptr) != SQLITE_OK) {
+        EVLOG_error << sqlite3_errmsg(db);
+        throw QueryExecutionException("Could not prepare statement for database.");
+    }
+
+    if (read_only and sqlite3_stmt_readonly(stmt) == 0) {
+        sqlite3_finalize(stmt);
+        return nullptr;
+    }
+
+    if (cache->get_capacity() == 0) {
+        return std::make_unique<SQLiteStatement>(db, stmt, nullptr);
+    }
+
+    return std::make_unique<SQLiteStatement>(
+        db, stmt,
+        [weak_cache = std::weak_ptr<PreparedStatementCache>(cache), sql, generation](sqlite3_stmt* released) {
+            // Without the cache the connection is gone and has finalized the statement
+            if (const auto locked_cache = weak_cache.lock(); locked_cache != nullptr) {
+                locked_cache->release(sql, released, generation);
+            }
+        });
+}
+
+} // namespace
+
+DatabaseConnection::DatabaseConnection(const fs::path& database_file_path, std::size_t statement_cache_size,
+                                       const DatabaseTuningProfile& tuning_profile) noexcept :
+    db(nullptr),
+    database_file_path(database_file_path),
+    open_count(0),
+    statement_cache(std::make_shared<PreparedStatementCache>(statement_cache_size)),
+    tuning_profile(tuning_profile),
+    next_read_connection(0) {
 }
 
 DatabaseConnection::~DatabaseConnection() {
@@ -75,9 +278,93 @@ bool DatabaseConnection::open_connection() {
         return false;
     }
     EVLOG_info << "Established connection to database: " << this->database_file_path;
+    this->apply_tuning_profile();
+    if (this->tuning_profile.read_connections > 0) {
+        this->open_read_connections();
+    }
     return true;
 }
 
+void DatabaseConnection::apply_tuning_profile() {
+    // The settings only affect the performance, so the connection is still usable if one of them fails
+    if (this->tuning_profile.journal_mode.has_value()) {
+        const auto journal_mode = journal_mode_to_string(this->tuning_profile.journal_mode.value());
+        auto statement = this->new_statement("PRAGMA journal_mode = "s + journal_mode);
+        // SQLite returns the resulting journal mode, e.g. in-memory databases can not use a write-ahead log
+        if (statement->step() != SQLITE_ROW) {
+            EVLOG_warning << "Could not set journal_mode of database " << this->database_file_path << ": "
+                          << this->get_error_message();
+        } else if (statement->column_text(0) != journal_mode) {
+            EVLOG_info << "Database " << this->database_file_path << " uses journal_mode "
+                       << statement->column_text(0) << " instead of " << journal_mode;
+        }
+    }
+    if (this->tuning_profile.synchronous.has_value()) {
+        this->execute_statement("PRAGMA synchronous = "s +
+                                synchronous_mode_to_string(this->tuning_profile.synchronous.value()));
+    }
+    if (this->tuning_profile.cache_size_kib.has_value()) {
+        // Negative values are interpreted as KiB instead of pages
+        this->execute_statement("PRAGMA cache_size = "s + std::to_string(-this->tuning_profile.cache_size_kib.value()));
+    }
+    if (this->tuning_profile.mmap_size.has_value()) {
+        this->execute_statement("PRAGMA mmap_size = "s + std::to_string(this->tuning_profile.mmap_size.value()));
+    }
+}
+
+void DatabaseConnection::open_read_connections() {
+    // Readers only run next to the writer with a write-ahead log. In-memory databases can not use it and would be a
+    // different database for every connection
+    {
+        auto statement = this->new_statement("PRAGMA journal_mode = wal");
+        if (statement->step() != SQLITE_ROW or statement->column_text(0) != "wal") {
+            EVLOG_info << "Database " << this->database_file_path
+                       << " can not use a write-ahead log, all statements use a single connection";
+            return;
+        }
+    }
+
+    std::lock_guard lock(this->read_connections_mutex);
+    for (std::size_t i = 0; i < this->tuning_profile.read_connections; i++) {
+        sqlite3* read_db = nullptr;
+        if (sqlite3_open_v2(this->database_file_path.c_str(), &read_db, SQLITE_OPEN_READONLY | SQLITE_OPEN_URI,
+                            nullptr) != SQLITE_OK) {
+            EVLOG_warning << "Error opening read connection to database at " << this->database_file_path << ": "
+                          << sqlite3_errmsg(read_db);
+            sqlite3_close_v2(read_db);
+            break;
+        }
+        if (this->tuning_profile.cache_size_kib.has_value()) {
+            execute(read_db, "PRAGMA cache_size = "s + std::to_string(-this->tuning_profile.cache_size_kib.value()));
+        }
+        if (this->tuning_profile.mmap_size.has_value()) {
+            execute(read_db, "PRAGMA mmap_size = "s + std::to_string(this->tuning_profile.mmap_size.value()));
+        }
+        this->read_connections.push_back(
+            {read_db, std::make_shared<PreparedStatementCache>(this->statement_cache->get_capacity())});
+    }
+    EVLOG_debug << "Opened " << this->read_connections.size() << " read connections to database "
+                << this->database_file_path;
+}
+
+void DatabaseConnection::close_read_connections() {
+    // Waits for statements that are being prepared on a read connection, later ones use the writing connection
+    std::lock_guard lock(this->read_connections_mutex);
+    for (auto& read_connection : this->read_connections) {
+        read_connection.statement_cache->clear();
+        sqlite3_stmt* stmt = nullptr;
+        while ((stmt = sqlite3_next_stmt(read_connection.db, stmt)) != nullptr) {
+            sqlite3_finalize(stmt);
+        }
+        if (sqlite3_close_v2(read_connection.db) != SQLITE_OK) {
+            EVLOG_error << "Error closing read connection to database file " << this->database_file_path << ": "
+                        << sqlite3_errmsg(read_connection.db);
+        }
+    }
+    this->read_connections.clear();
+    this->next_read_connection = 0;
+}
+
 bool DatabaseConnection::close_connection() {
     return this->close_connection_internal(false);
 }
@@ -93,6 +380,9 @@ bool DatabaseConnection::close_connection_internal(bool force_close) {
         return true;
     }
 
+    this->close_read_connections();
+    this->statement_cache->clear();
+
     // forcefully finalize all statements before calling sqlite3_close
     sqlite3_stmt* stmt = nullptr;
     while ((stmt = sqlite3_next_stmt(db, stmt)) != nullptr) {
@@ -109,13 +399,7 @@ bool DatabaseConnection::close_connection_internal(bool force_close) {
 }
 
 bool DatabaseConnection::execute_statement(const std::string& statement) {
-    char* err_msg = nullptr;
-    if (sqlite3_exec(this->db, statement.c_str(), NULL, NULL, &err_msg) != SQLITE_OK) {
-        EVLOG_error << "Could not execute statement \"" << statement << "\": " << err_msg;
-        sqlite3_free(err_msg);
-        return false;
-    }
-    return true;
+    return execute(this->db, statement);
 }
 
 const char* DatabaseConnection::get_error_message() {
@@ -123,11 +407,30 @@ const char* DatabaseConnection::get_error_message() {
 }
 
 std::unique_ptr<DatabaseTransactionInterface> DatabaseConnection::begin_transaction() {
-    return std::make_unique<DatabaseTransaction>(*this, std::unique_lock(this->transaction_mutex));
+    return std::make_unique<DatabaseTransaction>(*this, std::unique_lock(this->transaction_mutex),
+                                                 this->transaction_owner);
+}
+
+bool DatabaseConnection::is_transaction_owner() const {
+    return this->transaction_owner == std::this_thread::get_id();
 }
 
 std::unique_ptr<SQLiteStatementInterface> DatabaseConnection::new_statement(const std::string& sql) {
-    return std::make_unique<SQLiteStatement>(this->db, sql);
+    // The thread of a running transaction has to see its own changes, which are only visible on the writing connection
+    if (!this->is_transaction_owner() and is_query(sql)) {
+        // Held while preparing, so that the read connection is not closed meanwhile
+        std::lock_guard lock(this->read_connections_mutex);
+        if (!this->read_connections.empty()) {
+            const auto& read_connection =
+                this->read_connections.at(this->next_read_connection++ % this->read_connections.size());
+            auto stmt = prepare_statement(read_connection.db, read_connection.statement_cache, sql, true);
+            if (stmt != nullptr) {
+                return stmt;
+            }
+        }
+    }
+
+    return prepare_statement(this->db, this->statement_cache, sql, false);
 }
 
 bool DatabaseConnection::clear_table(const std::string& table) {
@@ -155,4 +458,8 @@ void DatabaseConnection::set_user_version(uint32_t version) {
     }
 }
 
+void DatabaseConnection::set_tuning_profile(const DatabaseTuningProfile& profile) {
+    this->tuning_profile = profile;
+}
+
 } // namespace ocpp::common
@@ -3,11 +3,33 @@
 
 #include <ocpp/common/database/database_handler_common.hpp>
 
+#include <algorithm>
+
 #include <everest/logging.hpp>
 #include <ocpp/common/database/database_schema_updater.hpp>
 
 namespace ocpp::common {
 
+namespace {
+std::string get_message_queue_table_name(const QueueType queue_type) {
+    return queue_type == QueueType::Normal ? "NORMAL_QUEUE" : "TRANSACTION_QUEUE";
+}
+
+std::vector<std::uint8_t> encode_message(const json& message, const MessageQueuePersistenceFormat format) {
+    if (format == MessageQueuePersistenceFormat::MessagePack) {
+        return json::to_msgpack(message);
+    }
+    return json::to_cbor(message);
+}
+
+json decode_message(const std::vector<std::uint8_t>& message, const MessageQueuePersistenceFormat format) {
+    if (format == MessageQueuePersistenceFormat::MessagePack) {
+        return json::from_msgpack(message);
+    }
+    return json::from_cbor(message);
+}
+} // namespace
+
 DatabaseHandlerCommon::DatabaseHandlerCommon(std::unique_ptr<DatabaseConnectionInterface> database,
                                              const fs::path& sql_migration_files_path,
                                              uint32_t target_schema_version) noexcept :
@@ -16,6 +38,21 @@ DatabaseHandlerCommon::DatabaseHandlerCommon(std::unique_ptr<DatabaseConnectionI
     target_schema_version(target_schema_version) {
 }
 
+DatabaseHandlerCommon::~DatabaseHandlerCommon() {
+    this->stop_database_worker();
+    std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+    if (this->pending_message_queue_operation_count > 0) {
+        EVLOG_error << "Discarding " << this->pending_message_queue_operation_count
+                    << " buffered message queue operations, the database handler was not closed";
+    }
+}
+
+void DatabaseHandlerCommon::close() {
+    this->stop_database_worker();
+    this->flush_message_queue();
+    this->write_tls_sessions();
+}
+
 void DatabaseHandlerCommon::open_connection() {
     DatabaseSchemaUpdater updater{this->database.get()};
 
@@ -28,38 +65,223 @@ void DatabaseHandlerCommon::open_connection() {
     }
 
     this->init_sql();
+    this->start_database_worker();
 }
 
 void DatabaseHandlerCommon::close_connection() {
+    // the worker must not write to the connection after it was closed
+    this->stop_database_worker();
+    this->write_message_queue_operations();
+    this->write_tls_sessions();
     this->database->close_connection();
 }
 
+void DatabaseHandlerCommon::set_tuning_profile(const DatabaseTuningProfile& profile) {
+    this->database->set_tuning_profile(profile);
+}
+
+void DatabaseHandlerCommon::set_message_queue_write_behind_config(const MessageQueueWriteBehindConfig& config) {
+    {
+        // operations are written immediately until the new configuration is applied
+        std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+        this->message_queue_write_behind_enabled = false;
+    }
+    this->flush_message_queue();
+
+    {
+        std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+        this->message_queue_write_behind_config = config;
+        this->message_queue_write_behind_enabled = config.flush_interval.count() > 0;
+        // the worker waits with the new flush interval from now on
+        this->database_worker_config_changed = true;
+    }
+    this->database_worker_cv.notify_all();
+
+    if (this->message_queue_write_behind_enabled) {
+        this->start_database_worker();
+    }
+}
+
+void DatabaseHandlerCommon::start_database_worker() {
+    std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+    if (this->database_worker_running) {
+        return;
+    }
+    this->database_worker_running = true;
+    this->database_worker_thread = std::thread([this]() { this->database_worker(); });
+}
+
+void DatabaseHandlerCommon::stop_database_worker() {
+    {
+        std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+        this->database_worker_running = false;
+        this->message_queue_write_behind_enabled = false;
+    }
+    this->database_worker_cv.notify_all();
+    if (this->database_worker_thread.joinable()) {
+        this->database_worker_thread.join();
+    }
+}
+
+void DatabaseHandlerCommon::database_worker() {
+    std::unique_lock<std::mutex> lk(this->database_worker_mutex);
+    while (this->database_worker_running) {
+        const auto wakeup = [this]() {
+            return !this->database_worker_running or this->database_worker_wakeup_requested or
+                   this->database_worker_config_changed;
+        };
+        if (this->message_queue_write_behind_enabled) {
+            this->database_worker_cv.wait_for(lk, this->message_queue_write_behind_config.flush_interval, wakeup);
+        } else {
+            this->database_worker_cv.wait(lk, wakeup);
+        }
+        if (this->database_worker_config_changed and !this->database_worker_wakeup_requested) {
+            // nothing has to be written yet, start waiting again with the new configuration
+            this->database_worker_config_changed = false;
+            continue;
+        }
+        this->database_worker_config_changed = false;
+        this->database_worker_wakeup_requested = false;
+        lk.unlock();
+        // failures are collected and reported by get_failed_message_queue_operations
+        this->write_message_queue_operations();
+        this->write_tls_sessions();
+        lk.lock();
+    }
+}
+
+void DatabaseHandlerCommon::buffer_message_queue_operation(PendingMessageQueueOperation&& operation) {
+    std::unique_lock<std::mutex> lk(this->database_worker_mutex);
+    const auto key = get_message_queue_table_name(operation.queue_type) + operation.unique_id;
+
+    if (operation.message.has_value()) {
+        this->pending_message_queue_inserts[key] = this->pending_message_queue_operations.size();
+        this->pending_message_queue_operations.push_back(std::move(operation));
+        this->pending_message_queue_operation_count++;
+    } else {
+        const auto insert = this->pending_message_queue_inserts.find(key);
+        if (insert != this->pending_message_queue_inserts.end()) {
+            // the message never made it to the database, so neither the insert nor the remove has to be written
+            this->pending_message_queue_operations.at(insert->second).cancelled = true;
+            this->pending_message_queue_inserts.erase(insert);
+            this->pending_message_queue_operation_count--;
+            return;
+        }
+        this->pending_message_queue_operations.push_back(std::move(operation));
+        this->pending_message_queue_operation_count++;
+    }
+
+    if (this->pending_message_queue_operation_count >= this->message_queue_write_behind_config.max_pending_operations) {
+        this->database_worker_wakeup_requested = true;
+        lk.unlock();
+        this->database_worker_cv.notify_all();
+    }
+}
+
+void DatabaseHandlerCommon::execute_message_queue_operation(const PendingMessageQueueOperation& operation) {
+    if (operation.message.has_value()) {
+        this->insert_message_queue_message_internal(operation.message.value(), operation.queue_type);
+    } else {
+        this->remove_message_queue_message_internal(operation.unique_id, operation.queue_type);
+    }
+}
+
+bool DatabaseHandlerCommon::flush_message_queue() {
+    return this->write_message_queue_operations();
+}
+
+bool DatabaseHandlerCommon::write_message_queue_operations() {
+    std::lock_guard<std::mutex> flush_lk(this->message_queue_flush_mutex);
+
+    std::vector<PendingMessageQueueOperation> operations;
+    {
+        std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+        operations.swap(this->pending_message_queue_operations);
+        this->pending_message_queue_inserts.clear();
+        this->pending_message_queue_operation_count = 0;
+    }
+
+    operations.erase(std::remove_if(operations.begin(), operations.end(),
+                                    [](const PendingMessageQueueOperation& operation) { return operation.cancelled; }),
+                     operations.end());
+    if (operations.empty()) {
+        return true;
+    }
+
+    try {
+        auto transaction = this->database->begin_transaction();
+        for (const auto& operation : operations) {
+            this->execute_message_queue_operation(operation);
+        }
+        transaction->commit();
+        this->message_queue_write_transactions++;
+        return true;
+    } catch (const std::exception& e) {
+        EVLOG_warning << "Could not write " << operations.size()
+                      << " buffered message queue operations in one transaction: " << e.what()
+                      << ". Writing them one by one";
+    }
+
+    // write the operations individually so that a single failing operation does not discard the whole batch
+    bool all_written = true;
+    for (const auto& operation : operations) {
+        try {
+            this->execute_message_queue_operation(operation);
+            this->message_queue_write_transactions++;
+        } catch (const std::exception& e) {
+            EVLOG_error << "Could not write buffered message queue operation for message " << operation.unique_id
+                        << ": " << e.what();
+            all_written = false;
+            std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+            this->failed_message_queue_operations.push_back(operation.unique_id);
+        }
+    }
+    return all_written;
+}
+
+std::vector<std::string> DatabaseHandlerCommon::get_failed_message_queue_operations() {
+    std::vector<std::string> failed_unique_ids;
+    std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+    failed_unique_ids.swap(this->failed_message_queue_operations);
+    return failed_unique_ids;
+}
+
+void DatabaseHandlerCommon::set_message_queue_persistence_format(const MessageQueuePersistenceFormat format) {
+    this->message_queue_persistence_format = format;
+}
+
+std::size_t DatabaseHandlerCommon::get_message_queue_write_transaction_count() const {
+    return this->message_queue_write_transactions;
+}
+
 std::vector<DBTransactionMessage> DatabaseHandlerCommon::get_message_queue_messages(const QueueType queue_type) {
+    this->flush_message_queue();
+
     std::vector<DBTransactionMessage> messages;
 
-    const std::string table_name = queue_type == QueueType::Normal ? "NORMAL_QUEUE" : "TRANSACTION_QUEUE";
+    const std::string table_name = get_message_queue_table_name(queue_type);
 
-    std::string sql = "SELECT UNIQUE_ID, MESSAGE, MESSAGE_TYPE, MESSAGE_ATTEMPTS, MESSAGE_TIMESTAMP FROM " + table_name;
+    std::string sql = "SELECT UNIQUE_ID, MESSAGE, MESSAGE_TYPE, MESSAGE_ATTEMPTS, MESSAGE_TIMESTAMP, MESSAGE_FORMAT "
+                      "FROM " +
+                      table_name;
 
     auto stmt = this->database->new_statement(sql);
 
     int status;
     while ((status = stmt->step()) == SQLITE_ROW) {
         try {
-            const std::string message = stmt->column_text(1);
-            const std::string unique_id = stmt->column_text(0);
-            const std::string message_type = stmt->column_text(2);
-            const std::string message_timestamp = stmt->column_text(4);
-            const int message_attempts = stmt->column_int(3);
-
-            json json_message = json::parse(message);
+            const auto format = conversions::string_to_message_queue_persistence_format(stmt->column_text(5));
 
             DBTransactionMessage control_message;
-            control_message.message_attempts = message_attempts;
-            control_message.timestamp = ocpp::DateTime(message_timestamp);
-            control_message.message_type = message_type;
-            control_message.unique_id = unique_id;
-            control_message.json_message = json_message;
+            if (format == MessageQueuePersistenceFormat::Json) {
+                control_message.json_message = json::parse(stmt->column_text(1));
+            } else {
+                control_message.json_message = decode_message(stmt->column_blob(1), format);
+            }
+            control_message.message_attempts = stmt->column_int(3);
+            control_message.timestamp = ocpp::DateTime(stmt->column_text(4));
+            control_message.message_type = stmt->column_text(2);
+            control_message.unique_id = stmt->column_text(0);
             messages.push_back(std::move(control_message));
         } catch (const json::exception& e) {
             EVLOG_error << "json parse failed because: "
@@ -80,28 +302,60 @@ std::vector<DBTransactionMessage> DatabaseHandlerCommon::get_message_queue_messa
 
 void DatabaseHandlerCommon::insert_message_queue_message(const DBTransactionMessage& db_message,
                                                          const QueueType queue_type) {
-    const std::string table_name = queue_type == QueueType::Normal ? "NORMAL_QUEUE" : "TRANSACTION_QUEUE";
+    if (this->message_queue_write_behind_enabled) {
+        this->buffer_message_queue_operation({queue_type, db_message.unique_id, db_message});
+        return;
+    }
+    this->insert_message_queue_message_internal(db_message, queue_type);
+    this->message_queue_write_transactions++;
+}
 
-    const std::string sql = "INSERT INTO " + table_name +
-                            " (UNIQUE_ID, MESSAGE, MESSAGE_TYPE, MESSAGE_ATTEMPTS, MESSAGE_TIMESTAMP) VALUES "
-                            "(@unique_id, @message, @message_type, @message_attempts, @message_timestamp)";
+void DatabaseHandlerCommon::remove_message_queue_message(const std::string& unique_id, const QueueType queue_type) {
+    if (this->message_queue_write_behind_enabled) {
+        this->buffer_message_queue_operation({queue_type, unique_id, std::nullopt});
+        return;
+    }
+    this->remove_message_queue_message_internal(unique_id, queue_type);
+    this->message_queue_write_transactions++;
+}
+
+void DatabaseHandlerCommon::insert_message_queue_message_internal(const DBTransactionMessage& db_message,
+                                                                  const QueueType queue_type) {
+    const std::string table_name = get_message_queue_table_name(queue_type);
+
+    const std::string sql =
+        "INSERT INTO " + table_name +
+        " (UNIQUE_ID, MESSAGE, MESSAGE_TYPE, MESSAGE_ATTEMPTS, MESSAGE_TIMESTAMP, MESSAGE_FORMAT) VALUES "
+        "(@unique_id, @message, @message_type, @message_attempts, @message_timestamp, @message_format)";
 
     auto stmt = this->database->new_statement(sql);
 
-    const std::string message = db_message.json_message.dump();
+    const MessageQueuePersistenceFormat format = this->message_queue_persistence_format;
+    // both buffers have to outlive the statement since they are bound as static
+    std::string text_message;
+    std::vector<std::uint8_t> binary_message;
+    if (format == MessageQueuePersistenceFormat::Json) {
+        text_message = db_message.json_message.dump();
+        stmt->bind_text("@message", text_message);
+    } else {
+        binary_message = encode_message(db_message.json_message, format);
+        stmt->bind_blob("@message", binary_message);
+    }
     stmt->bind_text("@unique_id", db_message.unique_id);
-    stmt->bind_text("@message", message);
     stmt->bind_text("@message_type", db_message.message_type);
     stmt->bind_int("@message_attempts", db_message.message_attempts);
     stmt->bind_text("@message_timestamp", db_message.timestamp.to_rfc3339(), SQLiteString::Transient);
+    stmt->bind_text("@message_format", conversions::message_queue_persistence_format_to_string(format),
+                    SQLiteString::Transient);
 
     if (stmt->step() != SQLITE_DONE) {
         throw QueryExecutionException(this->database->get_error_message());
     }
 }
 
-void DatabaseHandlerCommon::remove_message_queue_message(const std::string& unique_id, const QueueType queue_type) {
-    const std::string table_name = queue_type == QueueType::Normal ? "NORMAL_QUEUE" : "TRANSACTION_QUEUE";
+void DatabaseHandlerCommon::remove_message_queue_message_internal(const std::string& unique_id,
+                                                                  const QueueType queue_type) {
+    const std::string table_name = get_message_queue_table_name(queue_type);
     std::string sql = "DELETE FROM " + table_name + " WHERE UNIQUE_ID = @unique_id";
 
     auto stmt = this->database->new_statement(sql);
@@ -114,11 +368,130 @@ void DatabaseHandlerCommon::remove_message_queue_message(const std::string& uniq
 }
 
 void DatabaseHandlerCommon::clear_message_queue(const QueueType queue_type) {
-    const std::string table_name = queue_type == QueueType::Normal ? "NORMAL_QUEUE" : "TRANSACTION_QUEUE";
+    this->flush_message_queue();
+
+    const std::string table_name = get_message_queue_table_name(queue_type);
     const auto retval = this->database->clear_table(table_name);
     if (retval == false) {
         throw QueryExecutionException(this->database->get_error_message());
     }
 }
 
+void DatabaseHandlerCommon::insert_or_update_tls_session(const std::string& key,
+                                                         const std::vector<std::uint8_t>& session) {
+    auto stmt = this->database->new_statement(
+        "INSERT OR REPLACE INTO TLS_SESSIONS (SESSION_KEY, SESSION) VALUES (@session_key, @session)");
+
+    stmt->bind_text("@session_key", key);
+    stmt->bind_blob("@session", session);
+
+    if (stmt->step() != SQLITE_DONE) {
+        throw QueryExecutionException(this->database->get_error_message());
+    }
+}
+
+void DatabaseHandlerCommon::insert_or_update_tls_session_async(const std::string& key,
+                                                               const std::vector<std::uint8_t>& session) {
+    bool buffered = false;
+    {
+        std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+        if (this->database_worker_running) {
+            // only the latest session per key is of interest, older ones that were not written yet are replaced
+            this->pending_tls_sessions[key] = session;
+            this->database_worker_wakeup_requested = true;
+            buffered = true;
+        }
+    }
+    if (buffered) {
+        this->database_worker_cv.notify_all();
+        return;
+    }
+
+    try {
+        this->insert_or_update_tls_session(key, session);
+    } catch (const QueryExecutionException& e) {
+        EVLOG_warning << "Could not store TLS session: " << e.what();
+    }
+}
+
+void DatabaseHandlerCommon::write_tls_sessions() {
+    std::map<std::string, std::vector<std::uint8_t>> sessions;
+    {
+        std::lock_guard<std::mutex> lk(this->database_worker_mutex);
+        std::swap(sessions, this->pending_tls_sessions);
+    }
+
+    for (const auto& [key, session] : sessions) {
+        try {
+            this->insert_or_update_tls_session(key, session);
+        } catch (const QueryExecutionException& e) {
+            EVLOG_warning << "Could not store TLS session: " << e.what();
+        }
+    }
+}
+
+std::vector<std::pair<std::string, std::vector<std::uint8_t>>> DatabaseHandlerCommon::get_tls_sessions() {
+    std::vector<std::pair<std::string, std::vector<std::uint8_t>>> sessions;
+
+    auto stmt = this->database->new_statement("SELECT SESSION_KEY, SESSION FROM TLS_SESSIONS");
+
+    int status;
+    while ((status = stmt->step()) == SQLITE_ROW) {
+        sessions.emplace_back(stmt->column_text(0), stmt->column_blob(1));
+    }
+
+    if (status != SQLITE_DONE) {
+        throw QueryExecutionException(this->database->get_error_message());
+    }
+
+    return sessions;
+}
+
+void DatabaseHandlerCommon::clear_tls_sessions() {
+    if (!this->database->clear_table("TLS_SESSIONS")) {
+        throw QueryExecutionException(this->database->get_error_message());
+    }
+}
+
+void DatabaseHandlerCommon::insert_or_update_transaction_seq_no_offset(const std::string& transaction_id,
+                                                                       const int32_t offset) {
+    auto stmt = this->database->new_statement("INSERT OR REPLACE INTO TRANSACTION_SEQ_NO_OFFSETS (TRANSACTION_ID, "
+                                              "SEQ_NO_OFFSET) VALUES (@transaction_id, @seq_no_offset)");
+
+    stmt->bind_text("@transaction_id", transaction_id);
+    stmt->bind_int("@seq_no_offset", offset);
+
+    if (stmt->step() != SQLITE_DONE) {
+        throw QueryExecutionException(this->database->get_error_message());
+    }
+}
+
+std::map<std::string, int32_t> DatabaseHandlerCommon::get_transaction_seq_no_offsets() {
+    std::map<std::string, int32_t> offsets;
+
+    auto stmt = this->database->new_statement("SELECT TRANSACTION_ID, SEQ_NO_OFFSET FROM TRANSACTION_SEQ_NO_OFFSETS");
+
+    int status;
+    while ((status = stmt->step()) == SQLITE_ROW) {
+        offsets.emplace(stmt->column_text(0), stmt->column_int(1));
+    }
+
+    if (status != SQLITE_DONE) {
+        throw QueryExecutionException(this->database->get_error_message());
+    }
+
+    return offsets;
+}
+
+void DatabaseHandlerCommon::remove_transaction_seq_no_offset(const std::string& transaction_id) {
+    auto stmt =
+        this->database->new_statement("DELETE FROM TRANSACTION_SEQ_NO_OFFSETS WHERE TRANSACTION_ID = @transaction_id");
+
+    stmt->bind_text("@transaction_id", transaction_id);
+
+    if (stmt->step() != SQLITE_DONE) {
+        throw QueryExecutionException(this->database->get_error_message());
+    }
+}
+
 } // namespace ocpp::common
@@ -15,8 +15,14 @@ SQLiteStatement::SQLiteStatement(sqlite3* db, const std::string& query) : db(db)
     }
 }
 
+SQLiteStatement::SQLiteStatement(sqlite3* db, sqlite3_stmt* stmt, ReleaseCallback release_callback) :
+    stmt(stmt), db(db), release_callback(std::move(release_callback)) {
+}
+
 SQLiteStatement::~SQLiteStatement() {
-    if (this->stmt != nullptr) {
+    if (this->stmt != nullptr and this->release_callback != nullptr) {
+        this->release_callback(this->stmt);
+    } else if (this->stmt != nullptr) {
         if (sqlite3_finalize(this->stmt) != SQLITE_OK) {
             EVLOG_error << "Error finalizing statement: " << sqlite3_errmsg(this->db);
         }
@@ -99,6 +105,20 @@ int SQLiteStatement::bind_null(const std::string& param) {
     return bind_null(index);
 }
 
+int SQLiteStatement::bind_blob(const int idx, const std::vector<std::uint8_t>& val, SQLiteString lifetime) {
+    return sqlite3_bind_blob(this->stmt, idx, val.data(), val.size(),
+                             lifetime == SQLiteString::Static ? SQLITE_STATIC : SQLITE_TRANSIENT);
+}
+
+int SQLiteStatement::bind_blob(const std::string& param, const std::vector<std::uint8_t>& val,
+                               SQLiteString lifetime) {
+    int index = sqlite3_bind_parameter_index(this->stmt, param.c_str());
+    if (index <= 0) {
+        throw std::out_of_range("Parameter not found in SQL query");
+    }
+    return bind_blob(index, val, lifetime);
+}
+
 int SQLiteStatement::get_number_of_rows() {
     return sqlite3_data_count(this->stmt);
 }
@@ -133,4 +153,14 @@ double SQLiteStatement::column_double(const int idx) {
     return sqlite3_column_double(this->stmt, idx);
 }
 
+std::vector<std::uint8_t> SQLiteStatement::column_blob(const int idx) {
+    const auto* data = static_cast<const std::uint8_t*>(sqlite3_column_blob(this->stmt, idx));
+    // sqlite3_column_bytes has to be called after sqlite3_column_blob
+    const auto size = sqlite3_column_bytes(this->stmt, idx);
+    if (data == nullptr) {
+        return {};
+    }
+    return std::vector<std::uint8_t>(data, data + size);
+}
+
 } // namespace ocpp::common
@@ -0,0 +1,476 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <ocpp/common/incremental_json_parser.hpp>
+
+#include <charconv>
+#include <system_error>
+
+namespace ocpp {
+
+namespace {
+
+bool is_whitespace(char c) {
+    return c == ' ' or c == '\t' or c == '\n' or c == '\r';
+}
+
+bool is_digit(char c) {
+    return c >= '0' and c <= '9';
+}
+
+/// \returns the value of the hex digit \p c or -1 if it is not a hex digit
+int hex_value(char c) {
+    if (c >= '0' and c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' and c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' and c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/// \brief Checks the number grammar of RFC 8259: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+bool is_valid_number(const std::string& number, bool& is_integer) {
+    std::size_t i = 0;
+    const auto digits = [&]() {
+        const auto start = i;
+        while (i < number.size() and is_digit(number[i])) {
+            i++;
+        }
+        return i - start;
+    };
+
+    is_integer = true;
+    if (i < number.size() and number[i] == '-') {
+        i++;
+    }
+    if (i < number.size() and number[i] == '0') {
+        i++;
+    } else if (digits() == 0) {
+        return false;
+    }
+    if (i < number.size() and number[i] == '.') {
+        is_integer = false;
+        i++;
+        if (digits() == 0) {
+            return false;
+        }
+    }
+    if (i < number.size() and (number[i] == 'e' or number[i] == 'E')) {
+        is_integer = false;
+        i++;
+        if (i < number.size() and (number[i] == '+' or number[i] == '-')) {
+            i++;
+        }
+        if (digits() == 0) {
+            return false;
+        }
+    }
+    return i == number.size();
+}
+
+/// \brief Checks that \p str is well-formed UTF-8, i.e. that it can be serialized again
+bool is_valid_utf8(const std::string& str) {
+    std::size_t i = 0;
+    while (i < str.size()) {
+        const auto byte = static_cast<unsigned char>(str[i]);
+        std::size_t continuation_bytes = 0;
+        std::uint32_t code_point = 0;
+        if (byte < 0x80) {
+            i++;
+            continue;
+        } else if ((byte & 0xE0) == 0xC0) {
+            continuation_bytes = 1;
+            code_point = byte & 0x1F;
+        } else if ((byte & 0xF0) == 0xE0) {
+            continuation_bytes = 2;
+            code_point = byte & 0x0F;
+        } else if ((byte & 0xF8) == 0xF0) {
+            continuation_bytes = 3;
+            code_point = byte & 0x07;
+        } else {
+            return false;
+        }
+        if (i + continuation_bytes >= str.size()) {
+            return false;
+        }
+        for (std::size_t j = 1; j <= continuation_bytes; j++) {
+            const auto continuation = static_cast<unsigned char>(str[i + j]);
+            if ((continuation & 0xC0) != 0x80) {
+                return false;
+            }
+            code_point = (code_point << 6) | (continuation & 0x3F);
+        }
+        // reject overlong encodings, surrogates and code points beyond U+10FFFF
+        if ((continuation_bytes == 1 and code_point < 0x80) or (continuation_bytes == 2 and code_point < 0x800) or
+            (continuation_bytes == 3 and code_point < 0x10000) or (code_point >= 0xD800 and code_point <= 0xDFFF) or
+            code_point > 0x10FFFF) {
+            return false;
+        }
+        i += continuation_bytes + 1;
+    }
+    return true;
+}
+
+} // namespace
+
+IncrementalJsonParser::IncrementalJsonParser() {
+    this->reset();
+}
+
+void IncrementalJsonParser::feed(std::string_view fragment) {
+    std::size_t i = 0;
+    while (i < fragment.size()) {
+        if (this->state == State::String and this->high_surrogate == 0) {
+            // copy plain string content in one go, this is where most of the bytes of a message end up
+            auto end = i;
+            while (end < fragment.size() and fragment[end] != '"' and fragment[end] != '\\' and
+                   static_cast<unsigned char>(fragment[end]) >= 0x20) {
+                end++;
+            }
+            this->token.append(fragment.data() + i, end - i);
+            this->parsed_bytes += end - i;
+            i = end;
+            if (i == fragment.size()) {
+                break;
+            }
+        }
+
+        if (this->process(fragment[i])) {
+            this->parsed_bytes++;
+            i++;
+        }
+    }
+}
+
+json IncrementalJsonParser::finish() {
+    if (this->state == State::Number and this->containers.empty()) {
+        this->finish_number();
+    }
+    if (this->state != State::Done) {
+        this->fail("unexpected end of input");
+    }
+    json result = std::move(this->document);
+    this->reset();
+    return result;
+}
+
+void IncrementalJsonParser::reset() {
+    this->state = State::Value;
+    this->string_is_key = false;
+    this->token.clear();
+    this->unicode_code_point = 0;
+    this->unicode_digits = 0;
+    this->high_surrogate = 0;
+    this->parsed_bytes = 0;
+    this->document = json();
+    this->containers.clear();
+    this->key.clear();
+}
+
+std::size_t IncrementalJsonParser::get_parsed_bytes() const {
+    return this->parsed_bytes;
+}
+
+bool IncrementalJsonParser::process(char c) {
+    switch (this->state) {
+    case State::Value:
+    case State::ValueOrEnd:
+        if (is_whitespace(c)) {
+            return true;
+        }
+        if (this->state == State::ValueOrEnd and c == ']') {
+            this->end_container(c);
+        } else {
+            this->begin_value(c);
+        }
+        return true;
+
+    case State::KeyOrEnd:
+    case State::Key:
+        if (is_whitespace(c)) {
+            return true;
+        }
+        if (this->state == State::KeyOrEnd and c == '}') {
+            this->end_container(c);
+        } else if (c == '"') {
+            this->string_is_key = true;
+            this->token.clear();
+            this->state = State::String;
+        } else {
+            this->fail("expected object key");
+        }
+        return true;
+
+    case State::Colon:
+        if (is_whitespace(c)) {
+            return true;
+        }
+        if (c != ':') {
+            this->fail("expected ':'");
+        }
+        this->state = State::Value;
+        return true;
+
+    case State::AfterValue:
+        if (is_whitespace(c)) {
+            return true;
+        }
+        if (c == ',') {
+            this->state = this->containers.back()->is_object() ? State::Key : State::Value;
+        } else if (c == ']' or c == '}') {
+            this->end_container(c);
+        } else {
+            this->fail("expected ',' or end of container");
+        }
+        return true;
+
+    case State::String:
+        if (this->high_surrogate != 0 and c != '\\') {
+            this->fail("expected low surrogate");
+        }
+        if (c == '"') {
+            this->finish_string();
+        } else if (c == '\\') {
+            this->state = State::StringEscape;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            this->fail("control character in string");
+        } else {
+            this->token.push_back(c);
+        }
+        return true;
+
+    case State::StringEscape:
+        if (this->high_surrogate != 0 and c != 'u') {
+            this->fail("expected low surrogate");
+        }
+        this->state = State::String;
+        switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+            this->token.push_back(c);
+            break;
+        case 'b':
+            this->token.push_back('\b');
+            break;
+        case 'f':
+            this->token.push_back('\f');
+            break;
+        case 'n':
+            this->token.push_back('\n');
+            break;
+        case 'r':
+            this->token.push_back('\r');
+            break;
+        case 't':
+            this->token.push_back('\t');
+            break;
+        case 'u':
+            this->unicode_code_point = 0;
+            this->unicode_digits = 0;
+            this->state = State::StringUnicode;
+            break;
+        default:
+            this->fail("invalid escape sequence");
+        }
+        return true;
+
+    case State::StringUnicode: {
+        const auto value = hex_value(c);
+        if (value < 0) {
+            this->fail("invalid \\u escape sequence");
+        }
+        this->unicode_code_point = (this->unicode_code_point << 4) | static_cast<std::uint32_t>(value);
+        if (++this->unicode_digits < 4) {
+            return true;
+        }
+        this->state = State::String;
+        const auto code_point = this->unicode_code_point;
+        if (this->high_surrogate != 0) {
+            if (code_point < 0xDC00 or code_point > 0xDFFF) {
+                this->fail("expected low surrogate");
+            }
+            this->append_code_point(0x10000 + ((this->high_surrogate - 0xD800) << 10) + (code_point - 0xDC00));
+            this->high_surrogate = 0;
+        } else if (code_point >= 0xD800 and code_point <= 0xDBFF) {
+            this->high_surrogate = code_point;
+        } else if (code_point >= 0xDC00 and code_point <= 0xDFFF) {
+            this->fail("unexpected low surrogate");
+        } else {
+            this->append_code_point(code_point);
+        }
+        return true;
+    }
+
+    case State::Number:
+        if (is_digit(c) or c == '-' or c == '+' or c == '.' or c == 'e' or c == 'E') {
+            this->token.push_back(c);
+            return true;
+        }
+        // the character following the number is processed in the state after the number
+        this->finish_number();
+        return false;
+
+    case State::Literal:
+        this->token.push_back(c);
+        this->finish_literal();
+        return true;
+
+    case State::Done:
+        if (!is_whitespace(c)) {
+            this->fail("unexpected data after the end of the document");
+        }
+        return true;
+    }
+    return true;
+}
+
+void IncrementalJsonParser::begin_value(char c) {
+    if (c == '{') {
+        this->containers.push_back(&this->add_value(json::object()));
+        this->state = State::KeyOrEnd;
+    } else if (c == '[') {
+        this->containers.push_back(&this->add_value(json::array()));
+        this->state = State::ValueOrEnd;
+    } else if (c == '"') {
+        this->string_is_key = false;
+        this->token.clear();
+        this->state = State::String;
+    } else if (c == '-' or is_digit(c)) {
+        this->token.assign(1, c);
+        this->state = State::Number;
+    } else if (c == 't' or c == 'f' or c == 'n') {
+        this->token.assign(1, c);
+        this->state = State::Literal;
+    } else {
+        this->fail("expected value");
+    }
+}
+
+json& IncrementalJsonParser::add_value(json&& value) {
+    if (this->containers.empty()) {
+        this->document = std::move(value);
+        this->state = State::Done;
+        return this->document;
+    }
+
+    this->state = State::AfterValue;
+    auto& container = *this->containers.back();
+    if (container.is_array()) {
+        container.push_back(std::move(value));
+        return container.back();
+    }
+    // duplicate keys: the last value wins like in json::parse
+    auto& member = container[this->key];
+    member = std::move(value);
+    return member;
+}
+
+void IncrementalJsonParser::end_container(char c) {
+    const auto& container = *this->containers.back();
+    if ((c == ']' and !container.is_array()) or (c == '}' and !container.is_object())) {
+        this->fail("mismatched end of container");
+    }
+    this->containers.pop_back();
+    this->state = this->containers.empty() ? State::Done : State::AfterValue;
+}
+
+void IncrementalJsonParser::finish_string() {
+    if (!is_valid_utf8(this->token)) {
+        this->fail("invalid UTF-8 in string");
+    }
+    if (this->string_is_key) {
+        this->key = std::move(this->token);
+        this->token.clear();
+        this->state = State::Colon;
+    } else {
+        this->add_value(json(std::move(this->token)));
+        this->token.clear();
+    }
+}
+
+void IncrementalJsonParser::finish_number() {
+    bool is_integer = true;
+    if (!is_valid_number(this->token, is_integer)) {
+        this->fail("invalid number");
+    }
+
+    // std::from_chars does not depend on the locale, unlike strtod which expects the decimal point of LC_NUMERIC
+    const auto begin = this->token.data();
+    const auto end = this->token.data() + this->token.size();
+
+    // integers that do not fit into 64 bits are stored as floating point numbers like json::parse does
+    if (is_integer) {
+        if (this->token.front() == '-') {
+            json::number_integer_t value = 0;
+            if (std::from_chars(begin, end, value).ec == std::errc()) {
+                this->add_value(json(value));
+                return;
+            }
+        } else {
+            json::number_unsigned_t value = 0;
+            if (std::from_chars(begin, end, value).ec == std::errc()) {
+                this->add_value(json(value));
+                return;
+            }
+        }
+    }
+
+    json::number_float_t value = 0;
+    if (std::from_chars(begin, end, value).ec == std::errc()) {
+        this->add_value(json(value));
+        return;
+    }
+    // numbers that underflow a double are rounded like json::parse does, numbers that overflow are rejected by it
+    try {
+        this->add_value(json::parse(this->token));
+    } catch (const json::exception&) {
+        this->fail("number out of range");
+    }
+}
+
+void IncrementalJsonParser::finish_literal() {
+    static const std::string true_literal = "true";
+    static const std::string false_literal = "false";
+    static const std::string null_literal = "null";
+
+    if (this->token == true_literal) {
+        this->add_value(json(true));
+    } else if (this->token == false_literal) {
+        this->add_value(json(false));
+    } else if (this->token == null_literal) {
+        this->add_value(json(nullptr));
+    } else if (true_literal.compare(0, this->token.size(), this->token) != 0 and
+               false_literal.compare(0, this->token.size(), this->token) != 0 and
+               null_literal.compare(0, this->token.size(), this->token) != 0) {
+        this->fail("invalid literal");
+    }
+}
+
+void IncrementalJsonParser::append_code_point(std::uint32_t code_point) {
+    if (code_point < 0x80) {
+        this->token.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        this->token.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        this->token.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        this->token.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        this->token.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        this->token.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        this->token.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        this->token.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        this->token.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        this->token.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+void IncrementalJsonParser::fail(const std::string& reason) const {
+    throw JsonParseException("JSON parse error at byte " + std::to_string(this->parsed_bytes) + ": " + reason);
+}
+
+} // namespace ocpp
@@ -273,9 +273,9 @@ MessageLogging::~MessageLogging() {
     }
 }
 
-void MessageLogging::charge_point(const std::string& message_type, const std::string& json_str) {
+void MessageLogging::charge_point(const std::string& message_type, std::string_view json_str) {
     if (this->message_callback != nullptr) {
-        this->message_callback(json_str, MessageDirection::ChargingStationToCSMS);
+        this->message_callback(std::string(json_str), MessageDirection::ChargingStationToCSMS);
     }
     auto formatted = format_message(message_type, json_str);
     log_output(0, formatted.message_type, formatted.message);
@@ -301,6 +301,13 @@ void MessageLogging::central_system(const std::string& message_type, const std::
     }
 }
 
+void MessageLogging::central_system(const std::string& message_type, const json& message) {
+    if (!this->log_messages and !this->session_logging and this->message_callback == nullptr) {
+        return;
+    }
+    this->central_system(message_type, message.dump());
+}
+
 void MessageLogging::sys(const std::string& msg) {
     log_output(2, msg, "");
     if (this->session_logging) {
@@ -383,9 +390,9 @@ std::string MessageLogging::html_encode(const std::string& msg) {
     return out;
 }
 
-FormattedMessageWithType MessageLogging::format_message(const std::string& message_type, const std::string& json_str) {
+FormattedMessageWithType MessageLogging::format_message(const std::string& message_type, std::string_view json_str) {
     auto extracted_message_type = message_type;
-    auto formatted_message = json_str;
+    auto formatted_message = std::string(json_str);
 
     try {
         auto json_object = json::parse(json_str);
@@ -1233,6 +1233,33 @@ std::string generate_certificate_signing_request_status_to_string(const GetCerti
 }
 } // namespace conversions
 
+namespace conversions {
+std::string message_queue_persistence_format_to_string(MessageQueuePersistenceFormat e) {
+    switch (e) {
+    case MessageQueuePersistenceFormat::Json:
+        return "JSON";
+    case MessageQueuePersistenceFormat::Cbor:
+        return "CBOR";
+    case MessageQueuePersistenceFormat::MessagePack:
+        return "MessagePack";
+    }
+    throw EnumToStringException{e, "MessageQueuePersistenceFormat"};
+}
+
+MessageQueuePersistenceFormat string_to_message_queue_persistence_format(const std::string& s) {
+    if (s == "JSON") {
+        return MessageQueuePersistenceFormat::Json;
+    }
+    if (s == "CBOR") {
+        return MessageQueuePersistenceFormat::Cbor;
+    }
+    if (s == "MessagePack") {
+        return MessageQueuePersistenceFormat::MessagePack;
+    }
+    throw StringToEnumException{s, "MessageQueuePersistenceFormat"};
+}
+} // namespace conversions
+
 namespace conversions {
 v16::FirmwareStatus firmware_status_notification_to_firmware_status(const FirmwareStatusNotification status) {
     switch (status) {
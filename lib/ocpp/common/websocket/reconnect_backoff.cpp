@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <ocpp/common/websocket/reconnect_backoff.hpp>
+
+#include <algorithm>
+
+namespace ocpp {
+
+namespace {
+
+std::mt19937 create_generator(const std::string& seed) {
+    if (seed.empty()) {
+        std::random_device rd;
+        return std::mt19937(rd());
+    }
+
+    std::seed_seq seed_sequence(seed.begin(), seed.end());
+    return std::mt19937(seed_sequence);
+}
+
+} // namespace
+
+ReconnectBackoff::ReconnectBackoff(const ReconnectBackoffOptions& options, const std::string& seed) :
+    options(options),
+    generator(create_generator(seed)),
+    spread_offset(0),
+    previous_delay(0),
+    attempts(0) {
+    this->options.wait_minimum = std::max(this->options.wait_minimum, std::chrono::milliseconds(0));
+    this->options.random_range = std::max(this->options.random_range, std::chrono::milliseconds(0));
+    this->options.maximum = std::max(this->options.maximum, std::chrono::milliseconds(0));
+    this->options.spread = std::max(this->options.spread, std::chrono::milliseconds(0));
+    // Drawn once, so that the station keeps its place within the window
+    this->spread_offset = this->random_between(std::chrono::milliseconds(0), this->options.spread);
+}
+
+std::chrono::milliseconds ReconnectBackoff::random_between(std::chrono::milliseconds min,
+                                                           std::chrono::milliseconds max) {
+    if (max <= min) {
+        return min;
+    }
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> distribution(min.count(), max.count());
+    return std::chrono::milliseconds(distribution(this->generator));
+}
+
+std::chrono::milliseconds ReconnectBackoff::next_delay() {
+    this->attempts += 1;
+
+    const auto random_part = [this]() {
+        return this->random_between(std::chrono::milliseconds(0), this->options.random_range);
+    };
+
+    std::chrono::milliseconds delay;
+    if (this->attempts == 1) {
+        delay = this->options.wait_minimum + random_part();
+    } else if (this->options.decorrelated_jitter) {
+        // A minimum of 0 would keep the range at 0, so the range grows from at least one second. The range instead of
+        // the delay is capped, so that the delays of stations that reached the cap do not fall together
+        auto upper = std::max(this->previous_delay, std::chrono::milliseconds(std::chrono::seconds(1))) * 3;
+        if (this->options.maximum.count() > 0) {
+            upper = std::min(upper, this->options.maximum);
+        }
+        delay = this->random_between(this->options.wait_minimum, upper);
+    } else if (this->attempts > this->options.repeat_times + 1) {
+        delay = this->previous_delay;
+    } else {
+        delay = this->previous_delay * 2 + random_part();
+    }
+
+    if (this->options.maximum.count() > 0) {
+        delay = std::min(delay, this->options.maximum);
+    }
+
+    // With decorrelated jitter the range keeps growing up to the maximum
+    if (this->options.decorrelated_jitter or this->attempts <= this->options.repeat_times + 1) {
+        this->previous_delay = delay;
+    }
+
+    if (this->attempts == 1) {
+        delay += this->spread_offset;
+    }
+
+    return delay;
+}
+
+void ReconnectBackoff::reset() {
+    this->attempts = 0;
+    this->previous_delay = std::chrono::milliseconds(0);
+}
+
+std::chrono::milliseconds ReconnectBackoff::get_spread_offset() const {
+    return this->spread_offset;
+}
+
+} // namespace ocpp
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <ocpp/common/websocket/tls_session_cache.hpp>
+
+#include <ctime>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <openssl/ssl.h>
+
+namespace ocpp {
+
+namespace {
+
+/// \brief The cache and the context an SSL_CTX has been attached with, stored in the ex_data of the SSL_CTX
+struct Attachment {
+    std::shared_ptr<TlsSessionCache> cache;
+    std::string context;
+};
+
+void free_attachment(void* /*parent*/, void* ptr, CRYPTO_EX_DATA* /*ad*/, int /*idx*/, long /*argl*/,
+                     void* /*argp*/) {
+    delete static_cast<Attachment*>(ptr);
+}
+
+int get_attachment_index() {
+    static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, free_attachment);
+    return index;
+}
+
+Attachment* get_attachment(const SSL* ssl) {
+    return static_cast<Attachment*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), get_attachment_index()));
+}
+
+/// \returns the server \p ssl connects to: the SNI host name or, if none is set, the peer address, and the peer port.
+/// Empty if the server can not be determined
+std::string get_server(const SSL* ssl) {
+    std::string host;
+    if (const char* server_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name); server_name != nullptr) {
+        host = server_name;
+    }
+
+    sockaddr_storage address{};
+    socklen_t address_length = sizeof(address);
+    const int fd = SSL_get_fd(ssl);
+    if (fd < 0 or getpeername(fd, reinterpret_cast<sockaddr*>(&address), &address_length) != 0) {
+        return host;
+    }
+
+    char peer[INET6_ADDRSTRLEN] = "";
+    int port = 0;
+    if (address.ss_family == AF_INET) {
+        const auto* address_in = reinterpret_cast<const sockaddr_in*>(&address);
+        inet_ntop(AF_INET, &address_in->sin_addr, peer, sizeof(peer));
+        port = ntohs(address_in->sin_port);
+    } else if (address.ss_family == AF_INET6) {
+        const auto* address_in6 = reinterpret_cast<const sockaddr_in6*>(&address);
+        inet_ntop(AF_INET6, &address_in6->sin6_addr, peer, sizeof(peer));
+        port = ntohs(address_in6->sin6_port);
+    }
+
+    if (host.empty()) {
+        host = peer;
+    }
+    if (host.empty()) {
+        return host;
+    }
+    return host + ":" + std::to_string(port);
+}
+
+bool is_resumable(const SSL_SESSION* session) {
+    return SSL_SESSION_is_resumable(session) == 1 and
+           SSL_SESSION_get_time(session) + SSL_SESSION_get_timeout(session) > std::time(nullptr);
+}
+
+} // namespace
+
+TlsSessionCache::TlsSessionCache() = default;
+
+TlsSessionCache::~TlsSessionCache() = default;
+
+void TlsSessionCache::attach(SSL_CTX* ssl_ctx, const std::string& context) {
+    // The sessions are only stored in this cache, the internal cache of the SSL_CTX is freed with it
+    SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ssl_ctx, new_session_callback);
+    // The SSL objects are created by libwebsockets, the start of the handshake is the first point at which the session
+    // can be set
+    SSL_CTX_set_info_callback(ssl_ctx, info_callback);
+
+    delete static_cast<Attachment*>(SSL_CTX_get_ex_data(ssl_ctx, get_attachment_index()));
+    auto* attachment = new Attachment{this->shared_from_this(), context};
+    if (SSL_CTX_set_ex_data(ssl_ctx, get_attachment_index(), attachment) != 1) {
+        delete attachment;
+    }
+}
+
+bool TlsSessionCache::restore(const std::string& key, const std::vector<std::uint8_t>& session) {
+    const unsigned char* data = session.data();
+    SSL_SESSION* decoded = d2i_SSL_SESSION(nullptr, &data, static_cast<long>(session.size()));
+    if (decoded == nullptr) {
+        return false;
+    }
+    if (!is_resumable(decoded)) {
+        SSL_SESSION_free(decoded);
+        return false;
+    }
+
+    std::lock_guard lock(this->mutex);
+    this->sessions[key] = std::shared_ptr<SSL_SESSION>(decoded, SSL_SESSION_free);
+    return true;
+}
+
+void TlsSessionCache::register_session_stored_callback(const SessionStoredCallback& callback) {
+    std::lock_guard lock(this->mutex);
+    this->session_stored_callback = callback;
+}
+
+void TlsSessionCache::clear() {
+    std::lock_guard lock(this->mutex);
+    this->sessions.clear();
+}
+
+std::size_t TlsSessionCache::size() {
+    std::lock_guard lock(this->mutex);
+    return this->sessions.size();
+}
+
+void TlsSessionCache::store(const std::string& key, SSL_SESSION* session) {
+    SessionStoredCallback callback;
+    {
+        std::lock_guard lock(this->mutex);
+        this->sessions[key] = std::shared_ptr<SSL_SESSION>(session, SSL_SESSION_free);
+        callback = this->session_stored_callback;
+    }
+
+    if (callback == nullptr) {
+        return;
+    }
+
+    const int length = i2d_SSL_SESSION(session, nullptr);
+    if (length <= 0) {
+        return;
+    }
+    std::vector<std::uint8_t> serialized(length);
+    unsigned char* data = serialized.data();
+    i2d_SSL_SESSION(session, &data);
+    callback(key, serialized);
+}
+
+std::shared_ptr<SSL_SESSION> TlsSessionCache::find(const std::string& key) {
+    std::lock_guard lock(this->mutex);
+    const auto it = this->sessions.find(key);
+    if (it == this->sessions.end()) {
+        return nullptr;
+    }
+
+    const auto session = it->second;
+    const bool resumable = is_resumable(session.get());
+    // TLS 1.3 tickets should only be used once (RFC 8446 C.4), the server sends new ones after the handshake
+    if (!resumable or SSL_SESSION_get_protocol_version(session.get()) >= TLS1_3_VERSION) {
+        this->sessions.erase(it);
+    }
+    return resumable ? session : nullptr;
+}
+
+int TlsSessionCache::new_session_callback(SSL* ssl, SSL_SESSION* session) {
+    auto* attachment = get_attachment(ssl);
+    const auto server = get_server(ssl);
+    if (attachment == nullptr or server.empty()) {
+        return 0;
+    }
+
+    // Returning 1 keeps the reference to the session
+    attachment->cache->store(attachment->context + ";" + server, session);
+    return 1;
+}
+
+void TlsSessionCache::info_callback(const SSL* ssl, int where, int /*ret*/) {
+    if ((where & SSL_CB_HANDSHAKE_START) == 0 or SSL_get0_session(ssl) != nullptr) {
+        return;
+    }
+
+    auto* attachment = get_attachment(ssl);
+    const auto server = get_server(ssl);
+    if (attachment == nullptr or server.empty()) {
+        return;
+    }
+
+    if (const auto session = attachment->cache->find(attachment->context + ";" + server); session != nullptr) {
+        SSL_set_session(const_cast<SSL*>(ssl), session.get());
+    }
+}
+
+} // namespace ocpp
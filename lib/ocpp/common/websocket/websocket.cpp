@@ -76,6 +76,11 @@ void Websocket::register_message_callback(const std::function<void(const std::st
     this->websocket->register_message_callback([this](const std::string& message) { this->message_callback(message); });
 }
 
+void Websocket::register_parsed_message_callback(
+    const std::function<void(json&& message, std::size_t message_size)>& callback) {
+    this->websocket->register_parsed_message_callback(callback);
+}
+
 void Websocket::register_connection_failed_callback(const std::function<void(ConnectionFailedReason)>& callback) {
     this->websocket->register_connection_failed_callback(callback);
 }
@@ -85,6 +90,13 @@ bool Websocket::send(const std::string& message) {
     return this->websocket->send(message);
 }
 
+bool Websocket::send(const json& message) {
+    auto buffer = this->websocket->create_send_buffer();
+    buffer.assign(message);
+    this->logging->charge_point("Unknown", buffer.payload());
+    return this->websocket->send(std::move(buffer));
+}
+
 void Websocket::set_websocket_ping_interval(int32_t interval_s) {
     this->logging->sys("WebsocketPingInterval changed");
     this->websocket->set_websocket_ping_interval(interval_s);
@@ -94,4 +106,8 @@ void Websocket::set_authorization_key(const std::string& authorization_key) {
     this->websocket->set_authorization_key(authorization_key);
 }
 
+void Websocket::set_event_loop(boost::asio::io_context& io_context) {
+    this->websocket->set_event_loop(io_context);
+}
+
 } // namespace ocpp
@@ -1,22 +1,85 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2020 - 2023 Pionix GmbH and Contributors to EVerest
-#include <random>
+#include <algorithm>
 
 #include <everest/logging.hpp>
+#include <nlohmann/json.hpp>
 #include <ocpp/common/websocket/websocket_base.hpp>
 #include <websocketpp_utils/base64.hpp>
 namespace ocpp {
 
+std::string get_permessage_deflate_offer(const PerMessageDeflateOptions& options) {
+    // window sizes below 2^8 are not allowed by RFC 7692
+    const auto clamp_window_bits = [](int window_bits) { return std::clamp(window_bits, 8, 15); };
+
+    std::string offer = "permessage-deflate";
+    if (options.client_no_context_takeover) {
+        offer += "; client_no_context_takeover";
+    }
+    if (options.server_no_context_takeover) {
+        offer += "; server_no_context_takeover";
+    }
+    offer += "; client_max_window_bits=" + std::to_string(clamp_window_bits(options.client_max_window_bits));
+    offer += "; server_max_window_bits=" + std::to_string(clamp_window_bits(options.server_max_window_bits));
+    return offer;
+}
+
+WebsocketSendBuffer::WebsocketSendBuffer(std::size_t headroom, std::size_t payload_size_hint) :
+    headroom_size(headroom) {
+    this->storage.reserve(headroom + payload_size_hint);
+    this->storage.resize(headroom);
+}
+
+void WebsocketSendBuffer::assign(const json& message) {
+    this->storage.resize(this->headroom_size);
+    // the reserved storage is kept, only the serialized message is a temporary copy
+    this->storage.append(message.dump());
+}
+
+void WebsocketSendBuffer::assign(const std::string& message) {
+    this->storage.resize(this->headroom_size);
+    this->storage.append(message);
+}
+
+std::string_view WebsocketSendBuffer::payload() const {
+    return std::string_view(this->storage).substr(this->headroom_size);
+}
+
+char* WebsocketSendBuffer::payload_data() {
+    return this->storage.data() + this->headroom_size;
+}
+
+std::size_t WebsocketSendBuffer::size() const {
+    return this->storage.size() - this->headroom_size;
+}
+
+std::size_t WebsocketSendBuffer::headroom() const {
+    return this->headroom_size;
+}
+
+WebsocketFragment WebsocketSendBuffer::fragment(std::size_t offset, std::size_t max_fragment_size) {
+    const auto payload_size = this->size();
+    offset = std::min(offset, payload_size);
+
+    auto fragment_size = payload_size - offset;
+    if (max_fragment_size > 0) {
+        fragment_size = std::min(fragment_size, max_fragment_size);
+    }
+
+    return {this->payload_data() + offset, fragment_size, offset == 0, offset + fragment_size == payload_size};
+}
+
 WebsocketBase::WebsocketBase() :
     m_is_connected(false),
     connected_callback(nullptr),
     stopped_connecting_callback(nullptr),
     message_callback(nullptr),
+    parsed_message_callback(nullptr),
     reconnect_timer(nullptr),
     connection_attempts(1),
-    reconnect_backoff_ms(0),
     shutting_down(false),
-    reconnecting(false) {
+    reconnecting(false),
+    send_buffer_size_hint(0) {
 
     set_connection_options_base(connection_options);
 
@@ -34,6 +97,17 @@ WebsocketBase::~WebsocketBase() {
 
 void WebsocketBase::set_connection_options_base(const WebsocketConnectionOptions& connection_options) {
     this->connection_options = connection_options;
+
+    ReconnectBackoffOptions backoff_options;
+    backoff_options.wait_minimum = std::chrono::seconds(connection_options.retry_backoff_wait_minimum_s);
+    backoff_options.random_range = std::chrono::seconds(connection_options.retry_backoff_random_range_s);
+    backoff_options.repeat_times = connection_options.retry_backoff_repeat_times;
+    backoff_options.decorrelated_jitter = connection_options.retry_backoff_decorrelated_jitter;
+    backoff_options.maximum = std::chrono::seconds(connection_options.retry_backoff_maximum_s);
+    backoff_options.spread = std::chrono::seconds(connection_options.retry_backoff_spread_s);
+
+    std::lock_guard<std::mutex> lk(this->reconnect_backoff_mutex);
+    this->reconnect_backoff = ReconnectBackoff(backoff_options, this->connection_options.csms_uri.get_chargepoint_id());
 }
 
 void WebsocketBase::register_connected_callback(const std::function<void(OcppProtocolVersion protocol)>& callback) {
@@ -53,6 +127,16 @@ void WebsocketBase::register_message_callback(const std::function<void(const std
     this->message_callback = callback;
 }
 
+void WebsocketBase::register_parsed_message_callback(
+    const std::function<void(json&& message, std::size_t message_size)>& callback) {
+    this->parsed_message_callback = callback;
+}
+
+void WebsocketBase::set_event_loop(boost::asio::io_context& io_context) {
+    this->event_loop = std::make_unique<EventLoopExecutor>(io_context);
+    this->ping_timer = std::make_unique<Everest::SteadyTimer>(&io_context);
+}
+
 void WebsocketBase::register_connection_failed_callback(const std::function<void(ConnectionFailedReason)>& callback) {
     this->connection_failed_callback = callback;
 }
@@ -130,25 +214,11 @@ void WebsocketBase::log_on_fail(const std::error_code& ec, const boost::system::
 }
 
 long WebsocketBase::get_reconnect_interval() {
-
-    // We need to add 1 to the repeat times since the first try is already connection_attempt 1
-    if (this->connection_attempts > (this->connection_options.retry_backoff_repeat_times + 1)) {
-        return this->reconnect_backoff_ms;
-    }
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> distr(0, this->connection_options.retry_backoff_random_range_s);
-
-    int random_number = distr(gen);
-
+    std::lock_guard<std::mutex> lk(this->reconnect_backoff_mutex);
     if (this->connection_attempts == 1) {
-        this->reconnect_backoff_ms = (this->connection_options.retry_backoff_wait_minimum_s + random_number) * 1000;
-        return this->reconnect_backoff_ms;
+        this->reconnect_backoff.reset();
     }
-
-    this->reconnect_backoff_ms = this->reconnect_backoff_ms * 2 + (random_number * 1000);
-    return this->reconnect_backoff_ms;
+    return this->reconnect_backoff.next_delay().count();
 }
 
 void WebsocketBase::cancel_reconnect_timer() {
@@ -159,6 +229,10 @@ void WebsocketBase::cancel_reconnect_timer() {
     this->reconnect_timer = nullptr;
 }
 
+WebsocketSendBuffer WebsocketBase::create_send_buffer() {
+    return WebsocketSendBuffer(0, this->send_buffer_size_hint);
+}
+
 void WebsocketBase::set_websocket_ping_interval(int32_t interval_s) {
     if (this->ping_timer) {
         this->ping_timer->stop();
@@ -7,12 +7,17 @@
 
 #include <libwebsockets.h>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
@@ -77,10 +82,23 @@ static constexpr int LWS_CLOSE_SOCKET_RESPONSE_MESSAGE = -1;
 /// \brief How much we wait for a message to be sent in seconds
 static constexpr int MESSAGE_SEND_TIMEOUT_S = 1;
 
+/// \brief Reconnect timer of a connection on the shared context, runs on its service thread
+struct ReconnectTimer {
+    lws_sorted_usec_list_t sul; // Must be the first member, libwebsockets passes a pointer to it to the callback
+    ConnectionData* data;
+};
+
 /// \brief Current connection data, sets the internal state of the
-struct ConnectionData {
-    explicit ConnectionData(WebsocketLibwebsockets* owner) :
-        wsi(nullptr), owner(owner), is_running(true), is_stopped_run(false), state(EConnectionState::INITIALIZE) {
+struct ConnectionData : public std::enable_shared_from_this<ConnectionData> {
+    explicit ConnectionData(WebsocketLibwebsockets* owner, SharedLwsContext* shared_context = nullptr) :
+        wsi(nullptr),
+        owner(owner),
+        shared_context(shared_context),
+        attempt_ended(false),
+        reconnect_timer{},
+        is_running(true),
+        is_stopped_run(false),
+        state(EConnectionState::INITIALIZE) {
     }
 
     ~ConnectionData() {
@@ -215,6 +233,21 @@ public:
         this->wsi = lws;
     }
 
+    /// \brief Called when libwebsockets frees \p lws after the current callback. A connection on the shared context
+    /// outlives its wsi, so the wsi must not lead to the connection anymore
+    void detach_connection(lws* lws) {
+        if (this->shared_context == nullptr) {
+            return;
+        }
+
+        lws_set_wsi_user(lws, nullptr);
+
+        std::lock_guard lock(this->mutex);
+        if (this->wsi == lws) {
+            this->wsi = nullptr;
+        }
+    }
+
     lws* get_conn() {
         std::lock_guard lock(this->mutex);
         return wsi;
@@ -230,7 +263,15 @@ public:
         return owner;
     }
 
+    // No need for sync here since its set on construction
+    SharedLwsContext* get_shared_context() {
+        return shared_context;
+    }
+
 private:
+    // Extensions offered by the lws context, must outlive it
+    std::string permessage_deflate_offer;
+    std::array<lws_extension, 2> extensions{};
     // Openssl context, must be destroyed in this order
     std::unique_ptr<SSL_CTX> sec_context;
     // libwebsockets state
@@ -240,6 +281,15 @@ private:
     // Owner, set on creation
     WebsocketLibwebsockets* owner;
 
+    // Shared context the connection runs on, set on creation, nullptr if the connection has its own context
+    SharedLwsContext* shared_context;
+    // The following are only accessed on the service thread of the shared context
+    // Key of the vhost used by the current connection attempt
+    std::string shared_vhost;
+    // If the end of the current connection attempt has been handled
+    bool attempt_ended;
+    ReconnectTimer reconnect_timer;
+
     // State variables
     bool is_running;
     bool is_stopped_run;
@@ -257,11 +307,13 @@ private:
 };
 
 struct WebsocketMessage {
-    WebsocketMessage() : sent_bytes(0), message_sent(false) {
+    explicit WebsocketMessage(WebsocketSendBuffer&& payload) :
+        payload(std::move(payload)), sent_bytes(0), message_sent(false), message_failed(false) {
     }
 
 public:
-    std::string payload;
+    // Serialized message with LWS_PRE bytes in front, written to libwebsockets as is
+    WebsocketSendBuffer payload;
     lws_write_protocol protocol;
 
     // How many bytes we have sent to libwebsockets, does not
@@ -270,6 +322,9 @@ public:
     size_t sent_bytes;
     // If libwebsockets has sent all the bytes through the wire
     std::atomic_bool message_sent;
+    // If writing the message failed, it is not written again since libwebsockets has already masked the written
+    // part of the payload in place
+    std::atomic_bool message_failed;
 };
 
 static bool verify_csms_cn(const std::string& hostname, bool preverified, const X509_STORE_CTX* ctx,
@@ -340,6 +395,7 @@ WebsocketLibwebsockets::WebsocketLibwebsockets(const WebsocketConnectionOptions&
                                                std::shared_ptr<EvseSecurity> evse_security) :
     WebsocketBase(),
     evse_security(evse_security),
+    recv_message_size(0),
     stop_deferred_handler(false),
     connected_ocpp_version{OcppProtocolVersion::Unknown} {
 
@@ -363,6 +419,9 @@ WebsocketLibwebsockets::~WebsocketLibwebsockets() {
 
     if (this->m_is_connected || is_trying_to_connect_internal()) {
         this->close_internal(WebsocketCloseReason::Normal, "websocket destructor");
+    } else if (local_conn_data != nullptr && local_conn_data->get_shared_context() != nullptr) {
+        // The service thread of the shared context might still be finishing the last connection attempt
+        this->safe_close_threads();
     }
 
     // In the dtor we must make sure the deferred callback thread
@@ -373,6 +432,11 @@ WebsocketLibwebsockets::~WebsocketLibwebsockets() {
 
         this->deferred_callback_thread->join();
     }
+
+    // The callbacks posted to the event loop capture 'this' as well
+    if (this->event_loop != nullptr) {
+        this->event_loop->shutdown();
+    }
 }
 
 void WebsocketLibwebsockets::set_connection_options(const WebsocketConnectionOptions& connection_options) {
@@ -439,6 +503,302 @@ constexpr auto local_protocol_name = "lws-everest-client";
 static const struct lws_protocols protocols[] = {{local_protocol_name, callback_minimal, 0, 0, 0, NULL, 0},
                                                  LWS_PROTOCOL_LIST_TERM};
 
+/// \brief Settings of the vhost a connection attempt on the shared context uses. They are prepared on the thread of the
+/// connection and not on the service thread, since looking up the certificates and loading them into the SSL_CTX can
+/// take a while and would hold up all other connections
+struct SharedVhostSettings {
+    // Identifies the settings, connections with the same key share a vhost
+    std::string key;
+    std::optional<std::string> permessage_deflate_offer;
+    // Openssl context for security profile 2 and 3, only created if no vhost exists for the key yet
+    std::unique_ptr<SSL_CTX> ssl_ctx;
+    // Set if a vhost for the key already existed and has been acquired while the settings were prepared
+    bool vhost_acquired = false;
+};
+
+/// \brief libwebsockets context shared by all connections of the process that set the shared_context option. Instead
+/// of a context and client thread per connection, a single service thread runs the context and the connections are
+/// established, attempted again and closed on it. The connections with the same TLS settings share a vhost and with it
+/// their SSL_CTX
+class SharedLwsContext {
+public:
+    /// \brief Gets the shared context, it is created if no connection uses it at the moment
+    /// \return The shared context or nullptr if it could not be created
+    static std::shared_ptr<SharedLwsContext> acquire() {
+        static std::mutex instance_mutex;
+        static std::weak_ptr<SharedLwsContext> instance;
+
+        std::lock_guard lock(instance_mutex);
+        auto context = instance.lock();
+
+        if (context == nullptr) {
+            context = std::shared_ptr<SharedLwsContext>(new SharedLwsContext());
+            if (!context->start()) {
+                return nullptr;
+            }
+            instance = context;
+        }
+
+        return context;
+    }
+
+    ~SharedLwsContext() {
+        if (this->service_thread.joinable()) {
+            {
+                std::lock_guard lock(this->tasks_mutex);
+                this->running = false;
+            }
+            lws_cancel_service(this->lws_ctx.get());
+            this->service_thread.join();
+        }
+
+        // The vhosts have to outlive the context since it uses their SSL_CTX
+        this->lws_ctx.reset();
+    }
+
+    lws_context* get_context() {
+        return this->lws_ctx.get();
+    }
+
+    std::thread::id get_thread_id() const {
+        return this->service_thread.get_id();
+    }
+
+    /// \brief Queues \p task to run on the service thread
+    /// \return False if the service thread has stopped, the task is dropped in that case
+    bool post(std::function<void()>&& task) {
+        {
+            std::lock_guard lock(this->tasks_mutex);
+            if (!this->running) {
+                return false;
+            }
+            this->tasks.push_back(std::move(task));
+        }
+
+        // Awakes the service thread from 'poll', ok to call from another thread
+        lws_cancel_service(this->lws_ctx.get());
+        return true;
+    }
+
+    /// \brief Runs \p task on the service thread and waits until it has finished
+    void run(const std::function<void()>& task) {
+        if (std::this_thread::get_id() == this->get_thread_id()) {
+            task();
+            return;
+        }
+
+        std::promise<void> done;
+        auto finished = done.get_future();
+
+        if (this->post([&task, &done]() {
+                task();
+                done.set_value();
+            })) {
+            finished.wait();
+        }
+    }
+
+    /// \brief Acquires the vhost for \p key if it exists, so that it is not destroyed before the connection attempt
+    /// uses it. May be called from any thread
+    /// \return True if the vhost exists, the settings for the key do not need an SSL_CTX in that case
+    bool try_acquire_existing_vhost(const std::string& key) {
+        std::lock_guard lock(this->vhosts_mutex);
+        auto it = this->vhosts.find(key);
+
+        if (it == this->vhosts.end()) {
+            return false;
+        }
+
+        it->second->connections += 1;
+        return true;
+    }
+
+    /// \brief Gets the vhost for \p settings. If no connection uses these settings at the moment the vhost is created
+    /// with their SSL_CTX, if set, and permessage-deflate offer. A vhost that has been acquired while the settings
+    /// were prepared is returned as it is. Only called on the service thread
+    /// \return The vhost or nullptr if it could not be created
+    lws_vhost* acquire_vhost(SharedVhostSettings& settings) {
+        std::lock_guard lock(this->vhosts_mutex);
+        auto it = this->vhosts.find(settings.key);
+
+        if (settings.vhost_acquired) {
+            return it != this->vhosts.end() ? it->second->vhost : nullptr;
+        }
+
+        if (it == this->vhosts.end()) {
+            auto vhost = std::make_unique<Vhost>();
+            vhost->name = "ocpp-" + std::to_string(this->created_vhosts++);
+
+            lws_context_creation_info info;
+            memset(&info, 0, sizeof(lws_context_creation_info));
+
+            info.options = LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
+            info.port = CONTEXT_PORT_NO_LISTEN;
+            info.protocols = protocols;
+            info.vhost_name = vhost->name.c_str();
+
+            if (settings.permessage_deflate_offer.has_value()) {
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+                vhost->permessage_deflate_offer = settings.permessage_deflate_offer.value();
+                vhost->extensions[0] = {"permessage-deflate", lws_extension_callback_pm_deflate,
+                                        vhost->permessage_deflate_offer.c_str()};
+                vhost->extensions[1] = {nullptr, nullptr, nullptr};
+                info.extensions = vhost->extensions.data();
+
+                EVLOG_info << "Offering websocket extension: " << vhost->permessage_deflate_offer;
+#else
+                EVLOG_warning << "permessage-deflate is configured, but libwebsockets was built without extension "
+                                 "support";
+#endif
+            }
+
+            if (settings.ssl_ctx != nullptr) {
+                vhost->sec_context = std::move(settings.ssl_ctx);
+                info.provided_client_ssl_ctx = vhost->sec_context.get();
+            }
+
+            vhost->vhost = lws_create_vhost(this->lws_ctx.get(), &info);
+            if (vhost->vhost == nullptr) {
+                EVLOG_error << "lws create vhost failed";
+                return nullptr;
+            }
+
+            EVLOG_info << "Created shared websocket vhost: " << vhost->name;
+            it = this->vhosts.emplace(settings.key, std::move(vhost)).first;
+        }
+
+        it->second->connections += 1;
+        return it->second->vhost;
+    }
+
+    /// \brief Releases a vhost acquired with acquire_vhost(), it is destroyed once no connection uses it anymore. Only
+    /// called on the service thread
+    void release_vhost(const std::string& key) {
+        std::lock_guard lock(this->vhosts_mutex);
+        auto it = this->vhosts.find(key);
+
+        if (it == this->vhosts.end()) {
+            return;
+        }
+
+        it->second->connections -= 1;
+
+        if (it->second->connections <= 0) {
+            EVLOG_info << "Destroying shared websocket vhost: " << it->second->name;
+
+            // No wsi is bound to the vhost anymore, libwebsockets does not free a provided SSL_CTX
+            lws_vhost_destroy(it->second->vhost);
+            this->vhosts.erase(it);
+        }
+    }
+
+private:
+    struct Vhost {
+        // Openssl context, must outlive the vhost
+        std::unique_ptr<SSL_CTX> sec_context;
+        // Extensions offered by the vhost, must outlive it
+        std::string permessage_deflate_offer;
+        std::array<lws_extension, 2> extensions{};
+        std::string name;
+        lws_vhost* vhost = nullptr;
+        // Number of connection attempts using the vhost
+        int connections = 0;
+    };
+
+    SharedLwsContext() : running(false), created_vhosts(0) {
+    }
+
+    bool start() {
+        lws_set_log_level(LLL_ERR, nullptr);
+
+        lws_context_creation_info info;
+        memset(&info, 0, sizeof(lws_context_creation_info));
+
+        // A vhost is created per TLS settings, the default vhost would not be used
+        info.options = LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT | LWS_SERVER_OPTION_EXPLICIT_VHOSTS;
+        info.port = CONTEXT_PORT_NO_LISTEN; /* we do not run any server */
+        info.protocols = protocols;
+
+        lws_context* lws_ctx = lws_create_context(&info);
+        if (nullptr == lws_ctx) {
+            EVLOG_error << "lws create shared context failed";
+            return false;
+        }
+
+#if !defined(LWS_WITH_SYS_ASYNC_DNS)
+        EVLOG_warning << "libwebsockets was built without asynchronous DNS, resolving the host of a connection holds "
+                         "up all other connections on the shared websocket context";
+#endif
+
+        this->lws_ctx = std::unique_ptr<lws_context>(lws_ctx);
+        this->running = true;
+        this->service_thread = std::thread(&SharedLwsContext::thread_service_loop, this);
+
+        return true;
+    }
+
+    void thread_service_loop() {
+        EVLOG_info << "Init shared websocket service loop with ID: " << std::hex << std::this_thread::get_id();
+
+        int n = 0;
+
+        while (n >= 0) {
+            std::deque<std::function<void()>> pending_tasks;
+            {
+                std::lock_guard lock(this->tasks_mutex);
+                if (!this->running) {
+                    break;
+                }
+                pending_tasks.swap(this->tasks);
+            }
+
+            for (auto& task : pending_tasks) {
+                task();
+            }
+
+            n = lws_service(this->lws_ctx.get(), 0);
+        }
+
+        if (n < 0) {
+            EVLOG_error << "Shared websocket service loop failed";
+        }
+
+        // Tasks queued until now still run, so that nobody waits for them forever
+        std::deque<std::function<void()>> pending_tasks;
+        {
+            std::lock_guard lock(this->tasks_mutex);
+            this->running = false;
+            pending_tasks.swap(this->tasks);
+        }
+
+        for (auto& task : pending_tasks) {
+            task();
+        }
+
+        EVLOG_info << "Exit shared websocket service loop with ID: " << std::hex << std::this_thread::get_id();
+    }
+
+    // Vhosts are only created and destroyed on the service thread, other threads only acquire existing ones
+    std::map<std::string, std::unique_ptr<Vhost>> vhosts;
+    std::mutex vhosts_mutex;
+    std::unique_ptr<lws_context> lws_ctx;
+    std::thread service_thread;
+
+    std::mutex tasks_mutex;
+    std::deque<std::function<void()>> tasks;
+    bool running;
+
+    // Used to give each vhost a unique name
+    int created_vhosts;
+};
+
+/// \brief Modification time of the file or directory at \p path, 0 if it does not exist
+static std::filesystem::file_time_type::rep get_modification_time(const std::string& path) {
+    std::error_code error;
+    const auto time = std::filesystem::last_write_time(path, error);
+    return error ? 0 : time.time_since_epoch().count();
+}
+
 bool WebsocketLibwebsockets::tls_init(SSL_CTX* ctx, const std::string& path_chain, const std::string& path_key,
                                       bool custom_key, std::optional<std::string>& password) {
     auto rc = SSL_CTX_set_cipher_list(ctx, this->connection_options.supported_ciphers_12.c_str());
@@ -563,19 +923,10 @@ void WebsocketLibwebsockets::thread_websocket_message_recv_loop(std::shared_ptr<
 
     while (!local_data->is_interupted()) {
         // Process all messages
-        while (true) {
-            std::string message{};
-
-            {
-                if (recv_message_queue.empty())
-                    break;
-
-                message = recv_message_queue.pop();
-            }
-
+        while (auto message = pop_received_message()) {
             // Invoke our processing callback, that might trigger a send back that
             // can cause a deadlock if is not managed on a different thread
-            this->message_callback(message);
+            dispatch_message(std::move(message.value()));
         }
 
         // While we are empty, sleep, only if we have not been interrupted in the
@@ -614,6 +965,21 @@ bool WebsocketLibwebsockets::initialize_connection_options(std::shared_ptr<Conne
 
     info.fd_limit_per_thread = 1 + 1 + 1;
 
+    if (this->connection_options.permessage_deflate.has_value()) {
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+        local_data->permessage_deflate_offer =
+            get_permessage_deflate_offer(this->connection_options.permessage_deflate.value());
+        local_data->extensions[0] = {"permessage-deflate", lws_extension_callback_pm_deflate,
+                                     local_data->permessage_deflate_offer.c_str()};
+        local_data->extensions[1] = {nullptr, nullptr, nullptr};
+        info.extensions = local_data->extensions.data();
+
+        EVLOG_info << "Offering websocket extension: " << local_data->permessage_deflate_offer;
+#else
+        EVLOG_warning << "permessage-deflate is configured, but libwebsockets was built without extension support";
+#endif
+    }
+
     // Lifetime of this is important since we use the data from this in private_key_callback()
     std::optional<std::string> private_key_password;
     SSL_CTX* ssl_ctx = nullptr;
@@ -623,79 +989,209 @@ bool WebsocketLibwebsockets::initialize_connection_options(std::shared_ptr<Conne
         std::string path_key;
         std::string path_chain;
 
-        if (this->connection_options.security_profile == 3) {
-            const auto certificate_response =
-                this->evse_security->get_leaf_certificate_info(CertificateSigningUseEnum::ChargingStationCertificate);
+        if (this->connection_options.security_profile == 3 and
+            !get_client_certificate(path_chain, path_key, private_key_password)) {
+            return false;
+        }
 
-            if (certificate_response.status != ocpp::GetCertificateInfoStatus::Accepted or
-                !certificate_response.info.has_value()) {
-                EVLOG_error << "Connecting with security profile 3 but no client side certificate is present or valid";
-                return false;
-            }
+        ssl_ctx = create_ssl_context(path_chain, path_key, private_key_password);
+        if (ssl_ctx == nullptr) {
+            return false;
+        }
 
-            const auto& certificate_info = certificate_response.info.value();
+        // Setup our context
+        info.provided_client_ssl_ctx = ssl_ctx;
+    }
 
-            if (certificate_info.certificate_path.has_value()) {
-                path_chain = certificate_info.certificate_path.value();
-            } else if (certificate_info.certificate_single_path.has_value()) {
-                path_chain = certificate_info.certificate_single_path.value();
-            } else {
-                EVLOG_error << "Connecting with security profile 3 but no client side certificate is present or valid";
-                return false;
-            }
+    lws_context* lws_ctx = lws_create_context(&info);
+    if (nullptr == lws_ctx) {
+        EVLOG_error << "lws create context failed";
+        return false;
+    }
 
-            path_key = certificate_info.key_path;
-            private_key_password = certificate_info.password;
-        }
+    // Conn acquire the lws context and security context
+    local_data->init_connection_context(lws_ctx, ssl_ctx);
+    return true;
+}
 
-        bool custom_key = false;
+bool WebsocketLibwebsockets::get_client_certificate(std::string& path_chain, std::string& path_key,
+                                                    std::optional<std::string>& password) {
+    const auto certificate_response =
+        this->evse_security->get_leaf_certificate_info(CertificateSigningUseEnum::ChargingStationCertificate);
 
-        if (!path_key.empty()) {
-            custom_key = is_custom_private_key_file(path_key);
-        }
+    if (certificate_response.status != ocpp::GetCertificateInfoStatus::Accepted or
+        !certificate_response.info.has_value()) {
+        EVLOG_error << "Connecting with security profile 3 but no client side certificate is present or valid";
+        return false;
+    }
 
-        OpenSSLProvider provider;
+    const auto& certificate_info = certificate_response.info.value();
 
-        if (custom_key) {
-            provider.set_tls_mode(OpenSSLProvider::mode_t::custom_provider);
-        } else {
-            provider.set_tls_mode(OpenSSLProvider::mode_t::default_provider);
-        }
+    if (certificate_info.certificate_path.has_value()) {
+        path_chain = certificate_info.certificate_path.value();
+    } else if (certificate_info.certificate_single_path.has_value()) {
+        path_chain = certificate_info.certificate_single_path.value();
+    } else {
+        EVLOG_error << "Connecting with security profile 3 but no client side certificate is present or valid";
+        return false;
+    }
 
-        const SSL_METHOD* method = SSLv23_client_method();
-        ssl_ctx = SSL_CTX_new_ex(provider, provider.propquery_tls_str(), method);
+    path_key = certificate_info.key_path;
+    password = certificate_info.password;
+    return true;
+}
 
-        if (ssl_ctx == nullptr) {
-            ERR_print_errors_fp(stderr);
-            EVLOG_error << "Unable to create ssl context";
-            return false;
+SSL_CTX* WebsocketLibwebsockets::create_ssl_context(const std::string& path_chain, const std::string& path_key,
+                                                    std::optional<std::string>& password) {
+    bool custom_key = false;
+
+    if (!path_key.empty()) {
+        custom_key = is_custom_private_key_file(path_key);
+    }
+
+    OpenSSLProvider provider;
+
+    if (custom_key) {
+        provider.set_tls_mode(OpenSSLProvider::mode_t::custom_provider);
+    } else {
+        provider.set_tls_mode(OpenSSLProvider::mode_t::default_provider);
+    }
+
+    const SSL_METHOD* method = SSLv23_client_method();
+    SSL_CTX* ssl_ctx = SSL_CTX_new_ex(provider, provider.propquery_tls_str(), method);
+
+    if (ssl_ctx == nullptr) {
+        ERR_print_errors_fp(stderr);
+        EVLOG_error << "Unable to create ssl context";
+        return nullptr;
+    }
+
+    if (this->connection_options.enable_tls_keylog and this->connection_options.keylog_file.has_value()) {
+        EVLOG_info << "Logging TLS secrets to: " << this->connection_options.keylog_file.value().string();
+        keylog_file = this->connection_options.keylog_file;
+        SSL_CTX_set_keylog_callback(ssl_ctx, keylog_callback);
+    }
+
+    // Init TLS data
+    if (!tls_init(ssl_ctx, path_chain, path_key, custom_key, password)) {
+        EVLOG_error << "Unable to init tls security options for websocket";
+        SSL_CTX_free(ssl_ctx);
+        return nullptr;
+    }
+
+    if (this->connection_options.tls_session_cache != nullptr) {
+        // Sessions are only resumed with the same client certificate and trust anchors they have been established with.
+        // The modification times are part of the context, so that renewed certificates cause a full handshake
+        std::stringstream context;
+        context << this->connection_options.security_profile << ";" << path_chain << ";"
+                << get_modification_time(path_chain) << ";" << path_key << ";" << get_modification_time(path_key);
+
+        if (this->evse_security->is_ca_certificate_installed(ocpp::CaCertificateType::CSMS)) {
+            const auto ca_csms = this->evse_security->get_verify_location(ocpp::CaCertificateType::CSMS);
+            context << ";" << ca_csms << ";" << get_modification_time(ca_csms);
         }
 
-        if (this->connection_options.enable_tls_keylog and this->connection_options.keylog_file.has_value()) {
-            EVLOG_info << "Logging TLS secrets to: " << this->connection_options.keylog_file.value().string();
-            keylog_file = this->connection_options.keylog_file;
-            SSL_CTX_set_keylog_callback(ssl_ctx, keylog_callback);
+        this->connection_options.tls_session_cache->attach(ssl_ctx, context.str());
+    }
+
+    return ssl_ctx;
+}
+
+lws* WebsocketLibwebsockets::connect_client(ConnectionData* conn_data, lws_context* context, lws_vhost* vhost) {
+    lws_client_connect_info i;
+    memset(&i, 0, sizeof(lws_client_connect_info));
+
+    // No SSL
+    int ssl_connection = 0;
+
+    if (this->connection_options.security_profile == 2 || this->connection_options.security_profile == 3) {
+        ssl_connection = LCCSCF_USE_SSL;
+
+        // Skip server hostname check
+        if (this->connection_options.verify_csms_common_name == false) {
+            ssl_connection |= LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK;
         }
 
-        // Init TLS data
-        if (!tls_init(ssl_ctx, path_chain, path_key, custom_key, private_key_password)) {
-            EVLOG_error << "Unable to init tls security options for websocket";
-            return false;
+        // Debugging if required
+        // ssl_connection |= LCCSCF_ALLOW_SELFSIGNED;
+        // ssl_connection |= LCCSCF_ALLOW_INSECURE;
+        // ssl_connection |= LCCSCF_ALLOW_EXPIRED;
+    }
+
+    auto& uri = this->connection_options.csms_uri;
+    lws* local_lws = nullptr;
+
+    std::string ocpp_versions;
+    bool first = true;
+    for (auto version : this->connection_options.ocpp_versions) {
+        if (!first) {
+            ocpp_versions += ", ";
         }
+        first = false;
+        ocpp_versions += conversions::ocpp_protocol_version_to_string(version);
+    }
+
+    // TODO: No idea who releases the strdup?
+    i.context = context;
+    i.vhost = vhost; // The TLS context of the vhost is used if set, otherwise the one of the context
+    i.port = uri.get_port();
+    i.address = strdup(uri.get_hostname().c_str()); // Base address, as resolved by getnameinfo
+    i.path = strdup((uri.get_path() + uri.get_chargepoint_id()).c_str()); // Path of resource
+    i.host = i.address;
+    i.origin = i.address;
+    i.ssl_connection = ssl_connection;
+    i.protocol = strdup(ocpp_versions.c_str());
+    i.local_protocol_name = local_protocol_name;
+    i.pwsi = &local_lws; // Will set the local_data->wsi to a valid value in case of a successful connect
+    i.userdata = conn_data; // See lws_context 'user'
 
-        // Setup our context
-        info.provided_client_ssl_ctx = ssl_ctx;
+    if (this->connection_options.iface.has_value()) {
+        i.iface = this->connection_options.iface.value().c_str();
     }
 
-    lws_context* lws_ctx = lws_create_context(&info);
-    if (nullptr == lws_ctx) {
-        EVLOG_error << "lws create context failed";
-        return false;
+    // Print data for debug
+    EVLOG_info << "LWS connect with info "
+               << "port: [" << i.port << "] address: [" << i.address << "] path: [" << i.path << "] protocol: ["
+               << i.protocol << "]"
+               << " security profile: [" << this->connection_options.security_profile << "]";
+
+    if (lws_client_connect_via_info(&i) == nullptr) {
+        return nullptr;
     }
 
-    // Conn acquire the lws context and security context
-    local_data->init_connection_context(lws_ctx, ssl_ctx);
-    return true;
+    return local_lws;
+}
+
+std::optional<long> WebsocketLibwebsockets::get_internal_reconnect_delay(ConnectionData* conn_data) {
+    if (conn_data->is_interupted() || conn_data->get_state() == EConnectionState::FINALIZED) {
+        EVLOG_info << "Connection interrupted or cleanly finalized, exiting websocket loop";
+        return std::nullopt;
+    }
+
+    if (conn_data->get_state() == EConnectionState::CONNECTED) {
+        return 0;
+    }
+
+    // Any other failure than a successful connect
+
+    // -1 indicates to always attempt to reconnect
+    if (this->connection_options.max_connection_attempts == -1 or
+        this->connection_attempts <= this->connection_options.max_connection_attempts) {
+        conn_data->update_state(EConnectionState::RECONNECTING);
+        const long reconnect_delay = this->get_reconnect_interval();
+
+        // Increment reconn attempts
+        this->connection_attempts += 1;
+
+        EVLOG_info << "Connection not successful, attempting internal reconnect in: " << reconnect_delay << "ms";
+        return reconnect_delay;
+    }
+
+    conn_data->update_state(EConnectionState::FINALIZED);
+
+    EVLOG_info << "Connection reconnect attempts exhausted, exiting websocket loop, passing back control "
+                  "to the application logic";
+    return std::nullopt;
 }
 
 void WebsocketLibwebsockets::thread_websocket_client_loop(std::shared_ptr<ConnectionData> local_data) {
@@ -713,63 +1209,9 @@ void WebsocketLibwebsockets::thread_websocket_client_loop(std::shared_ptr<Connec
             local_data->update_state(EConnectionState::ERROR);
             on_conn_fail(local_data.get());
         } else {
-            lws_client_connect_info i;
-            memset(&i, 0, sizeof(lws_client_connect_info));
-
-            // No SSL
-            int ssl_connection = 0;
-
-            if (this->connection_options.security_profile == 2 || this->connection_options.security_profile == 3) {
-                ssl_connection = LCCSCF_USE_SSL;
+            lws* local_lws = connect_client(local_data.get(), local_data->lws_ctx.get(), nullptr);
 
-                // Skip server hostname check
-                if (this->connection_options.verify_csms_common_name == false) {
-                    ssl_connection |= LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK;
-                }
-
-                // Debugging if required
-                // ssl_connection |= LCCSCF_ALLOW_SELFSIGNED;
-                // ssl_connection |= LCCSCF_ALLOW_INSECURE;
-                // ssl_connection |= LCCSCF_ALLOW_EXPIRED;
-            }
-
-            auto& uri = this->connection_options.csms_uri;
-            lws* local_lws = nullptr;
-
-            std::string ocpp_versions;
-            bool first = true;
-            for (auto version : this->connection_options.ocpp_versions) {
-                if (!first) {
-                    ocpp_versions += ", ";
-                }
-                first = false;
-                ocpp_versions += conversions::ocpp_protocol_version_to_string(version);
-            }
-
-            // TODO: No idea who releases the strdup?
-            i.context = local_data->lws_ctx.get();
-            i.port = uri.get_port();
-            i.address = strdup(uri.get_hostname().c_str()); // Base address, as resolved by getnameinfo
-            i.path = strdup((uri.get_path() + uri.get_chargepoint_id()).c_str()); // Path of resource
-            i.host = i.address;
-            i.origin = i.address;
-            i.ssl_connection = ssl_connection;
-            i.protocol = strdup(ocpp_versions.c_str());
-            i.local_protocol_name = local_protocol_name;
-            i.pwsi = &local_lws; // Will set the local_data->wsi to a valid value in case of a successful connect
-            i.userdata = local_data.get(); // See lws_context 'user'
-
-            if (this->connection_options.iface.has_value()) {
-                i.iface = this->connection_options.iface.value().c_str();
-            }
-
-            // Print data for debug
-            EVLOG_info << "LWS connect with info "
-                       << "port: [" << i.port << "] address: [" << i.address << "] path: [" << i.path << "] protocol: ["
-                       << i.protocol << "]"
-                       << " security profile: [" << this->connection_options.security_profile << "]";
-
-            if (lws_client_connect_via_info(&i) == nullptr) {
+            if (local_lws == nullptr) {
                 EVLOG_error << "LWS connect failed!";
                 // This condition can occur when connecting fails to an IP address
                 // retries need to be attempted
@@ -789,11 +1231,15 @@ void WebsocketLibwebsockets::thread_websocket_client_loop(std::shared_ptr<Connec
                     // Set to -1 for continuous servicing, if required, not recommended
                     n = lws_service(local_data->lws_ctx.get(), 0);
 
+                    if (this->recv_resume_requested.exchange(false)) {
+                        lws_rx_flow_control(local_data->get_conn(), 1);
+                    }
+
                     auto state = local_data->state;
                     processing = (!local_data->is_interupted()) &&
                                  (state != EConnectionState::FINALIZED && state != EConnectionState::ERROR);
 
-                    if (processing && !message_queue.empty()) {
+                    if (processing && this->is_write_pending()) {
                         lws_callback_on_writable(local_data->get_conn());
                     }
                 } while (n >= 0 && processing);
@@ -803,34 +1249,9 @@ void WebsocketLibwebsockets::thread_websocket_client_loop(std::shared_ptr<Connec
             local_data->reset_connection_data();
         } // End init connection
 
-        long reconnect_delay = 0;
-
-        if (local_data->is_interupted() || local_data->get_state() == EConnectionState::FINALIZED) {
-            EVLOG_info << "Connection interrupted or cleanly finalized, exiting websocket loop";
-            try_reconnect = false;
-        } else if (local_data->get_state() != EConnectionState::CONNECTED) {
-            // Any other failure than a successful connect
-
-            // -1 indicates to always attempt to reconnect
-            if (this->connection_options.max_connection_attempts == -1 or
-                this->connection_attempts <= this->connection_options.max_connection_attempts) {
-                local_data->update_state(EConnectionState::RECONNECTING);
-                reconnect_delay = this->get_reconnect_interval();
-                try_reconnect = true;
-
-                // Increment reconn attempts
-                this->connection_attempts += 1;
-
-                EVLOG_info << "Connection not successful, attempting internal reconnect in: " << reconnect_delay
-                           << "ms";
-            } else {
-                local_data->update_state(EConnectionState::FINALIZED);
-                try_reconnect = false;
-
-                EVLOG_info << "Connection reconnect attempts exhausted, exiting websocket loop, passing back control "
-                              "to the application logic";
-            }
-        }
+        const auto next_attempt_delay = get_internal_reconnect_delay(local_data.get());
+        const long reconnect_delay = next_attempt_delay.value_or(0);
+        try_reconnect = next_attempt_delay.has_value();
 
         // Wait until new connection attempt
         if (local_data->get_state() == EConnectionState::RECONNECTING) {
@@ -849,31 +1270,197 @@ void WebsocketLibwebsockets::thread_websocket_client_loop(std::shared_ptr<Connec
         }
     } while (try_reconnect); // End trying to connect
 
-    // Give back control to the application
-    if (false == local_data->is_stop_executed()) {
-        this->push_deferred_callback([this]() {
-            if (this->stopped_connecting_callback) {
-                this->stopped_connecting_callback(WebsocketCloseReason::Normal);
-            } else {
-                EVLOG_error << "Stopped connecting callback not registered!";
-            }
+    on_conn_stopped(local_data.get());
 
-            if (this->disconnected_callback) {
-                this->disconnected_callback();
-            } else {
-                EVLOG_error << "Disconnected callback not registered!";
+    // Client loop finished for our tid
+    EVLOG_info << "Exit websocket client loop with ID: " << std::hex << std::this_thread::get_id();
+}
+
+void WebsocketLibwebsockets::schedule_shared_attempt(std::shared_ptr<ConnectionData> local_data) {
+    // The settings are prepared on the deferred callback thread, or the event loop, of this connection. Only the
+    // connection attempt itself is started on the service thread
+    this->push_deferred_callback([this, local_data]() {
+        if (local_data->is_interupted()) {
+            return;
+        }
+
+        auto settings = std::make_shared<SharedVhostSettings>();
+        if (!prepare_shared_vhost(*settings)) {
+            settings.reset();
+        }
+
+        local_data->get_shared_context()->post([local_data, settings]() {
+            // Once interrupted the owner closes the connection itself and might be gone afterwards
+            if (!local_data->is_interupted()) {
+                local_data->get_owner()->shared_connect(local_data, settings);
+            } else if (settings != nullptr and settings->vhost_acquired) {
+                local_data->get_shared_context()->release_vhost(settings->key);
             }
         });
+    });
+}
+
+void WebsocketLibwebsockets::shared_connect(std::shared_ptr<ConnectionData> local_data,
+                                            std::shared_ptr<SharedVhostSettings> settings) {
+    // Called on the service thread of the shared context
+    local_data->attempt_ended = false;
+
+    lws* local_lws = nullptr;
+    lws_vhost* vhost = nullptr;
+
+    if (settings != nullptr) {
+        vhost = local_data->get_shared_context()->acquire_vhost(*settings);
+        if (vhost != nullptr) {
+            local_data->shared_vhost = settings->key;
+        }
     }
 
-    // Client loop finished for our tid
-    EVLOG_info << "Exit websocket client loop with ID: " << std::hex << std::this_thread::get_id();
+    if (vhost == nullptr) {
+        EVLOG_error << "Could not initialize connection options.";
+    } else {
+        local_lws = connect_client(local_data.get(), local_data->get_shared_context()->get_context(), vhost);
+
+        if (local_lws == nullptr) {
+            EVLOG_error << "LWS connect failed!";
+        }
+    }
+
+    if (local_lws == nullptr) {
+        local_data->update_state(EConnectionState::ERROR);
+        on_conn_fail(local_data.get());
+    } else if (!local_data->attempt_ended) {
+        // The attempt can already have failed in a callback from within 'lws_client_connect_via_info'
+        local_data->init_connection(local_lws);
+    }
+}
+
+bool WebsocketLibwebsockets::prepare_shared_vhost(SharedVhostSettings& settings) {
+    if (this->connection_options.permessage_deflate.has_value()) {
+        settings.permessage_deflate_offer =
+            get_permessage_deflate_offer(this->connection_options.permessage_deflate.value());
+    }
+
+    // The key identifies the settings the vhost and its SSL_CTX are created from. The modification times of the
+    // certificates are part of it, so that new connection attempts use renewed certificates
+    std::stringstream key;
+    key << this->connection_options.security_profile << ";" << settings.permessage_deflate_offer.value_or("");
+
+    if (this->connection_options.security_profile == 2 || this->connection_options.security_profile == 3) {
+        std::string path_key;
+        std::string path_chain;
+        std::optional<std::string> private_key_password;
+
+        if (this->connection_options.security_profile == 3 and
+            !get_client_certificate(path_chain, path_key, private_key_password)) {
+            return false;
+        }
+
+        key << ";" << path_chain << ";" << get_modification_time(path_chain) << ";" << path_key << ";"
+            << get_modification_time(path_key) << ";" << this->connection_options.supported_ciphers_12 << ";"
+            << this->connection_options.supported_ciphers_13 << ";"
+            << this->connection_options.use_ssl_default_verify_paths << ";"
+            << this->connection_options.enable_tls_keylog << ";"
+            << this->connection_options.keylog_file.value_or(std::filesystem::path()).string() << ";"
+            << this->connection_options.tls_session_cache.get();
+
+        if (this->evse_security->is_ca_certificate_installed(ocpp::CaCertificateType::CSMS)) {
+            const auto ca_csms = this->evse_security->get_verify_location(ocpp::CaCertificateType::CSMS);
+            key << ";" << ca_csms << ";" << get_modification_time(ca_csms);
+        }
+
+        settings.key = key.str();
+
+        // Building the SSL_CTX loads the certificates and keys, it is only needed if the vhost has to be created
+        settings.vhost_acquired = this->shared_context->try_acquire_existing_vhost(settings.key);
+        if (!settings.vhost_acquired) {
+            settings.ssl_ctx =
+                std::unique_ptr<SSL_CTX>(create_ssl_context(path_chain, path_key, private_key_password));
+            if (settings.ssl_ctx == nullptr) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    settings.key = key.str();
+    return true;
+}
+
+void WebsocketLibwebsockets::end_shared_attempt(ConnectionData* conn_data) {
+    // Called on the service thread of the shared context
+    if (conn_data->attempt_ended or conn_data->is_interupted()) {
+        return;
+    }
+
+    conn_data->attempt_ended = true;
+
+    // Posted, since the wsi of the attempt can not be closed from within one of its callbacks
+    conn_data->get_shared_context()->post([local_data = conn_data->shared_from_this()]() {
+        // Once interrupted the owner closes the connection itself and might be gone afterwards
+        if (!local_data->is_interupted()) {
+            local_data->get_owner()->on_shared_attempt_ended(local_data);
+        }
+    });
+}
+
+void WebsocketLibwebsockets::on_shared_attempt_ended(std::shared_ptr<ConnectionData> local_data) {
+    // Called on the service thread of the shared context
+    release_shared_connection(local_data.get());
+
+    const auto reconnect_delay = get_internal_reconnect_delay(local_data.get());
+
+    if (!reconnect_delay.has_value()) {
+        on_conn_stopped(local_data.get());
+        return;
+    }
+
+    local_data->reconnect_timer.data = local_data.get();
+    lws_sul_schedule(local_data->get_shared_context()->get_context(), 0, &local_data->reconnect_timer.sul,
+                     &WebsocketLibwebsockets::on_reconnect_timer, reconnect_delay.value() * LWS_US_PER_MS);
+}
+
+void WebsocketLibwebsockets::on_reconnect_timer(lws_sorted_usec_list_t* sul) {
+    // Called on the service thread of the shared context, the timer is canceled before the connection is released
+    ConnectionData* data = reinterpret_cast<ReconnectTimer*>(sul)->data;
+
+    if (!data->is_interupted()) {
+        EVLOG_info << "Attempting reconnect on shared websocket context";
+        data->get_owner()->schedule_shared_attempt(data->shared_from_this());
+    }
+}
+
+void WebsocketLibwebsockets::release_shared_connection(ConnectionData* conn_data) {
+    // Called on the service thread of the shared context
+    lws_sul_cancel(&conn_data->reconnect_timer.sul);
+
+    lws* wsi = conn_data->get_conn();
+
+    if (wsi != nullptr) {
+        conn_data->init_connection(nullptr);
+
+        // Closes the wsi right away, its close callbacks are called before this returns
+        lws_set_timeout(wsi, PENDING_TIMEOUT_USER_OK, LWS_TO_KILL_SYNC);
+    }
+
+    if (!conn_data->shared_vhost.empty()) {
+        conn_data->get_shared_context()->release_vhost(conn_data->shared_vhost);
+        conn_data->shared_vhost.clear();
+    }
 }
 
 void WebsocketLibwebsockets::clear_all_queues() {
     this->message_queue.clear();
     this->recv_buffered_message.clear();
+    this->recv_message_parser.reset();
+    this->recv_message_size = 0;
+    this->recv_parse_error.reset();
     this->recv_message_queue.clear();
+    {
+        std::lock_guard<std::mutex> lk(this->recv_overflow_mutex);
+        this->recv_overflow_queue.clear();
+        this->recv_paused = false;
+    }
+    this->recv_resume_requested = false;
 }
 
 void WebsocketLibwebsockets::safe_close_threads() {
@@ -912,6 +1499,12 @@ void WebsocketLibwebsockets::safe_close_threads() {
         request_write();
         this->websocket_thread->join();
         this->websocket_thread.reset();
+    } else if (local_conn_data != nullptr && local_conn_data->get_shared_context() != nullptr) {
+        // Close the connection on the service thread, no callback for it is made afterwards
+        local_conn_data->get_shared_context()->run([this, local_conn_data]() {
+            release_shared_connection(local_conn_data.get());
+            on_conn_stopped(local_conn_data.get());
+        });
     }
 
     if (in_message_thread) {
@@ -957,11 +1550,26 @@ bool WebsocketLibwebsockets::start_connecting() {
 
     this->connected_ocpp_version = OcppProtocolVersion::Unknown;
 
+    SharedLwsContext* connection_context = nullptr;
+
+    if (this->connection_options.shared_context) {
+        if (this->shared_context == nullptr) {
+            this->shared_context = SharedLwsContext::acquire();
+        }
+
+        if (this->shared_context == nullptr) {
+            EVLOG_error << "Could not create the shared websocket context. A reconnect attempt will not be made.";
+            return false;
+        }
+
+        connection_context = this->shared_context.get();
+    }
+
     // If we already have a connection attempt started for now shut it down first
     safe_close_threads();
 
     // Create a new connection data (only created here, owner never changes)
-    conn_data = std::make_shared<ConnectionData>(this);
+    conn_data = std::make_shared<ConnectionData>(this, connection_context);
 
     // Stop any pending reconnect timer
     {
@@ -971,15 +1579,22 @@ bool WebsocketLibwebsockets::start_connecting() {
 
     this->connection_attempts = 1; // reset connection attempts
 
-    // This should always be running, start it only once
-    if (this->deferred_callback_thread == nullptr) {
+    // This should always be running, start it only once. Not needed if the callbacks are executed on the event loop
+    if (this->deferred_callback_thread == nullptr and this->event_loop == nullptr) {
         this->deferred_callback_thread =
             std::make_unique<std::thread>(&WebsocketLibwebsockets::thread_deferred_callback_queue, this);
     }
 
-    // Release other threads
-    this->websocket_thread =
-        std::make_unique<std::thread>(&WebsocketLibwebsockets::thread_websocket_client_loop, this, this->conn_data);
+    if (connection_context != nullptr) {
+        // The connection attempts are made on the service thread of the shared context
+        this->conn_data->bind_thread_client(connection_context->get_thread_id());
+
+        schedule_shared_attempt(this->conn_data);
+    } else {
+        // Release other threads
+        this->websocket_thread = std::make_unique<std::thread>(&WebsocketLibwebsockets::thread_websocket_client_loop,
+                                                               this, this->conn_data);
+    }
 
     // TODO(ioan): remove this thread when the fix will be moved into 'MessageQueue'
     // The reason for having a received message processing thread is that because
@@ -987,12 +1602,19 @@ bool WebsocketLibwebsockets::start_connecting() {
     // will send back another message, and since we're waiting for that message to be
     // sent over the wire on the client_loop, not giving the opportunity to the loop to
     // advance we will have a dead-lock
-    this->recv_message_thread = std::make_unique<std::thread>(
-        &WebsocketLibwebsockets::thread_websocket_message_recv_loop, this, this->conn_data);
+    // On an event loop the received messages are dispatched by the loop instead
+    if (this->event_loop == nullptr) {
+        this->recv_message_thread = std::make_unique<std::thread>(
+            &WebsocketLibwebsockets::thread_websocket_message_recv_loop, this, this->conn_data);
+    }
 
     // Bind threads for various checks
-    this->conn_data->bind_thread_client(this->websocket_thread->get_id());
-    this->conn_data->bind_thread_message(this->recv_message_thread->get_id());
+    if (this->websocket_thread) {
+        this->conn_data->bind_thread_client(this->websocket_thread->get_id());
+    }
+    if (this->recv_message_thread) {
+        this->conn_data->bind_thread_message(this->recv_message_thread->get_id());
+    }
 
     return true;
 }
@@ -1054,35 +1676,34 @@ void WebsocketLibwebsockets::reconnect(long delay) {
         std::chrono::milliseconds(delay));
 }
 
-static bool send_internal(lws* wsi, WebsocketMessage* msg) {
-    static std::vector<char> buff;
-
-    std::string& message = msg->payload;
-    size_t message_len = message.length();
-    size_t buff_req_size = message_len + LWS_PRE;
-
-    if (buff.size() < buff_req_size)
-        buff.resize(buff_req_size);
-
-    // Copy data in send buffer
-    memcpy(&buff[LWS_PRE], message.data(), message_len);
+/// \brief Writes the message or its next fragment to libwebsockets
+/// \return false if the fragment could not be written completely. The message can not be written again in that case,
+/// since the written part of the payload has been masked in place and the frame header might have overwritten the end
+/// of the previous fragment
+static bool send_internal(lws* wsi, WebsocketMessage* msg, std::size_t max_fragment_size) {
+    if (msg->payload.headroom() < LWS_PRE) {
+        EVLOG_AND_THROW(std::runtime_error("Websocket message without LWS_PRE headroom, fatal error!"));
+    }
 
-    // TODO (ioan): if we require certain sending over the wire,
-    // we'll have to send chunked manually something like this:
+    // Control frames (e.g. pings) must not be fragmented
+    if (msg->protocol != LWS_WRITE_TEXT) {
+        max_fragment_size = 0;
+    }
 
-    // Ethernet MTU: ~= 1500bytes
-    // size_t BUFF_SIZE = (MTU * 2);
-    // char *buff = alloca(LWS_PRE + BUFF_SIZE);
-    // memcpy(buff, message.data() + already_written, BUFF_SIZE);
-    // int flags = lws_write_ws_flags(proto, is_start, is_end);
-    // already_written += lws_write(wsi, buff + LWS_PRE, BUFF_SIZE - LWS_PRE, flags);
+    // Large messages are written one fragment per writable callback so that the service loop is not blocked and
+    // libwebsockets never has to buffer more than a fragment
+    auto fragment = msg->payload.fragment(msg->sent_bytes, max_fragment_size);
+    auto flags = lws_write_ws_flags(msg->protocol, fragment.first, fragment.last);
 
-    auto sent = lws_write(wsi, reinterpret_cast<unsigned char*>(&buff[LWS_PRE]), message_len, msg->protocol);
+    // The fragment is written in place, libwebsockets puts the frame header in the LWS_PRE bytes in front of it. For
+    // the first fragment this is the headroom of the buffer, for the following ones the end of the previous fragment,
+    // which libwebsockets has already consumed when it invokes the next writable callback
+    auto sent = lws_write(wsi, reinterpret_cast<unsigned char*>(fragment.data), fragment.size,
+                          static_cast<lws_write_protocol>(flags));
 
     if (sent < 0) {
         // Fatal error, conn closed
         EVLOG_error << "Error sending message over TLS websocket, conn closed.";
-        msg->sent_bytes = 0;
         return false;
     }
 
@@ -1091,11 +1712,11 @@ static bool send_internal(lws* wsi, WebsocketMessage* msg) {
     // sent, the 'LWS_CALLBACK_CLIENT_WRITEABLE' callback will be suppressed. When we received
     // another callback, it means that everything was sent and that we can mark the message
     // as certainly 'sent' over the wire
-    msg->sent_bytes = sent;
+    msg->sent_bytes += sent;
 
-    if (static_cast<size_t>(sent) < message_len) {
+    if (static_cast<size_t>(sent) < fragment.size) {
         EVLOG_error << "Error sending message over TLS websocket. Sent bytes: " << sent
-                    << " Total to send: " << message_len;
+                    << " Total to send: " << fragment.size;
         return false;
     }
 
@@ -1106,7 +1727,14 @@ void WebsocketLibwebsockets::request_write() {
     if (this->m_is_connected) {
         std::shared_ptr<ConnectionData> local_data = conn_data;
 
-        if (local_data != nullptr) {
+        if (local_data != nullptr and local_data->get_shared_context() != nullptr) {
+            // 'lws_callback_on_writable' may only be called on the service thread of the shared context
+            local_data->get_shared_context()->post([local_data]() {
+                if (!local_data->is_interupted() and local_data->get_conn() != nullptr) {
+                    lws_callback_on_writable(local_data->get_conn());
+                }
+            });
+        } else if (local_data != nullptr) {
             // Notify waiting processing thread to wake up. According to docs
             // it is ok  to call from another thread.
             local_data->request_awake();
@@ -1116,10 +1744,10 @@ void WebsocketLibwebsockets::request_write() {
     }
 }
 
-void WebsocketLibwebsockets::poll_message(const std::shared_ptr<WebsocketMessage>& msg) {
+bool WebsocketLibwebsockets::poll_message(const std::shared_ptr<WebsocketMessage>& msg) {
     if (this->m_is_connected == false) {
         EVLOG_debug << "Trying to poll message without being connected!";
-        return;
+        return false;
     }
 
     std::shared_ptr<ConnectionData> local_data = conn_data;
@@ -1134,17 +1762,23 @@ void WebsocketLibwebsockets::poll_message(const std::shared_ptr<WebsocketMessage
         // If we are interupted or finalized
         if (local_data->is_interupted() || local_data->get_state() == EConnectionState::FINALIZED) {
             EVLOG_warning << "Trying to poll message to interrupted/finalized state!";
-            return;
+            return false;
         }
     }
 
-    EVLOG_debug << "Queueing message over TLS websocket: " << msg->payload;
-    message_queue.push(msg);
+    EVLOG_debug << "Queueing message over TLS websocket: " << msg->payload.payload();
+    // the queue is not drained while the connection is down, so do not wait for a free cell
+    if (!message_queue.try_push(msg)) {
+        // reported to the caller like any other send failure, the message queue sends the message again later
+        EVLOG_warning << "Could not send message over TLS websocket, the outgoing message queue is full!";
+        msg->message_failed = true;
+        return false;
+    }
 
     // Request a write callback
     request_write();
 
-    message_queue.wait_on_custom_event([&] { return (true == msg->message_sent); },
+    message_queue.wait_on_custom_event([&] { return msg->message_sent or msg->message_failed; },
                                        std::chrono::seconds(MESSAGE_SEND_TIMEOUT_S));
 
     if (msg->message_sent) {
@@ -1152,6 +1786,7 @@ void WebsocketLibwebsockets::poll_message(const std::shared_ptr<WebsocketMessage
     } else {
         EVLOG_warning << "Could not send last message over TLS websocket!";
     }
+    return msg->message_sent;
 }
 
 // Will be called from external threads
@@ -1161,13 +1796,29 @@ bool WebsocketLibwebsockets::send(const std::string& message) {
         return false;
     }
 
-    auto msg = std::make_shared<WebsocketMessage>();
-    msg->payload = std::move(message);
-    msg->protocol = LWS_WRITE_TEXT;
+    auto buffer = this->create_send_buffer();
+    buffer.assign(message);
 
-    poll_message(msg);
+    return this->send(std::move(buffer));
+}
 
-    return msg->message_sent;
+WebsocketSendBuffer WebsocketLibwebsockets::create_send_buffer() {
+    return WebsocketSendBuffer(LWS_PRE, this->send_buffer_size_hint);
+}
+
+// Will be called from external threads
+bool WebsocketLibwebsockets::send(WebsocketSendBuffer&& buffer) {
+    if (!this->initialized()) {
+        EVLOG_error << "Could not send message because websocket is not properly initialized.";
+        return false;
+    }
+
+    this->send_buffer_size_hint = buffer.size();
+
+    auto msg = std::make_shared<WebsocketMessage>(std::move(buffer));
+    msg->protocol = LWS_WRITE_TEXT;
+
+    return poll_message(msg);
 }
 
 void WebsocketLibwebsockets::ping() {
@@ -1175,8 +1826,10 @@ void WebsocketLibwebsockets::ping() {
         EVLOG_error << "Could not send ping because websocket is not properly initialized.";
     }
 
-    auto msg = std::make_shared<WebsocketMessage>();
-    msg->payload = this->connection_options.ping_payload;
+    auto buffer = this->create_send_buffer();
+    buffer.assign(this->connection_options.ping_payload);
+
+    auto msg = std::make_shared<WebsocketMessage>(std::move(buffer));
     msg->protocol = LWS_WRITE_PING;
 
     poll_message(msg);
@@ -1284,6 +1937,8 @@ int WebsocketLibwebsockets::process_callback(void* wsi_ptr, int callback_reason,
             });
         }
 
+        // libwebsockets frees the wsi after this callback
+        data->detach_connection(wsi);
         data->update_state(EConnectionState::ERROR);
         on_conn_fail(data);
 
@@ -1330,6 +1985,9 @@ int WebsocketLibwebsockets::process_callback(void* wsi_ptr, int callback_reason,
     }
 
     case LWS_CALLBACK_CLIENT_CLOSED:
+        // libwebsockets frees the wsi after this callback
+        data->detach_connection(wsi);
+
         // Determine if the close connection was requested or if the server went away
         // case in which we receive a 'LWS_CALLBACK_CLIENT_CLOSED' that was not requested
         if (data->is_interupted()) {
@@ -1349,34 +2007,33 @@ int WebsocketLibwebsockets::process_callback(void* wsi_ptr, int callback_reason,
         break;
 
     case LWS_CALLBACK_CLIENT_WRITEABLE:
-        on_conn_writable();
-        if (false == message_queue.empty()) {
+        if (!on_conn_writable()) {
+            // Closes the connection, a reconnect is attempted afterwards
+            return -1;
+        }
+        if (this->is_write_pending()) {
             lws_callback_on_writable(wsi);
         }
         break;
 
     case LWS_CALLBACK_CLIENT_RECEIVE_PONG: {
-        if (false == message_queue.empty()) {
+        if (this->is_write_pending()) {
             lws_callback_on_writable(data->get_conn());
         }
     } break;
 
     case LWS_CALLBACK_CLIENT_RECEIVE:
-        recv_buffered_message.append(reinterpret_cast<char*>(in), reinterpret_cast<char*>(in) + len);
-
-        // Message is complete
-        if (lws_remaining_packet_payload(wsi) <= 0) {
-            on_conn_message(std::move(recv_buffered_message));
-            recv_buffered_message.clear();
-        }
+        // Message is complete once the last frame of the last fragment has been received
+        on_conn_receive(std::string_view(reinterpret_cast<const char*>(in), len),
+                        lws_remaining_packet_payload(wsi) <= 0 and lws_is_final_fragment(wsi));
 
-        if (false == message_queue.empty()) {
+        if (this->is_write_pending()) {
             lws_callback_on_writable(data->get_conn());
         }
         break;
 
     case LWS_CALLBACK_EVENT_WAIT_CANCELLED: {
-        if (false == message_queue.empty()) {
+        if (this->is_write_pending()) {
             lws_callback_on_writable(data->get_conn());
         }
     } break;
@@ -1514,6 +2171,7 @@ void WebsocketLibwebsockets::on_conn_connected(ConnectionData* conn_data) {
 
     // Clear any irrelevant data after a DC
     clear_all_queues();
+    this->message_in_progress.reset();
 
     this->push_deferred_callback([this]() {
         if (connected_callback) {
@@ -1537,6 +2195,7 @@ void WebsocketLibwebsockets::on_conn_close(ConnectionData* conn_data) {
 
     // Clear any irrelevant data after a DC
     clear_all_queues();
+    this->message_in_progress.reset();
 
     this->push_deferred_callback([this]() {
         if (this->stopped_connecting_callback) {
@@ -1574,91 +2233,242 @@ void WebsocketLibwebsockets::on_conn_fail(ConnectionData* conn_data) {
 
     // Clear any irrelevant data after a DC
     clear_all_queues();
+    this->message_in_progress.reset();
 
     // TODO: See if this is required for a faster fail
     // lws_set_timeout(conn_data->get_conn(), (enum pending_timeout)1, LWS_TO_KILL_ASYNC);
+
+    // On the shared context there is no client loop of the connection that ends with the attempt
+    if (conn_data->get_shared_context() != nullptr) {
+        end_shared_attempt(conn_data);
+    }
+}
+
+void WebsocketLibwebsockets::on_conn_stopped(ConnectionData* conn_data) {
+    // Called on the websocket client thread
+    if (conn_data->is_stop_executed()) {
+        return;
+    }
+
+    // Give back control to the application
+    this->push_deferred_callback([this]() {
+        if (this->stopped_connecting_callback) {
+            this->stopped_connecting_callback(WebsocketCloseReason::Normal);
+        } else {
+            EVLOG_error << "Stopped connecting callback not registered!";
+        }
+
+        if (this->disconnected_callback) {
+            this->disconnected_callback();
+        } else {
+            EVLOG_error << "Disconnected callback not registered!";
+        }
+    });
+
+    conn_data->mark_stop_executed();
+}
+
+void WebsocketLibwebsockets::on_conn_receive(std::string_view fragment, bool final_fragment) {
+    // Called on the websocket client thread
+    if (!this->connection_options.incremental_message_parsing or this->parsed_message_callback == nullptr) {
+        recv_buffered_message.append(fragment);
+        if (final_fragment) {
+            ReceivedMessage received;
+            received.message_size = recv_buffered_message.size();
+            received.message = std::move(recv_buffered_message);
+            recv_buffered_message.clear();
+            on_conn_message(std::move(received));
+        }
+        return;
+    }
+
+    // Every fragment is parsed as soon as it arrives, so the complete message text is never held in memory. After a
+    // parse error the remaining fragments are discarded
+    recv_message_size += fragment.size();
+    if (!recv_parse_error.has_value()) {
+        try {
+            recv_message_parser.feed(fragment);
+        } catch (const JsonParseException& e) {
+            recv_parse_error = e.what();
+        }
+    }
+
+    if (!final_fragment) {
+        return;
+    }
+
+    ReceivedMessage received;
+    received.message_size = recv_message_size;
+    if (!recv_parse_error.has_value()) {
+        try {
+            received.parsed_message = recv_message_parser.finish();
+        } catch (const JsonParseException& e) {
+            recv_parse_error = e.what();
+        }
+    }
+    if (recv_parse_error.has_value()) {
+        EVLOG_error << "Received invalid message of " << recv_message_size << " bytes: " << recv_parse_error.value();
+        // the message text is not available anymore, so the message callback rejects the parse error as invalid
+        // message instead
+        received.message = std::move(recv_parse_error.value());
+    }
+
+    recv_message_parser.reset();
+    recv_message_size = 0;
+    recv_parse_error.reset();
+    on_conn_message(std::move(received));
 }
 
-void WebsocketLibwebsockets::on_conn_message(std::string&& message) {
+void WebsocketLibwebsockets::on_conn_message(ReceivedMessage&& message) {
     // Called on the websocket client thread
     if (!this->initialized()) {
         EVLOG_error << "Message received but TLS websocket has not been correctly initialized. Discarding message.";
         return;
     }
 
-    recv_message_queue.push(std::move(message));
+    // Waiting for a free cell would block the websocket client thread, while the receiving thread might wait for it to
+    // send a response. A message that does not fit is kept in the overflow queue and receiving is paused instead
+    {
+        std::lock_guard<std::mutex> lk(this->recv_overflow_mutex);
+        // once messages overflowed, later messages must queue up behind them to keep the order
+        if (!this->recv_overflow_queue.empty() or !recv_message_queue.try_push(std::move(message))) {
+            this->recv_overflow_queue.push_back(std::move(message));
+            std::shared_ptr<ConnectionData> local_data = conn_data;
+            if (!this->recv_paused and local_data != nullptr and local_data->get_conn() != nullptr) {
+                EVLOG_warning << "Received message queue is full, pausing receiving until the messages are processed";
+                this->recv_paused = true;
+                lws_rx_flow_control(local_data->get_conn(), 0);
+            }
+        }
+    }
+
+    if (this->event_loop != nullptr) {
+        // One handler per message, a handler finds the queue empty if it was cleared in the meantime
+        this->event_loop->post([this]() {
+            if (auto message = pop_received_message()) {
+                dispatch_message(std::move(message.value()));
+            }
+        });
+    }
+}
+
+std::optional<ReceivedMessage> WebsocketLibwebsockets::pop_received_message() {
+    // the overflow queue only holds messages that were received after all messages in the lock free queue
+    if (auto message = recv_message_queue.try_pop()) {
+        return message;
+    }
+
+    std::lock_guard<std::mutex> lk(this->recv_overflow_mutex);
+    if (this->recv_overflow_queue.empty()) {
+        return std::nullopt;
+    }
+    auto message = std::move(this->recv_overflow_queue.front());
+    this->recv_overflow_queue.pop_front();
+    if (this->recv_overflow_queue.empty() and this->recv_paused) {
+        this->recv_paused = false;
+        this->resume_receive();
+    }
+    return message;
 }
 
-void WebsocketLibwebsockets::on_conn_writable() {
+void WebsocketLibwebsockets::resume_receive() {
+    std::shared_ptr<ConnectionData> local_data = conn_data;
+    if (local_data == nullptr) {
+        return;
+    }
+
+    // 'lws_rx_flow_control' may only be called on the service thread of the context
+    if (local_data->get_shared_context() != nullptr) {
+        local_data->get_shared_context()->post([local_data]() {
+            if (!local_data->is_interupted() and local_data->get_conn() != nullptr) {
+                lws_rx_flow_control(local_data->get_conn(), 1);
+            }
+        });
+    } else {
+        this->recv_resume_requested = true;
+        local_data->request_awake();
+    }
+}
+
+void WebsocketLibwebsockets::dispatch_message(ReceivedMessage&& message) {
+    if (message.parsed_message.has_value()) {
+        this->parsed_message_callback(std::move(message.parsed_message.value()), message.message_size);
+    } else {
+        this->message_callback(message.message);
+    }
+}
+
+bool WebsocketLibwebsockets::on_conn_writable() {
     // Called on the websocket client thread
     if (!this->initialized() || !this->m_is_connected) {
         EVLOG_error << "Message sending but TLS websocket has not been correctly initialized/connected.";
-        return;
+        return true;
     }
 
     std::shared_ptr<ConnectionData> local_data = conn_data;
 
     if (local_data == nullptr) {
         EVLOG_error << "Message sending TLS websocket with null connection data!";
-        return;
+        return true;
     }
 
     if (local_data->is_interupted() || local_data->get_state() == EConnectionState::FINALIZED) {
         EVLOG_error << "Trying to write message to interrupted/finalized state!";
-        return;
+        return true;
     }
 
-    // Execute while we have messages that were polled
-    while (true) {
-        // Break if we have en empty queue
-        if (message_queue.empty())
-            break;
-
-        auto message = message_queue.front();
-
-        if (message == nullptr) {
-            EVLOG_AND_THROW(std::runtime_error("Null message in queue, fatal error!"));
-        }
+    // The message in progress was written in a previous call. If we received this writable callback,
+    // libwebsockets has sent everything over the wire, so mark it as sent
+    if (this->message_in_progress != nullptr &&
+        this->message_in_progress->sent_bytes >= this->message_in_progress->payload.size()) {
+        EVLOG_debug << "Websocket message fully written, notifying processing thread!";
 
-        // This message was polled in a previous iteration
-        if (message->sent_bytes >= message->payload.length()) {
-            EVLOG_debug << "Websocket message fully written, popping processing thread from queue!";
+        this->message_in_progress->message_sent = true;
+        this->message_in_progress.reset();
+        message_queue.notify_waiting_thread();
+    }
 
-            // If we have written all bytes to libwebsockets it means that if we received
-            // this writable callback everything is sent over the wire, mark it as sent and remove
-            message->message_sent = true;
-            message_queue.pop();
-        } else {
-            // If the message was not polled, we reached the first unpolled and break
-            break;
+    // Take the next message only after the previous one was confirmed, a single message is written per invoke of this
+    // function. libwebsockets is designed so that when a message is sent to the wire from the internal buffer it
+    // will invoke 'on_conn_writable' again and we can execute the code above
+    if (this->message_in_progress == nullptr) {
+        auto message = message_queue.try_pop();
+        if (!message.has_value()) {
+            return true;
         }
+        this->message_in_progress = std::move(message.value());
     }
 
-    // If we still have message ONLY poll a single one that can be processed in the invoke of the function
-    // libwebsockets is designed so that when a message is sent to the wire from the internal buffer it
-    // will invoke 'on_conn_writable' again and we can execute the code above
-    if (!message_queue.empty()) {
-        // Poll a single message
-        EVLOG_debug << "Client writable, sending message part!";
+    // Poll a single message
+    EVLOG_debug << "Client writable, sending message part!";
 
-        auto message = message_queue.front();
+    auto& message = this->message_in_progress;
 
-        if (message == nullptr) {
-            EVLOG_AND_THROW(std::runtime_error("Null message in queue, fatal error!"));
-        }
+    if (message == nullptr) {
+        EVLOG_AND_THROW(std::runtime_error("Null message in queue, fatal error!"));
+    }
 
-        if (message->sent_bytes >= message->payload.length()) {
-            EVLOG_AND_THROW(std::runtime_error("Already polled message should be handled above, fatal error!"));
-        }
+    if (message->sent_bytes >= message->payload.size()) {
+        EVLOG_AND_THROW(std::runtime_error("Already polled message should be handled above, fatal error!"));
+    }
 
-        // Continue sending message part, for a single message only
-        bool sent = send_internal(local_data->get_conn(), message.get());
+    // Continue sending message part (the whole message or its next fragment), for a single message only
+    bool sent = send_internal(local_data->get_conn(), message.get(), this->connection_options.message_fragment_size);
 
-        // If we failed, attempt again later
-        if (!sent) {
-            message->sent_bytes = 0;
-        }
+    // The partially written message can not be written again and the frame it started can not be continued with
+    // another message, so give up on it and close the connection
+    if (!sent) {
+        message->message_failed = true;
+        this->message_in_progress.reset();
+        message_queue.notify_waiting_thread();
+        return false;
     }
+
+    return true;
+}
+
+bool WebsocketLibwebsockets::is_write_pending() const {
+    return this->message_in_progress != nullptr || !this->message_queue.empty();
 }
 
 void WebsocketLibwebsockets::push_deferred_callback(const std::function<void()>& callback) {
@@ -1667,6 +2477,11 @@ void WebsocketLibwebsockets::push_deferred_callback(const std::function<void()>&
         return;
     }
 
+    if (this->event_loop != nullptr) {
+        this->event_loop->post(callback);
+        return;
+    }
+
     this->deferred_callback_queue.push(callback);
 }
 
@@ -858,6 +858,258 @@ KeyValue ChargePointConfiguration::getWebsocketPongTimeoutKeyValue() {
     return kv;
 }
 
+std::optional<int> ChargePointConfiguration::getWebsocketMessageFragmentSize() {
+    std::optional<int> fragment_size = std::nullopt;
+    if (this->config["Internal"].contains("WebsocketMessageFragmentSize")) {
+        fragment_size.emplace(this->config["Internal"]["WebsocketMessageFragmentSize"]);
+    }
+    return fragment_size;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getWebsocketMessageFragmentSizeKeyValue() {
+    std::optional<KeyValue> fragment_size_kv = std::nullopt;
+    auto fragment_size = this->getWebsocketMessageFragmentSize();
+    if (fragment_size.has_value()) {
+        KeyValue kv;
+        kv.key = "WebsocketMessageFragmentSize";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(fragment_size.value()));
+        fragment_size_kv.emplace(kv);
+    }
+    return fragment_size_kv;
+}
+
+std::optional<bool> ChargePointConfiguration::getWebsocketPermessageDeflate() {
+    std::optional<bool> permessage_deflate = std::nullopt;
+    if (this->config["Internal"].contains("WebsocketPermessageDeflate")) {
+        permessage_deflate.emplace(this->config["Internal"]["WebsocketPermessageDeflate"]);
+    }
+    return permessage_deflate;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getWebsocketPermessageDeflateKeyValue() {
+    std::optional<KeyValue> permessage_deflate_kv = std::nullopt;
+    auto permessage_deflate = this->getWebsocketPermessageDeflate();
+    if (permessage_deflate.has_value()) {
+        KeyValue kv;
+        kv.key = "WebsocketPermessageDeflate";
+        kv.readonly = true;
+        kv.value.emplace(ocpp::conversions::bool_to_string(permessage_deflate.value()));
+        permessage_deflate_kv.emplace(kv);
+    }
+    return permessage_deflate_kv;
+}
+
+std::optional<bool> ChargePointConfiguration::getWebsocketPermessageDeflateNoContextTakeover() {
+    std::optional<bool> no_context_takeover = std::nullopt;
+    if (this->config["Internal"].contains("WebsocketPermessageDeflateNoContextTakeover")) {
+        no_context_takeover.emplace(this->config["Internal"]["WebsocketPermessageDeflateNoContextTakeover"]);
+    }
+    return no_context_takeover;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getWebsocketPermessageDeflateNoContextTakeoverKeyValue() {
+    std::optional<KeyValue> no_context_takeover_kv = std::nullopt;
+    auto no_context_takeover = this->getWebsocketPermessageDeflateNoContextTakeover();
+    if (no_context_takeover.has_value()) {
+        KeyValue kv;
+        kv.key = "WebsocketPermessageDeflateNoContextTakeover";
+        kv.readonly = true;
+        kv.value.emplace(ocpp::conversions::bool_to_string(no_context_takeover.value()));
+        no_context_takeover_kv.emplace(kv);
+    }
+    return no_context_takeover_kv;
+}
+
+std::optional<int> ChargePointConfiguration::getWebsocketPermessageDeflateMaxWindowBits() {
+    std::optional<int> max_window_bits = std::nullopt;
+    if (this->config["Internal"].contains("WebsocketPermessageDeflateMaxWindowBits")) {
+        max_window_bits.emplace(this->config["Internal"]["WebsocketPermessageDeflateMaxWindowBits"]);
+    }
+    return max_window_bits;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getWebsocketPermessageDeflateMaxWindowBitsKeyValue() {
+    std::optional<KeyValue> max_window_bits_kv = std::nullopt;
+    auto max_window_bits = this->getWebsocketPermessageDeflateMaxWindowBits();
+    if (max_window_bits.has_value()) {
+        KeyValue kv;
+        kv.key = "WebsocketPermessageDeflateMaxWindowBits";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(max_window_bits.value()));
+        max_window_bits_kv.emplace(kv);
+    }
+    return max_window_bits_kv;
+}
+
+std::optional<bool> ChargePointConfiguration::getWebsocketIncrementalMessageParsing() {
+    std::optional<bool> incremental_message_parsing = std::nullopt;
+    if (this->config["Internal"].contains("WebsocketIncrementalMessageParsing")) {
+        incremental_message_parsing.emplace(this->config["Internal"]["WebsocketIncrementalMessageParsing"]);
+    }
+    return incremental_message_parsing;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getWebsocketIncrementalMessageParsingKeyValue() {
+    std::optional<KeyValue> incremental_message_parsing_kv = std::nullopt;
+    auto incremental_message_parsing = this->getWebsocketIncrementalMessageParsing();
+    if (incremental_message_parsing.has_value()) {
+        KeyValue kv;
+        kv.key = "WebsocketIncrementalMessageParsing";
+        kv.readonly = true;
+        kv.value.emplace(ocpp::conversions::bool_to_string(incremental_message_parsing.value()));
+        incremental_message_parsing_kv.emplace(kv);
+    }
+    return incremental_message_parsing_kv;
+}
+
+std::optional<bool> ChargePointConfiguration::getWebsocketSharedContext() {
+    std::optional<bool> shared_context = std::nullopt;
+    if (this->config["Internal"].contains("WebsocketSharedContext")) {
+        shared_context.emplace(this->config["Internal"]["WebsocketSharedContext"]);
+    }
+    return shared_context;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getWebsocketSharedContextKeyValue() {
+    std::optional<KeyValue> shared_context_kv = std::nullopt;
+    auto shared_context = this->getWebsocketSharedContext();
+    if (shared_context.has_value()) {
+        KeyValue kv;
+        kv.key = "WebsocketSharedContext";
+        kv.readonly = true;
+        kv.value.emplace(ocpp::conversions::bool_to_string(shared_context.value()));
+        shared_context_kv.emplace(kv);
+    }
+    return shared_context_kv;
+}
+
+std::optional<bool> ChargePointConfiguration::getWebsocketTlsSessionResumption() {
+    std::optional<bool> tls_session_resumption = std::nullopt;
+    if (this->config["Internal"].contains("WebsocketTlsSessionResumption")) {
+        tls_session_resumption.emplace(this->config["Internal"]["WebsocketTlsSessionResumption"]);
+    }
+    return tls_session_resumption;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getWebsocketTlsSessionResumptionKeyValue() {
+    std::optional<KeyValue> tls_session_resumption_kv = std::nullopt;
+    auto tls_session_resumption = this->getWebsocketTlsSessionResumption();
+    if (tls_session_resumption.has_value()) {
+        KeyValue kv;
+        kv.key = "WebsocketTlsSessionResumption";
+        kv.readonly = true;
+        kv.value.emplace(ocpp::conversions::bool_to_string(tls_session_resumption.value()));
+        tls_session_resumption_kv.emplace(kv);
+    }
+    return tls_session_resumption_kv;
+}
+
+std::optional<bool> ChargePointConfiguration::getWebsocketPersistTlsSessions() {
+    std::optional<bool> persist_tls_sessions = std::nullopt;
+    if (this->config["Internal"].contains("WebsocketPersistTlsSessions")) {
+        persist_tls_sessions.emplace(this->config["Internal"]["WebsocketPersistTlsSessions"]);
+    }
+    return persist_tls_sessions;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getWebsocketPersistTlsSessionsKeyValue() {
+    std::optional<KeyValue> persist_tls_sessions_kv = std::nullopt;
+    auto persist_tls_sessions = this->getWebsocketPersistTlsSessions();
+    if (persist_tls_sessions.has_value()) {
+        KeyValue kv;
+        kv.key = "WebsocketPersistTlsSessions";
+        kv.readonly = true;
+        kv.value.emplace(ocpp::conversions::bool_to_string(persist_tls_sessions.value()));
+        persist_tls_sessions_kv.emplace(kv);
+    }
+    return persist_tls_sessions_kv;
+}
+
+std::optional<bool> ChargePointConfiguration::getRetryBackoffDecorrelatedJitter() {
+    std::optional<bool> decorrelated_jitter = std::nullopt;
+    if (this->config["Internal"].contains("RetryBackoffDecorrelatedJitter")) {
+        decorrelated_jitter.emplace(this->config["Internal"]["RetryBackoffDecorrelatedJitter"]);
+    }
+    return decorrelated_jitter;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getRetryBackoffDecorrelatedJitterKeyValue() {
+    std::optional<KeyValue> decorrelated_jitter_kv = std::nullopt;
+    auto decorrelated_jitter = this->getRetryBackoffDecorrelatedJitter();
+    if (decorrelated_jitter.has_value()) {
+        KeyValue kv;
+        kv.key = "RetryBackoffDecorrelatedJitter";
+        kv.readonly = true;
+        kv.value.emplace(ocpp::conversions::bool_to_string(decorrelated_jitter.value()));
+        decorrelated_jitter_kv.emplace(kv);
+    }
+    return decorrelated_jitter_kv;
+}
+
+std::optional<int> ChargePointConfiguration::getRetryBackoffMaximum() {
+    std::optional<int> backoff_maximum = std::nullopt;
+    if (this->config["Internal"].contains("RetryBackoffMaximum")) {
+        backoff_maximum.emplace(this->config["Internal"]["RetryBackoffMaximum"]);
+    }
+    return backoff_maximum;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getRetryBackoffMaximumKeyValue() {
+    std::optional<KeyValue> backoff_maximum_kv = std::nullopt;
+    auto backoff_maximum = this->getRetryBackoffMaximum();
+    if (backoff_maximum.has_value()) {
+        KeyValue kv;
+        kv.key = "RetryBackoffMaximum";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(backoff_maximum.value()));
+        backoff_maximum_kv.emplace(kv);
+    }
+    return backoff_maximum_kv;
+}
+
+std::optional<int> ChargePointConfiguration::getRetryBackoffSpread() {
+    std::optional<int> backoff_spread = std::nullopt;
+    if (this->config["Internal"].contains("RetryBackoffSpread")) {
+        backoff_spread.emplace(this->config["Internal"]["RetryBackoffSpread"]);
+    }
+    return backoff_spread;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getRetryBackoffSpreadKeyValue() {
+    std::optional<KeyValue> backoff_spread_kv = std::nullopt;
+    auto backoff_spread = this->getRetryBackoffSpread();
+    if (backoff_spread.has_value()) {
+        KeyValue kv;
+        kv.key = "RetryBackoffSpread";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(backoff_spread.value()));
+        backoff_spread_kv.emplace(kv);
+    }
+    return backoff_spread_kv;
+}
+
+std::optional<bool> ChargePointConfiguration::getSingleThreadedEventLoop() {
+    std::optional<bool> single_threaded_event_loop = std::nullopt;
+    if (this->config["Internal"].contains("SingleThreadedEventLoop")) {
+        single_threaded_event_loop.emplace(this->config["Internal"]["SingleThreadedEventLoop"]);
+    }
+    return single_threaded_event_loop;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getSingleThreadedEventLoopKeyValue() {
+    std::optional<KeyValue> single_threaded_event_loop_kv = std::nullopt;
+    auto single_threaded_event_loop = this->getSingleThreadedEventLoop();
+    if (single_threaded_event_loop.has_value()) {
+        KeyValue kv;
+        kv.key = "SingleThreadedEventLoop";
+        kv.readonly = true;
+        kv.value.emplace(ocpp::conversions::bool_to_string(single_threaded_event_loop.value()));
+        single_threaded_event_loop_kv.emplace(kv);
+    }
+    return single_threaded_event_loop_kv;
+}
+
 int32_t ChargePointConfiguration::getRetryBackoffRandomRange() {
     return this->config["Internal"]["RetryBackoffRandomRange"];
 }
@@ -1115,6 +1367,172 @@ std::optional<KeyValue> ChargePointConfiguration::getMessageQueueSizeThresholdKe
     return message_queue_size_threshold_kv;
 }
 
+std::optional<int> ChargePointConfiguration::getMessageQueueMaxMessagesInFlight() {
+    std::optional<int> max_messages_in_flight = std::nullopt;
+    if (this->config["Internal"].contains("MessageQueueMaxMessagesInFlight")) {
+        max_messages_in_flight.emplace(this->config["Internal"]["MessageQueueMaxMessagesInFlight"]);
+    }
+    return max_messages_in_flight;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getMessageQueueMaxMessagesInFlightKeyValue() {
+    std::optional<KeyValue> max_messages_in_flight_kv = std::nullopt;
+    auto max_messages_in_flight = this->getMessageQueueMaxMessagesInFlight();
+    if (max_messages_in_flight.has_value()) {
+        KeyValue kv;
+        kv.key = "MessageQueueMaxMessagesInFlight";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(max_messages_in_flight.value()));
+        max_messages_in_flight_kv.emplace(kv);
+    }
+    return max_messages_in_flight_kv;
+}
+
+std::optional<int> ChargePointConfiguration::getMessageQueueSizeThresholdBytes() {
+    std::optional<int> size_threshold_bytes = std::nullopt;
+    if (this->config["Internal"].contains("MessageQueueSizeThresholdBytes")) {
+        size_threshold_bytes.emplace(this->config["Internal"]["MessageQueueSizeThresholdBytes"]);
+    }
+    return size_threshold_bytes;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getMessageQueueSizeThresholdBytesKeyValue() {
+    std::optional<KeyValue> size_threshold_bytes_kv = std::nullopt;
+    auto size_threshold_bytes = this->getMessageQueueSizeThresholdBytes();
+    if (size_threshold_bytes.has_value()) {
+        KeyValue kv;
+        kv.key = "MessageQueueSizeThresholdBytes";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(size_threshold_bytes.value()));
+        size_threshold_bytes_kv.emplace(kv);
+    }
+    return size_threshold_bytes_kv;
+}
+
+std::optional<int> ChargePointConfiguration::getMessageQueueUpdateThinningResolution() {
+    std::optional<int> thinning_resolution = std::nullopt;
+    if (this->config["Internal"].contains("MessageQueueUpdateThinningResolution")) {
+        thinning_resolution.emplace(this->config["Internal"]["MessageQueueUpdateThinningResolution"]);
+    }
+    return thinning_resolution;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getMessageQueueUpdateThinningResolutionKeyValue() {
+    std::optional<KeyValue> thinning_resolution_kv = std::nullopt;
+    auto thinning_resolution = this->getMessageQueueUpdateThinningResolution();
+    if (thinning_resolution.has_value()) {
+        KeyValue kv;
+        kv.key = "MessageQueueUpdateThinningResolution";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(thinning_resolution.value()));
+        thinning_resolution_kv.emplace(kv);
+    }
+    return thinning_resolution_kv;
+}
+
+std::optional<int> ChargePointConfiguration::getMessageQueuePersistenceFlushInterval() {
+    std::optional<int> flush_interval = std::nullopt;
+    if (this->config["Internal"].contains("MessageQueuePersistenceFlushInterval")) {
+        flush_interval.emplace(this->config["Internal"]["MessageQueuePersistenceFlushInterval"]);
+    }
+    return flush_interval;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getMessageQueuePersistenceFlushIntervalKeyValue() {
+    std::optional<KeyValue> flush_interval_kv = std::nullopt;
+    auto flush_interval = this->getMessageQueuePersistenceFlushInterval();
+    if (flush_interval.has_value()) {
+        KeyValue kv;
+        kv.key = "MessageQueuePersistenceFlushInterval";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(flush_interval.value()));
+        flush_interval_kv.emplace(kv);
+    }
+    return flush_interval_kv;
+}
+
+std::optional<int> ChargePointConfiguration::getMessageQueuePersistenceMaxPendingOperations() {
+    std::optional<int> max_pending_operations = std::nullopt;
+    if (this->config["Internal"].contains("MessageQueuePersistenceMaxPendingOperations")) {
+        max_pending_operations.emplace(this->config["Internal"]["MessageQueuePersistenceMaxPendingOperations"]);
+    }
+    return max_pending_operations;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getMessageQueuePersistenceMaxPendingOperationsKeyValue() {
+    std::optional<KeyValue> max_pending_operations_kv = std::nullopt;
+    auto max_pending_operations = this->getMessageQueuePersistenceMaxPendingOperations();
+    if (max_pending_operations.has_value()) {
+        KeyValue kv;
+        kv.key = "MessageQueuePersistenceMaxPendingOperations";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(max_pending_operations.value()));
+        max_pending_operations_kv.emplace(kv);
+    }
+    return max_pending_operations_kv;
+}
+
+std::optional<std::string> ChargePointConfiguration::getMessageQueuePersistenceFormat() {
+    if (this->config["Internal"].contains("MessageQueuePersistenceFormat")) {
+        return this->config["Internal"]["MessageQueuePersistenceFormat"];
+    }
+    return std::nullopt;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getMessageQueuePersistenceFormatKeyValue() {
+    std::optional<KeyValue> persistence_format_kv = std::nullopt;
+    auto persistence_format = this->getMessageQueuePersistenceFormat();
+    if (persistence_format.has_value()) {
+        KeyValue kv;
+        kv.key = "MessageQueuePersistenceFormat";
+        kv.readonly = true;
+        kv.value.emplace(persistence_format.value());
+        persistence_format_kv.emplace(kv);
+    }
+    return persistence_format_kv;
+}
+
+std::optional<std::string> ChargePointConfiguration::getDatabaseTuningProfile() {
+    if (this->config["Internal"].contains("DatabaseTuningProfile")) {
+        return this->config["Internal"]["DatabaseTuningProfile"];
+    }
+    return std::nullopt;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getDatabaseTuningProfileKeyValue() {
+    std::optional<KeyValue> tuning_profile_kv = std::nullopt;
+    auto tuning_profile = this->getDatabaseTuningProfile();
+    if (tuning_profile.has_value()) {
+        KeyValue kv;
+        kv.key = "DatabaseTuningProfile";
+        kv.readonly = true;
+        kv.value.emplace(tuning_profile.value());
+        tuning_profile_kv.emplace(kv);
+    }
+    return tuning_profile_kv;
+}
+
+std::optional<int> ChargePointConfiguration::getDatabaseReadConnections() {
+    std::optional<int> read_connections = std::nullopt;
+    if (this->config["Internal"].contains("DatabaseReadConnections")) {
+        read_connections.emplace(this->config["Internal"]["DatabaseReadConnections"]);
+    }
+    return read_connections;
+}
+
+std::optional<KeyValue> ChargePointConfiguration::getDatabaseReadConnectionsKeyValue() {
+    std::optional<KeyValue> read_connections_kv = std::nullopt;
+    auto read_connections = this->getDatabaseReadConnections();
+    if (read_connections.has_value()) {
+        KeyValue kv;
+        kv.key = "DatabaseReadConnections";
+        kv.readonly = true;
+        kv.value.emplace(std::to_string(read_connections.value()));
+        read_connections_kv.emplace(kv);
+    }
+    return read_connections_kv;
+}
+
 // Core Profile - optional
 std::optional<bool> ChargePointConfiguration::getAllowOfflineTxForUnknownId() {
     std::optional<bool> unknown_offline_auth = std::nullopt;
@@ -3095,6 +3513,42 @@ std::optional<KeyValue> ChargePointConfiguration::get(CiString<50> key) {
     if (key == "WebsocketPongTimeout") {
         return this->getWebsocketPongTimeoutKeyValue();
     }
+    if (key == "WebsocketMessageFragmentSize") {
+        return this->getWebsocketMessageFragmentSizeKeyValue();
+    }
+    if (key == "WebsocketPermessageDeflate") {
+        return this->getWebsocketPermessageDeflateKeyValue();
+    }
+    if (key == "WebsocketPermessageDeflateNoContextTakeover") {
+        return this->getWebsocketPermessageDeflateNoContextTakeoverKeyValue();
+    }
+    if (key == "WebsocketPermessageDeflateMaxWindowBits") {
+        return this->getWebsocketPermessageDeflateMaxWindowBitsKeyValue();
+    }
+    if (key == "WebsocketIncrementalMessageParsing") {
+        return this->getWebsocketIncrementalMessageParsingKeyValue();
+    }
+    if (key == "WebsocketSharedContext") {
+        return this->getWebsocketSharedContextKeyValue();
+    }
+    if (key == "WebsocketTlsSessionResumption") {
+        return this->getWebsocketTlsSessionResumptionKeyValue();
+    }
+    if (key == "WebsocketPersistTlsSessions") {
+        return this->getWebsocketPersistTlsSessionsKeyValue();
+    }
+    if (key == "RetryBackoffDecorrelatedJitter") {
+        return this->getRetryBackoffDecorrelatedJitterKeyValue();
+    }
+    if (key == "RetryBackoffMaximum") {
+        return this->getRetryBackoffMaximumKeyValue();
+    }
+    if (key == "RetryBackoffSpread") {
+        return this->getRetryBackoffSpreadKeyValue();
+    }
+    if (key == "SingleThreadedEventLoop") {
+        return this->getSingleThreadedEventLoopKeyValue();
+    }
     if (key == "UseSslDefaultVerifyPaths") {
         return this->getUseSslDefaultVerifyPathsKeyValue();
     }
@@ -3143,6 +3597,30 @@ std::optional<KeyValue> ChargePointConfiguration::get(CiString<50> key) {
     if (key == "MessageQueueSizeThreshold") {
         return this->getMessageQueueSizeThresholdKeyValue();
     }
+    if (key == "MessageQueueMaxMessagesInFlight") {
+        return this->getMessageQueueMaxMessagesInFlightKeyValue();
+    }
+    if (key == "MessageQueueSizeThresholdBytes") {
+        return this->getMessageQueueSizeThresholdBytesKeyValue();
+    }
+    if (key == "MessageQueueUpdateThinningResolution") {
+        return this->getMessageQueueUpdateThinningResolutionKeyValue();
+    }
+    if (key == "MessageQueuePersistenceFlushInterval") {
+        return this->getMessageQueuePersistenceFlushIntervalKeyValue();
+    }
+    if (key == "MessageQueuePersistenceMaxPendingOperations") {
+        return this->getMessageQueuePersistenceMaxPendingOperationsKeyValue();
+    }
+    if (key == "MessageQueuePersistenceFormat") {
+        return this->getMessageQueuePersistenceFormatKeyValue();
+    }
+    if (key == "DatabaseTuningProfile") {
+        return this->getDatabaseTuningProfileKeyValue();
+    }
+    if (key == "DatabaseReadConnections") {
+        return this->getDatabaseReadConnectionsKeyValue();
+    }
     if (key == "StopTransactionIfUnlockNotSupported") {
         return this->getStopTransactionIfUnlockNotSupportedKeyValue();
     }
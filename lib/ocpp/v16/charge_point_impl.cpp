@@ -32,6 +32,8 @@ const auto OCSP_REQUEST_TIMER_INTERVAL = std::chrono::hours(12);
 const auto INITIAL_CERTIFICATE_REQUESTS_DELAY = std::chrono::seconds(60);
 const auto WEBSOCKET_INIT_DELAY = std::chrono::seconds(2);
 const auto DEFAULT_MESSAGE_QUEUE_SIZE_THRESHOLD = 2E5;
+const auto DEFAULT_MESSAGE_QUEUE_MAX_MESSAGES_IN_FLIGHT = 1;
+const auto DEFAULT_MESSAGE_QUEUE_PERSISTENCE_MAX_PENDING_OPERATIONS = 100;
 const auto DEFAULT_BOOT_NOTIFICATION_INTERVAL_S = 60; // fallback interval if BootNotification returns interval of 0.
 const auto DEFAULT_PRICE_NUMBER_OF_DECIMALS = 3;
 
@@ -56,6 +58,16 @@ ChargePointImpl::ChargePointImpl(const std::string& config, const fs::path& shar
         std::make_unique<common::DatabaseConnection>(database_path / (this->configuration->getChargePointId() + ".db"));
     this->database_handler = std::make_shared<DatabaseHandler>(std::move(database_connection), sql_init_path,
                                                                this->configuration->getNumberOfConnectors());
+    common::DatabaseTuningProfile database_tuning_profile;
+    try {
+        database_tuning_profile =
+            common::get_database_tuning_profile(this->configuration->getDatabaseTuningProfile().value_or("Default"));
+    } catch (const StringToEnumException& e) {
+        EVLOG_warning << "Could not apply DatabaseTuningProfile configuration: " << e.what();
+    }
+    database_tuning_profile.read_connections =
+        static_cast<std::size_t>(std::max(this->configuration->getDatabaseReadConnections().value_or(0), 0));
+    this->database_handler->set_tuning_profile(database_tuning_profile);
     this->database_handler->open_connection();
     this->transaction_handler = std::make_unique<TransactionHandler>(this->configuration->getNumberOfConnectors());
     this->external_notify = {v16::MessageType::StartTransactionResponse};
@@ -199,10 +211,17 @@ ChargePointImpl::ChargePointImpl(const std::string& config, const fs::path& shar
             [this](ocpp::Call<ocpp::v16::DataTransferRequest> call) {
                 this->handle_data_transfer_install_certificate(call);
             };
-        this->ocsp_request_timer = std::make_unique<Everest::SteadyTimer>(&this->io_context, [this]() {
+        // update_ocsp_cache() waits for the responses of its requests, so it must not run on the event loop that
+        // processes these responses
+        const auto update_ocsp_cache = [this]() {
             this->update_ocsp_cache();
             this->ocsp_request_timer->interval(OCSP_REQUEST_TIMER_INTERVAL);
-        });
+        };
+        if (this->configuration->getSingleThreadedEventLoop().value_or(false)) {
+            this->ocsp_request_timer = std::make_unique<Everest::SteadyTimer>(update_ocsp_cache);
+        } else {
+            this->ocsp_request_timer = std::make_unique<Everest::SteadyTimer>(&this->io_context, update_ocsp_cache);
+        }
     }
 
     // California pricing requirements
@@ -273,21 +292,74 @@ std::unique_ptr<ocpp::MessageQueue<v16::MessageType>> ChargePointImpl::create_me
         }
     }
 
+    MessageQueueConfig<v16::MessageType> message_queue_config{
+        this->configuration->getTransactionMessageAttempts(), this->configuration->getTransactionMessageRetryInterval(),
+        this->configuration->getMessageQueueSizeThreshold().value_or(DEFAULT_MESSAGE_QUEUE_SIZE_THRESHOLD),
+        this->configuration->getQueueAllMessages().value_or(false), message_types_discard_for_queueing};
+    message_queue_config.max_messages_in_flight = this->configuration->getMessageQueueMaxMessagesInFlight().value_or(
+        DEFAULT_MESSAGE_QUEUE_MAX_MESSAGES_IN_FLIGHT);
+    message_queue_config.queues_total_size_threshold_bytes =
+        static_cast<std::size_t>(this->configuration->getMessageQueueSizeThresholdBytes().value_or(0));
+    message_queue_config.transaction_update_thinning_resolution_seconds =
+        this->configuration->getMessageQueueUpdateThinningResolution().value_or(0);
+
+    this->database_handler->set_message_queue_write_behind_config(
+        {std::chrono::milliseconds(this->configuration->getMessageQueuePersistenceFlushInterval().value_or(0)),
+         static_cast<std::size_t>(this->configuration->getMessageQueuePersistenceMaxPendingOperations().value_or(
+             DEFAULT_MESSAGE_QUEUE_PERSISTENCE_MAX_PENDING_OPERATIONS))});
+
+    try {
+        this->database_handler->set_message_queue_persistence_format(
+            ocpp::conversions::string_to_message_queue_persistence_format(
+                this->configuration->getMessageQueuePersistenceFormat().value_or("JSON")));
+    } catch (const StringToEnumException& e) {
+        EVLOG_warning << "Could not apply MessageQueuePersistenceFormat configuration: " << e.what();
+    }
+
     return std::make_unique<ocpp::MessageQueue<v16::MessageType>>(
-        [this](json message) -> bool { return this->websocket->send(message.dump()); },
-        MessageQueueConfig<v16::MessageType>{
-            this->configuration->getTransactionMessageAttempts(),
-            this->configuration->getTransactionMessageRetryInterval(),
-            this->configuration->getMessageQueueSizeThreshold().value_or(DEFAULT_MESSAGE_QUEUE_SIZE_THRESHOLD),
-            this->configuration->getQueueAllMessages().value_or(false), message_types_discard_for_queueing},
+        [this](json message) -> bool { return this->websocket->send(message); }, message_queue_config,
         this->external_notify, this->database_handler, start_transaction_message_retry_callback);
 }
 
+std::shared_ptr<TlsSessionCache> ChargePointImpl::create_tls_session_cache() {
+    auto cache = std::make_shared<TlsSessionCache>();
+    if (!this->configuration->getWebsocketPersistTlsSessions().value_or(false)) {
+        return cache;
+    }
+
+    try {
+        // Only the sessions that are still resumable are kept in the database
+        const auto sessions = this->database_handler->get_tls_sessions();
+        this->database_handler->clear_tls_sessions();
+        for (const auto& [key, session] : sessions) {
+            if (cache->restore(key, session)) {
+                this->database_handler->insert_or_update_tls_session(key, session);
+            }
+        }
+    } catch (const QueryExecutionException& e) {
+        EVLOG_warning << "Could not restore TLS sessions from the database: " << e.what();
+    }
+
+    // called on the thread that runs the TLS handshake, so the session is written by the database worker
+    cache->register_session_stored_callback(
+        [database_handler = this->database_handler](const std::string& key, const std::vector<std::uint8_t>& session) {
+            database_handler->insert_or_update_tls_session_async(key, session);
+        });
+    return cache;
+}
+
 void ChargePointImpl::init_websocket() {
+    if (this->tls_session_cache == nullptr and
+        this->configuration->getWebsocketTlsSessionResumption().value_or(false)) {
+        this->tls_session_cache = this->create_tls_session_cache();
+    }
 
     auto connection_options = this->get_ws_connection_options();
 
     this->websocket = std::make_unique<Websocket>(connection_options, this->evse_security, this->logging);
+    if (this->configuration->getSingleThreadedEventLoop().value_or(false)) {
+        this->websocket->set_event_loop(this->io_context);
+    }
     this->websocket->register_connected_callback([this](OcppProtocolVersion protocol) {
         if (this->connection_state_changed_callback != nullptr) {
             this->connection_state_changed_callback(true);
@@ -336,6 +408,9 @@ void ChargePointImpl::init_websocket() {
     });
 
     this->websocket->register_message_callback([this](const std::string& message) { this->message_callback(message); });
+    this->websocket->register_parsed_message_callback([this](json&& message, std::size_t message_size) {
+        this->parsed_message_callback(std::move(message), message_size);
+    });
 }
 void ChargePointImpl::init_state_machine(const std::map<int, ChargePointStatus>& connector_status_map) {
     // if connector_status_map empty it retrieves the last availablity states from the database
@@ -369,6 +444,16 @@ WebsocketConnectionOptions ChargePointImpl::get_ws_connection_options() {
     auto security_profile = this->configuration->getSecurityProfile();
     auto uri = Uri::parse_and_validate(this->configuration->getCentralSystemURI(),
                                        this->configuration->getChargePointId(), security_profile);
+    const auto message_fragment_size = std::max(0, this->configuration->getWebsocketMessageFragmentSize().value_or(0));
+
+    std::optional<PerMessageDeflateOptions> permessage_deflate;
+    if (this->configuration->getWebsocketPermessageDeflate().value_or(false)) {
+        const auto no_context_takeover =
+            this->configuration->getWebsocketPermessageDeflateNoContextTakeover().value_or(false);
+        const auto max_window_bits = this->configuration->getWebsocketPermessageDeflateMaxWindowBits().value_or(15);
+        permessage_deflate = PerMessageDeflateOptions{no_context_takeover, no_context_takeover, max_window_bits,
+                                                      max_window_bits};
+    }
 
     WebsocketConnectionOptions connection_options{{OcppProtocolVersion::v16},
                                                   uri,
@@ -391,7 +476,17 @@ WebsocketConnectionOptions ChargePointImpl::get_ws_connection_options() {
                                                   this->configuration->getVerifyCsmsAllowWildcards(),
                                                   this->configuration->getIFace(),
                                                   this->configuration->getEnableTLSKeylog(),
-                                                  this->configuration->getTLSKeylogFile()};
+                                                  this->configuration->getTLSKeylogFile(),
+                                                  static_cast<std::size_t>(message_fragment_size),
+                                                  permessage_deflate,
+                                                  this->configuration->getWebsocketIncrementalMessageParsing().value_or(
+                                                      false),
+                                                  this->configuration->getWebsocketSharedContext().value_or(false),
+                                                  this->tls_session_cache,
+                                                  this->configuration->getRetryBackoffDecorrelatedJitter().value_or(
+                                                      false),
+                                                  this->configuration->getRetryBackoffMaximum().value_or(0),
+                                                  this->configuration->getRetryBackoffSpread().value_or(0)};
     return connection_options;
 }
 
@@ -1085,7 +1180,11 @@ void ChargePointImpl::reset_pricing_triggers(const int32_t connector_number) {
 
 bool ChargePointImpl::start(const std::map<int, ChargePointStatus>& connector_status_map, BootReasonEnum bootreason,
                             const std::set<std::string>& resuming_session_ids) {
-    this->message_queue->start();
+    if (this->configuration->getSingleThreadedEventLoop().value_or(false)) {
+        this->message_queue->start(this->io_context);
+    } else {
+        this->message_queue->start();
+    }
     this->bootreason = bootreason;
     this->init_state_machine(connector_status_map);
     this->init_websocket();
@@ -1272,30 +1371,60 @@ void ChargePointImpl::connected_callback() {
 void ChargePointImpl::message_callback(const std::string& message) {
     EVLOG_debug << "Received Message: " << message;
 
+    const auto enhanced_message = this->receive_message([this, &message]() {
+        return this->message_queue->receive(message);
+    });
+    if (!enhanced_message.has_value()) {
+        return;
+    }
+
+    this->logging->central_system(conversions::messagetype_to_string(enhanced_message->messageType), message);
+    this->process_received_message(enhanced_message.value(), [&message]() { return message; });
+}
+
+void ChargePointImpl::parsed_message_callback(json&& message, std::size_t message_size) {
+    const auto enhanced_message = this->receive_message([this, &message, message_size]() {
+        return this->message_queue->receive(std::move(message), message_size);
+    });
+    if (!enhanced_message.has_value()) {
+        return;
+    }
+
+    this->logging->central_system(conversions::messagetype_to_string(enhanced_message->messageType),
+                                  enhanced_message->message);
+    this->process_received_message(enhanced_message.value(),
+                                   [&enhanced_message]() { return enhanced_message->message.dump(); });
+}
+
+std::optional<EnhancedMessage<v16::MessageType>>
+ChargePointImpl::receive_message(const std::function<EnhancedMessage<v16::MessageType>()>& receive) {
     EnhancedMessage<v16::MessageType> enhanced_message;
     try {
-        enhanced_message = this->message_queue->receive(message);
+        enhanced_message = receive();
     } catch (const TimePointParseException& e) {
         EVLOG_error << "Exception during handling of message: " << e.what();
         this->message_dispatcher->dispatch_call_error(
             CallError(enhanced_message.uniqueId, "FormationViolation", e.what(), json({})));
-        return;
+        return std::nullopt;
     } catch (const json::exception& e) {
         EVLOG_error << "JSON exception during reception of message: " << e.what();
         this->message_dispatcher->dispatch_call_error(CallError(MessageId("-1"), "GenericError", e.what(), json({})));
-        return;
+        return std::nullopt;
     } catch (const std::runtime_error& e) {
         EVLOG_error << "runtime_error during reception of message: " << e.what();
         this->message_dispatcher->dispatch_call_error(CallError(MessageId("-1"), "GenericError", e.what(), json({})));
-        return;
+        return std::nullopt;
     } catch (const std::exception& e) {
         EVLOG_error << "Exception during reception of message: " << e.what();
         this->message_dispatcher->dispatch_call_error(CallError(MessageId("-1"), "GenericError", e.what(), json({})));
-        return;
+        return std::nullopt;
     }
+    return enhanced_message;
+}
 
-    auto json_message = enhanced_message.message;
-    this->logging->central_system(conversions::messagetype_to_string(enhanced_message.messageType), message);
+void ChargePointImpl::process_received_message(const EnhancedMessage<v16::MessageType>& enhanced_message,
+                                               const std::function<std::string()>& raw_message) {
+    const auto& json_message = enhanced_message.message;
     try {
         // reject unsupported messages
         if (this->configuration->getSupportedMessageTypesReceiving().count(enhanced_message.messageType) == 0) {
@@ -1306,7 +1435,8 @@ void ChargePointImpl::message_callback(const std::string& message) {
                 this->message_dispatcher->dispatch_call_error(call_error);
             } else if (enhanced_message.messageTypeId == MessageTypeId::CALLERROR) {
                 EVLOG_error << "Received a CALLERROR in response to a "
-                            << conversions::messagetype_to_string(enhanced_message.messageType) << ": " << message;
+                            << conversions::messagetype_to_string(enhanced_message.messageType) << ": "
+                            << raw_message();
             }
             // in any case stop message handling here:
             return;
@@ -1371,7 +1501,7 @@ void ChargePointImpl::message_callback(const std::string& message) {
     } catch (json::exception& e) {
         EVLOG_error << "JSON exception during handling of message: " << e.what();
         this->securityEventNotification(ocpp::security_events::INVALIDMESSAGES,
-                                        CiString<255>(message, StringTooLarge::Truncate), true);
+                                        CiString<255>(raw_message(), StringTooLarge::Truncate), true);
         if (enhanced_message.messageTypeId != MessageTypeId::CALL) {
             return; // CALLERROR shall only follow on a CALL message
         }
@@ -1382,7 +1512,7 @@ void ChargePointImpl::message_callback(const std::string& message) {
     } catch (const EnumConversionException& e) {
         EVLOG_error << "EnumConversionException during handling of message: " << e.what();
         this->securityEventNotification(ocpp::security_events::INVALIDMESSAGES,
-                                        CiString<255>(message, StringTooLarge::Truncate), true);
+                                        CiString<255>(raw_message(), StringTooLarge::Truncate), true);
         if (enhanced_message.messageTypeId != MessageTypeId::CALL) {
             return; // CALLERROR shall only follow on a CALL message
         }
@@ -1391,7 +1521,7 @@ void ChargePointImpl::message_callback(const std::string& message) {
     } catch (const StringConversionException& e) {
         EVLOG_error << "StringConversionException during handling of message: " << e.what();
         this->securityEventNotification(ocpp::security_events::INVALIDMESSAGES,
-                                        CiString<255>(message, StringTooLarge::Truncate), true);
+                                        CiString<255>(raw_message(), StringTooLarge::Truncate), true);
         if (enhanced_message.messageTypeId != MessageTypeId::CALL) {
             return; // CALLERROR shall only follow on a CALL message
         }
@@ -3406,6 +3536,11 @@ IdTagInfo ChargePointImpl::authorize_id_token(CiString<20> idTag, const bool aut
     AuthorizeRequest req;
     req.idTag = idTag;
 
+    if (!this->message_dispatcher->can_wait_for_response()) {
+        EVLOG_error << "Authorize.req can not wait for its response on the event loop, not sending it";
+        return {AuthorizationStatus::Invalid, std::nullopt, std::nullopt};
+    }
+
     ocpp::Call<AuthorizeRequest> call(req);
 
     auto authorize_future = this->message_dispatcher->dispatch_call_async(call);
@@ -3622,6 +3757,12 @@ ocpp::v2::AuthorizeResponse ChargePointImpl::data_transfer_pnc_authorize(
         // AuthorizeRequest sent to CSMS, let's show the results
         req.data.emplace(json(authorize_req).dump());
 
+        if (!this->message_dispatcher->can_wait_for_response()) {
+            EVLOG_error << "DataTransfer.req(Authorize) can not wait for its response on the event loop, not "
+                           "sending it";
+            return authorize_response;
+        }
+
         // Send the DataTransfer(Authorize) to the CSMS
         Call<DataTransferRequest> call(req);
         auto authorize_future = this->message_dispatcher->dispatch_call_async(call);
@@ -3731,6 +3872,12 @@ void ChargePointImpl::data_transfer_pnc_get_15118_ev_certificate(
 
     req.data.emplace(json(cert_req).dump());
 
+    if (!this->message_dispatcher->can_wait_for_response()) {
+        EVLOG_error << "DataTransfer.req(Get15118EVCertificate) can not wait for its response on the event loop, not "
+                       "sending it";
+        return;
+    }
+
     Call<DataTransferRequest> call(req);
     auto future = this->message_dispatcher->dispatch_call_async(call);
 
@@ -3781,6 +3928,12 @@ void ChargePointImpl::data_transfer_pnc_get_certificate_status(const ocpp::v2::O
 
     req.data.emplace(json(cert_status_req).dump());
 
+    if (!this->message_dispatcher->can_wait_for_response()) {
+        EVLOG_error << "DataTransfer.req(GetCertificateStatus) can not wait for its response on the event loop, not "
+                       "sending it";
+        return;
+    }
+
     Call<DataTransferRequest> call(req);
     auto future = this->message_dispatcher->dispatch_call_async(call);
 
@@ -4034,6 +4187,11 @@ std::optional<DataTransferResponse> ChargePointImpl::data_transfer(const CiStrin
 
     DataTransferResponse response;
     response.status = DataTransferStatus::Rejected;
+    if (!this->message_dispatcher->can_wait_for_response()) {
+        EVLOG_error << "DataTransfer.req can not wait for its response on the event loop, not sending it";
+        return std::nullopt;
+    }
+
     ocpp::Call<DataTransferRequest> call(req);
     auto data_transfer_future = this->message_dispatcher->dispatch_call_async(call);
 
@@ -17,6 +17,14 @@ DatabaseHandler::DatabaseHandler(std::unique_ptr<DatabaseConnectionInterface> da
     number_of_connectors(number_of_connectors) {
 }
 
+DatabaseHandler::~DatabaseHandler() {
+    try {
+        this->close();
+    } catch (const QueryExecutionException& e) {
+        EVLOG_error << e.what();
+    }
+}
+
 void DatabaseHandler::init_sql() {
     this->init_connector_table();
     try {
@@ -46,6 +46,10 @@ namespace ocpp {
 namespace v2 {
 
 const auto DEFAULT_MESSAGE_QUEUE_SIZE_THRESHOLD = 2E5;
+const auto DEFAULT_MESSAGE_QUEUE_MAX_MESSAGES_IN_FLIGHT = 1;
+const auto DEFAULT_MESSAGE_QUEUE_PERSISTENCE_MAX_PENDING_OPERATIONS = 100;
+const auto DEFAULT_MESSAGE_QUEUE_TRANSACTION_COMPACTION_INTERVAL = 900;
+const auto DEFAULT_TRANSACTION_WRITE_BEHIND_MAX_QUEUE_SIZE = 1000;
 
 ChargePoint::ChargePoint(const std::map<int32_t, int32_t>& evse_connector_structure,
                          std::shared_ptr<DeviceModel> device_model, std::shared_ptr<DatabaseHandler> database_handler,
@@ -108,7 +112,14 @@ ChargePoint::~ChargePoint() {
 }
 
 void ChargePoint::start(BootReasonEnum bootreason, bool start_connecting) {
-    this->message_queue->start();
+    const auto single_threaded_event_loop =
+        this->device_model->get_optional_value<bool>(ControllerComponentVariables::SingleThreadedEventLoop)
+            .value_or(false);
+    if (single_threaded_event_loop) {
+        this->message_queue->start(this->io_context);
+    } else {
+        this->message_queue->start();
+    }
 
     this->bootreason = bootreason;
     // Trigger all initial status notifications and callbacks related to component state
@@ -242,6 +253,34 @@ void ChargePoint::on_meter_value(const int32_t evse_id, const MeterValue& meter_
     this->meter_values->on_meter_value(evse_id, meter_value);
 }
 
+std::shared_ptr<TlsSessionCache> ChargePoint::create_tls_session_cache() {
+    auto cache = std::make_shared<TlsSessionCache>();
+    if (!this->device_model->get_optional_value<bool>(ControllerComponentVariables::WebsocketPersistTlsSessions)
+             .value_or(false)) {
+        return cache;
+    }
+
+    try {
+        // Only the sessions that are still resumable are kept in the database
+        const auto sessions = this->database_handler->get_tls_sessions();
+        this->database_handler->clear_tls_sessions();
+        for (const auto& [key, session] : sessions) {
+            if (cache->restore(key, session)) {
+                this->database_handler->insert_or_update_tls_session(key, session);
+            }
+        }
+    } catch (const DatabaseException& e) {
+        EVLOG_warning << "Could not restore TLS sessions from the database: " << e.what();
+    }
+
+    // called on the thread that runs the TLS handshake, so the session is written by the database worker
+    cache->register_session_stored_callback(
+        [database_handler = this->database_handler](const std::string& key, const std::vector<std::uint8_t>& session) {
+            database_handler->insert_or_update_tls_session_async(key, session);
+        });
+    return cache;
+}
+
 void ChargePoint::configure_message_logging_format(const std::string& message_log_path) {
     auto log_formats = this->device_model->get_value<std::string>(ControllerComponentVariables::LogMessagesFormat);
     bool log_to_console = log_formats.find("console") != log_formats.npos;
@@ -400,7 +439,28 @@ void ChargePoint::on_ev_charging_needs(const NotifyEVChargingNeedsRequest& reque
 void ChargePoint::initialize(const std::map<int32_t, int32_t>& evse_connector_structure,
                              const std::string& message_log_path) {
     this->device_model->check_integrity(evse_connector_structure);
+    common::DatabaseTuningProfile database_tuning_profile;
+    try {
+        database_tuning_profile = common::get_database_tuning_profile(
+            this->device_model->get_optional_value<std::string>(ControllerComponentVariables::DatabaseTuningProfile)
+                .value_or("Default"));
+    } catch (const StringToEnumException& e) {
+        EVLOG_warning << "Could not apply DatabaseTuningProfile configuration: " << e.what();
+    }
+    database_tuning_profile.read_connections = static_cast<std::size_t>(std::max(
+        this->device_model->get_optional_value<int>(ControllerComponentVariables::DatabaseReadConnections).value_or(0),
+        0));
+    this->database_handler->set_tuning_profile(database_tuning_profile);
     this->database_handler->open_connection();
+    TransactionWriteBehindConfig transaction_write_behind_config;
+    transaction_write_behind_config.enabled =
+        this->device_model->get_optional_value<bool>(ControllerComponentVariables::TransactionWriteBehind)
+            .value_or(false);
+    transaction_write_behind_config.max_queue_size = static_cast<std::size_t>(std::max(
+        this->device_model->get_optional_value<int>(ControllerComponentVariables::TransactionWriteBehindMaxQueueSize)
+            .value_or(DEFAULT_TRANSACTION_WRITE_BEHIND_MAX_QUEUE_SIZE),
+        1));
+    this->database_handler->set_transaction_write_behind_config(transaction_write_behind_config);
     this->component_state_manager = std::make_shared<ComponentStateManager>(
         evse_connector_structure, database_handler,
         [this](auto evse_id, auto connector_id, auto status, bool initiated_by_trigger_message) {
@@ -458,9 +518,19 @@ void ChargePoint::initialize(const std::map<int32_t, int32_t>& evse_connector_st
         transaction_meter_value_callback, this->callbacks.pause_charging_callback);
     this->configure_message_logging_format(message_log_path);
 
-    this->connectivity_manager =
-        std::make_unique<ConnectivityManager>(*this->device_model, this->evse_security, this->logging,
-                                              std::bind(&ChargePoint::message_callback, this, std::placeholders::_1));
+    const auto single_threaded_event_loop =
+        this->device_model->get_optional_value<bool>(ControllerComponentVariables::SingleThreadedEventLoop)
+            .value_or(false);
+    std::shared_ptr<TlsSessionCache> tls_session_cache;
+    if (this->device_model->get_optional_value<bool>(ControllerComponentVariables::WebsocketTlsSessionResumption)
+            .value_or(false)) {
+        tls_session_cache = this->create_tls_session_cache();
+    }
+    this->connectivity_manager = std::make_unique<ConnectivityManager>(
+        *this->device_model, this->evse_security, this->logging,
+        std::bind(&ChargePoint::message_callback, this, std::placeholders::_1),
+        std::bind(&ChargePoint::parsed_message_callback, this, std::placeholders::_1, std::placeholders::_2),
+        single_threaded_event_loop ? &this->io_context : nullptr, tls_session_cache);
 
     this->connectivity_manager->set_websocket_connected_callback(
         [this](int configuration_slot, const NetworkConnectionProfile& network_connection_profile,
@@ -493,18 +563,60 @@ void ChargePoint::initialize(const std::map<int32_t, int32_t>& evse_connector_st
             EVLOG_warning << "Could not apply MessageTypesDiscardForQueueing configuration";
         }
 
+        MessageQueueConfig<v2::MessageType> message_queue_config{
+            this->device_model->get_value<int>(ControllerComponentVariables::MessageAttempts),
+            this->device_model->get_value<int>(ControllerComponentVariables::MessageAttemptInterval),
+            this->device_model->get_optional_value<int>(ControllerComponentVariables::MessageQueueSizeThreshold)
+                .value_or(DEFAULT_MESSAGE_QUEUE_SIZE_THRESHOLD),
+            this->device_model->get_optional_value<bool>(ControllerComponentVariables::QueueAllMessages)
+                .value_or(false),
+            message_types_discard_for_queueing,
+            this->device_model->get_value<int>(ControllerComponentVariables::MessageTimeout)};
+        message_queue_config.max_messages_in_flight =
+            this->device_model
+                ->get_optional_value<int>(ControllerComponentVariables::MessageQueueMaxMessagesInFlight)
+                .value_or(DEFAULT_MESSAGE_QUEUE_MAX_MESSAGES_IN_FLIGHT);
+        message_queue_config.queues_total_size_threshold_bytes = static_cast<std::size_t>(
+            this->device_model->get_optional_value<int>(ControllerComponentVariables::MessageQueueSizeThresholdBytes)
+                .value_or(0));
+        message_queue_config.transaction_update_thinning_resolution_seconds =
+            this->device_model
+                ->get_optional_value<int>(ControllerComponentVariables::MessageQueueUpdateThinningResolution)
+                .value_or(0);
+        message_queue_config.transaction_message_compaction_threshold =
+            this->device_model
+                ->get_optional_value<int>(ControllerComponentVariables::MessageQueueTransactionCompactionThreshold)
+                .value_or(0);
+        message_queue_config.transaction_message_compaction_interval_seconds =
+            this->device_model
+                ->get_optional_value<int>(ControllerComponentVariables::MessageQueueTransactionCompactionInterval)
+                .value_or(DEFAULT_MESSAGE_QUEUE_TRANSACTION_COMPACTION_INTERVAL);
+
+        const auto persistence_flush_interval =
+            this->device_model
+                ->get_optional_value<int>(ControllerComponentVariables::MessageQueuePersistenceFlushInterval)
+                .value_or(0);
+        const auto persistence_max_pending_operations =
+            this->device_model
+                ->get_optional_value<int>(ControllerComponentVariables::MessageQueuePersistenceMaxPendingOperations)
+                .value_or(DEFAULT_MESSAGE_QUEUE_PERSISTENCE_MAX_PENDING_OPERATIONS);
+        this->database_handler->set_message_queue_write_behind_config(
+            {std::chrono::milliseconds(persistence_flush_interval),
+             static_cast<std::size_t>(persistence_max_pending_operations)});
+
+        try {
+            this->database_handler->set_message_queue_persistence_format(
+                ocpp::conversions::string_to_message_queue_persistence_format(
+                    this->device_model
+                        ->get_optional_value<std::string>(ControllerComponentVariables::MessageQueuePersistenceFormat)
+                        .value_or("JSON")));
+        } catch (const StringToEnumException& e) {
+            EVLOG_warning << "Could not apply MessageQueuePersistenceFormat configuration: " << e.what();
+        }
+
         this->message_queue = std::make_unique<ocpp::MessageQueue<v2::MessageType>>(
-            [this](json message) -> bool { return this->connectivity_manager->send_to_websocket(message.dump()); },
-            MessageQueueConfig<v2::MessageType>{
-                this->device_model->get_value<int>(ControllerComponentVariables::MessageAttempts),
-                this->device_model->get_value<int>(ControllerComponentVariables::MessageAttemptInterval),
-                this->device_model->get_optional_value<int>(ControllerComponentVariables::MessageQueueSizeThreshold)
-                    .value_or(DEFAULT_MESSAGE_QUEUE_SIZE_THRESHOLD),
-                this->device_model->get_optional_value<bool>(ControllerComponentVariables::QueueAllMessages)
-                    .value_or(false),
-                message_types_discard_for_queueing,
-                this->device_model->get_value<int>(ControllerComponentVariables::MessageTimeout)},
-            this->database_handler);
+            [this](json message) -> bool { return this->connectivity_manager->send_to_websocket(message); },
+            message_queue_config, this->database_handler);
     }
 
     this->message_dispatcher =
@@ -833,43 +945,70 @@ void ChargePoint::handle_message(const EnhancedMessage<v2::MessageType>& message
 }
 
 void ChargePoint::message_callback(const std::string& message) {
-    EnhancedMessage<v2::MessageType> enhanced_message;
+    const auto enhanced_message =
+        this->receive_message([this, &message]() { return this->message_queue->receive(message); },
+                              [&message]() { return message; });
+    if (!enhanced_message.has_value()) {
+        return;
+    }
+
+    this->logging->central_system(conversions::messagetype_to_string(enhanced_message->messageType), message);
+    this->process_received_message(enhanced_message.value());
+}
+
+void ChargePoint::parsed_message_callback(json&& message, std::size_t message_size) {
+    // the message queue only takes over the message if it is valid, so it is still available for error reports
+    const auto enhanced_message = this->receive_message(
+        [this, &message, message_size]() { return this->message_queue->receive(std::move(message), message_size); },
+        [&message]() { return message.dump(); });
+    if (!enhanced_message.has_value()) {
+        return;
+    }
+
+    this->logging->central_system(conversions::messagetype_to_string(enhanced_message->messageType),
+                                  enhanced_message->message);
+    this->process_received_message(enhanced_message.value());
+}
+
+std::optional<EnhancedMessage<v2::MessageType>>
+ChargePoint::receive_message(const std::function<EnhancedMessage<v2::MessageType>()>& receive,
+                             const std::function<std::string()>& raw_message) {
     try {
-        enhanced_message = this->message_queue->receive(message);
+        return receive();
     } catch (const json::exception& e) {
-        this->logging->central_system("Unknown", message);
+        this->logging->central_system("Unknown", raw_message());
         EVLOG_error << "JSON exception during reception of message: " << e.what();
         this->message_dispatcher->dispatch_call_error(
             CallError(MessageId("-1"), "RpcFrameworkError", e.what(), json({})));
         const auto& security_event = ocpp::security_events::INVALIDMESSAGES;
         this->security->security_event_notification_req(CiString<50>(security_event, StringTooLarge::Truncate),
-                                                        CiString<255>(message, StringTooLarge::Truncate), true,
+                                                        CiString<255>(raw_message(), StringTooLarge::Truncate), true,
                                                         utils::is_critical(security_event));
-        return;
+        return std::nullopt;
     } catch (const StringConversionException& e) {
-        this->logging->central_system("Unknown", message);
+        this->logging->central_system("Unknown", raw_message());
         EVLOG_error << "JSON exception during reception of message: " << e.what();
         this->message_dispatcher->dispatch_call_error(
             CallError(MessageId("-1"), "RpcFrameworkError", e.what(), json({})));
         const auto& security_event = ocpp::security_events::INVALIDMESSAGES;
         this->security->security_event_notification_req(CiString<50>(security_event, StringTooLarge::Truncate),
-                                                        CiString<255>(message, StringTooLarge::Truncate), true,
+                                                        CiString<255>(raw_message(), StringTooLarge::Truncate), true,
                                                         utils::is_critical(security_event));
-        return;
+        return std::nullopt;
     } catch (const EnumConversionException& e) {
         EVLOG_error << "EnumConversionException during handling of message: " << e.what();
         auto call_error = CallError(MessageId("-1"), "FormationViolation", e.what(), json({}));
         this->message_dispatcher->dispatch_call_error(call_error);
         const auto& security_event = ocpp::security_events::INVALIDMESSAGES;
         this->security->security_event_notification_req(CiString<50>(security_event, StringTooLarge::Truncate),
-                                                        CiString<255>(message, StringTooLarge::Truncate), true,
+                                                        CiString<255>(raw_message(), StringTooLarge::Truncate), true,
                                                         utils::is_critical(security_event));
-        return;
+        return std::nullopt;
     }
+}
 
-    enhanced_message.message_size = message.size();
-    auto json_message = enhanced_message.message;
-    this->logging->central_system(conversions::messagetype_to_string(enhanced_message.messageType), message);
+void ChargePoint::process_received_message(const EnhancedMessage<v2::MessageType>& enhanced_message) {
+    const auto& json_message = enhanced_message.message;
     try {
         if (this->registration_status == RegistrationStatusEnum::Accepted) {
             this->handle_message(enhanced_message);
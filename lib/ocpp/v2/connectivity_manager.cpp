@@ -21,12 +21,19 @@ namespace v2 {
 
 ConnectivityManager::ConnectivityManager(DeviceModel& device_model, std::shared_ptr<EvseSecurity> evse_security,
                                          std::shared_ptr<MessageLogging> logging,
-                                         const std::function<void(const std::string& message)>& message_callback) :
+                                         const std::function<void(const std::string& message)>& message_callback,
+                                         const std::function<void(json&& message, std::size_t message_size)>&
+                                             parsed_message_callback,
+                                         boost::asio::io_context* event_loop,
+                                         std::shared_ptr<TlsSessionCache> tls_session_cache) :
     device_model{device_model},
     evse_security{evse_security},
     logging{logging},
     websocket{nullptr},
     message_callback{message_callback},
+    parsed_message_callback{parsed_message_callback},
+    event_loop{event_loop},
+    tls_session_cache{tls_session_cache},
     wants_to_be_connected{false},
     active_network_configuration_priority{0},
     last_known_security_level{0},
@@ -233,6 +240,9 @@ void ConnectivityManager::try_connect_websocket() {
 
     if (this->websocket == nullptr) {
         this->websocket = std::make_unique<Websocket>(connection_options.value(), this->evse_security, this->logging);
+        if (this->event_loop != nullptr) {
+            this->websocket->set_event_loop(*this->event_loop);
+        }
 
         this->websocket->register_connected_callback(
             [this](OcppProtocolVersion protocol) { this->on_websocket_connected(protocol); });
@@ -250,6 +260,9 @@ void ConnectivityManager::try_connect_websocket() {
     }
 
     this->websocket->register_message_callback([this](const std::string& message) { this->message_callback(message); });
+    this->websocket->register_parsed_message_callback([this](json&& message, std::size_t message_size) {
+        this->parsed_message_callback(std::move(message), message_size);
+    });
 
     this->websocket->start_connecting();
 }
@@ -298,6 +311,14 @@ bool ConnectivityManager::send_to_websocket(const std::string& message) {
     return this->websocket->send(message);
 }
 
+bool ConnectivityManager::send_to_websocket(const json& message) {
+    if (this->websocket == nullptr) {
+        return false;
+    }
+
+    return this->websocket->send(message);
+}
+
 void ConnectivityManager::on_network_disconnected(OCPPInterfaceEnum ocpp_interface) {
 
     const int actual_configuration_slot = get_active_network_configuration_slot();
@@ -340,6 +361,11 @@ ConnectivityManager::get_ws_connection_options(const int32_t configuration_slot)
         const auto ocpp_versions = utils::get_ocpp_protocol_versions(
             this->device_model.get_value<std::string>(ControllerComponentVariables::SupportedOcppVersions));
 
+        const auto message_fragment_size = std::max(
+            0,
+            this->device_model.get_optional_value<int>(ControllerComponentVariables::WebsocketMessageFragmentSize)
+                .value_or(0));
+
         WebsocketConnectionOptions connection_options{
             ocpp_versions,
             uri,
@@ -367,7 +393,19 @@ ConnectivityManager::get_ws_connection_options(const int32_t configuration_slot)
                 .value_or(false),
             this->device_model.get_optional_value<std::string>(ControllerComponentVariables::IFace),
             this->device_model.get_optional_value<bool>(ControllerComponentVariables::EnableTLSKeylog).value_or(false),
-            this->device_model.get_optional_value<std::string>(ControllerComponentVariables::TLSKeylogFile)};
+            this->device_model.get_optional_value<std::string>(ControllerComponentVariables::TLSKeylogFile),
+            static_cast<std::size_t>(message_fragment_size),
+            this->get_permessage_deflate_options(),
+            this->device_model
+                .get_optional_value<bool>(ControllerComponentVariables::WebsocketIncrementalMessageParsing)
+                .value_or(false),
+            this->device_model.get_optional_value<bool>(ControllerComponentVariables::WebsocketSharedContext)
+                .value_or(false),
+            this->tls_session_cache,
+            this->device_model.get_optional_value<bool>(ControllerComponentVariables::RetryBackOffDecorrelatedJitter)
+                .value_or(false),
+            this->device_model.get_optional_value<int>(ControllerComponentVariables::RetryBackOffMaximum).value_or(0),
+            this->device_model.get_optional_value<int>(ControllerComponentVariables::RetryBackOffSpread).value_or(0)};
 
         return connection_options;
 
@@ -378,6 +416,28 @@ ConnectivityManager::get_ws_connection_options(const int32_t configuration_slot)
     return std::nullopt;
 }
 
+std::optional<PerMessageDeflateOptions> ConnectivityManager::get_permessage_deflate_options() {
+    if (!this->device_model.get_optional_value<bool>(ControllerComponentVariables::WebsocketPermessageDeflate)
+             .value_or(false)) {
+        return std::nullopt;
+    }
+
+    PerMessageDeflateOptions options;
+    const auto no_context_takeover =
+        this->device_model
+            .get_optional_value<bool>(ControllerComponentVariables::WebsocketPermessageDeflateNoContextTakeover)
+            .value_or(false);
+    const auto max_window_bits =
+        this->device_model
+            .get_optional_value<int>(ControllerComponentVariables::WebsocketPermessageDeflateMaxWindowBits)
+            .value_or(15);
+    options.client_no_context_takeover = no_context_takeover;
+    options.server_no_context_takeover = no_context_takeover;
+    options.client_max_window_bits = max_window_bits;
+    options.server_max_window_bits = max_window_bits;
+    return options;
+}
+
 void ConnectivityManager::on_websocket_connected(OcppProtocolVersion protocol) {
     this->connected_ocpp_version = protocol;
     const int actual_configuration_slot = get_active_network_configuration_slot();
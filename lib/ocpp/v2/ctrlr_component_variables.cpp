@@ -36,1126 +36,1561 @@ const Variable Fallback = {"Fallback"};
 }; // namespace StandardizedVariables
 
 namespace ControllerComponentVariables {
-const ComponentVariable InternalCtrlrEnabled = {
+const ControllerComponentVariable InternalCtrlrEnabled = {
+    ControllerComponentVariableId::InternalCtrlrEnabled,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
 const RequiredComponentVariable ChargePointId = {
+    ControllerComponentVariableId::ChargePointId,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ChargePointId",
     }),
 };
 const RequiredComponentVariable NetworkConnectionProfiles = {
+    ControllerComponentVariableId::NetworkConnectionProfiles,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "NetworkConnectionProfiles",
     }),
 };
 const RequiredComponentVariable ChargeBoxSerialNumber = {
+    ControllerComponentVariableId::ChargeBoxSerialNumber,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ChargeBoxSerialNumber",
     }),
 };
 const RequiredComponentVariable ChargePointModel = {
+    ControllerComponentVariableId::ChargePointModel,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ChargePointModel",
     }),
 };
-const ComponentVariable ChargePointSerialNumber = {
+const ControllerComponentVariable ChargePointSerialNumber = {
+    ControllerComponentVariableId::ChargePointSerialNumber,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ChargePointSerialNumber",
     }),
 };
 const RequiredComponentVariable ChargePointVendor = {
+    ControllerComponentVariableId::ChargePointVendor,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ChargePointVendor",
     }),
 };
 const RequiredComponentVariable FirmwareVersion = {
+    ControllerComponentVariableId::FirmwareVersion,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "FirmwareVersion",
     }),
 };
-const ComponentVariable ICCID = {
+const ControllerComponentVariable ICCID = {
+    ControllerComponentVariableId::ICCID,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ICCID",
     }),
 };
-const ComponentVariable IMSI = {
+const ControllerComponentVariable IMSI = {
+    ControllerComponentVariableId::IMSI,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "IMSI",
     }),
 };
-const ComponentVariable MeterSerialNumber = {
+const ControllerComponentVariable MeterSerialNumber = {
+    ControllerComponentVariableId::MeterSerialNumber,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "MeterSerialNumber",
     }),
 };
-const ComponentVariable MeterType = {
+const ControllerComponentVariable MeterType = {
+    ControllerComponentVariableId::MeterType,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "MeterType",
     }),
 };
 const RequiredComponentVariable SupportedCiphers12 = {
+    ControllerComponentVariableId::SupportedCiphers12,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "SupportedCiphers12",
     }),
 };
 const RequiredComponentVariable SupportedCiphers13 = {
+    ControllerComponentVariableId::SupportedCiphers13,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "SupportedCiphers13",
     }),
 };
-const ComponentVariable AuthorizeConnectorZeroOnConnectorOne = {
+const ControllerComponentVariable AuthorizeConnectorZeroOnConnectorOne = {
+    ControllerComponentVariableId::AuthorizeConnectorZeroOnConnectorOne,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "AuthorizeConnectorZeroOnConnectorOne",
     }),
 };
-const ComponentVariable LogMessages = {
+const ControllerComponentVariable LogMessages = {
+    ControllerComponentVariableId::LogMessages,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "LogMessages",
     }),
 };
 const RequiredComponentVariable LogMessagesFormat = {
+    ControllerComponentVariableId::LogMessagesFormat,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "LogMessagesFormat",
     }),
 };
-const ComponentVariable LogRotation = {
+const ControllerComponentVariable LogRotation = {
+    ControllerComponentVariableId::LogRotation,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "LogRotation",
     }),
 };
-const ComponentVariable LogRotationDateSuffix = {
+const ControllerComponentVariable LogRotationDateSuffix = {
+    ControllerComponentVariableId::LogRotationDateSuffix,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "LogRotationDateSuffix",
     }),
 };
-const ComponentVariable LogRotationMaximumFileSize = {
+const ControllerComponentVariable LogRotationMaximumFileSize = {
+    ControllerComponentVariableId::LogRotationMaximumFileSize,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "LogRotationMaximumFileSize",
     }),
 };
-const ComponentVariable LogRotationMaximumFileCount = {
+const ControllerComponentVariable LogRotationMaximumFileCount = {
+    ControllerComponentVariableId::LogRotationMaximumFileCount,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "LogRotationMaximumFileCount",
     }),
 };
-const ComponentVariable SupportedCriteria = {
+const ControllerComponentVariable SupportedCriteria = {
+    ControllerComponentVariableId::SupportedCriteria,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "SupportedCriteria",
     }),
 };
-const ComponentVariable RoundClockAlignedTimestamps = {
+const ControllerComponentVariable RoundClockAlignedTimestamps = {
+    ControllerComponentVariableId::RoundClockAlignedTimestamps,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "RoundClockAlignedTimestamps",
     }),
 };
-const ComponentVariable NetworkConfigTimeout = {
+const ControllerComponentVariable NetworkConfigTimeout = {
+    ControllerComponentVariableId::NetworkConfigTimeout,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "NetworkConfigTimeout",
     }),
 };
-const ComponentVariable SupportedChargingProfilePurposeTypes = {
+const ControllerComponentVariable SupportedChargingProfilePurposeTypes = {
+    ControllerComponentVariableId::SupportedChargingProfilePurposeTypes,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "SupportedChargingProfilePurposeTypes",
     }),
 };
-const ComponentVariable MaxCompositeScheduleDuration = {
+const ControllerComponentVariable MaxCompositeScheduleDuration = {
+    ControllerComponentVariableId::MaxCompositeScheduleDuration,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "MaxCompositeScheduleDuration",
     }),
 };
 const RequiredComponentVariable NumberOfConnectors = {
+    ControllerComponentVariableId::NumberOfConnectors,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "NumberOfConnectors",
     }),
 };
-const ComponentVariable UseSslDefaultVerifyPaths = {
+const ControllerComponentVariable UseSslDefaultVerifyPaths = {
+    ControllerComponentVariableId::UseSslDefaultVerifyPaths,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "UseSslDefaultVerifyPaths",
     }),
 };
-const ComponentVariable VerifyCsmsCommonName = {
+const ControllerComponentVariable VerifyCsmsCommonName = {
+    ControllerComponentVariableId::VerifyCsmsCommonName,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "VerifyCsmsCommonName",
     }),
 };
-const ComponentVariable UseTPM = {
+const ControllerComponentVariable UseTPM = {
+    ControllerComponentVariableId::UseTPM,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "UseTPM",
     }),
 };
-const ComponentVariable UseTPMSeccLeafCertificate = {
+const ControllerComponentVariable UseTPMSeccLeafCertificate = {
+    ControllerComponentVariableId::UseTPMSeccLeafCertificate,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "UseTPMSeccLeafCertificate",
     }),
 };
-const ComponentVariable VerifyCsmsAllowWildcards = {
+const ControllerComponentVariable VerifyCsmsAllowWildcards = {
+    ControllerComponentVariableId::VerifyCsmsAllowWildcards,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "VerifyCsmsAllowWildcards",
     }),
 };
-const ComponentVariable IFace = {
+const ControllerComponentVariable IFace = {
+    ControllerComponentVariableId::IFace,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "IFace",
     }),
 };
-const ComponentVariable EnableTLSKeylog = {
+const ControllerComponentVariable EnableTLSKeylog = {
+    ControllerComponentVariableId::EnableTLSKeylog,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "EnableTLSKeylog",
     }),
 };
-const ComponentVariable TLSKeylogFile = {
+const ControllerComponentVariable TLSKeylogFile = {
+    ControllerComponentVariableId::TLSKeylogFile,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "TLSKeylogFile",
     }),
 };
-const ComponentVariable OcspRequestInterval = {
+const ControllerComponentVariable OcspRequestInterval = {
+    ControllerComponentVariableId::OcspRequestInterval,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "OcspRequestInterval",
     }),
 };
-const ComponentVariable WebsocketPingPayload = {
+const ControllerComponentVariable WebsocketPingPayload = {
+    ControllerComponentVariableId::WebsocketPingPayload,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "WebsocketPingPayload",
     }),
 };
-const ComponentVariable WebsocketPongTimeout = {
+const ControllerComponentVariable WebsocketPongTimeout = {
+    ControllerComponentVariableId::WebsocketPongTimeout,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "WebsocketPongTimeout",
     }),
 };
-const ComponentVariable MonitorsProcessingInterval = {
+const ControllerComponentVariable WebsocketMessageFragmentSize = {
+    ControllerComponentVariableId::WebsocketMessageFragmentSize,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketMessageFragmentSize",
+    }),
+};
+const ControllerComponentVariable WebsocketPermessageDeflate = {
+    ControllerComponentVariableId::WebsocketPermessageDeflate,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketPermessageDeflate",
+    }),
+};
+const ControllerComponentVariable WebsocketPermessageDeflateNoContextTakeover = {
+    ControllerComponentVariableId::WebsocketPermessageDeflateNoContextTakeover,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketPermessageDeflateNoContextTakeover",
+    }),
+};
+const ControllerComponentVariable WebsocketPermessageDeflateMaxWindowBits = {
+    ControllerComponentVariableId::WebsocketPermessageDeflateMaxWindowBits,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketPermessageDeflateMaxWindowBits",
+    }),
+};
+const ControllerComponentVariable WebsocketIncrementalMessageParsing = {
+    ControllerComponentVariableId::WebsocketIncrementalMessageParsing,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketIncrementalMessageParsing",
+    }),
+};
+const ControllerComponentVariable WebsocketSharedContext = {
+    ControllerComponentVariableId::WebsocketSharedContext,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketSharedContext",
+    }),
+};
+const ControllerComponentVariable WebsocketTlsSessionResumption = {
+    ControllerComponentVariableId::WebsocketTlsSessionResumption,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketTlsSessionResumption",
+    }),
+};
+const ControllerComponentVariable WebsocketPersistTlsSessions = {
+    ControllerComponentVariableId::WebsocketPersistTlsSessions,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketPersistTlsSessions",
+    }),
+};
+const ControllerComponentVariable RetryBackOffDecorrelatedJitter = {
+    ControllerComponentVariableId::RetryBackOffDecorrelatedJitter,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "RetryBackOffDecorrelatedJitter",
+    }),
+};
+const ControllerComponentVariable RetryBackOffMaximum = {
+    ControllerComponentVariableId::RetryBackOffMaximum,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "RetryBackOffMaximum",
+    }),
+};
+const ControllerComponentVariable RetryBackOffSpread = {
+    ControllerComponentVariableId::RetryBackOffSpread,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "RetryBackOffSpread",
+    }),
+};
+const ControllerComponentVariable SingleThreadedEventLoop = {
+    ControllerComponentVariableId::SingleThreadedEventLoop,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "SingleThreadedEventLoop",
+    }),
+};
+const ControllerComponentVariable MonitorsProcessingInterval = {
+    ControllerComponentVariableId::MonitorsProcessingInterval,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "MonitorsProcessingInterval",
     }),
 };
-const ComponentVariable MaxCustomerInformationDataLength = {
+const ControllerComponentVariable MaxCustomerInformationDataLength = {
+    ControllerComponentVariableId::MaxCustomerInformationDataLength,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "MaxCustomerInformationDataLength",
     }),
 };
-const ComponentVariable V2GCertificateExpireCheckInitialDelaySeconds = {
+const ControllerComponentVariable V2GCertificateExpireCheckInitialDelaySeconds = {
+    ControllerComponentVariableId::V2GCertificateExpireCheckInitialDelaySeconds,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "V2GCertificateExpireCheckInitialDelaySeconds",
     }),
 };
-const ComponentVariable V2GCertificateExpireCheckIntervalSeconds = {
+const ControllerComponentVariable V2GCertificateExpireCheckIntervalSeconds = {
+    ControllerComponentVariableId::V2GCertificateExpireCheckIntervalSeconds,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "V2GCertificateExpireCheckIntervalSeconds",
     }),
 };
-const ComponentVariable ClientCertificateExpireCheckInitialDelaySeconds = {
+const ControllerComponentVariable ClientCertificateExpireCheckInitialDelaySeconds = {
+    ControllerComponentVariableId::ClientCertificateExpireCheckInitialDelaySeconds,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ClientCertificateExpireCheckInitialDelaySeconds",
     }),
 };
-const ComponentVariable ClientCertificateExpireCheckIntervalSeconds = {
+const ControllerComponentVariable ClientCertificateExpireCheckIntervalSeconds = {
+    ControllerComponentVariableId::ClientCertificateExpireCheckIntervalSeconds,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ClientCertificateExpireCheckIntervalSeconds",
     }),
 };
-const ComponentVariable MessageQueueSizeThreshold = {
+const ControllerComponentVariable MessageQueueSizeThreshold = {
+    ControllerComponentVariableId::MessageQueueSizeThreshold,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "MessageQueueSizeThreshold",
     }),
 };
-const ComponentVariable MaxMessageSize = {
+const ControllerComponentVariable MessageQueueMaxMessagesInFlight = {
+    ControllerComponentVariableId::MessageQueueMaxMessagesInFlight,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "MessageQueueMaxMessagesInFlight",
+    }),
+};
+const ControllerComponentVariable MessageQueueSizeThresholdBytes = {
+    ControllerComponentVariableId::MessageQueueSizeThresholdBytes,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "MessageQueueSizeThresholdBytes",
+    }),
+};
+const ControllerComponentVariable MessageQueueUpdateThinningResolution = {
+    ControllerComponentVariableId::MessageQueueUpdateThinningResolution,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "MessageQueueUpdateThinningResolution",
+    }),
+};
+const ControllerComponentVariable MessageQueueTransactionCompactionThreshold = {
+    ControllerComponentVariableId::MessageQueueTransactionCompactionThreshold,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "MessageQueueTransactionCompactionThreshold",
+    }),
+};
+const ControllerComponentVariable MessageQueueTransactionCompactionInterval = {
+    ControllerComponentVariableId::MessageQueueTransactionCompactionInterval,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "MessageQueueTransactionCompactionInterval",
+    }),
+};
+const ControllerComponentVariable MessageQueuePersistenceFlushInterval = {
+    ControllerComponentVariableId::MessageQueuePersistenceFlushInterval,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "MessageQueuePersistenceFlushInterval",
+    }),
+};
+const ControllerComponentVariable MessageQueuePersistenceMaxPendingOperations = {
+    ControllerComponentVariableId::MessageQueuePersistenceMaxPendingOperations,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "MessageQueuePersistenceMaxPendingOperations",
+    }),
+};
+const ControllerComponentVariable MessageQueuePersistenceFormat = {
+    ControllerComponentVariableId::MessageQueuePersistenceFormat,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "MessageQueuePersistenceFormat",
+    }),
+};
+const ControllerComponentVariable DatabaseTuningProfile = {
+    ControllerComponentVariableId::DatabaseTuningProfile,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "DatabaseTuningProfile",
+    }),
+};
+const ControllerComponentVariable DatabaseReadConnections = {
+    ControllerComponentVariableId::DatabaseReadConnections,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "DatabaseReadConnections",
+    }),
+};
+const ControllerComponentVariable TransactionWriteBehind = {
+    ControllerComponentVariableId::TransactionWriteBehind,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "TransactionWriteBehind",
+    }),
+};
+const ControllerComponentVariable TransactionWriteBehindMaxQueueSize = {
+    ControllerComponentVariableId::TransactionWriteBehindMaxQueueSize,
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "TransactionWriteBehindMaxQueueSize",
+    }),
+};
+const ControllerComponentVariable MaxMessageSize = {
+    ControllerComponentVariableId::MaxMessageSize,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "MaxMessageSize",
     }),
 };
-const ComponentVariable ResumeTransactionsOnBoot = {
+const ControllerComponentVariable ResumeTransactionsOnBoot = {
+    ControllerComponentVariableId::ResumeTransactionsOnBoot,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "ResumeTransactionsOnBoot",
     }),
 };
-const ComponentVariable AllowCSMSRootCertInstallWithUnsecureConnection = {
+const ControllerComponentVariable AllowCSMSRootCertInstallWithUnsecureConnection = {
+    ControllerComponentVariableId::AllowCSMSRootCertInstallWithUnsecureConnection,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "AllowCSMSRootCertInstallWithUnsecureConnection",
     }),
 };
-const ComponentVariable AllowMFRootCertInstallWithUnsecureConnection = {
+const ControllerComponentVariable AllowMFRootCertInstallWithUnsecureConnection = {
+    ControllerComponentVariableId::AllowMFRootCertInstallWithUnsecureConnection,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "AllowMFRootCertInstallWithUnsecureConnection",
     }),
 };
-const ComponentVariable AllowSecurityLevelZeroConnections = {
+const ControllerComponentVariable AllowSecurityLevelZeroConnections = {
+    ControllerComponentVariableId::AllowSecurityLevelZeroConnections,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "AllowSecurityLevelZeroConnections",
     }),
 };
 const RequiredComponentVariable SupportedOcppVersions = {
+    ControllerComponentVariableId::SupportedOcppVersions,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({"SupportedOcppVersions"}),
 };
-const ComponentVariable AlignedDataCtrlrEnabled = {
+const ControllerComponentVariable AlignedDataCtrlrEnabled = {
+    ControllerComponentVariableId::AlignedDataCtrlrEnabled,
     ControllerComponents::AlignedDataCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
-const ComponentVariable AlignedDataCtrlrAvailable = {
+const ControllerComponentVariable AlignedDataCtrlrAvailable = {
+    ControllerComponentVariableId::AlignedDataCtrlrAvailable,
     ControllerComponents::AlignedDataCtrlr,
     std::optional<Variable>({
         "Available",
     }),
 };
 const RequiredComponentVariable AlignedDataInterval = {
+    ControllerComponentVariableId::AlignedDataInterval,
     ControllerComponents::AlignedDataCtrlr,
     std::optional<Variable>({
         "Interval",
     }),
 };
 const RequiredComponentVariable AlignedDataMeasurands = {
+    ControllerComponentVariableId::AlignedDataMeasurands,
     ControllerComponents::AlignedDataCtrlr,
     std::optional<Variable>({
         "Measurands",
     }),
 };
-const ComponentVariable AlignedDataSendDuringIdle = {
+const ControllerComponentVariable AlignedDataSendDuringIdle = {
+    ControllerComponentVariableId::AlignedDataSendDuringIdle,
     ControllerComponents::AlignedDataCtrlr,
     std::optional<Variable>({
         "SendDuringIdle",
     }),
 };
-const ComponentVariable AlignedDataSignReadings = {
+const ControllerComponentVariable AlignedDataSignReadings = {
+    ControllerComponentVariableId::AlignedDataSignReadings,
     ControllerComponents::AlignedDataCtrlr,
     std::optional<Variable>({
         "SignReadings",
     }),
 };
 const RequiredComponentVariable AlignedDataTxEndedInterval = {
+    ControllerComponentVariableId::AlignedDataTxEndedInterval,
     ControllerComponents::AlignedDataCtrlr,
     std::optional<Variable>({
         "TxEndedInterval",
     }),
 };
 const RequiredComponentVariable AlignedDataTxEndedMeasurands = {
+    ControllerComponentVariableId::AlignedDataTxEndedMeasurands,
     ControllerComponents::AlignedDataCtrlr,
     std::optional<Variable>({
         "TxEndedMeasurands",
     }),
 };
-const ComponentVariable AuthCacheCtrlrAvailable = {
+const ControllerComponentVariable AuthCacheCtrlrAvailable = {
+    ControllerComponentVariableId::AuthCacheCtrlrAvailable,
     ControllerComponents::AuthCacheCtrlr,
     std::optional<Variable>({
         "Available",
     }),
 };
-const ComponentVariable AuthCacheDisablePostAuthorize = {
+const ControllerComponentVariable AuthCacheDisablePostAuthorize = {
+    ControllerComponentVariableId::AuthCacheDisablePostAuthorize,
     ControllerComponents::AuthCacheCtrlr,
     std::optional<Variable>({
         "DisablePostAuthorize",
     }),
 };
-const ComponentVariable AuthCacheCtrlrEnabled = {
+const ControllerComponentVariable AuthCacheCtrlrEnabled = {
+    ControllerComponentVariableId::AuthCacheCtrlrEnabled,
     ControllerComponents::AuthCacheCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
-const ComponentVariable AuthCacheLifeTime = {
+const ControllerComponentVariable AuthCacheLifeTime = {
+    ControllerComponentVariableId::AuthCacheLifeTime,
     ControllerComponents::AuthCacheCtrlr,
     std::optional<Variable>({
         "LifeTime",
     }),
 };
-const ComponentVariable AuthCachePolicy = {
+const ControllerComponentVariable AuthCachePolicy = {
+    ControllerComponentVariableId::AuthCachePolicy,
     ControllerComponents::AuthCacheCtrlr,
     std::optional<Variable>({
         "Policy",
     }),
 };
-const ComponentVariable AuthCacheStorage = {
+const ControllerComponentVariable AuthCacheStorage = {
+    ControllerComponentVariableId::AuthCacheStorage,
     ControllerComponents::AuthCacheCtrlr,
     std::optional<Variable>({
         "Storage",
     }),
 };
-const ComponentVariable AuthCtrlrEnabled = {
+const ControllerComponentVariable AuthCtrlrEnabled = {
+    ControllerComponentVariableId::AuthCtrlrEnabled,
     ControllerComponents::AuthCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
-const ComponentVariable AdditionalInfoItemsPerMessage = {
+const ControllerComponentVariable AdditionalInfoItemsPerMessage = {
+    ControllerComponentVariableId::AdditionalInfoItemsPerMessage,
     ControllerComponents::AuthCtrlr,
     std::optional<Variable>({
         "AdditionalInfoItemsPerMessage",
     }),
 };
 const RequiredComponentVariable AuthorizeRemoteStart = {
+    ControllerComponentVariableId::AuthorizeRemoteStart,
     ControllerComponents::AuthCtrlr,
     std::optional<Variable>({
         "AuthorizeRemoteStart",
     }),
 };
 const RequiredComponentVariable LocalAuthorizeOffline = {
+    ControllerComponentVariableId::LocalAuthorizeOffline,
     ControllerComponents::AuthCtrlr,
     std::optional<Variable>({
         "LocalAuthorizeOffline",
     }),
 };
 const RequiredComponentVariable LocalPreAuthorize = {
+    ControllerComponentVariableId::LocalPreAuthorize,
     ControllerComponents::AuthCtrlr,
     std::optional<Variable>({
         "LocalPreAuthorize",
     }),
 };
-const ComponentVariable DisableRemoteAuthorization = {
+const ControllerComponentVariable DisableRemoteAuthorization = {
+    ControllerComponentVariableId::DisableRemoteAuthorization,
     ControllerComponents::AuthCtrlr,
     std::optional<Variable>({
         "DisableRemoteAuthorization",
     }),
 };
-const ComponentVariable MasterPassGroupId = {
+const ControllerComponentVariable MasterPassGroupId = {
+    ControllerComponentVariableId::MasterPassGroupId,
     ControllerComponents::AuthCtrlr,
     std::optional<Variable>({
         "MasterPassGroupId",
     }),
 };
-const ComponentVariable OfflineTxForUnknownIdEnabled = {
+const ControllerComponentVariable OfflineTxForUnknownIdEnabled = {
+    ControllerComponentVariableId::OfflineTxForUnknownIdEnabled,
     ControllerComponents::AuthCtrlr,
     std::optional<Variable>({
         "OfflineTxForUnknownIdEnabled",
     }),
 };
-const ComponentVariable AllowNewSessionsPendingFirmwareUpdate = {
+const ControllerComponentVariable AllowNewSessionsPendingFirmwareUpdate = {
+    ControllerComponentVariableId::AllowNewSessionsPendingFirmwareUpdate,
     ControllerComponents::ChargingStation,
     std::optional<Variable>({"AllowNewSessionsPendingFirmwareUpdate", "BytesPerMessage"}),
 };
 const RequiredComponentVariable ChargingStationAvailabilityState = {
+    ControllerComponentVariableId::ChargingStationAvailabilityState,
     ControllerComponents::ChargingStation,
     std::optional<Variable>({
         "AvailabilityState",
     }),
 };
 const RequiredComponentVariable ChargingStationAvailable = {
+    ControllerComponentVariableId::ChargingStationAvailable,
     ControllerComponents::ChargingStation,
     std::optional<Variable>({
         "Available",
     }),
 };
 const RequiredComponentVariable ChargingStationSupplyPhases = {
+    ControllerComponentVariableId::ChargingStationSupplyPhases,
     ControllerComponents::ChargingStation,
     std::optional<Variable>({
         "SupplyPhases",
     }),
 };
 const RequiredComponentVariable ClockCtrlrDateTime = {
+    ControllerComponentVariableId::ClockCtrlrDateTime,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({
         "DateTime",
     }),
 };
-const ComponentVariable NextTimeOffsetTransitionDateTime = {
+const ControllerComponentVariable NextTimeOffsetTransitionDateTime = {
+    ControllerComponentVariableId::NextTimeOffsetTransitionDateTime,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({
         "NextTimeOffsetTransitionDateTime",
     }),
 };
-const ComponentVariable NtpServerUri = {
+const ControllerComponentVariable NtpServerUri = {
+    ControllerComponentVariableId::NtpServerUri,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({
         "NtpServerUri",
     }),
 };
-const ComponentVariable NtpSource = {
+const ControllerComponentVariable NtpSource = {
+    ControllerComponentVariableId::NtpSource,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({
         "NtpSource",
     }),
 };
-const ComponentVariable TimeAdjustmentReportingThreshold = {
+const ControllerComponentVariable TimeAdjustmentReportingThreshold = {
+    ControllerComponentVariableId::TimeAdjustmentReportingThreshold,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({
         "TimeAdjustmentReportingThreshold",
     }),
 };
-const ComponentVariable TimeOffset = {
+const ControllerComponentVariable TimeOffset = {
+    ControllerComponentVariableId::TimeOffset,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({
         "TimeOffset",
     }),
 };
-const ComponentVariable TimeOffsetNextTransition = {
+const ControllerComponentVariable TimeOffsetNextTransition = {
+    ControllerComponentVariableId::TimeOffsetNextTransition,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({"TimeOffset", "NextTransition"}),
 };
 const RequiredComponentVariable TimeSource = {
+    ControllerComponentVariableId::TimeSource,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({
         "TimeSource",
     }),
 };
-const ComponentVariable TimeZone = {
+const ControllerComponentVariable TimeZone = {
+    ControllerComponentVariableId::TimeZone,
     ControllerComponents::ClockCtrlr,
     std::optional<Variable>({
         "TimeZone",
     }),
 };
-const ComponentVariable CustomImplementationEnabled = {
+const ControllerComponentVariable CustomImplementationEnabled = {
+    ControllerComponentVariableId::CustomImplementationEnabled,
     ControllerComponents::CustomizationCtrlr,
     std::optional<Variable>({
         "CustomImplementationEnabled",
     }),
 };
-const ComponentVariable CustomImplementationCaliforniaPricingEnabled = {
+const ControllerComponentVariable CustomImplementationCaliforniaPricingEnabled = {
+    ControllerComponentVariableId::CustomImplementationCaliforniaPricingEnabled,
     ControllerComponents::CustomizationCtrlr,
     std::optional<Variable>({"CustomImplementationEnabled", "org.openchargealliance.costmsg"}),
 };
-const ComponentVariable CustomImplementationMultiLanguageEnabled = {
+const ControllerComponentVariable CustomImplementationMultiLanguageEnabled = {
+    ControllerComponentVariableId::CustomImplementationMultiLanguageEnabled,
     ControllerComponents::CustomizationCtrlr,
     std::optional<Variable>({"CustomImplementationEnabled", "org.openchargealliance.multilanguage"}),
 };
 const RequiredComponentVariable BytesPerMessageGetReport = {
+    ControllerComponentVariableId::BytesPerMessageGetReport,
     ControllerComponents::DeviceDataCtrlr,
     std::optional<Variable>({"BytesPerMessage", "GetReport"}),
 };
 const RequiredComponentVariable BytesPerMessageGetVariables = {
+    ControllerComponentVariableId::BytesPerMessageGetVariables,
     ControllerComponents::DeviceDataCtrlr,
     std::optional<Variable>({"BytesPerMessage", "GetVariables"}),
 };
 const RequiredComponentVariable BytesPerMessageSetVariables = {
+    ControllerComponentVariableId::BytesPerMessageSetVariables,
     ControllerComponents::DeviceDataCtrlr,
     std::optional<Variable>({"BytesPerMessage", "SetVariables"}),
 };
-const ComponentVariable ConfigurationValueSize = {
+const ControllerComponentVariable ConfigurationValueSize = {
+    ControllerComponentVariableId::ConfigurationValueSize,
     ControllerComponents::DeviceDataCtrlr,
     std::optional<Variable>({
         "ConfigurationValueSize",
     }),
 };
 const RequiredComponentVariable ItemsPerMessageGetReport = {
+    ControllerComponentVariableId::ItemsPerMessageGetReport,
     ControllerComponents::DeviceDataCtrlr,
     std::optional<Variable>({"ItemsPerMessage", "GetReport"}),
 };
 const RequiredComponentVariable ItemsPerMessageGetVariables = {
+    ControllerComponentVariableId::ItemsPerMessageGetVariables,
     ControllerComponents::DeviceDataCtrlr,
     std::optional<Variable>({"ItemsPerMessage", "GetVariables"}),
 };
 const RequiredComponentVariable ItemsPerMessageSetVariables = {
+    ControllerComponentVariableId::ItemsPerMessageSetVariables,
     ControllerComponents::DeviceDataCtrlr,
     std::optional<Variable>({"ItemsPerMessage", "SetVariables"}),
 };
-const ComponentVariable ReportingValueSize = {
+const ControllerComponentVariable ReportingValueSize = {
+    ControllerComponentVariableId::ReportingValueSize,
     ControllerComponents::DeviceDataCtrlr,
     std::optional<Variable>({
         "ReportingValueSize",
     }),
 };
-const ComponentVariable DisplayMessageCtrlrAvailable = {
+const ControllerComponentVariable DisplayMessageCtrlrAvailable = {
+    ControllerComponentVariableId::DisplayMessageCtrlrAvailable,
     ControllerComponents::DisplayMessageCtrlr,
     std::optional<Variable>({
         "Available",
     }),
 };
 const RequiredComponentVariable NumberOfDisplayMessages = {
+    ControllerComponentVariableId::NumberOfDisplayMessages,
     ControllerComponents::DisplayMessageCtrlr,
     std::optional<Variable>({
         "DisplayMessages",
     }),
 };
 const RequiredComponentVariable DisplayMessageSupportedFormats = {
+    ControllerComponentVariableId::DisplayMessageSupportedFormats,
     ControllerComponents::DisplayMessageCtrlr,
     std::optional<Variable>({
         "SupportedFormats",
     }),
 };
 const RequiredComponentVariable DisplayMessageSupportedPriorities = {
+    ControllerComponentVariableId::DisplayMessageSupportedPriorities,
     ControllerComponents::DisplayMessageCtrlr,
     std::optional<Variable>({
         "SupportedPriorities",
     }),
 };
-const ComponentVariable DisplayMessageSupportedStates = {ControllerComponents::DisplayMessageCtrlr,
-                                                         std::optional<Variable>({"SupportedStates"})};
+const ControllerComponentVariable DisplayMessageSupportedStates = {
+    ControllerComponentVariableId::DisplayMessageSupportedStates,
+    ControllerComponents::DisplayMessageCtrlr,
+    std::optional<Variable>({"SupportedStates"}),
+};
 
-const ComponentVariable DisplayMessageQRCodeDisplayCapable = {ControllerComponents::DisplayMessageCtrlr,
-                                                              std::optional<Variable>({"QRCodeDisplayCapable"})};
+const ControllerComponentVariable DisplayMessageQRCodeDisplayCapable = {
+    ControllerComponentVariableId::DisplayMessageQRCodeDisplayCapable,
+    ControllerComponents::DisplayMessageCtrlr,
+    std::optional<Variable>({"QRCodeDisplayCapable"}),
+};
 
-const ComponentVariable DisplayMessageLanguage = {ControllerComponents::DisplayMessageCtrlr,
-                                                  std::optional<Variable>({"Language"})};
+const ControllerComponentVariable DisplayMessageLanguage = {
+    ControllerComponentVariableId::DisplayMessageLanguage,
+    ControllerComponents::DisplayMessageCtrlr,
+    std::optional<Variable>({"Language"}),
+};
 
-const ComponentVariable CentralContractValidationAllowed = {
+const ControllerComponentVariable CentralContractValidationAllowed = {
+    ControllerComponentVariableId::CentralContractValidationAllowed,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "CentralContractValidationAllowed",
     }),
 };
 const RequiredComponentVariable ContractValidationOffline = {
+    ControllerComponentVariableId::ContractValidationOffline,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "ContractValidationOffline",
     }),
 };
-const ComponentVariable RequestMeteringReceipt = {
+const ControllerComponentVariable RequestMeteringReceipt = {
+    ControllerComponentVariableId::RequestMeteringReceipt,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "RequestMeteringReceipt",
     }),
 };
-const ComponentVariable ISO15118CtrlrSeccId = {
+const ControllerComponentVariable ISO15118CtrlrSeccId = {
+    ControllerComponentVariableId::ISO15118CtrlrSeccId,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "SeccId",
     }),
 };
-const ComponentVariable ISO15118CtrlrCountryName = {
+const ControllerComponentVariable ISO15118CtrlrCountryName = {
+    ControllerComponentVariableId::ISO15118CtrlrCountryName,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "CountryName",
     }),
 };
-const ComponentVariable ISO15118CtrlrOrganizationName = {
+const ControllerComponentVariable ISO15118CtrlrOrganizationName = {
+    ControllerComponentVariableId::ISO15118CtrlrOrganizationName,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "OrganizationName",
     }),
 };
-const ComponentVariable PnCEnabled = {
+const ControllerComponentVariable PnCEnabled = {
+    ControllerComponentVariableId::PnCEnabled,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "PnCEnabled",
     }),
 };
-const ComponentVariable V2GCertificateInstallationEnabled = {
+const ControllerComponentVariable V2GCertificateInstallationEnabled = {
+    ControllerComponentVariableId::V2GCertificateInstallationEnabled,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "V2GCertificateInstallationEnabled",
     }),
 };
-const ComponentVariable ContractCertificateInstallationEnabled = {
+const ControllerComponentVariable ContractCertificateInstallationEnabled = {
+    ControllerComponentVariableId::ContractCertificateInstallationEnabled,
     ControllerComponents::ISO15118Ctrlr,
     std::optional<Variable>({
         "ContractCertificateInstallationEnabled",
     }),
 };
-const ComponentVariable LocalAuthListCtrlrAvailable = {
+const ControllerComponentVariable LocalAuthListCtrlrAvailable = {
+    ControllerComponentVariableId::LocalAuthListCtrlrAvailable,
     ControllerComponents::LocalAuthListCtrlr,
     std::optional<Variable>({
         "Available",
     }),
 };
 const RequiredComponentVariable BytesPerMessageSendLocalList = {
+    ControllerComponentVariableId::BytesPerMessageSendLocalList,
     ControllerComponents::LocalAuthListCtrlr,
     std::optional<Variable>({
         "BytesPerMessage",
     }),
 };
-const ComponentVariable LocalAuthListCtrlrEnabled = {
+const ControllerComponentVariable LocalAuthListCtrlrEnabled = {
+    ControllerComponentVariableId::LocalAuthListCtrlrEnabled,
     ControllerComponents::LocalAuthListCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
 const RequiredComponentVariable LocalAuthListCtrlrEntries = {
+    ControllerComponentVariableId::LocalAuthListCtrlrEntries,
     ControllerComponents::LocalAuthListCtrlr,
     std::optional<Variable>({
         "Entries",
     }),
 };
 const RequiredComponentVariable ItemsPerMessageSendLocalList = {
+    ControllerComponentVariableId::ItemsPerMessageSendLocalList,
     ControllerComponents::LocalAuthListCtrlr,
     std::optional<Variable>({
         "ItemsPerMessage",
     }),
 };
-const ComponentVariable LocalAuthListCtrlrStorage = {
+const ControllerComponentVariable LocalAuthListCtrlrStorage = {
+    ControllerComponentVariableId::LocalAuthListCtrlrStorage,
     ControllerComponents::LocalAuthListCtrlr,
     std::optional<Variable>({
         "Storage",
     }),
 };
-const ComponentVariable LocalAuthListDisablePostAuthorize = {
+const ControllerComponentVariable LocalAuthListDisablePostAuthorize = {
+    ControllerComponentVariableId::LocalAuthListDisablePostAuthorize,
     ControllerComponents::LocalAuthListCtrlr,
     std::optional<Variable>({
         "DisablePostAuthorize",
     }),
 };
-const ComponentVariable MonitoringCtrlrAvailable = {
+const ControllerComponentVariable MonitoringCtrlrAvailable = {
+    ControllerComponentVariableId::MonitoringCtrlrAvailable,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({
         "Available",
     }),
 };
-const ComponentVariable BytesPerMessageClearVariableMonitoring = {
+const ControllerComponentVariable BytesPerMessageClearVariableMonitoring = {
+    ControllerComponentVariableId::BytesPerMessageClearVariableMonitoring,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({"BytesPerMessage", "ClearVariableMonitoring"}),
 };
 const RequiredComponentVariable BytesPerMessageSetVariableMonitoring = {
+    ControllerComponentVariableId::BytesPerMessageSetVariableMonitoring,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({"BytesPerMessage", "SetVariableMonitoring"}),
 };
-const ComponentVariable MonitoringCtrlrEnabled = {
+const ControllerComponentVariable MonitoringCtrlrEnabled = {
+    ControllerComponentVariableId::MonitoringCtrlrEnabled,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
-const ComponentVariable ActiveMonitoringBase = {
+const ControllerComponentVariable ActiveMonitoringBase = {
+    ControllerComponentVariableId::ActiveMonitoringBase,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({"ActiveMonitoringBase"}),
 };
-const ComponentVariable ActiveMonitoringLevel = {
+const ControllerComponentVariable ActiveMonitoringLevel = {
+    ControllerComponentVariableId::ActiveMonitoringLevel,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({"ActiveMonitoringLevel"}),
 };
-const ComponentVariable ItemsPerMessageClearVariableMonitoring = {
+const ControllerComponentVariable ItemsPerMessageClearVariableMonitoring = {
+    ControllerComponentVariableId::ItemsPerMessageClearVariableMonitoring,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({"ItemsPerMessage", "ClearVariableMonitoring"}),
 };
 const RequiredComponentVariable ItemsPerMessageSetVariableMonitoring = {
+    ControllerComponentVariableId::ItemsPerMessageSetVariableMonitoring,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({"ItemsPerMessage", "SetVariableMonitoring"}),
 };
-const ComponentVariable OfflineQueuingSeverity = {
+const ControllerComponentVariable OfflineQueuingSeverity = {
+    ControllerComponentVariableId::OfflineQueuingSeverity,
     ControllerComponents::MonitoringCtrlr,
     std::optional<Variable>({
         "OfflineQueuingSeverity",
     }),
 };
-const ComponentVariable ActiveNetworkProfile = {
+const ControllerComponentVariable ActiveNetworkProfile = {
+    ControllerComponentVariableId::ActiveNetworkProfile,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "ActiveNetworkProfile",
     }),
 };
 const RequiredComponentVariable FileTransferProtocols = {
+    ControllerComponentVariableId::FileTransferProtocols,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "FileTransferProtocols",
     }),
 };
-const ComponentVariable HeartbeatInterval = {
+const ControllerComponentVariable HeartbeatInterval = {
+    ControllerComponentVariableId::HeartbeatInterval,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "HeartbeatInterval",
     }),
 };
 const RequiredComponentVariable MessageTimeout = {
+    ControllerComponentVariableId::MessageTimeout,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({"MessageTimeout", "Default"}),
 };
 const RequiredComponentVariable MessageAttemptInterval = {
+    ControllerComponentVariableId::MessageAttemptInterval,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({"MessageAttemptInterval", "TransactionEvent"}),
 };
 const RequiredComponentVariable MessageAttempts = {
+    ControllerComponentVariableId::MessageAttempts,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({"MessageAttempts", "TransactionEvent"}),
 };
 const RequiredComponentVariable NetworkConfigurationPriority = {
+    ControllerComponentVariableId::NetworkConfigurationPriority,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "NetworkConfigurationPriority",
     }),
 };
 const RequiredComponentVariable NetworkProfileConnectionAttempts = {
+    ControllerComponentVariableId::NetworkProfileConnectionAttempts,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "NetworkProfileConnectionAttempts",
     }),
 };
 const RequiredComponentVariable OfflineThreshold = {
+    ControllerComponentVariableId::OfflineThreshold,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "OfflineThreshold",
     }),
 };
-const ComponentVariable QueueAllMessages = {
+const ControllerComponentVariable QueueAllMessages = {
+    ControllerComponentVariableId::QueueAllMessages,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "QueueAllMessages",
     }),
 };
-const ComponentVariable MessageTypesDiscardForQueueing = {
+const ControllerComponentVariable MessageTypesDiscardForQueueing = {
+    ControllerComponentVariableId::MessageTypesDiscardForQueueing,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "MessageTypesDiscardForQueueing",
     }),
 };
 const RequiredComponentVariable ResetRetries = {
+    ControllerComponentVariableId::ResetRetries,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "ResetRetries",
     }),
 };
 const RequiredComponentVariable RetryBackOffRandomRange = {
+    ControllerComponentVariableId::RetryBackOffRandomRange,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "RetryBackOffRandomRange",
     }),
 };
 const RequiredComponentVariable RetryBackOffRepeatTimes = {
+    ControllerComponentVariableId::RetryBackOffRepeatTimes,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "RetryBackOffRepeatTimes",
     }),
 };
 const RequiredComponentVariable RetryBackOffWaitMinimum = {
+    ControllerComponentVariableId::RetryBackOffWaitMinimum,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "RetryBackOffWaitMinimum",
     }),
 };
 const RequiredComponentVariable UnlockOnEVSideDisconnect = {
+    ControllerComponentVariableId::UnlockOnEVSideDisconnect,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "UnlockOnEVSideDisconnect",
     }),
 };
 const RequiredComponentVariable WebSocketPingInterval = {
+    ControllerComponentVariableId::WebSocketPingInterval,
     ControllerComponents::OCPPCommCtrlr,
     std::optional<Variable>({
         "WebSocketPingInterval",
     }),
 };
-const ComponentVariable ReservationCtrlrAvailable = {
+const ControllerComponentVariable ReservationCtrlrAvailable = {
+    ControllerComponentVariableId::ReservationCtrlrAvailable,
     ControllerComponents::ReservationCtrlr,
     std::optional<Variable>({
         "Available",
     }),
 };
-const ComponentVariable ReservationCtrlrEnabled = {
+const ControllerComponentVariable ReservationCtrlrEnabled = {
+    ControllerComponentVariableId::ReservationCtrlrEnabled,
     ControllerComponents::ReservationCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
-const ComponentVariable ReservationCtrlrNonEvseSpecific = {
+const ControllerComponentVariable ReservationCtrlrNonEvseSpecific = {
+    ControllerComponentVariableId::ReservationCtrlrNonEvseSpecific,
     ControllerComponents::ReservationCtrlr,
     std::optional<Variable>({
         "NonEvseSpecific",
     }),
 };
-const ComponentVariable SampledDataCtrlrAvailable = {
+const ControllerComponentVariable SampledDataCtrlrAvailable = {
+    ControllerComponentVariableId::SampledDataCtrlrAvailable,
     ControllerComponents::SampledDataCtrlr,
     std::optional<Variable>({
         "Available",
     }),
 };
-const ComponentVariable SampledDataCtrlrEnabled = {
+const ControllerComponentVariable SampledDataCtrlrEnabled = {
+    ControllerComponentVariableId::SampledDataCtrlrEnabled,
     ControllerComponents::SampledDataCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
-const ComponentVariable SampledDataSignReadings = {
+const ControllerComponentVariable SampledDataSignReadings = {
+    ControllerComponentVariableId::SampledDataSignReadings,
     ControllerComponents::SampledDataCtrlr,
     std::optional<Variable>({
         "SignReadings",
     }),
 };
 const RequiredComponentVariable SampledDataTxEndedInterval = {
+    ControllerComponentVariableId::SampledDataTxEndedInterval,
     ControllerComponents::SampledDataCtrlr,
     std::optional<Variable>({
         "TxEndedInterval",
     }),
 };
 const RequiredComponentVariable SampledDataTxEndedMeasurands = {
+    ControllerComponentVariableId::SampledDataTxEndedMeasurands,
     ControllerComponents::SampledDataCtrlr,
     std::optional<Variable>({
         "TxEndedMeasurands",
     }),
 };
 const RequiredComponentVariable SampledDataTxStartedMeasurands = {
+    ControllerComponentVariableId::SampledDataTxStartedMeasurands,
     ControllerComponents::SampledDataCtrlr,
     std::optional<Variable>({
         "TxStartedMeasurands",
     }),
 };
 const RequiredComponentVariable SampledDataTxUpdatedInterval = {
+    ControllerComponentVariableId::SampledDataTxUpdatedInterval,
     ControllerComponents::SampledDataCtrlr,
     std::optional<Variable>({
         "TxUpdatedInterval",
     }),
 };
 const RequiredComponentVariable SampledDataTxUpdatedMeasurands = {
+    ControllerComponentVariableId::SampledDataTxUpdatedMeasurands,
     ControllerComponents::SampledDataCtrlr,
     std::optional<Variable>({
         "TxUpdatedMeasurands",
     }),
 };
-const ComponentVariable AdditionalRootCertificateCheck = {
+const ControllerComponentVariable AdditionalRootCertificateCheck = {
+    ControllerComponentVariableId::AdditionalRootCertificateCheck,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "AdditionalRootCertificateCheck",
     }),
 };
-const ComponentVariable BasicAuthPassword = {
+const ControllerComponentVariable BasicAuthPassword = {
+    ControllerComponentVariableId::BasicAuthPassword,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "BasicAuthPassword",
     }),
 };
 const RequiredComponentVariable CertificateEntries = {
+    ControllerComponentVariableId::CertificateEntries,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "CertificateEntries",
     }),
 };
-const ComponentVariable CertSigningRepeatTimes = {
+const ControllerComponentVariable CertSigningRepeatTimes = {
+    ControllerComponentVariableId::CertSigningRepeatTimes,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "CertSigningRepeatTimes",
     }),
 };
-const ComponentVariable CertSigningWaitMinimum = {
+const ControllerComponentVariable CertSigningWaitMinimum = {
+    ControllerComponentVariableId::CertSigningWaitMinimum,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "CertSigningWaitMinimum",
     }),
 };
 const RequiredComponentVariable SecurityCtrlrIdentity = {
+    ControllerComponentVariableId::SecurityCtrlrIdentity,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "Identity",
     }),
 };
-const ComponentVariable MaxCertificateChainSize = {
+const ControllerComponentVariable MaxCertificateChainSize = {
+    ControllerComponentVariableId::MaxCertificateChainSize,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "MaxCertificateChainSize",
     }),
 };
-const ComponentVariable UpdateCertificateSymlinks = {
+const ControllerComponentVariable UpdateCertificateSymlinks = {
+    ControllerComponentVariableId::UpdateCertificateSymlinks,
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
         "UpdateCertificateSymlinks",
     }),
 };
 const RequiredComponentVariable OrganizationName = {
+    ControllerComponentVariableId::OrganizationName,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "OrganizationName",
     }),
 };
 const RequiredComponentVariable SecurityProfile = {
+    ControllerComponentVariableId::SecurityProfile,
     ControllerComponents::SecurityCtrlr,
     std::optional<Variable>({
         "SecurityProfile",
     }),
 };
-const ComponentVariable ACPhaseSwitchingSupported = {
+const ControllerComponentVariable ACPhaseSwitchingSupported = {
+    ControllerComponentVariableId::ACPhaseSwitchingSupported,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "ACPhaseSwitchingSupported",
     }),
 };
-const ComponentVariable SmartChargingCtrlrAvailable = {
+const ControllerComponentVariable SmartChargingCtrlrAvailable = {
+    ControllerComponentVariableId::SmartChargingCtrlrAvailable,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "Available",
     }),
 };
-const ComponentVariable SmartChargingCtrlrEnabled = {
+const ControllerComponentVariable SmartChargingCtrlrEnabled = {
+    ControllerComponentVariableId::SmartChargingCtrlrEnabled,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "Enabled",
     }),
 };
 const RequiredComponentVariable EntriesChargingProfiles = {
+    ControllerComponentVariableId::EntriesChargingProfiles,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({"Entries", "ChargingProfiles"}),
 };
-const ComponentVariable ExternalControlSignalsEnabled = {
+const ControllerComponentVariable ExternalControlSignalsEnabled = {
+    ControllerComponentVariableId::ExternalControlSignalsEnabled,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "ExternalControlSignalsEnabled",
     }),
 };
 const RequiredComponentVariable LimitChangeSignificance = {
+    ControllerComponentVariableId::LimitChangeSignificance,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "LimitChangeSignificance",
     }),
 };
-const ComponentVariable NotifyChargingLimitWithSchedules = {
+const ControllerComponentVariable NotifyChargingLimitWithSchedules = {
+    ControllerComponentVariableId::NotifyChargingLimitWithSchedules,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "NotifyChargingLimitWithSchedules",
     }),
 };
 const RequiredComponentVariable PeriodsPerSchedule = {
+    ControllerComponentVariableId::PeriodsPerSchedule,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "PeriodsPerSchedule",
     }),
 };
 const RequiredComponentVariable CompositeScheduleDefaultLimitAmps = {
+    ControllerComponentVariableId::CompositeScheduleDefaultLimitAmps,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({"CompositeScheduleDefaultLimitAmps"}),
 };
 const RequiredComponentVariable CompositeScheduleDefaultLimitWatts = {
+    ControllerComponentVariableId::CompositeScheduleDefaultLimitWatts,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({"CompositeScheduleDefaultLimitWatts"}),
 };
 const RequiredComponentVariable CompositeScheduleDefaultNumberPhases = {
+    ControllerComponentVariableId::CompositeScheduleDefaultNumberPhases,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({"CompositeScheduleDefaultNumberPhases"}),
 };
 const RequiredComponentVariable SupplyVoltage = {
+    ControllerComponentVariableId::SupplyVoltage,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({"SupplyVoltage"}),
 };
-const ComponentVariable Phases3to1 = {
+const ControllerComponentVariable Phases3to1 = {
+    ControllerComponentVariableId::Phases3to1,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "Phases3to1",
     }),
 };
 const RequiredComponentVariable ChargingProfileMaxStackLevel = {
+    ControllerComponentVariableId::ChargingProfileMaxStackLevel,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "ProfileStackLevel",
     }),
 };
 const RequiredComponentVariable ChargingScheduleChargingRateUnit = {
+    ControllerComponentVariableId::ChargingScheduleChargingRateUnit,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "RateUnit",
     }),
 };
-const ComponentVariable IgnoredProfilePurposesOffline = {
+const ControllerComponentVariable IgnoredProfilePurposesOffline = {
+    ControllerComponentVariableId::IgnoredProfilePurposesOffline,
     ControllerComponents::SmartChargingCtrlr,
     std::optional<Variable>({
         "IgnoredProfilePurposesOffline",
     }),
 };
-const ComponentVariable TariffCostCtrlrAvailableTariff = {
+const ControllerComponentVariable TariffCostCtrlrAvailableTariff = {
+    ControllerComponentVariableId::TariffCostCtrlrAvailableTariff,
     ControllerComponents::TariffCostCtrlr,
     std::optional<Variable>({"Available", "Tariff"}),
 };
-const ComponentVariable TariffCostCtrlrAvailableCost = {
+const ControllerComponentVariable TariffCostCtrlrAvailableCost = {
+    ControllerComponentVariableId::TariffCostCtrlrAvailableCost,
     ControllerComponents::TariffCostCtrlr,
     std::optional<Variable>({"Available", "Cost"}),
 };
 const RequiredComponentVariable TariffCostCtrlrCurrency = {
+    ControllerComponentVariableId::TariffCostCtrlrCurrency,
     ControllerComponents::TariffCostCtrlr,
     std::optional<Variable>({
         "Currency",
     }),
 };
-const ComponentVariable TariffCostCtrlrEnabledTariff = {
+const ControllerComponentVariable TariffCostCtrlrEnabledTariff = {
+    ControllerComponentVariableId::TariffCostCtrlrEnabledTariff,
     ControllerComponents::TariffCostCtrlr,
     std::optional<Variable>({"Enabled", "Tariff"}),
 };
-const ComponentVariable TariffCostCtrlrEnabledCost = {
+const ControllerComponentVariable TariffCostCtrlrEnabledCost = {
+    ControllerComponentVariableId::TariffCostCtrlrEnabledCost,
     ControllerComponents::TariffCostCtrlr,
     std::optional<Variable>({"Enabled", "Cost"}),
 };
 const RequiredComponentVariable TariffFallbackMessage = {
+    ControllerComponentVariableId::TariffFallbackMessage,
     ControllerComponents::TariffCostCtrlr,
     std::optional<Variable>({
         "TariffFallbackMessage",
     }),
 };
 const RequiredComponentVariable TotalCostFallbackMessage = {
+    ControllerComponentVariableId::TotalCostFallbackMessage,
     ControllerComponents::TariffCostCtrlr,
     std::optional<Variable>({
         "TotalCostFallbackMessage",
     }),
 };
 
-const ComponentVariable NumberOfDecimalsForCostValues = {ControllerComponents::TariffCostCtrlr,
-                                                         std::optional<Variable>({"NumberOfDecimalsForCostValues"})};
+const ControllerComponentVariable NumberOfDecimalsForCostValues = {
+    ControllerComponentVariableId::NumberOfDecimalsForCostValues,
+    ControllerComponents::TariffCostCtrlr,
+    std::optional<Variable>({"NumberOfDecimalsForCostValues"}),
+};
 
 const RequiredComponentVariable EVConnectionTimeOut = {
+    ControllerComponentVariableId::EVConnectionTimeOut,
     ControllerComponents::TxCtrlr,
     std::optional<Variable>({
         "EVConnectionTimeOut",
     }),
 };
-const ComponentVariable MaxEnergyOnInvalidId = {
+const ControllerComponentVariable MaxEnergyOnInvalidId = {
+    ControllerComponentVariableId::MaxEnergyOnInvalidId,
     ControllerComponents::TxCtrlr,
     std::optional<Variable>({
         "MaxEnergyOnInvalidId",
     }),
 };
 const RequiredComponentVariable StopTxOnEVSideDisconnect = {
+    ControllerComponentVariableId::StopTxOnEVSideDisconnect,
     ControllerComponents::TxCtrlr,
     std::optional<Variable>({
         "StopTxOnEVSideDisconnect",
     }),
 };
 const RequiredComponentVariable StopTxOnInvalidId = {
+    ControllerComponentVariableId::StopTxOnInvalidId,
     ControllerComponents::TxCtrlr,
     std::optional<Variable>({
         "StopTxOnInvalidId",
     }),
 };
-const ComponentVariable TxBeforeAcceptedEnabled = {
+const ControllerComponentVariable TxBeforeAcceptedEnabled = {
+    ControllerComponentVariableId::TxBeforeAcceptedEnabled,
     ControllerComponents::TxCtrlr,
     std::optional<Variable>({
         "TxBeforeAcceptedEnabled",
     }),
 };
 const RequiredComponentVariable TxStartPoint = {
+    ControllerComponentVariableId::TxStartPoint,
     ControllerComponents::TxCtrlr,
     std::optional<Variable>({
         "TxStartPoint",
     }),
 };
 const RequiredComponentVariable TxStopPoint = {
+    ControllerComponentVariableId::TxStopPoint,
     ControllerComponents::TxCtrlr,
     std::optional<Variable>({
         "TxStopPoint",
     }),
 };
 
+const std::array<std::reference_wrapper<const ControllerComponentVariable>, number_of_variables> all = {
+    InternalCtrlrEnabled, ChargePointId, NetworkConnectionProfiles, ChargeBoxSerialNumber, ChargePointModel,
+    ChargePointSerialNumber, ChargePointVendor, FirmwareVersion, ICCID, IMSI, MeterSerialNumber, MeterType,
+    SupportedCiphers12, SupportedCiphers13, AuthorizeConnectorZeroOnConnectorOne, LogMessages, LogMessagesFormat,
+    LogRotation, LogRotationDateSuffix, LogRotationMaximumFileSize, LogRotationMaximumFileCount, SupportedCriteria,
+    RoundClockAlignedTimestamps, NetworkConfigTimeout, SupportedChargingProfilePurposeTypes,
+    MaxCompositeScheduleDuration, NumberOfConnectors, UseSslDefaultVerifyPaths, VerifyCsmsCommonName, UseTPM,
+    UseTPMSeccLeafCertificate, VerifyCsmsAllowWildcards, IFace, EnableTLSKeylog, TLSKeylogFile, OcspRequestInterval,
+    WebsocketPingPayload, WebsocketPongTimeout, WebsocketMessageFragmentSize, WebsocketPermessageDeflate,
+    WebsocketPermessageDeflateNoContextTakeover, WebsocketPermessageDeflateMaxWindowBits,
+    WebsocketIncrementalMessageParsing, WebsocketSharedContext, WebsocketTlsSessionResumption,
+    WebsocketPersistTlsSessions, RetryBackOffDecorrelatedJitter, RetryBackOffMaximum, RetryBackOffSpread,
+    SingleThreadedEventLoop, MonitorsProcessingInterval, MaxCustomerInformationDataLength,
+    V2GCertificateExpireCheckInitialDelaySeconds, V2GCertificateExpireCheckIntervalSeconds,
+    ClientCertificateExpireCheckInitialDelaySeconds, ClientCertificateExpireCheckIntervalSeconds,
+    MessageQueueSizeThreshold, MessageQueueMaxMessagesInFlight, MessageQueueSizeThresholdBytes,
+    MessageQueueUpdateThinningResolution, MessageQueueTransactionCompactionThreshold,
+    MessageQueueTransactionCompactionInterval, MessageQueuePersistenceFlushInterval,
+    MessageQueuePersistenceMaxPendingOperations, MessageQueuePersistenceFormat, DatabaseTuningProfile,
+    DatabaseReadConnections, TransactionWriteBehind, TransactionWriteBehindMaxQueueSize, MaxMessageSize,
+    ResumeTransactionsOnBoot, AllowCSMSRootCertInstallWithUnsecureConnection,
+    AllowMFRootCertInstallWithUnsecureConnection, AllowSecurityLevelZeroConnections, SupportedOcppVersions,
+    AlignedDataCtrlrEnabled, AlignedDataCtrlrAvailable, AlignedDataInterval, AlignedDataMeasurands,
+    AlignedDataSendDuringIdle, AlignedDataSignReadings, AlignedDataTxEndedInterval, AlignedDataTxEndedMeasurands,
+    AuthCacheCtrlrAvailable, AuthCacheDisablePostAuthorize, AuthCacheCtrlrEnabled, AuthCacheLifeTime, AuthCachePolicy,
+    AuthCacheStorage, AuthCtrlrEnabled, AdditionalInfoItemsPerMessage, AuthorizeRemoteStart, LocalAuthorizeOffline,
+    LocalPreAuthorize, DisableRemoteAuthorization, MasterPassGroupId, OfflineTxForUnknownIdEnabled,
+    AllowNewSessionsPendingFirmwareUpdate, ChargingStationAvailabilityState, ChargingStationAvailable,
+    ChargingStationSupplyPhases, ClockCtrlrDateTime, NextTimeOffsetTransitionDateTime, NtpServerUri, NtpSource,
+    TimeAdjustmentReportingThreshold, TimeOffset, TimeOffsetNextTransition, TimeSource, TimeZone,
+    CustomImplementationEnabled, CustomImplementationCaliforniaPricingEnabled, CustomImplementationMultiLanguageEnabled,
+    BytesPerMessageGetReport, BytesPerMessageGetVariables, BytesPerMessageSetVariables, ConfigurationValueSize,
+    ItemsPerMessageGetReport, ItemsPerMessageGetVariables, ItemsPerMessageSetVariables, ReportingValueSize,
+    DisplayMessageCtrlrAvailable, NumberOfDisplayMessages, DisplayMessageSupportedFormats,
+    DisplayMessageSupportedPriorities, DisplayMessageSupportedStates, DisplayMessageQRCodeDisplayCapable,
+    DisplayMessageLanguage, CentralContractValidationAllowed, ContractValidationOffline, RequestMeteringReceipt,
+    ISO15118CtrlrSeccId, ISO15118CtrlrCountryName, ISO15118CtrlrOrganizationName, PnCEnabled,
+    V2GCertificateInstallationEnabled, ContractCertificateInstallationEnabled, LocalAuthListCtrlrAvailable,
+    BytesPerMessageSendLocalList, LocalAuthListCtrlrEnabled, LocalAuthListCtrlrEntries, ItemsPerMessageSendLocalList,
+    LocalAuthListCtrlrStorage, LocalAuthListDisablePostAuthorize, MonitoringCtrlrAvailable,
+    BytesPerMessageClearVariableMonitoring, BytesPerMessageSetVariableMonitoring, MonitoringCtrlrEnabled,
+    ActiveMonitoringBase, ActiveMonitoringLevel, ItemsPerMessageClearVariableMonitoring,
+    ItemsPerMessageSetVariableMonitoring, OfflineQueuingSeverity, ActiveNetworkProfile, FileTransferProtocols,
+    HeartbeatInterval, MessageTimeout, MessageAttemptInterval, MessageAttempts, NetworkConfigurationPriority,
+    NetworkProfileConnectionAttempts, OfflineThreshold, QueueAllMessages, MessageTypesDiscardForQueueing, ResetRetries,
+    RetryBackOffRandomRange, RetryBackOffRepeatTimes, RetryBackOffWaitMinimum, UnlockOnEVSideDisconnect,
+    WebSocketPingInterval, ReservationCtrlrAvailable, ReservationCtrlrEnabled, ReservationCtrlrNonEvseSpecific,
+    SampledDataCtrlrAvailable, SampledDataCtrlrEnabled, SampledDataSignReadings, SampledDataTxEndedInterval,
+    SampledDataTxEndedMeasurands, SampledDataTxStartedMeasurands, SampledDataTxUpdatedInterval,
+    SampledDataTxUpdatedMeasurands, AdditionalRootCertificateCheck, BasicAuthPassword, CertificateEntries,
+    CertSigningRepeatTimes, CertSigningWaitMinimum, SecurityCtrlrIdentity, MaxCertificateChainSize,
+    UpdateCertificateSymlinks, OrganizationName, SecurityProfile, ACPhaseSwitchingSupported,
+    SmartChargingCtrlrAvailable, SmartChargingCtrlrEnabled, EntriesChargingProfiles, ExternalControlSignalsEnabled,
+    LimitChangeSignificance, NotifyChargingLimitWithSchedules, PeriodsPerSchedule, CompositeScheduleDefaultLimitAmps,
+    CompositeScheduleDefaultLimitWatts, CompositeScheduleDefaultNumberPhases, SupplyVoltage, Phases3to1,
+    ChargingProfileMaxStackLevel, ChargingScheduleChargingRateUnit, IgnoredProfilePurposesOffline,
+    TariffCostCtrlrAvailableTariff, TariffCostCtrlrAvailableCost, TariffCostCtrlrCurrency, TariffCostCtrlrEnabledTariff,
+    TariffCostCtrlrEnabledCost, TariffFallbackMessage, TotalCostFallbackMessage, NumberOfDecimalsForCostValues,
+    EVConnectionTimeOut, MaxEnergyOnInvalidId, StopTxOnEVSideDisconnect, StopTxOnInvalidId, TxBeforeAcceptedEnabled,
+    TxStartPoint, TxStopPoint};
+
 } // namespace ControllerComponentVariables
 
 namespace EvseComponentVariables {
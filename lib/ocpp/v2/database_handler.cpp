@@ -26,6 +26,161 @@ DatabaseHandler::DatabaseHandler(std::unique_ptr<DatabaseConnectionInterface> da
     DatabaseHandlerCommon(std::move(database), sql_migration_files_path, MIGRATION_FILE_VERSION_V2) {
 }
 
+DatabaseHandler::~DatabaseHandler() {
+    this->stop_transaction_write_behind();
+    try {
+        this->close();
+    } catch (const QueryExecutionException& e) {
+        EVLOG_error << e.what();
+    }
+}
+
+void DatabaseHandler::set_transaction_write_behind_config(const TransactionWriteBehindConfig& config) {
+    this->stop_transaction_write_behind();
+
+    std::lock_guard<std::mutex> lk(this->transaction_write_behind_mutex);
+    this->transaction_write_behind_config = config;
+    this->transaction_write_behind_config.max_queue_size = std::max<std::size_t>(config.max_queue_size, 1);
+    this->transaction_write_behind_enabled = config.enabled;
+    if (config.enabled) {
+        this->transaction_write_behind_running = true;
+        this->transaction_write_behind_thread = std::thread([this]() { this->transaction_write_behind_worker(); });
+    }
+}
+
+void DatabaseHandler::stop_transaction_write_behind() {
+    {
+        std::lock_guard<std::mutex> lk(this->transaction_write_behind_mutex);
+        this->transaction_write_behind_running = false;
+    }
+    this->transaction_write_behind_cv.notify_all();
+    this->transaction_write_behind_written_cv.notify_all();
+    // The worker writes the remaining updates before it returns
+    if (this->transaction_write_behind_thread.joinable()) {
+        this->transaction_write_behind_thread.join();
+    }
+    this->transaction_write_behind_enabled = false;
+}
+
+void DatabaseHandler::throw_if_transaction_owner() const {
+    // The worker could never begin its transaction, the transaction_mutex is not recursive
+    if (this->database->is_transaction_owner()) {
+        throw std::logic_error("Queued transaction updates can not be awaited while holding a database transaction");
+    }
+}
+
+void DatabaseHandler::flush_transaction_updates() {
+    if (!this->transaction_write_behind_enabled) {
+        return;
+    }
+    this->throw_if_transaction_owner();
+
+    std::unique_lock<std::mutex> lk(this->transaction_write_behind_mutex);
+    this->transaction_write_behind_written_cv.wait(lk, [this]() {
+        return this->transaction_write_behind_queue.empty() and this->transaction_write_behind_in_flight == 0;
+    });
+}
+
+std::vector<std::string> DatabaseHandler::get_transaction_write_behind_errors() {
+    std::lock_guard<std::mutex> lk(this->transaction_write_behind_mutex);
+    std::vector<std::string> errors;
+    errors.swap(this->transaction_write_behind_errors);
+    return errors;
+}
+
+std::size_t DatabaseHandler::get_transaction_write_behind_queue_depth() const {
+    std::lock_guard<std::mutex> lk(this->transaction_write_behind_mutex);
+    return this->transaction_write_behind_queue.size() + this->transaction_write_behind_in_flight;
+}
+
+std::size_t DatabaseHandler::get_transaction_write_behind_peak_queue_depth() const {
+    std::lock_guard<std::mutex> lk(this->transaction_write_behind_mutex);
+    return this->transaction_write_behind_peak_queue_depth;
+}
+
+bool DatabaseHandler::queue_transaction_update(std::function<void()>&& update) {
+    if (!this->transaction_write_behind_enabled) {
+        return false;
+    }
+    // Waiting for space in the queue would deadlock, the worker needs the transaction_mutex to write
+    this->throw_if_transaction_owner();
+
+    std::unique_lock<std::mutex> lk(this->transaction_write_behind_mutex);
+    this->transaction_write_behind_written_cv.wait(lk, [this]() {
+        return this->transaction_write_behind_queue.size() < this->transaction_write_behind_config.max_queue_size or
+               !this->transaction_write_behind_running;
+    });
+    if (!this->transaction_write_behind_running) {
+        // Stopping, the worker writes the remaining updates before the caller writes this one
+        this->transaction_write_behind_written_cv.wait(lk, [this]() {
+            return this->transaction_write_behind_queue.empty() and this->transaction_write_behind_in_flight == 0;
+        });
+        return false;
+    }
+    this->transaction_write_behind_queue.push_back(std::move(update));
+    this->transaction_write_behind_peak_queue_depth =
+        std::max(this->transaction_write_behind_peak_queue_depth,
+                 this->transaction_write_behind_queue.size() + this->transaction_write_behind_in_flight);
+    lk.unlock();
+    this->transaction_write_behind_cv.notify_one();
+    return true;
+}
+
+void DatabaseHandler::transaction_write_behind_worker() {
+    std::unique_lock<std::mutex> lk(this->transaction_write_behind_mutex);
+    while (true) {
+        this->transaction_write_behind_cv.wait(lk, [this]() {
+            return !this->transaction_write_behind_running or !this->transaction_write_behind_queue.empty();
+        });
+        if (this->transaction_write_behind_queue.empty()) {
+            // only reached when stopped
+            break;
+        }
+
+        std::deque<std::function<void()>> updates;
+        updates.swap(this->transaction_write_behind_queue);
+        this->transaction_write_behind_in_flight = updates.size();
+        lk.unlock();
+        // Callers that waited for space in the queue can continue while the batch is written
+        this->transaction_write_behind_written_cv.notify_all();
+
+        // All updates that were queued in the meantime are written with a single sync to disk
+        bool written = false;
+        try {
+            auto transaction = this->database->begin_transaction();
+            for (const auto& update : updates) {
+                update();
+            }
+            transaction->commit();
+            written = true;
+        } catch (const std::exception& e) {
+            EVLOG_warning << "Could not write " << updates.size()
+                          << " queued transaction updates in one transaction: " << e.what()
+                          << ". Writing them one by one";
+        }
+
+        // write the updates individually so that a single failing update does not discard the whole batch
+        std::vector<std::string> errors;
+        for (std::size_t i = 0; !written and i < updates.size(); i++) {
+            try {
+                auto transaction = this->database->begin_transaction();
+                updates.at(i)();
+                transaction->commit();
+            } catch (const std::exception& e) {
+                EVLOG_error << "Could not write queued transaction update: " << e.what();
+                errors.push_back(e.what());
+            }
+        }
+
+        lk.lock();
+        // Reported by get_transaction_write_behind_errors, the callers that queued the updates have already returned
+        this->transaction_write_behind_errors.insert(this->transaction_write_behind_errors.end(), errors.begin(),
+                                                     errors.end());
+        this->transaction_write_behind_in_flight = 0;
+        this->transaction_write_behind_written_cv.notify_all();
+    }
+}
+
 void DatabaseHandler::init_sql() {
     if (sqlite3_threadsafe() != 1) {
         throw std::logic_error("SQLite must be in serialized thread mode");
@@ -380,6 +535,20 @@ void DatabaseHandler::transaction_metervalues_insert(const std::string& transact
         throw std::invalid_argument("All metervalues must have the same context");
     }
 
+    if (this->queue_transaction_update([this, transaction_id, meter_value, context]() {
+            this->transaction_metervalues_insert_internal(transaction_id, meter_value, context);
+        })) {
+        return;
+    }
+
+    auto transaction = this->database->begin_transaction();
+    this->transaction_metervalues_insert_internal(transaction_id, meter_value, context);
+    transaction->commit();
+}
+
+void DatabaseHandler::transaction_metervalues_insert_internal(const std::string& transaction_id,
+                                                              const MeterValue& meter_value,
+                                                              ReadingContextEnum context) {
     std::string sql1 = "INSERT INTO METER_VALUES (TRANSACTION_ID, TIMESTAMP, READING_CONTEXT, CUSTOM_DATA) VALUES "
                        "(@transaction_id, @timestamp, @context, @custom_data)";
 
@@ -404,7 +573,6 @@ void DatabaseHandler::transaction_metervalues_insert(const std::string& transact
                        "@phase, @location, @custom_data, @unit_custom_data, @unit_text, @unit_multiplier, "
                        "@signed_meter_data, @signing_method, @encoding_method, @public_key);";
 
-    auto transaction = this->database->begin_transaction();
     auto insert_stmt = this->database->new_statement(sql2);
 
     for (const auto& item : meter_value.sampledValue) {
@@ -479,11 +647,10 @@ void DatabaseHandler::transaction_metervalues_insert(const std::string& transact
 
         insert_stmt->reset();
     }
-
-    transaction->commit();
 }
 
 std::vector<MeterValue> DatabaseHandler::transaction_metervalues_get_all(const std::string& transaction_id) {
+    this->flush_transaction_updates();
 
     std::string sql1 = "SELECT * FROM METER_VALUES WHERE TRANSACTION_ID = @transaction_id;";
     std::string sql2 = "SELECT * FROM METER_VALUE_ITEMS WHERE METER_VALUE_ID = @row_id;";
@@ -577,6 +744,7 @@ std::vector<MeterValue> DatabaseHandler::transaction_metervalues_get_all(const s
 }
 
 void DatabaseHandler::transaction_metervalues_clear(const std::string& transaction_id) {
+    this->flush_transaction_updates();
 
     std::string sql1 = "SELECT ROWID FROM METER_VALUES WHERE TRANSACTION_ID = @transaction_id;";
 
@@ -643,6 +811,8 @@ OperationalStatusEnum DatabaseHandler::get_connector_availability(int32_t evse_i
 
 // transactions
 void DatabaseHandler::transaction_insert(const EnhancedTransaction& transaction, int32_t evse_id) {
+    this->flush_transaction_updates();
+
     std::string sql =
         "INSERT INTO TRANSACTIONS "
         "(TRANSACTION_ID, EVSE_ID, CONNECTOR_ID, TIME_START, SEQ_NO, CHARGING_STATE, ID_TAG_SENT) VALUES"
@@ -665,6 +835,8 @@ void DatabaseHandler::transaction_insert(const EnhancedTransaction& transaction,
 }
 
 std::unique_ptr<EnhancedTransaction> DatabaseHandler::transaction_get(const int32_t evse_id) {
+    this->flush_transaction_updates();
+
     std::string sql = "SELECT TRANSACTION_ID, CONNECTOR_ID, TIME_START, SEQ_NO, CHARGING_STATE, ID_TAG_SENT FROM "
                       "TRANSACTIONS WHERE EVSE_ID = @evse_id";
     auto get_stmt = this->database->new_statement(sql);
@@ -694,6 +866,14 @@ std::unique_ptr<EnhancedTransaction> DatabaseHandler::transaction_get(const int3
 }
 
 void DatabaseHandler::transaction_update_seq_no(const std::string& transaction_id, int32_t seq_no) {
+    if (!this->queue_transaction_update([this, transaction_id, seq_no]() {
+            this->transaction_update_seq_no_internal(transaction_id, seq_no);
+        })) {
+        this->transaction_update_seq_no_internal(transaction_id, seq_no);
+    }
+}
+
+void DatabaseHandler::transaction_update_seq_no_internal(const std::string& transaction_id, int32_t seq_no) {
     std::string sql = "UPDATE TRANSACTIONS SET SEQ_NO = @seq_no WHERE TRANSACTION_ID = @transaction_id";
     auto update_stmt = this->database->new_statement(sql);
 
@@ -707,6 +887,15 @@ void DatabaseHandler::transaction_update_seq_no(const std::string& transaction_i
 
 void DatabaseHandler::transaction_update_charging_state(const std::string& transaction_id,
                                                         const ChargingStateEnum charging_state) {
+    if (!this->queue_transaction_update([this, transaction_id, charging_state]() {
+            this->transaction_update_charging_state_internal(transaction_id, charging_state);
+        })) {
+        this->transaction_update_charging_state_internal(transaction_id, charging_state);
+    }
+}
+
+void DatabaseHandler::transaction_update_charging_state_internal(const std::string& transaction_id,
+                                                                 const ChargingStateEnum charging_state) {
     std::string sql = "UPDATE TRANSACTIONS SET CHARGING_STATE = @charging_state WHERE TRANSACTION_ID = @transaction_id";
     auto update_stmt = this->database->new_statement(sql);
 
@@ -719,6 +908,15 @@ void DatabaseHandler::transaction_update_charging_state(const std::string& trans
 }
 
 void DatabaseHandler::transaction_update_id_token_sent(const std::string& transaction_id, bool id_token_sent) {
+    if (!this->queue_transaction_update([this, transaction_id, id_token_sent]() {
+            this->transaction_update_id_token_sent_internal(transaction_id, id_token_sent);
+        })) {
+        this->transaction_update_id_token_sent_internal(transaction_id, id_token_sent);
+    }
+}
+
+void DatabaseHandler::transaction_update_id_token_sent_internal(const std::string& transaction_id,
+                                                                bool id_token_sent) {
     std::string sql = "UPDATE TRANSACTIONS SET ID_TAG_SENT = @id_token_sent WHERE TRANSACTION_ID = @transaction_id";
     auto update_stmt = this->database->new_statement(sql);
 
@@ -731,6 +929,8 @@ void DatabaseHandler::transaction_update_id_token_sent(const std::string& transa
 }
 
 void DatabaseHandler::transaction_delete(const std::string& transaction_id) {
+    this->flush_transaction_updates();
+
     std::string sql = "DELETE FROM TRANSACTIONS WHERE TRANSACTION_ID = @transaction_id";
     auto delete_stmt = this->database->new_statement(sql);
     delete_stmt->bind_text("@transaction_id", transaction_id);
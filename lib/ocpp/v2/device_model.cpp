@@ -282,42 +282,174 @@ bool include_in_summary_inventory(const ComponentVariable& cv, const VariableAtt
     return false;
 }
 
-GetVariableStatusEnum DeviceModel::request_value_internal(const Component& component_id, const Variable& variable_id,
-                                                          const AttributeEnum& attribute_enum, std::string& value,
-                                                          bool allow_write_only) const {
-    const auto component_it = this->device_model_map.find(component_id);
-    if (component_it == this->device_model_map.end()) {
-        EVLOG_debug << "unknown component in " << component_id.name << "." << variable_id.name;
-        return GetVariableStatusEnum::UnknownComponent;
-    }
+/// \brief Combines \p hash into \p seed, like boost::hash_combine
+static void hash_combine(std::size_t& seed, const std::size_t hash) {
+    seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
 
-    const auto& component = component_it->second;
-    const auto& variable_it = component.find(variable_id);
+/// \brief Case sensitive comparison of two optional instances, like operator< of Component and Variable
+static bool instance_equals(const std::optional<CiString<50>>& lhs, const std::optional<CiString<50>>& rhs) {
+    if (lhs.has_value() and rhs.has_value()) {
+        return lhs->get() == rhs->get();
+    }
+    return lhs.has_value() == rhs.has_value();
+}
 
-    if (variable_it == component.end()) {
-        EVLOG_debug << "unknown variable in " << component_id.name << "." << variable_id.name;
-        return GetVariableStatusEnum::UnknownVariable;
+std::size_t DeviceModel::ComponentVariableKeyHash::operator()(const ComponentVariableKey& key) const {
+    const auto& [component, variable] = key;
+    const std::hash<std::string> string_hash;
+    std::size_t seed = string_hash(component->name.get());
+    if (component->instance.has_value()) {
+        hash_combine(seed, string_hash(component->instance->get()));
+    }
+    if (component->evse.has_value()) {
+        hash_combine(seed, std::hash<int32_t>{}(component->evse->id));
+        hash_combine(seed, std::hash<int32_t>{}(component->evse->connectorId.value_or(-1)));
     }
+    hash_combine(seed, string_hash(variable->name.get()));
+    if (variable->instance.has_value()) {
+        hash_combine(seed, string_hash(variable->instance->get()));
+    }
+    return seed;
+}
 
-    const auto attribute_opt = this->device_model->get_variable_attribute(component_id, variable_id, attribute_enum);
+bool DeviceModel::ComponentVariableKeyEqual::operator()(const ComponentVariableKey& lhs,
+                                                        const ComponentVariableKey& rhs) const {
+    return lhs.first->name.get() == rhs.first->name.get() and
+           instance_equals(lhs.first->instance, rhs.first->instance) and lhs.first->evse == rhs.first->evse and
+           lhs.second->name.get() == rhs.second->name.get() and
+           instance_equals(lhs.second->instance, rhs.second->instance);
+}
 
-    if ((not attribute_opt) or (not attribute_opt->value)) {
+/// \brief Sets \p value to the value of \p attribute if it has one and may be read
+static GetVariableStatusEnum get_attribute_value(const VariableAttribute& attribute, std::string& value,
+                                                 bool allow_write_only) {
+    if (not attribute.value) {
         return GetVariableStatusEnum::NotSupportedAttributeType;
     }
 
     // only internal functions can access WriteOnly variables
-    if (!allow_write_only and attribute_opt.value().mutability.has_value() and
-        attribute_opt.value().mutability.value() == MutabilityEnum::WriteOnly) {
+    if (!allow_write_only and attribute.mutability.has_value() and
+        attribute.mutability.value() == MutabilityEnum::WriteOnly) {
         return GetVariableStatusEnum::Rejected;
     }
 
-    value = attribute_opt->value->get();
+    value = attribute.value->get();
     return GetVariableStatusEnum::Accepted;
 }
 
+/// \brief Sets \p value to the value of the attribute of type \p attribute_enum in \p attributes
+static GetVariableStatusEnum get_attribute_value(const std::vector<VariableAttribute>& attributes,
+                                                 const AttributeEnum& attribute_enum, std::string& value,
+                                                 bool allow_write_only) {
+    for (const auto& attribute : attributes) {
+        if (attribute.type == attribute_enum) {
+            return get_attribute_value(attribute, value, allow_write_only);
+        }
+    }
+    return GetVariableStatusEnum::NotSupportedAttributeType;
+}
+
+GetVariableStatusEnum DeviceModel::request_value_internal(const Component& component_id, const Variable& variable_id,
+                                                          const AttributeEnum& attribute_enum, std::string& value,
+                                                          bool allow_write_only) const {
+    // No lock for the lookup, the keys of variable_attributes do not change after construction
+    const auto attributes_it = this->variable_attributes.find({&component_id, &variable_id});
+    if (attributes_it == this->variable_attributes.end()) {
+        return this->get_unknown_variable_status(component_id, variable_id);
+    }
+
+    return this->request_value_internal(attributes_it->second, attribute_enum, value, allow_write_only);
+}
+
+GetVariableStatusEnum DeviceModel::request_value_internal(const ControllerComponentVariable& component_variable,
+                                                          const AttributeEnum& attribute_enum, std::string& value,
+                                                          bool allow_write_only) const {
+    if (!component_variable.id.has_value() or
+        this->controller_variable_attributes.at(component_variable.id.value()) == nullptr) {
+        return this->request_value_internal(component_variable.component, component_variable.variable.value(),
+                                            attribute_enum, value, allow_write_only);
+    }
+
+    return this->request_value_internal(*this->controller_variable_attributes.at(component_variable.id.value()),
+                                        attribute_enum, value, allow_write_only);
+}
+
+GetVariableStatusEnum DeviceModel::request_value_internal(const std::vector<VariableAttribute>& attributes,
+                                                          const AttributeEnum& attribute_enum, std::string& value,
+                                                          bool allow_write_only) const {
+    std::lock_guard<std::mutex> lock(this->variable_attributes_mutex);
+    return get_attribute_value(attributes, attribute_enum, value, allow_write_only);
+}
+
+GetVariableStatusEnum DeviceModel::get_unknown_variable_status(const Component& component_id,
+                                                               const Variable& variable_id) const {
+    if (this->device_model_map.find(component_id) == this->device_model_map.end()) {
+        EVLOG_debug << "unknown component in " << component_id.name << "." << variable_id.name;
+        return GetVariableStatusEnum::UnknownComponent;
+    }
+    EVLOG_debug << "unknown variable in " << component_id.name << "." << variable_id.name;
+    return GetVariableStatusEnum::UnknownVariable;
+}
+
+std::vector<GetVariableResult>
+DeviceModel::request_values(const std::vector<GetVariableData>& get_variable_data) const {
+    std::vector<GetVariableResult> results;
+    results.reserve(get_variable_data.size());
+
+    // Keep the lock for the whole request, so all values are read from the same state of the device model
+    std::lock_guard<std::mutex> lock(this->variable_attributes_mutex);
+    for (const auto& data : get_variable_data) {
+        GetVariableResult result;
+        result.component = data.component;
+        result.variable = data.variable;
+        result.attributeType = data.attributeType.value_or(AttributeEnum::Actual);
+
+        const auto attributes_it = this->variable_attributes.find({&data.component, &data.variable});
+        if (attributes_it == this->variable_attributes.end()) {
+            result.attributeStatus = this->get_unknown_variable_status(data.component, data.variable);
+        } else {
+            std::string value;
+            result.attributeStatus =
+                get_attribute_value(attributes_it->second, result.attributeType.value(), value, false);
+            if (result.attributeStatus == GetVariableStatusEnum::Accepted) {
+                result.attributeValue = value;
+            }
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+std::optional<VariableAttribute> DeviceModel::get_variable_attribute(const Component& component_id,
+                                                                    const Variable& variable_id,
+                                                                    const AttributeEnum& attribute_enum) const {
+    std::lock_guard<std::mutex> lock(this->variable_attributes_mutex);
+    const auto attributes_it = this->variable_attributes.find({&component_id, &variable_id});
+    if (attributes_it == this->variable_attributes.end()) {
+        return std::nullopt;
+    }
+    for (const auto& attribute : attributes_it->second) {
+        if (attribute.type == attribute_enum) {
+            return attribute;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<VariableAttribute> DeviceModel::get_variable_attributes(const Component& component_id,
+                                                                    const Variable& variable_id) const {
+    std::lock_guard<std::mutex> lock(this->variable_attributes_mutex);
+    const auto attributes_it = this->variable_attributes.find({&component_id, &variable_id});
+    if (attributes_it == this->variable_attributes.end()) {
+        return {};
+    }
+    return attributes_it->second;
+}
+
 std::optional<MutabilityEnum> DeviceModel::get_mutability(const Component& component, const Variable& variable,
                                                           const AttributeEnum& attribute_enum) {
-    const auto attribute = this->device_model->get_variable_attribute(component, variable, attribute_enum);
+    const auto attribute = this->get_variable_attribute(component, variable, attribute_enum);
     if (!attribute.has_value()) {
         return std::nullopt;
     }
@@ -325,21 +457,20 @@ std::optional<MutabilityEnum> DeviceModel::get_mutability(const Component& compo
     return attribute.value().mutability.value();
 }
 
-SetVariableStatusEnum DeviceModel::set_value(const Component& component, const Variable& variable,
-                                             const AttributeEnum& attribute_enum, const std::string& value,
-                                             const std::string& source, bool allow_read_only) {
-
-    if (this->device_model_map.find(component) == this->device_model_map.end()) {
+SetVariableStatusEnum DeviceModel::validate_set_value(const Component& component, const Variable& variable,
+                                                      const AttributeEnum& attribute_enum, const std::string& value,
+                                                      const bool allow_read_only) const {
+    const auto component_it = this->device_model_map.find(component);
+    if (component_it == this->device_model_map.end()) {
         return SetVariableStatusEnum::UnknownComponent;
     }
 
-    auto variable_map = this->device_model_map[component];
-
-    if (variable_map.find(variable) == variable_map.end()) {
+    const auto variable_it = component_it->second.find(variable);
+    if (variable_it == component_it->second.end()) {
         return SetVariableStatusEnum::UnknownVariable;
     }
 
-    const auto& characteristics = variable_map[variable].characteristics;
+    const auto& characteristics = variable_it->second.characteristics;
     try {
         if (!validate_value(characteristics, value, allow_zero(component, variable))) {
             return SetVariableStatusEnum::Rejected;
@@ -350,7 +481,7 @@ SetVariableStatusEnum DeviceModel::set_value(const Component& component, const V
         return SetVariableStatusEnum::Rejected;
     }
 
-    const auto attribute = this->device_model->get_variable_attribute(component, variable, attribute_enum);
+    const auto attribute = this->get_variable_attribute(component, variable, attribute_enum);
 
     if (!attribute.has_value()) {
         return SetVariableStatusEnum::NotSupportedAttributeType;
@@ -362,33 +493,156 @@ SetVariableStatusEnum DeviceModel::set_value(const Component& component, const V
         return SetVariableStatusEnum::Rejected;
     }
 
-    const auto success =
-        this->device_model->set_variable_attribute_value(component, variable, attribute_enum, value, source);
+    return SetVariableStatusEnum::Accepted;
+}
+
+std::optional<VariableAttribute> DeviceModel::set_cached_value(const Component& component, const Variable& variable,
+                                                               const AttributeEnum& attribute_enum,
+                                                               const std::string& value) {
+    const auto attributes_it = this->variable_attributes.find({&component, &variable});
+    if (attributes_it == this->variable_attributes.end()) {
+        return std::nullopt;
+    }
+    for (auto& cached_attribute : attributes_it->second) {
+        if (cached_attribute.type == attribute_enum) {
+            auto previous_attribute = cached_attribute;
+            cached_attribute.value = value;
+            return previous_attribute;
+        }
+    }
+    return std::nullopt;
+}
 
+void DeviceModel::notify_variable_changed(const Component& component, const Variable& variable,
+                                          const VariableAttribute& attribute, const std::string& value) {
     // Only trigger for actual values
-    if ((attribute_enum == AttributeEnum::Actual) && success && variable_listener) {
-        const auto& monitors = variable_map[variable].monitors;
+    if (attribute.type != AttributeEnum::Actual or !variable_listener) {
+        return;
+    }
 
-        // If we had a variable value change, trigger the listener
-        if (!monitors.empty()) {
-            static const std::string EMPTY_VALUE{};
+    const auto& variable_meta_data = this->device_model_map.at(component).at(variable);
+    const auto& monitors = variable_meta_data.monitors;
 
-            const std::string& value_previous = attribute.value().value.value_or(EMPTY_VALUE);
-            const std::string& value_current = value;
+    // If we had a variable value change, trigger the listener
+    if (!monitors.empty()) {
+        static const std::string EMPTY_VALUE{};
 
-            if (value_previous != value_current) {
-                variable_listener(monitors, component, variable, characteristics, attribute.value(), value_previous,
-                                  value_current);
-            }
+        const std::string& value_previous = attribute.value.value_or(EMPTY_VALUE);
+        const std::string& value_current = value;
+
+        if (value_previous != value_current) {
+            variable_listener(monitors, component, variable, variable_meta_data.characteristics, attribute,
+                              value_previous, value_current);
+        }
+    }
+}
+
+SetVariableStatusEnum DeviceModel::set_value(const Component& component, const Variable& variable,
+                                             const AttributeEnum& attribute_enum, const std::string& value,
+                                             const std::string& source, bool allow_read_only) {
+    const auto status = this->validate_set_value(component, variable, attribute_enum, value, allow_read_only);
+    if (status != SetVariableStatusEnum::Accepted) {
+        return status;
+    }
+
+    bool success = false;
+    std::optional<VariableAttribute> previous_attribute;
+    {
+        // Serializes the writers, so the cache is updated in the same order as the storage. Readers only wait for the
+        // update of the cache, not for the storage
+        std::lock_guard<std::mutex> write_lock(this->storage_write_mutex);
+        success = this->device_model->set_variable_attribute_value(component, variable, attribute_enum, value, source);
+        if (success) {
+            std::lock_guard<std::mutex> lock(this->variable_attributes_mutex);
+            previous_attribute = this->set_cached_value(component, variable, attribute_enum, value);
         }
     }
 
+    if (previous_attribute.has_value()) {
+        this->notify_variable_changed(component, variable, previous_attribute.value(), value);
+    }
+
     return success ? SetVariableStatusEnum::Accepted : SetVariableStatusEnum::Rejected;
 };
 
+std::vector<SetVariableStatusEnum> DeviceModel::set_values(const std::vector<SetVariableData>& set_variable_data,
+                                                           const std::string& source, const bool allow_read_only) {
+    std::vector<SetVariableStatusEnum> statuses;
+    statuses.reserve(set_variable_data.size());
+    // values that passed the validation and the index of their SetVariableData
+    std::vector<VariableAttributeUpdate> updates;
+    std::vector<std::size_t> update_indices;
+
+    for (std::size_t i = 0; i < set_variable_data.size(); i++) {
+        const auto& data = set_variable_data.at(i);
+        const auto attribute_enum = data.attributeType.value_or(AttributeEnum::Actual);
+        statuses.push_back(this->validate_set_value(data.component, data.variable, attribute_enum,
+                                                    data.attributeValue.get(), allow_read_only));
+        if (statuses.back() == SetVariableStatusEnum::Accepted) {
+            updates.push_back({data.component, data.variable, attribute_enum, data.attributeValue.get(), source});
+            update_indices.push_back(i);
+        }
+    }
+
+    if (updates.empty()) {
+        return statuses;
+    }
+
+    // index of the SetVariableData and the VariableAttribute before it was changed
+    std::vector<std::pair<std::size_t, VariableAttribute>> changed_attributes;
+    {
+        // Serializes the writers, so the cache is updated in the same order as the storage
+        std::lock_guard<std::mutex> write_lock(this->storage_write_mutex);
+        const auto results = this->device_model->set_variable_attribute_values(updates);
+        std::lock_guard<std::mutex> lock(this->variable_attributes_mutex);
+        for (std::size_t i = 0; i < updates.size(); i++) {
+            const auto index = update_indices.at(i);
+            if (i >= results.size() or !results.at(i)) {
+                statuses.at(index) = SetVariableStatusEnum::Rejected;
+                continue;
+            }
+            const auto& update = updates.at(i);
+            auto previous_attribute =
+                this->set_cached_value(update.component, update.variable, update.attribute_enum, update.value);
+            if (previous_attribute.has_value()) {
+                changed_attributes.emplace_back(index, std::move(previous_attribute.value()));
+            }
+        }
+    }
+
+    for (const auto& [index, previous_attribute] : changed_attributes) {
+        const auto& data = set_variable_data.at(index);
+        this->notify_variable_changed(data.component, data.variable, previous_attribute, data.attributeValue.get());
+    }
+
+    return statuses;
+}
+
 DeviceModel::DeviceModel(std::unique_ptr<DeviceModelStorageInterface> device_model_storage_interface) :
     device_model{std::move(device_model_storage_interface)} {
     this->device_model_map = this->device_model->get_device_model();
+    std::size_t nr_of_variables = 0;
+    for (const auto& [component, variable_map] : this->device_model_map) {
+        nr_of_variables += variable_map.size();
+    }
+    this->variable_attributes.reserve(nr_of_variables);
+    for (const auto& [component, variable_map] : this->device_model_map) {
+        for (const auto& [variable, variable_meta_data] : variable_map) {
+            this->variable_attributes.emplace(ComponentVariableKey{&component, &variable},
+                                              this->device_model->get_variable_attributes(component, variable));
+        }
+    }
+
+    for (const ControllerComponentVariable& component_variable : ControllerComponentVariables::all) {
+        if (!component_variable.variable.has_value()) {
+            continue;
+        }
+        const auto attributes_it =
+            this->variable_attributes.find({&component_variable.component, &component_variable.variable.value()});
+        if (attributes_it != this->variable_attributes.end()) {
+            this->controller_variable_attributes.at(component_variable.id.value()) = &attributes_it->second;
+        }
+    }
 }
 
 SetVariableStatusEnum DeviceModel::set_read_only_value(const Component& component, const Variable& variable,
@@ -426,7 +680,7 @@ std::vector<ReportData> DeviceModel::get_base_report_data(const ReportBaseEnum&
             cv.variable = variable;
 
             // request the variable attribute from the device model
-            const auto variable_attributes = this->device_model->get_variable_attributes(component, variable);
+            const auto variable_attributes = this->get_variable_attributes(component, variable);
 
             // iterate over possibly (Actual, Target, MinSet, MaxSet)
             for (const auto& variable_attribute : variable_attributes) {
@@ -470,7 +724,7 @@ DeviceModel::get_custom_report_data(const std::optional<std::vector<ComponentVar
                     report_data.variable = variable;
 
                     //  request the variable attribute from the device model
-                    const auto variable_attributes = this->device_model->get_variable_attributes(component, variable);
+                    const auto variable_attributes = this->get_variable_attributes(component, variable);
 
                     for (const auto& variable_attribute : variable_attributes) {
                         report_data.variableAttribute.push_back(variable_attribute);
@@ -765,8 +1019,8 @@ std::vector<SetMonitoringResult> DeviceModel::set_monitors(const std::vector<Set
                 // N07.FR.11
                 // In case of an existing monitor update
                 if (request_has_id && monitor_update_listener) {
-                    auto attribute = this->device_model->get_variable_attribute(component_it->first, variable_it->first,
-                                                                                AttributeEnum::Actual);
+                    auto attribute =
+                        this->get_variable_attribute(component_it->first, variable_it->first, AttributeEnum::Actual);
 
                     if (attribute.has_value()) {
                         static std::string empty_value{};
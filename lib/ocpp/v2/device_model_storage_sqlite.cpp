@@ -19,7 +19,8 @@ extern void filter_criteria_monitors(const std::vector<MonitoringCriterionEnum>&
                                      std::vector<VariableMonitoringMeta>& monitors);
 
 DeviceModelStorageSqlite::DeviceModelStorageSqlite(const fs::path& db_path, const fs::path& migration_files_path,
-                                                   const fs::path& config_path, const bool init_db) {
+                                                   const fs::path& config_path, const bool init_db,
+                                                   const ocpp::common::DatabaseTuningProfile& tuning_profile) {
     if (init_db) {
         if (db_path.empty() || migration_files_path.empty() || config_path.empty()) {
             EVLOG_AND_THROW(DeviceModelError("Can not initialize device model storage: one of the paths is empty."));
@@ -28,7 +29,8 @@ DeviceModelStorageSqlite::DeviceModelStorageSqlite(const fs::path& db_path, cons
         init_device_model_db.initialize_database(config_path, false);
     }
 
-    db = std::make_unique<ocpp::common::DatabaseConnection>(db_path);
+    db = std::make_unique<ocpp::common::DatabaseConnection>(db_path, ocpp::common::DEFAULT_STATEMENT_CACHE_SIZE,
+                                                            tuning_profile);
 
     if (!db->open_connection()) {
         EVLOG_AND_THROW(
@@ -248,6 +250,40 @@ bool DeviceModelStorageSqlite::set_variable_attribute_value(const Component& com
     return true;
 }
 
+std::vector<bool>
+DeviceModelStorageSqlite::set_variable_attribute_values(const std::vector<VariableAttributeUpdate>& updates) {
+    std::vector<bool> results(updates.size(), false);
+    auto transaction = this->db->begin_transaction();
+
+    std::string update_query =
+        "UPDATE VARIABLE_ATTRIBUTE SET VALUE = ?, VALUE_SOURCE = ? WHERE VARIABLE_ID = ? AND TYPE_ID = ?";
+    auto update_stmt = this->db->new_statement(update_query);
+
+    for (std::size_t i = 0; i < updates.size(); i++) {
+        const auto& update = updates.at(i);
+        const auto _variable_id = this->get_variable_id(update.component, update.variable);
+
+        if (_variable_id == -1) {
+            continue;
+        }
+
+        update_stmt->bind_text(1, update.value);
+        update_stmt->bind_text(2, update.source);
+        update_stmt->bind_int(3, _variable_id);
+        update_stmt->bind_int(4, static_cast<int>(update.attribute_enum));
+        if (update_stmt->step() != SQLITE_DONE) {
+            EVLOG_error << this->db->get_error_message();
+            // the transaction is rolled back, so none of the values is written
+            return std::vector<bool>(updates.size(), false);
+        }
+        update_stmt->reset();
+        results.at(i) = true;
+    }
+
+    transaction->commit();
+    return results;
+}
+
 bool DeviceModelStorageSqlite::update_monitoring_reference(const int32_t monitor_id,
                                                            const std::string& reference_value) {
     auto transaction = this->db->begin_transaction();
@@ -69,6 +69,11 @@ ocpp::v2::Authorization::authorize_req(const IdToken id_token, const std::option
         return response;
     }
 
+    if (!this->context.message_dispatcher.can_wait_for_response()) {
+        EVLOG_error << "Authorize.req can not wait for its response on the event loop, not sending it";
+        return response;
+    }
+
     ocpp::Call<AuthorizeRequest> call(req);
     auto future = this->context.message_dispatcher.dispatch_call_async(call);
 
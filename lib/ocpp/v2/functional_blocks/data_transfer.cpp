@@ -46,6 +46,11 @@ std::optional<DataTransferResponse> DataTransfer::data_transfer_req(const DataTr
     DataTransferResponse response;
     response.status = DataTransferStatusEnum::Rejected;
 
+    if (!this->context.message_dispatcher.can_wait_for_response()) {
+        EVLOG_error << "DataTransfer.req can not wait for its response on the event loop, not sending it";
+        return std::nullopt;
+    }
+
     ocpp::Call<DataTransferRequest> call(request);
     auto data_transfer_future = this->context.message_dispatcher.dispatch_call_async(call);
 
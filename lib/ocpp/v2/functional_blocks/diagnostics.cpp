@@ -266,7 +266,7 @@ void Diagnostics::handle_set_monitoring_level_req(Call<SetMonitoringLevelRequest
 }
 
 void Diagnostics::handle_set_variable_monitoring_req(const EnhancedMessage<MessageType>& message) {
-    Call<SetVariableMonitoringRequest> call = message.call_message;
+    Call<SetVariableMonitoringRequest> call = message.message;
     SetVariableMonitoringResponse response;
     const auto& msg = call.msg;
 
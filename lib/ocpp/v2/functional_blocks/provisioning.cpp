@@ -117,23 +117,7 @@ void Provisioning::on_variable_changed(const SetVariableData& set_variable_data)
 
 std::vector<GetVariableResult>
 Provisioning::get_variables(const std::vector<GetVariableData>& get_variable_data_vector) {
-    std::vector<GetVariableResult> response;
-    for (const auto& get_variable_data : get_variable_data_vector) {
-        GetVariableResult get_variable_result;
-        get_variable_result.component = get_variable_data.component;
-        get_variable_result.variable = get_variable_data.variable;
-        get_variable_result.attributeType = get_variable_data.attributeType.value_or(AttributeEnum::Actual);
-        const auto request_value_response = this->context.device_model.request_value<std::string>(
-            get_variable_data.component, get_variable_data.variable,
-            get_variable_data.attributeType.value_or(AttributeEnum::Actual));
-        if (request_value_response.status == GetVariableStatusEnum::Accepted and
-            request_value_response.value.has_value()) {
-            get_variable_result.attributeValue = request_value_response.value.value();
-        }
-        get_variable_result.attributeStatus = request_value_response.status;
-        response.push_back(get_variable_result);
-    }
-    return response;
+    return this->context.device_model.request_values(get_variable_data_vector);
 }
 
 std::map<SetVariableData, SetVariableResult>
@@ -236,7 +220,7 @@ void Provisioning::handle_set_variables_req(Call<SetVariablesRequest> call) {
 }
 
 void Provisioning::handle_get_variables_req(const EnhancedMessage<MessageType>& message) {
-    Call<GetVariablesRequest> call = message.call_message;
+    Call<GetVariablesRequest> call = message.message;
     const auto msg = call.msg;
 
     const auto max_variables_per_message =
@@ -282,7 +266,7 @@ void Provisioning::handle_get_base_report_req(Call<GetBaseReportRequest> call) {
 }
 
 void Provisioning::handle_get_report_req(const EnhancedMessage<MessageType>& message) {
-    Call<GetReportRequest> call = message.call_message;
+    Call<GetReportRequest> call = message.message;
     const auto msg = call.msg;
     std::vector<ReportData> report_data;
     GetReportResponse response;
@@ -652,6 +636,8 @@ std::map<SetVariableData, SetVariableResult>
 Provisioning::set_variables_internal(const std::vector<SetVariableData>& set_variable_data_vector,
                                      const std::string& source, const bool allow_read_only) {
     std::map<SetVariableData, SetVariableResult> response;
+    // variables that are valid according to the business logic of the spec, they are set together
+    std::vector<SetVariableData> valid_set_variable_data;
 
     // iterate over the set_variable_data_vector
     for (const auto& set_variable_data : set_variable_data_vector) {
@@ -659,20 +645,21 @@ Provisioning::set_variables_internal(const std::vector<SetVariableData>& set_var
         set_variable_result.component = set_variable_data.component;
         set_variable_result.variable = set_variable_data.variable;
         set_variable_result.attributeType = set_variable_data.attributeType.value_or(AttributeEnum::Actual);
+        set_variable_result.attributeStatus = SetVariableStatusEnum::Rejected;
 
         // validates variable against business logic of the spec
         if (this->validate_set_variable(set_variable_data)) {
-            // attempt to set the value includes device model validation
-            set_variable_result.attributeStatus =
-                this->context.device_model.set_value(set_variable_data.component, set_variable_data.variable,
-                                                     set_variable_data.attributeType.value_or(AttributeEnum::Actual),
-                                                     set_variable_data.attributeValue.get(), source, allow_read_only);
-        } else {
-            set_variable_result.attributeStatus = SetVariableStatusEnum::Rejected;
+            valid_set_variable_data.push_back(set_variable_data);
         }
         response[set_variable_data] = set_variable_result;
     }
 
+    // attempt to set the values includes device model validation, all values are written in a single transaction
+    const auto statuses = this->context.device_model.set_values(valid_set_variable_data, source, allow_read_only);
+    for (std::size_t i = 0; i < valid_set_variable_data.size(); i++) {
+        response[valid_set_variable_data.at(i)].attributeStatus = statuses.at(i);
+    }
+
     return response;
 }
 
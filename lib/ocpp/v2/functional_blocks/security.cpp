@@ -75,6 +75,12 @@ Security::on_get_15118_ev_certificate_request(const Get15118EVCertificateRequest
     }
 
     EVLOG_debug << "Received Get15118EVCertificateRequest " << request;
+    if (!this->context.message_dispatcher.can_wait_for_response()) {
+        EVLOG_error << "Get15118EVCertificateRequest can not wait for its response on the event loop, not sending it";
+        response.status = Iso15118EVCertificateStatusEnum::Failed;
+        return response;
+    }
+
     auto future_res =
         this->context.message_dispatcher.dispatch_call_async(ocpp::Call<Get15118EVCertificateRequest>(request));
 
@@ -3,13 +3,16 @@
 
 #include <ocpp/v2/init_device_model_db.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
 #include <map>
+#include <sstream>
 #include <string>
 
 #include <everest/logging.hpp>
 #include <ocpp/v2/enums.hpp>
+#include <ocpp/v2/utils.hpp>
 
 const static std::string STANDARDIZED_COMPONENT_CONFIG_DIR = "standardized";
 const static std::string CUSTOM_COMPONENT_CONFIG_DIR = "custom";
@@ -38,6 +41,9 @@ static bool has_attribute_actual_value(const VariableAttribute& attribute,
 static std::string get_string_value_from_json(const json& value);
 static std::string get_component_name_for_logging(const ComponentKey& component);
 static std::string get_variable_name_for_logging(const DeviceModelVariable& variable);
+static std::string get_component_config_file_hash(const std::string& content);
+static std::string get_component_config_hash(const std::vector<ComponentConfigFile>& standardized_files,
+                                             const std::vector<ComponentConfigFile>& custom_files);
 
 InitDeviceModelDb::InitDeviceModelDb(const std::filesystem::path& database_path,
                                      const std::filesystem::path& migration_files_path) :
@@ -54,28 +60,43 @@ InitDeviceModelDb::~InitDeviceModelDb() {
 void InitDeviceModelDb::initialize_database(const std::filesystem::path& config_path, bool delete_db_if_exists = true) {
     execute_init_sql(delete_db_if_exists);
 
+    // Get component config files from the filesystem.
+    const std::vector<ComponentConfigFile> standardized_files =
+        read_component_config_files(config_path, STANDARDIZED_COMPONENT_CONFIG_DIR);
+    const std::vector<ComponentConfigFile> custom_files =
+        read_component_config_files(config_path, CUSTOM_COMPONENT_CONFIG_DIR);
+    const std::string config_hash = get_component_config_hash(standardized_files, custom_files);
+
+    // Nothing has to be done if the database was initialized with exactly the same component config files.
+    if (this->database_exists && get_config_hash_from_db() == config_hash) {
+        EVLOG_debug << "Component config did not change, device model database is up to date";
+        return;
+    }
+
     // Get existing components from the database.
     std::map<ComponentKey, std::vector<DeviceModelVariable>> existing_components;
-    DeviceModelMap device_model;
     if (this->database_exists) {
         existing_components = get_all_components_from_db();
     }
 
-    // Get component config files from the filesystem.
-    std::map<ComponentKey, std::vector<DeviceModelVariable>> component_configs = get_all_component_configs(config_path);
+    std::map<ComponentKey, std::vector<DeviceModelVariable>> component_configs =
+        get_all_component_configs(standardized_files, custom_files);
 
     // Check if the config is consistent.
     check_integrity(component_configs);
 
+    // Starting a transaction makes this a lot faster (inserting all components takes a few seconds without it and a
+    // few milliseconds if it is done inside a transaction). It also makes sure the stored hashes always belong to the
+    // components in the database.
+    std::unique_ptr<common::DatabaseTransactionInterface> transaction = database->begin_transaction();
+
     // Remove components from db if they do not exist in the component config
     if (this->database_exists) {
         remove_not_existing_components_from_db(component_configs, existing_components);
     }
 
-    // Starting a transaction makes this a lot faster (inserting all components takes a few seconds without it and a
-    // few milliseconds if it is done inside a transaction).
-    std::unique_ptr<common::DatabaseTransactionInterface> transaction = database->begin_transaction();
     insert_components(component_configs, existing_components);
+    set_config_hash_in_db(config_hash);
     transaction->commit();
 }
 
@@ -120,17 +141,31 @@ InitDeviceModelDb::get_component_config_from_directory(const std::filesystem::pa
     return component_config_files;
 }
 
-std::map<ComponentKey, std::vector<DeviceModelVariable>>
-InitDeviceModelDb::get_all_component_configs(const std::filesystem::path& directory) {
-    const std::vector<std::filesystem::path> standardized_component_config_files =
-        get_component_config_from_directory(directory / STANDARDIZED_COMPONENT_CONFIG_DIR);
-    const std::vector<std::filesystem::path> custom_component_config_files =
-        get_component_config_from_directory(directory / CUSTOM_COMPONENT_CONFIG_DIR);
+std::vector<ComponentConfigFile>
+InitDeviceModelDb::read_component_config_files(const std::filesystem::path& config_path,
+                                               const std::filesystem::path& directory) {
+    std::vector<ComponentConfigFile> component_config_files;
+    for (const auto& path : get_component_config_from_directory(config_path / directory)) {
+        std::ifstream config_file(path);
+        std::stringstream content;
+        content << config_file.rdbuf();
+
+        ComponentConfigFile component_config_file;
+        component_config_file.path = directory / path.filename();
+        component_config_file.content = content.str();
+        component_config_file.hash = get_component_config_file_hash(component_config_file.content);
+        component_config_files.push_back(std::move(component_config_file));
+    }
+
+    return component_config_files;
+}
 
+std::map<ComponentKey, std::vector<DeviceModelVariable>>
+InitDeviceModelDb::get_all_component_configs(const std::vector<ComponentConfigFile>& standardized_files,
+                                             const std::vector<ComponentConfigFile>& custom_files) {
     std::map<ComponentKey, std::vector<DeviceModelVariable>> standardized_components_map =
-        read_component_config(standardized_component_config_files);
-    std::map<ComponentKey, std::vector<DeviceModelVariable>> components =
-        read_component_config(custom_component_config_files);
+        read_component_config(standardized_files);
+    std::map<ComponentKey, std::vector<DeviceModelVariable>> components = read_component_config(custom_files);
 
     // Merge the two maps so they can be used for the insert_component function with a single iterator. This will use
     // the custom components map as base and add not existing standardized components to the components map. So if the
@@ -148,8 +183,14 @@ void InitDeviceModelDb::insert_components(
         std::optional<std::pair<ComponentKey, std::vector<DeviceModelVariable>>> component_db;
         if (this->database_exists &&
             (component_db = component_exists_in_db(existing_components, component.first)).has_value()) {
+            if (component.first.config_hash.has_value() &&
+                component_db.value().first.config_hash == component.first.config_hash) {
+                // Component config file did not change since the component was written to the database.
+                continue;
+            }
             // Component exists in the database, update component if necessary.
             update_component_variables(component_db.value(), component.second);
+            update_component_config_hash(component_db.value().first, component.first.config_hash);
         } else {
             // Database is new or component does not exist. Insert component.
             insert_component(component.first, component.second);
@@ -161,8 +202,9 @@ void InitDeviceModelDb::insert_component(const ComponentKey& component_key,
                                          const std::vector<DeviceModelVariable>& component_variables) {
     EVLOG_debug << "Inserting component " << component_key.name;
 
-    static const std::string statement = "INSERT OR REPLACE INTO COMPONENT (NAME, INSTANCE, EVSE_ID, CONNECTOR_ID) "
-                                         "VALUES (@name, @instance, @evse_id, @connector_id)";
+    static const std::string statement =
+        "INSERT OR REPLACE INTO COMPONENT (NAME, INSTANCE, EVSE_ID, CONNECTOR_ID, CONFIG_HASH) "
+        "VALUES (@name, @instance, @evse_id, @connector_id, @config_hash)";
 
     std::unique_ptr<common::SQLiteStatementInterface> insert_component_statement;
     try {
@@ -191,6 +233,13 @@ void InitDeviceModelDb::insert_component(const ComponentKey& component_key,
         insert_component_statement->bind_null("@instance");
     }
 
+    if (component_key.config_hash.has_value()) {
+        insert_component_statement->bind_text("@config_hash", component_key.config_hash.value(),
+                                              ocpp::common::SQLiteString::Transient);
+    } else {
+        insert_component_statement->bind_null("@config_hash");
+    }
+
     if (insert_component_statement->step() != SQLITE_DONE) {
         throw InitDeviceModelDbError("Could not insert component " + component_key.name + ": " +
                                      std::string(this->database->get_error_message()));
@@ -208,13 +257,13 @@ void InitDeviceModelDb::insert_component(const ComponentKey& component_key,
 }
 
 std::map<ComponentKey, std::vector<DeviceModelVariable>>
-InitDeviceModelDb::read_component_config(const std::vector<std::filesystem::path>& components_config_path) {
+InitDeviceModelDb::read_component_config(const std::vector<ComponentConfigFile>& component_config_files) {
     std::map<ComponentKey, std::vector<DeviceModelVariable>> components;
-    for (const auto& path : components_config_path) {
-        std::ifstream config_file(path);
+    for (const auto& component_config_file : component_config_files) {
         try {
-            json data = json::parse(config_file);
+            json data = json::parse(component_config_file.content);
             ComponentKey p = data;
+            p.config_hash = component_config_file.hash;
             if (data.contains("properties")) {
                 std::vector<DeviceModelVariable> variables = get_all_component_properties(data.at("properties"));
                 components.insert({p, variables});
@@ -223,7 +272,7 @@ InitDeviceModelDb::read_component_config(const std::vector<std::filesystem::path
                 continue;
             }
         } catch (const json::parse_error& e) {
-            EVLOG_error << "Error while parsing config file: " << path;
+            EVLOG_error << "Error while parsing config file: " << component_config_file.path;
             throw;
         }
     }
@@ -802,7 +851,7 @@ std::map<ComponentKey, std::vector<DeviceModelVariable>> InitDeviceModelDb::get_
             "v.ID, v.NAME, v.INSTANCE, "
             "vc.ID, vc.DATATYPE_ID, vc.MAX_LIMIT, vc.MIN_LIMIT, vc.SUPPORTS_MONITORING, vc.UNIT, vc.VALUES_LIST, "
             "va.ID, va.MUTABILITY_ID, va.PERSISTENT, va.CONSTANT, va.TYPE_ID, va.VALUE, va.VALUE_SOURCE,"
-            "v.SOURCE "
+            "v.SOURCE, c.CONFIG_HASH "
         "FROM "
             "COMPONENT c "
             "JOIN VARIABLE v ON v.COMPONENT_ID = c.ID "
@@ -833,6 +882,8 @@ std::map<ComponentKey, std::vector<DeviceModelVariable>> InitDeviceModelDb::get_
             component_key.connector_id = select_statement->column_int(4);
         }
 
+        component_key.config_hash = select_statement->column_text_nullable(23);
+
         bool variable_exists = false;
         DeviceModelVariable new_variable;
         new_variable.db_id = select_statement->column_int(5);
@@ -1029,6 +1080,78 @@ void InitDeviceModelDb::update_component_variables(
     }
 }
 
+void InitDeviceModelDb::update_component_config_hash(const ComponentKey& db_component,
+                                                     const std::optional<std::string>& config_hash) {
+    if (!db_component.db_id.has_value()) {
+        EVLOG_error << "Can not update config hash of component " << db_component.name << ": no id given";
+        return;
+    }
+
+    static const std::string update_hash_statement =
+        "UPDATE COMPONENT SET CONFIG_HASH = @config_hash WHERE ID = @component_id";
+
+    std::unique_ptr<common::SQLiteStatementInterface> update_statement;
+    try {
+        update_statement = this->database->new_statement(update_hash_statement);
+    } catch (const common::QueryExecutionException&) {
+        throw InitDeviceModelDbError("Could not create statement " + update_hash_statement);
+    }
+
+    update_statement->bind_int("@component_id", static_cast<int>(db_component.db_id.value()));
+    if (config_hash.has_value()) {
+        update_statement->bind_text("@config_hash", config_hash.value(), ocpp::common::SQLiteString::Transient);
+    } else {
+        update_statement->bind_null("@config_hash");
+    }
+
+    if (update_statement->step() != SQLITE_DONE) {
+        throw InitDeviceModelDbError("Could not update config hash of component " + db_component.name + ": " +
+                                     std::string(this->database->get_error_message()));
+    }
+}
+
+std::optional<std::string> InitDeviceModelDb::get_config_hash_from_db() {
+    static const std::string select_hash_statement = "SELECT HASH FROM COMPONENT_CONFIG_HASH WHERE ID = 0";
+
+    std::unique_ptr<common::SQLiteStatementInterface> select_statement;
+    try {
+        select_statement = this->database->new_statement(select_hash_statement);
+    } catch (const common::QueryExecutionException&) {
+        throw InitDeviceModelDbError("Could not create statement " + select_hash_statement);
+    }
+
+    const int status = select_statement->step();
+    if (status == SQLITE_ROW) {
+        return select_statement->column_text(0);
+    }
+
+    if (status != SQLITE_DONE) {
+        throw InitDeviceModelDbError("Could not get config hash from the database: " +
+                                     std::string(this->database->get_error_message()));
+    }
+
+    return std::nullopt;
+}
+
+void InitDeviceModelDb::set_config_hash_in_db(const std::string& config_hash) {
+    static const std::string insert_hash_statement =
+        "INSERT OR REPLACE INTO COMPONENT_CONFIG_HASH (ID, HASH) VALUES (0, @hash)";
+
+    std::unique_ptr<common::SQLiteStatementInterface> insert_statement;
+    try {
+        insert_statement = this->database->new_statement(insert_hash_statement);
+    } catch (const common::QueryExecutionException&) {
+        throw InitDeviceModelDbError("Could not create statement " + insert_hash_statement);
+    }
+
+    insert_statement->bind_text("@hash", config_hash, ocpp::common::SQLiteString::Transient);
+
+    if (insert_statement->step() != SQLITE_DONE) {
+        throw InitDeviceModelDbError("Could not store config hash in the database: " +
+                                     std::string(this->database->get_error_message()));
+    }
+}
+
 std::vector<DbVariableAttribute> InitDeviceModelDb::get_variable_attributes_from_db(const uint64_t& variable_id) {
     std::vector<DbVariableAttribute> attributes;
 
@@ -1574,4 +1697,45 @@ static std::string get_variable_name_for_logging(const DeviceModelVariable& vari
     return variable_name;
 }
 
+///
+/// \brief Get the hash of the content of a component config file.
+///
+/// The version of the database schema is part of the hash, so a migration of the database causes the component config
+/// to be written to the database again.
+///
+/// \param content  The content of the component config file.
+/// \return The hash.
+///
+static std::string get_component_config_file_hash(const std::string& content) {
+    return utils::sha256(std::to_string(MIGRATION_DEVICE_MODEL_FILE_VERSION_V2) + "\n" + content);
+}
+
+///
+/// \brief Get the hash of all component config files.
+///
+/// It changes when a file is added, removed, renamed or changed.
+///
+/// \param standardized_files   The standardized component config files.
+/// \param custom_files         The custom component config files.
+/// \return The hash.
+///
+static std::string get_component_config_hash(const std::vector<ComponentConfigFile>& standardized_files,
+                                             const std::vector<ComponentConfigFile>& custom_files) {
+    // The order of the files in a directory is not specified, so they are sorted by their path.
+    std::vector<std::pair<std::string, std::string>> file_hashes;
+    for (const auto& file : standardized_files) {
+        file_hashes.emplace_back(file.path.generic_string(), file.hash);
+    }
+    for (const auto& file : custom_files) {
+        file_hashes.emplace_back(file.path.generic_string(), file.hash);
+    }
+    std::sort(file_hashes.begin(), file_hashes.end());
+
+    std::string hashes;
+    for (const auto& [path, hash] : file_hashes) {
+        hashes += path + " " + hash + "\n";
+    }
+    return utils::sha256(hashes);
+}
+
 } // namespace ocpp::v2
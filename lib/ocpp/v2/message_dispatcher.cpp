@@ -47,6 +47,10 @@ std::future<ocpp::EnhancedMessage<MessageType>> MessageDispatcher::dispatch_call
     throw std::runtime_error("Missing handling for MessageTransmissionPriority");
 }
 
+bool MessageDispatcher::can_wait_for_response() const {
+    return !this->message_queue.is_event_loop_thread();
+}
+
 void MessageDispatcher::dispatch_call_result(const json& call_result) {
     this->message_queue.push_call_result(call_result);
 }
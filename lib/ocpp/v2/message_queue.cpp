@@ -3,10 +3,170 @@
 
 #include <ocpp/common/message_queue.hpp>
 
+#include <tuple>
+
 #include <everest/logging.hpp>
 
 namespace ocpp {
 
+namespace {
+/// \brief Keys of a TransactionEvent payload in which merged events may differ
+const std::set<std::string> MERGEABLE_TRANSACTION_EVENT_KEYS = {"seqNo", "timestamp", "meterValue", "offline"};
+
+/// \brief Only periodic meter values are merged, all other updates carry information of their own
+bool is_compactable_transaction_event(const json& payload) {
+    return payload.at("eventType") ==
+               v2::conversions::transaction_event_enum_to_string(v2::TransactionEventEnum::Updated) and
+           payload.at("triggerReason") ==
+               v2::conversions::trigger_reason_enum_to_string(v2::TriggerReasonEnum::MeterValuePeriodic) and
+           payload.contains("meterValue");
+}
+
+/// \brief Two events can be merged if they only differ in their sequence number, timestamp, meter values and offline
+/// flag
+bool can_merge_transaction_events(const json& lhs, const json& rhs) {
+    for (const auto& [lhs_payload, rhs_payload] : {std::make_pair(&lhs, &rhs), std::make_pair(&rhs, &lhs)}) {
+        for (const auto& [key, value] : lhs_payload->items()) {
+            if (MERGEABLE_TRANSACTION_EVENT_KEYS.count(key) == 0 and
+                (!rhs_payload->contains(key) or rhs_payload->at(key) != value)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// \brief How the samples of a measurand within one aggregation interval are combined
+enum class SampleAggregation {
+    Average, ///< instantaneous values like power, current and voltage
+    Sum,     ///< energy per sampling interval
+    Last,    ///< registers and all other measurands, averaging the readings of a register would break billing
+};
+
+SampleAggregation get_sample_aggregation(const v2::SampledValue& sampled_value) {
+    // a sampled value without measurand is an Energy.Active.Import.Register reading
+    if (!sampled_value.measurand.has_value()) {
+        return SampleAggregation::Last;
+    }
+    switch (sampled_value.measurand.value()) {
+    case v2::MeasurandEnum::Current_Export:
+    case v2::MeasurandEnum::Current_Import:
+    case v2::MeasurandEnum::Frequency:
+    case v2::MeasurandEnum::Power_Active_Export:
+    case v2::MeasurandEnum::Power_Active_Import:
+    case v2::MeasurandEnum::Power_Factor:
+    case v2::MeasurandEnum::Power_Reactive_Export:
+    case v2::MeasurandEnum::Power_Reactive_Import:
+    case v2::MeasurandEnum::Voltage:
+        return SampleAggregation::Average;
+    case v2::MeasurandEnum::Energy_Active_Export_Interval:
+    case v2::MeasurandEnum::Energy_Active_Import_Interval:
+    case v2::MeasurandEnum::Energy_Reactive_Export_Interval:
+    case v2::MeasurandEnum::Energy_Reactive_Import_Interval:
+        return SampleAggregation::Sum;
+    default:
+        return SampleAggregation::Last;
+    }
+}
+
+/// \brief Combines the meter values of one aggregation interval to a single meter value with the timestamp of the
+/// last one. Every measurand, phase and location that occurs in the interval is part of the result
+class MeterValueAggregate {
+private:
+    struct Samples {
+        v2::SampledValue last;
+        double sum;
+        int count;
+    };
+    using SampleKey =
+        std::tuple<std::optional<v2::MeasurandEnum>, std::optional<v2::PhaseEnum>, std::optional<v2::LocationEnum>>;
+
+    std::optional<v2::MeterValue> last_meter_value;
+    std::map<SampleKey, std::size_t> sample_indices;
+    // in order of first occurrence, so the aggregated meter value keeps the order of the samples
+    std::vector<Samples> samples;
+
+public:
+    bool empty() const {
+        return !this->last_meter_value.has_value();
+    }
+
+    void add(const v2::MeterValue& meter_value) {
+        for (const auto& sampled_value : meter_value.sampledValue) {
+            const SampleKey key{sampled_value.measurand, sampled_value.phase, sampled_value.location};
+            const auto [index, inserted] = this->sample_indices.try_emplace(key, this->samples.size());
+            if (inserted) {
+                this->samples.push_back({sampled_value, 0.0, 0});
+            }
+            auto& entry = this->samples.at(index->second);
+            entry.last = sampled_value;
+            entry.sum += sampled_value.value;
+            entry.count++;
+        }
+        this->last_meter_value = meter_value;
+    }
+
+    v2::MeterValue retrieve() {
+        auto meter_value = this->last_meter_value.value();
+        meter_value.sampledValue.clear();
+        for (const auto& entry : this->samples) {
+            auto sampled_value = entry.last;
+            switch (get_sample_aggregation(sampled_value)) {
+            case SampleAggregation::Average:
+                sampled_value.value = static_cast<float>(entry.sum / entry.count);
+                break;
+            case SampleAggregation::Sum:
+                sampled_value.value = static_cast<float>(entry.sum);
+                break;
+            case SampleAggregation::Last:
+                break;
+            }
+            meter_value.sampledValue.push_back(std::move(sampled_value));
+        }
+        this->last_meter_value.reset();
+        this->sample_indices.clear();
+        this->samples.clear();
+        return meter_value;
+    }
+};
+
+/// \brief Aggregates \p meter_values to one meter value per \p interval. Instantaneous measurands are averaged,
+/// interval energies are summed up and registers keep their last reading. Meter values with signed sampled values are
+/// kept as they are, since aggregating would invalidate the signature
+json aggregate_meter_values(const json& meter_values, const std::chrono::seconds interval) {
+    if (interval.count() <= 0) {
+        return meter_values;
+    }
+    json aggregated = json::array();
+    MeterValueAggregate aggregate;
+    std::optional<std::int64_t> current_interval;
+    for (const auto& meter_value_json : meter_values) {
+        const v2::MeterValue meter_value = meter_value_json;
+        const auto signed_meter_value = std::any_of(
+            meter_value.sampledValue.begin(), meter_value.sampledValue.end(),
+            [](const v2::SampledValue& sampled_value) { return sampled_value.signedMeterValue.has_value(); });
+        const auto meter_value_interval =
+            std::chrono::duration_cast<std::chrono::seconds>(meter_value.timestamp.to_time_point().time_since_epoch())
+                .count() /
+            interval.count();
+
+        if (!aggregate.empty() and (signed_meter_value or current_interval != meter_value_interval)) {
+            aggregated.push_back(aggregate.retrieve());
+        }
+        if (signed_meter_value) {
+            aggregated.push_back(meter_value_json);
+            continue;
+        }
+        aggregate.add(meter_value);
+        current_interval = meter_value_interval;
+    }
+    if (!aggregate.empty()) {
+        aggregated.push_back(aggregate.retrieve());
+    }
+    return aggregated;
+}
+} // namespace
+
 bool is_transaction_message(const ocpp::v2::MessageType message_type) {
     return (message_type == v2::MessageType::TransactionEvent) ||
            (message_type == v2::MessageType::SecurityEventNotification);
@@ -37,6 +197,141 @@ ControlMessage<v2::MessageType>::ControlMessage(const json& message, const bool
     stall_until_accepted(stall_until_accepted) {
 }
 
+template <> void MessageQueue<v2::MessageType>::compact_transaction_message_queue() {
+    // the message each transaction's following periodic update messages are merged into
+    std::map<std::string, std::shared_ptr<ControlMessage<v2::MessageType>>> merge_targets;
+    // meter values per merge target that still have to be aggregated, aggregated meter values of compacted merge
+    // targets are not part of it, since averaging them again would weight their samples wrong
+    std::map<std::shared_ptr<ControlMessage<v2::MessageType>>, json> merged_meter_values;
+    // number of merged messages per transaction so far; later messages of the transaction are renumbered by it
+    std::map<std::string, int32_t> merged_counts;
+    std::set<std::string> ended_transactions;
+    std::set<std::shared_ptr<ControlMessage<v2::MessageType>>> changed_messages;
+    std::deque<std::shared_ptr<ControlMessage<v2::MessageType>>> compacted_queue;
+
+    for (auto& message : this->transaction_message_queue) {
+        if (message->messageType != v2::MessageType::TransactionEvent) {
+            compacted_queue.push_back(std::move(message));
+            continue;
+        }
+        auto& payload = message->message.at(CALL_PAYLOAD);
+        const std::string transaction_id = payload.at("transactionInfo").at("transactionId");
+
+        // a message that has been sent before, e.g. one that is retried after a timeout, might already be known to the
+        // CSMS and is neither merged nor merged into
+        if (is_compactable_transaction_event(payload) and message->message_attempts == 0) {
+            const auto target = merge_targets.find(transaction_id);
+            if (target != merge_targets.end() and
+                can_merge_transaction_events(target->second->message.at(CALL_PAYLOAD), payload)) {
+                // the merge target keeps its message id and sequence number
+                auto& target_payload = target->second->message.at(CALL_PAYLOAD);
+                auto& meter_values = merged_meter_values[target->second];
+                if (meter_values.is_null()) {
+                    meter_values = json::array();
+                    if (!target->second->compacted) {
+                        meter_values = std::move(target_payload.at("meterValue"));
+                        target_payload["meterValue"] = json::array();
+                    }
+                }
+                meter_values.insert(meter_values.end(), payload.at("meterValue").begin(),
+                                    payload.at("meterValue").end());
+                target_payload["timestamp"] = payload.at("timestamp");
+                if (payload.value("offline", false)) {
+                    target_payload["offline"] = true;
+                }
+                changed_messages.insert(target->second);
+
+                EVLOG_debug << "Merge transactional message " << message->initial_unique_id << " into "
+                            << target->second->initial_unique_id;
+                try {
+                    this->database_handler->remove_message_queue_message(message->initial_unique_id);
+                } catch (const QueryExecutionException& e) {
+                    EVLOG_warning << "Could not delete message from transaction queue: " << e.what();
+                }
+                this->account_dequeued_message(message);
+                merged_counts[transaction_id]++;
+                continue;
+            }
+            merge_targets[transaction_id] = message;
+        } else {
+            merge_targets.erase(transaction_id);
+        }
+
+        const auto merged_count = merged_counts.find(transaction_id);
+        if (merged_count != merged_counts.end()) {
+            payload["seqNo"] = payload.at("seqNo").get<int32_t>() - merged_count->second;
+            changed_messages.insert(message);
+        }
+        if (payload.at("eventType") ==
+            v2::conversions::transaction_event_enum_to_string(v2::TransactionEventEnum::Ended)) {
+            ended_transactions.insert(transaction_id);
+        }
+        compacted_queue.push_back(std::move(message));
+    }
+    std::swap(this->transaction_message_queue, compacted_queue);
+
+    const auto interval = std::chrono::seconds(this->config.transaction_message_compaction_interval_seconds);
+    for (const auto& [message, meter_values] : merged_meter_values) {
+        auto& target_meter_values = message->message.at(CALL_PAYLOAD).at("meterValue");
+        const auto aggregated = aggregate_meter_values(meter_values, interval);
+        target_meter_values.insert(target_meter_values.end(), aggregated.begin(), aggregated.end());
+        message->compacted = true;
+    }
+    for (const auto& message : changed_messages) {
+        this->update_queued_transaction_message(message);
+    }
+
+    int32_t total_merged_count = 0;
+    for (const auto& [transaction_id, merged_count] : merged_counts) {
+        total_merged_count += merged_count;
+        // messages of a transaction that has not ended yet will be queued later and have to be renumbered as well
+        if (ended_transactions.count(transaction_id) == 0) {
+            auto& offset = this->transaction_seq_no_offsets[transaction_id];
+            offset += merged_count;
+            try {
+                this->database_handler->insert_or_update_transaction_seq_no_offset(transaction_id, offset);
+            } catch (const QueryExecutionException& e) {
+                EVLOG_warning << "Could not store sequence number offset of transaction: " << e.what();
+            }
+        }
+    }
+    if (total_merged_count > 0) {
+        EVLOG_info << "Merged " << total_merged_count << " transaction update messages into "
+                   << changed_messages.size() << " changed messages";
+    }
+}
+
+template <>
+void MessageQueue<v2::MessageType>::renumber_transaction_message(ControlMessage<v2::MessageType>& message) {
+    if (message.messageType != v2::MessageType::TransactionEvent or this->transaction_seq_no_offsets.empty()) {
+        return;
+    }
+    auto& payload = message.message.at(CALL_PAYLOAD);
+    const std::string transaction_id = payload.at("transactionInfo").at("transactionId");
+    const auto offset = this->transaction_seq_no_offsets.find(transaction_id);
+    if (offset == this->transaction_seq_no_offsets.end()) {
+        return;
+    }
+    payload["seqNo"] = payload.at("seqNo").get<int32_t>() - offset->second;
+    if (payload.at("eventType") ==
+        v2::conversions::transaction_event_enum_to_string(v2::TransactionEventEnum::Ended)) {
+        this->transaction_seq_no_offsets.erase(offset);
+        try {
+            this->database_handler->remove_transaction_seq_no_offset(transaction_id);
+        } catch (const QueryExecutionException& e) {
+            EVLOG_warning << "Could not delete sequence number offset of transaction: " << e.what();
+        }
+    }
+}
+
+template <> void MessageQueue<v2::MessageType>::restore_transaction_seq_no_offsets() {
+    try {
+        this->transaction_seq_no_offsets = this->database_handler->get_transaction_seq_no_offsets();
+    } catch (const QueryExecutionException& e) {
+        EVLOG_warning << "Could not get sequence number offsets of transactions: " << e.what();
+    }
+}
+
 template <> v2::MessageType MessageQueue<v2::MessageType>::string_to_messagetype(const std::string& s) {
     return v2::conversions::string_to_messagetype(s);
 }
@@ -0,0 +1,325 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <atomic>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocpp/common/database/database_connection.hpp>
+
+namespace ocpp::common {
+
+namespace {
+
+constexpr auto SELECT_VALUE = "SELECT VALUE FROM TEST WHERE ID = @id";
+
+class DatabaseConnectionTest : public ::testing::Test {
+protected:
+    std::unique_ptr<DatabaseConnection> create_database(std::size_t statement_cache_size) {
+        auto database = std::make_unique<DatabaseConnection>(":memory:", statement_cache_size);
+        EXPECT_TRUE(database->open_connection());
+        EXPECT_TRUE(database->execute_statement("CREATE TABLE TEST (ID INT PRIMARY KEY, VALUE TEXT)"));
+        for (int i = 0; i < 100; i++) {
+            EXPECT_TRUE(database->execute_statement("INSERT INTO TEST VALUES (" + std::to_string(i) + ", 'value" +
+                                                    std::to_string(i) + "')"));
+        }
+        return database;
+    }
+};
+
+class DatabaseTuningProfileTest : public ::testing::Test {
+protected:
+    const std::filesystem::path database_directory =
+        std::filesystem::temp_directory_path() / "libocpp_test_database_tuning_profile";
+
+    void SetUp() override {
+        std::filesystem::remove_all(this->database_directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(this->database_directory);
+    }
+
+    std::unique_ptr<DatabaseConnection> create_database(const std::string& profile_name) {
+        auto database = std::make_unique<DatabaseConnection>(this->database_directory / (profile_name + ".db"),
+                                                             DEFAULT_STATEMENT_CACHE_SIZE,
+                                                             get_database_tuning_profile(profile_name));
+        EXPECT_TRUE(database->open_connection());
+        EXPECT_TRUE(database->execute_statement("CREATE TABLE TEST (ID INT PRIMARY KEY, VALUE TEXT)"));
+        return database;
+    }
+
+    std::string query_text(DatabaseConnection& database, const std::string& sql) {
+        auto stmt = database.new_statement(sql);
+        EXPECT_EQ(stmt->step(), SQLITE_ROW);
+        return stmt->column_text(0);
+    }
+};
+
+class DatabaseConnectionPoolTest : public ::testing::Test {
+protected:
+    const std::filesystem::path database_directory =
+        std::filesystem::temp_directory_path() / "libocpp_test_database_connection_pool";
+
+    void SetUp() override {
+        std::filesystem::remove_all(this->database_directory);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(this->database_directory);
+    }
+
+    std::unique_ptr<DatabaseConnection> create_database(const std::filesystem::path& path,
+                                                        std::size_t read_connections) {
+        DatabaseTuningProfile profile;
+        profile.read_connections = read_connections;
+        auto database = std::make_unique<DatabaseConnection>(path, DEFAULT_STATEMENT_CACHE_SIZE, profile);
+        EXPECT_TRUE(database->open_connection());
+        EXPECT_TRUE(database->execute_statement("CREATE TABLE TEST (ID INT PRIMARY KEY, VALUE TEXT)"));
+        EXPECT_TRUE(database->execute_statement("INSERT INTO TEST VALUES (1, 'value1')"));
+        return database;
+    }
+
+    std::unique_ptr<DatabaseConnection> create_database(std::size_t read_connections) {
+        return this->create_database(
+            this->database_directory / ("pool" + std::to_string(read_connections) + ".db"), read_connections);
+    }
+
+    /// \returns true if the row with \p id exists, queried from another thread
+    bool exists_in_other_thread(DatabaseConnection& database, int id) {
+        bool exists = false;
+        std::thread([&database, &exists, id]() {
+            auto stmt = database.new_statement(SELECT_VALUE);
+            stmt->bind_int("@id", id);
+            exists = stmt->step() == SQLITE_ROW;
+        }).join();
+        return exists;
+    }
+
+    std::string query_journal_mode(DatabaseConnection& database) {
+        auto stmt = database.new_statement("PRAGMA journal_mode");
+        EXPECT_EQ(stmt->step(), SQLITE_ROW);
+        return stmt->column_text(0);
+    }
+
+    bool exists(DatabaseConnection& database, int id) {
+        auto stmt = database.new_statement(SELECT_VALUE);
+        stmt->bind_int("@id", id);
+        return stmt->step() == SQLITE_ROW;
+    }
+};
+
+} // namespace
+
+TEST_F(DatabaseConnectionTest, test_reused_statement_is_reset_and_unbound) {
+    auto database = this->create_database(DEFAULT_STATEMENT_CACHE_SIZE);
+
+    {
+        auto stmt = database->new_statement(SELECT_VALUE);
+        stmt->bind_int("@id", 1);
+        ASSERT_EQ(stmt->step(), SQLITE_ROW);
+        EXPECT_EQ(stmt->column_text(0), "value1");
+    }
+
+    // The statement is not finished and still bound to 1 when it is returned to the cache
+    auto stmt = database->new_statement(SELECT_VALUE);
+    EXPECT_EQ(stmt->step(), SQLITE_DONE);
+
+    stmt->reset();
+    stmt->bind_int("@id", 2);
+    ASSERT_EQ(stmt->step(), SQLITE_ROW);
+    EXPECT_EQ(stmt->column_text(0), "value2");
+}
+
+TEST_F(DatabaseConnectionTest, test_same_sql_can_be_used_at_the_same_time) {
+    auto database = this->create_database(DEFAULT_STATEMENT_CACHE_SIZE);
+
+    auto first = database->new_statement(SELECT_VALUE);
+    auto second = database->new_statement(SELECT_VALUE);
+    first->bind_int("@id", 3);
+    second->bind_int("@id", 4);
+
+    ASSERT_EQ(first->step(), SQLITE_ROW);
+    ASSERT_EQ(second->step(), SQLITE_ROW);
+    EXPECT_EQ(first->column_text(0), "value3");
+    EXPECT_EQ(second->column_text(0), "value4");
+}
+
+TEST_F(DatabaseConnectionTest, test_more_statements_than_cache_size) {
+    auto database = this->create_database(2);
+
+    // Statements are evicted and prepared again
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 10; i++) {
+            auto stmt = database->new_statement("SELECT VALUE FROM TEST WHERE ID = " + std::to_string(i));
+            ASSERT_EQ(stmt->step(), SQLITE_ROW);
+            EXPECT_EQ(stmt->column_text(0), "value" + std::to_string(i));
+        }
+    }
+}
+
+TEST_F(DatabaseConnectionTest, test_statement_can_outlive_closed_connection) {
+    auto database = this->create_database(DEFAULT_STATEMENT_CACHE_SIZE);
+
+    auto stmt = database->new_statement(SELECT_VALUE);
+    EXPECT_TRUE(database->close_connection());
+    stmt.reset();
+
+    EXPECT_TRUE(database->open_connection());
+    EXPECT_TRUE(database->execute_statement("CREATE TABLE TEST (ID INT PRIMARY KEY, VALUE TEXT)"));
+    EXPECT_EQ(database->new_statement(SELECT_VALUE)->step(), SQLITE_DONE);
+}
+
+TEST_F(DatabaseTuningProfileTest, test_get_database_tuning_profile) {
+    const auto default_profile = get_database_tuning_profile("Default");
+    EXPECT_FALSE(default_profile.journal_mode.has_value());
+    EXPECT_FALSE(default_profile.synchronous.has_value());
+    EXPECT_FALSE(default_profile.cache_size_kib.has_value());
+    EXPECT_FALSE(default_profile.mmap_size.has_value());
+
+    const auto wal_profile = get_database_tuning_profile("WAL");
+    EXPECT_EQ(wal_profile.journal_mode, DatabaseJournalMode::WAL);
+    EXPECT_EQ(wal_profile.synchronous, DatabaseSynchronousMode::Normal);
+    EXPECT_FALSE(wal_profile.cache_size_kib.has_value());
+
+    const auto flash_profile = get_database_tuning_profile("Flash");
+    EXPECT_EQ(flash_profile.journal_mode, DatabaseJournalMode::WAL);
+    EXPECT_EQ(flash_profile.cache_size_kib, 8 * 1024);
+    EXPECT_EQ(flash_profile.mmap_size, 64 * 1024 * 1024);
+
+    EXPECT_THROW(get_database_tuning_profile("Fast"), StringToEnumException);
+}
+
+TEST_F(DatabaseTuningProfileTest, test_profile_is_applied_when_opened) {
+    auto database = this->create_database("Flash");
+
+    EXPECT_EQ(this->query_text(*database, "PRAGMA journal_mode"), "wal");
+    // NORMAL
+    EXPECT_EQ(this->query_text(*database, "PRAGMA synchronous"), "1");
+    EXPECT_EQ(this->query_text(*database, "PRAGMA cache_size"), "-8192");
+
+    // Settings that are not stored in the database file are applied again when it is reopened
+    EXPECT_TRUE(database->close_connection());
+    EXPECT_TRUE(database->open_connection());
+    EXPECT_EQ(this->query_text(*database, "PRAGMA synchronous"), "1");
+    EXPECT_EQ(this->query_text(*database, "PRAGMA cache_size"), "-8192");
+}
+
+TEST_F(DatabaseTuningProfileTest, test_profile_set_before_opening) {
+    DatabaseConnection database(this->database_directory / "set.db");
+    database.set_tuning_profile(get_database_tuning_profile("WAL"));
+    ASSERT_TRUE(database.open_connection());
+
+    EXPECT_EQ(this->query_text(database, "PRAGMA journal_mode"), "wal");
+    EXPECT_EQ(this->query_text(database, "PRAGMA synchronous"), "1");
+}
+
+TEST_F(DatabaseTuningProfileTest, test_wal_is_not_available_in_memory) {
+    DatabaseConnection database(":memory:", DEFAULT_STATEMENT_CACHE_SIZE, get_database_tuning_profile("Flash"));
+    ASSERT_TRUE(database.open_connection());
+
+    // The connection is usable with the remaining settings
+    EXPECT_EQ(this->query_text(database, "PRAGMA journal_mode"), "memory");
+    EXPECT_EQ(this->query_text(database, "PRAGMA cache_size"), "-8192");
+}
+
+TEST_F(DatabaseConnectionPoolTest, test_queries_see_committed_writes) {
+    auto database = this->create_database(2);
+
+    EXPECT_EQ(this->query_journal_mode(*database), "wal");
+    EXPECT_TRUE(database->execute_statement("INSERT INTO TEST VALUES (2, 'value2')"));
+    EXPECT_TRUE(this->exists(*database, 2));
+    EXPECT_TRUE(this->exists_in_other_thread(*database, 2));
+
+    auto transaction = database->begin_transaction();
+    EXPECT_TRUE(database->execute_statement("INSERT INTO TEST VALUES (3, 'value3')"));
+    transaction->commit();
+    EXPECT_TRUE(this->exists_in_other_thread(*database, 3));
+}
+
+TEST_F(DatabaseConnectionPoolTest, test_transaction_is_isolated_from_other_threads) {
+    auto database = this->create_database(2);
+
+    auto transaction = database->begin_transaction();
+    EXPECT_TRUE(database->execute_statement("INSERT INTO TEST VALUES (2, 'value2')"));
+
+    // The thread of the transaction sees its changes, other threads are not blocked and see the last commit
+    EXPECT_TRUE(this->exists(*database, 2));
+    EXPECT_FALSE(this->exists_in_other_thread(*database, 2));
+    EXPECT_TRUE(this->exists_in_other_thread(*database, 1));
+
+    transaction->rollback();
+    EXPECT_FALSE(this->exists(*database, 2));
+}
+
+TEST_F(DatabaseConnectionPoolTest, test_writing_statement_with_query_keyword) {
+    auto database = this->create_database(1);
+
+    auto stmt = database->new_statement(
+        "WITH NEW(ID, VALUE) AS (SELECT 2, 'value2') INSERT INTO TEST SELECT ID, VALUE FROM NEW");
+    EXPECT_EQ(stmt->step(), SQLITE_DONE);
+    EXPECT_TRUE(this->exists_in_other_thread(*database, 2));
+}
+
+TEST_F(DatabaseConnectionPoolTest, test_in_memory_database_uses_single_connection) {
+    auto database = this->create_database(":memory:", 2);
+
+    EXPECT_TRUE(database->execute_statement("INSERT INTO TEST VALUES (2, 'value2')"));
+    EXPECT_TRUE(this->exists(*database, 2));
+    EXPECT_TRUE(this->exists_in_other_thread(*database, 2));
+}
+
+TEST_F(DatabaseConnectionPoolTest, test_concurrent_reads_and_writes) {
+    constexpr int readers = 4;
+    constexpr int rows = 300;
+    auto database = this->create_database(2);
+
+    std::atomic_bool writing = true;
+    std::atomic_int errors = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readers; i++) {
+        threads.emplace_back([&]() {
+            while (writing) {
+                auto stmt = database->new_statement("SELECT COUNT(*) FROM TEST");
+                if (stmt->step() != SQLITE_ROW or stmt->column_int(0) < 1) {
+                    errors++;
+                }
+                stmt = database->new_statement(SELECT_VALUE);
+                stmt->bind_int("@id", 1);
+                if (stmt->step() != SQLITE_ROW) {
+                    errors++;
+                }
+            }
+        });
+    }
+
+    for (int i = 2; i < rows; i++) {
+        auto transaction = database->begin_transaction();
+        auto stmt = database->new_statement("INSERT INTO TEST VALUES (@id, @value)");
+        stmt->bind_int("@id", i);
+        stmt->bind_text("@value", "value" + std::to_string(i), SQLiteString::Transient);
+        if (stmt->step() != SQLITE_DONE) {
+            errors++;
+        }
+        // The thread of the transaction has to read from the writing connection
+        if (!this->exists(*database, i)) {
+            errors++;
+        }
+        transaction->commit();
+    }
+    writing = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(errors, 0);
+    auto stmt = database->new_statement("SELECT COUNT(*) FROM TEST");
+    ASSERT_EQ(stmt->step(), SQLITE_ROW);
+    EXPECT_EQ(stmt->column_int(0), rows - 1);
+}
+
+} // namespace ocpp::common
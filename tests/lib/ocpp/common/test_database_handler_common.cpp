@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <chrono>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include <ocpp/common/database/database_handler_common.hpp>
+
+namespace ocpp::common {
+
+using namespace std::chrono_literals;
+
+class DatabaseHandlerCommonTestable : public DatabaseHandlerCommon {
+public:
+    using DatabaseHandlerCommon::DatabaseHandlerCommon;
+
+    ~DatabaseHandlerCommonTestable() override {
+        this->close();
+    }
+
+protected:
+    void init_sql() override {
+    }
+};
+
+class DatabaseHandlerCommonTest : public ::testing::Test {
+protected:
+    std::unique_ptr<DatabaseHandlerCommonTestable> db_handler;
+
+    void SetUp() override {
+        auto database_connection = std::make_unique<DatabaseConnection>("file::memory:?cache=shared");
+        database_connection->open_connection(); // Open connection so memory stays shared
+        this->db_handler = std::make_unique<DatabaseHandlerCommonTestable>(
+            std::move(database_connection), std::filesystem::path(MIGRATION_FILES_LOCATION_V16),
+            MIGRATION_FILE_VERSION_V16);
+        this->db_handler->open_connection();
+    }
+
+    void TearDown() override {
+        this->db_handler->clear_message_queue(QueueType::Normal);
+        this->db_handler->clear_message_queue(QueueType::Transaction);
+        this->db_handler->clear_tls_sessions();
+    }
+
+    static DBTransactionMessage make_message(int id) {
+        const auto unique_id = "message_" + std::to_string(id);
+        return {json::array({2, unique_id, "MeterValues", json::object()}), "MeterValues", 0, DateTime(), unique_id};
+    }
+
+    /// \brief Inserts \p count messages and acknowledges all but the last \p unacknowledged ones. Returns the number of
+    /// write transactions this took
+    std::size_t run_queue_workload(int count, int unacknowledged) {
+        const auto transactions_before = this->db_handler->get_message_queue_write_transaction_count();
+        for (int i = 0; i < count; i++) {
+            this->db_handler->insert_message_queue_message(make_message(i), QueueType::Normal);
+        }
+        for (int i = 0; i < count - unacknowledged; i++) {
+            this->db_handler->remove_message_queue_message(make_message(i).unique_id, QueueType::Normal);
+        }
+        this->db_handler->flush_message_queue();
+
+        return this->db_handler->get_message_queue_write_transaction_count() - transactions_before;
+    }
+
+    static DBTransactionMessage make_meter_values_message(int id) {
+        auto message = make_message(id);
+        json sampled_values = json::array();
+        for (const auto measurand : {"Energy.Active.Import.Register", "Power.Active.Import", "Current.Import"}) {
+            sampled_values.push_back({{"value", std::to_string(id * 1.5)},
+                                      {"context", "Sample.Periodic"},
+                                      {"measurand", measurand},
+                                      {"unit", "Wh"}});
+        }
+        message.json_message[3] = {
+            {"connectorId", 1},
+            {"transactionId", 42},
+            {"meterValue", json::array({{{"timestamp", "2024-01-01T00:00:00.000Z"}, {"sampledValue", sampled_values}}})}};
+        return message;
+    }
+
+    /// \brief Persists \p count messages in \p format in one batch and checks that all of them are restored
+    void run_restore(int count, MessageQueuePersistenceFormat format) {
+        this->db_handler->set_message_queue_persistence_format(format);
+        this->db_handler->set_message_queue_write_behind_config({1h, 1000000});
+        for (int i = 0; i < count; i++) {
+            this->db_handler->insert_message_queue_message(make_meter_values_message(i), QueueType::Transaction);
+        }
+        this->db_handler->flush_message_queue();
+
+        const auto messages = this->db_handler->get_message_queue_messages(QueueType::Transaction);
+
+        ASSERT_EQ(messages.size(), static_cast<std::size_t>(count));
+        for (int i = 0; i < count; i++) {
+            EXPECT_EQ(messages.at(i).json_message, make_meter_values_message(i).json_message);
+        }
+    }
+};
+
+TEST_F(DatabaseHandlerCommonTest, test_immediate_writes_by_default) {
+    this->db_handler->insert_message_queue_message(make_message(0), QueueType::Normal);
+    this->db_handler->insert_message_queue_message(make_message(1), QueueType::Transaction);
+    EXPECT_EQ(this->db_handler->get_message_queue_write_transaction_count(), 2);
+
+    this->db_handler->remove_message_queue_message(make_message(0).unique_id, QueueType::Normal);
+    EXPECT_EQ(this->db_handler->get_message_queue_write_transaction_count(), 3);
+
+    EXPECT_TRUE(this->db_handler->get_message_queue_messages(QueueType::Normal).empty());
+    EXPECT_EQ(this->db_handler->get_message_queue_messages(QueueType::Transaction).size(), 1);
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_write_behind_writes_batch_in_one_transaction) {
+    this->db_handler->set_message_queue_write_behind_config({1h, 1000});
+
+    this->db_handler->insert_message_queue_message(make_message(0), QueueType::Normal);
+    this->db_handler->insert_message_queue_message(make_message(1), QueueType::Normal);
+    this->db_handler->insert_message_queue_message(make_message(2), QueueType::Transaction);
+    EXPECT_EQ(this->db_handler->get_message_queue_write_transaction_count(), 0);
+
+    // reading the queue writes the buffered operations first
+    const auto messages = this->db_handler->get_message_queue_messages(QueueType::Normal);
+    EXPECT_EQ(messages.size(), 2);
+    EXPECT_EQ(this->db_handler->get_message_queue_messages(QueueType::Transaction).size(), 1);
+    EXPECT_EQ(this->db_handler->get_message_queue_write_transaction_count(), 1);
+
+    this->db_handler->remove_message_queue_message(make_message(0).unique_id, QueueType::Normal);
+    this->db_handler->remove_message_queue_message(make_message(2).unique_id, QueueType::Transaction);
+    this->db_handler->flush_message_queue();
+    EXPECT_EQ(this->db_handler->get_message_queue_write_transaction_count(), 2);
+    EXPECT_EQ(this->db_handler->get_message_queue_messages(QueueType::Normal).size(), 1);
+    EXPECT_TRUE(this->db_handler->get_message_queue_messages(QueueType::Transaction).empty());
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_write_behind_drops_acknowledged_inserts) {
+    this->db_handler->set_message_queue_write_behind_config({1h, 1000});
+
+    this->db_handler->insert_message_queue_message(make_message(0), QueueType::Normal);
+    this->db_handler->remove_message_queue_message(make_message(0).unique_id, QueueType::Normal);
+    this->db_handler->flush_message_queue();
+
+    EXPECT_EQ(this->db_handler->get_message_queue_write_transaction_count(), 0);
+    EXPECT_TRUE(this->db_handler->get_message_queue_messages(QueueType::Normal).empty());
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_write_behind_flushes_in_background) {
+    this->db_handler->set_message_queue_write_behind_config({1h, 2});
+
+    this->db_handler->insert_message_queue_message(make_message(0), QueueType::Normal);
+    this->db_handler->insert_message_queue_message(make_message(1), QueueType::Normal);
+
+    // reaching max_pending_operations wakes the writer before the flush interval elapsed
+    for (int i = 0; i < 100 and this->db_handler->get_message_queue_write_transaction_count() == 0; i++) {
+        std::this_thread::sleep_for(10ms);
+    }
+    EXPECT_EQ(this->db_handler->get_message_queue_write_transaction_count(), 1);
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_write_behind_failing_operation_does_not_discard_batch) {
+    this->db_handler->insert_message_queue_message(make_message(0), QueueType::Normal);
+    this->db_handler->set_message_queue_write_behind_config({1h, 1000});
+
+    // inserting the same unique id again violates the primary key
+    this->db_handler->insert_message_queue_message(make_message(0), QueueType::Normal);
+    this->db_handler->insert_message_queue_message(make_message(1), QueueType::Normal);
+    EXPECT_FALSE(this->db_handler->flush_message_queue());
+
+    EXPECT_EQ(this->db_handler->get_failed_message_queue_operations(), std::vector<std::string>{"message_0"});
+    EXPECT_EQ(this->db_handler->get_message_queue_messages(QueueType::Normal).size(), 2);
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_write_behind_failure_of_background_flush_is_reported) {
+    this->db_handler->insert_message_queue_message(make_message(0), QueueType::Normal);
+    this->db_handler->set_message_queue_write_behind_config({1h, 2});
+
+    // the duplicate insert fails in the background flush triggered by max_pending_operations
+    this->db_handler->insert_message_queue_message(make_message(0), QueueType::Normal);
+    this->db_handler->insert_message_queue_message(make_message(1), QueueType::Normal);
+    for (int i = 0; i < 100 and this->db_handler->get_message_queue_write_transaction_count() < 2; i++) {
+        std::this_thread::sleep_for(10ms);
+    }
+    ASSERT_EQ(this->db_handler->get_message_queue_write_transaction_count(), 2);
+
+    // later operations are not affected by the failure
+    EXPECT_NO_THROW(this->db_handler->insert_message_queue_message(make_message(2), QueueType::Normal));
+    EXPECT_TRUE(this->db_handler->flush_message_queue());
+    EXPECT_EQ(this->db_handler->get_message_queue_messages(QueueType::Normal).size(), 3);
+
+    // the failure is reported once
+    EXPECT_EQ(this->db_handler->get_failed_message_queue_operations(), std::vector<std::string>{"message_0"});
+    EXPECT_TRUE(this->db_handler->get_failed_message_queue_operations().empty());
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_tls_session_is_written_by_worker) {
+    const std::vector<std::uint8_t> session{0x30, 0x82, 0x01};
+    this->db_handler->insert_or_update_tls_session_async("csms.example.com:443", session);
+
+    std::vector<std::pair<std::string, std::vector<std::uint8_t>>> sessions;
+    for (int i = 0; i < 100 and sessions.empty(); i++) {
+        std::this_thread::sleep_for(10ms);
+        sessions = this->db_handler->get_tls_sessions();
+    }
+    ASSERT_EQ(sessions.size(), 1);
+    EXPECT_EQ(sessions.at(0).first, "csms.example.com:443");
+    EXPECT_EQ(sessions.at(0).second, session);
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_write_transactions_immediate_1000) {
+    EXPECT_EQ(run_queue_workload(1000, 10), 1990);
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_write_transactions_write_behind_1000) {
+    this->db_handler->set_message_queue_write_behind_config({1h, 100000});
+    EXPECT_EQ(run_queue_workload(1000, 10), 1);
+    EXPECT_EQ(this->db_handler->get_message_queue_messages(QueueType::Normal).size(), 10);
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_binary_formats_round_trip) {
+    this->db_handler->set_message_queue_persistence_format(MessageQueuePersistenceFormat::Cbor);
+    this->db_handler->insert_message_queue_message(make_meter_values_message(0), QueueType::Normal);
+    this->db_handler->set_message_queue_persistence_format(MessageQueuePersistenceFormat::MessagePack);
+    this->db_handler->insert_message_queue_message(make_meter_values_message(1), QueueType::Normal);
+    this->db_handler->set_message_queue_persistence_format(MessageQueuePersistenceFormat::Json);
+    this->db_handler->insert_message_queue_message(make_meter_values_message(2), QueueType::Normal);
+
+    // messages written in different formats can be read back side by side
+    const auto messages = this->db_handler->get_message_queue_messages(QueueType::Normal);
+    ASSERT_EQ(messages.size(), 3);
+    for (int i = 0; i < 3; i++) {
+        const auto expected = make_meter_values_message(i);
+        EXPECT_EQ(messages.at(i).unique_id, expected.unique_id);
+        EXPECT_EQ(messages.at(i).message_type, expected.message_type);
+        EXPECT_EQ(messages.at(i).json_message, expected.json_message);
+    }
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_restore_json) {
+    run_restore(500, MessageQueuePersistenceFormat::Json);
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_restore_cbor) {
+    run_restore(500, MessageQueuePersistenceFormat::Cbor);
+}
+
+TEST_F(DatabaseHandlerCommonTest, test_restore_msgpack) {
+    run_restore(500, MessageQueuePersistenceFormat::MessagePack);
+}
+
+} // namespace ocpp::common
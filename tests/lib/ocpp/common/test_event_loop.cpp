@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/executor_work_guard.hpp>
+
+#include <ocpp/common/event_loop.hpp>
+
+namespace ocpp {
+
+class EventLoopExecutorTest : public ::testing::Test {
+protected:
+    boost::asio::io_context io_context;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work{io_context.get_executor()};
+    std::thread loop_thread;
+
+    void SetUp() override {
+        this->loop_thread = std::thread([this]() { this->io_context.run(); });
+    }
+
+    void TearDown() override {
+        this->work.reset();
+        this->loop_thread.join();
+    }
+
+    /// \brief Waits until all handlers that have been posted so far have run
+    void drain() {
+        std::promise<void> drained;
+        boost::asio::post(this->io_context, [&drained]() { drained.set_value(); });
+        drained.get_future().wait();
+    }
+};
+
+TEST_F(EventLoopExecutorTest, test_handlers_run_in_order_on_the_loop) {
+    EventLoopExecutor executor(this->io_context);
+    std::vector<int> order;
+    for (int i = 0; i < 100; i++) {
+        EXPECT_TRUE(executor.post([&order, &executor, i]() {
+            EXPECT_TRUE(executor.running_in_this_thread());
+            order.push_back(i);
+        }));
+    }
+    this->drain();
+
+    ASSERT_EQ(order.size(), 100);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(order.at(i), i);
+    }
+    EXPECT_FALSE(executor.running_in_this_thread());
+}
+
+TEST_F(EventLoopExecutorTest, test_no_handler_runs_after_shutdown) {
+    EventLoopExecutor executor(this->io_context);
+    std::promise<void> blocked;
+    std::promise<void> release;
+    auto release_future = release.get_future().share();
+    std::atomic_int handled{0};
+
+    // block the loop, so the handlers below are pending when the executor is shut down
+    boost::asio::post(this->io_context, [&blocked, release_future]() {
+        blocked.set_value();
+        release_future.wait();
+    });
+    blocked.get_future().wait();
+    for (int i = 0; i < 10; i++) {
+        executor.post([&handled]() { handled++; });
+    }
+
+    auto shutdown = std::async(std::launch::async, [&executor]() { executor.shutdown(); });
+    // the executor does not accept handlers anymore as soon as the shut down starts
+    while (executor.post([&handled]() { handled++; })) {
+        std::this_thread::yield();
+    }
+    release.set_value();
+    shutdown.wait();
+    this->drain();
+
+    EXPECT_EQ(handled, 0);
+}
+
+TEST_F(EventLoopExecutorTest, test_shutdown_waits_for_running_handler) {
+    EventLoopExecutor executor(this->io_context);
+    std::promise<void> started;
+    std::atomic_bool finished{false};
+
+    executor.post([&started, &finished]() {
+        started.set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+    started.get_future().wait();
+    executor.shutdown();
+
+    EXPECT_TRUE(finished);
+}
+
+TEST_F(EventLoopExecutorTest, test_shutdown_from_handler) {
+    auto executor = std::make_unique<EventLoopExecutor>(this->io_context);
+    std::promise<void> release;
+    std::atomic_int handled{0};
+
+    // block the loop until both handlers are posted
+    boost::asio::post(this->io_context, [release_future = release.get_future()]() { release_future.wait(); });
+    executor->post([&executor, &handled]() {
+        handled++;
+        // a component may be destroyed by one of its own handlers
+        executor.reset();
+    });
+    executor->post([&handled]() { handled++; });
+    release.set_value();
+    this->drain();
+
+    EXPECT_EQ(executor, nullptr);
+    EXPECT_EQ(handled, 1);
+}
+
+} // namespace ocpp
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <clocale>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ocpp/common/incremental_json_parser.hpp>
+
+namespace ocpp {
+
+namespace {
+
+/// \brief Feeds \p message to \p parser in fragments of \p fragment_size bytes
+json parse_in_fragments(IncrementalJsonParser& parser, std::string_view message, std::size_t fragment_size) {
+    for (std::size_t offset = 0; offset < message.size(); offset += fragment_size) {
+        parser.feed(message.substr(offset, fragment_size));
+    }
+    return parser.finish();
+}
+
+/// \brief A large NotifyReport.req as it is received by a CSMS or a GetBaseReport response that is sent to a charger
+std::string create_large_message(int report_data_count) {
+    json report_data = json::array();
+    for (int i = 0; i < report_data_count; i++) {
+        report_data.push_back(
+            {{"component", {{"name", "Connector"}, {"evse", {{"id", i % 4}}}}},
+             {"variable", {{"name", "AvailabilityState"}}},
+             {"variableAttribute", json::array({{{"value", "Available"}, {"mutability", "ReadOnly"}}})},
+             {"variableCharacteristics", {{"dataType", "OptionList"}, {"supportsMonitoring", true}}}});
+    }
+    return json::array({2, "unique-id", "NotifyReport", {{"requestId", 1}, {"seqNo", 0}, {"reportData", report_data}}})
+        .dump();
+}
+
+} // namespace
+
+TEST(IncrementalJsonParserTest, test_matches_json_parse_for_every_split) {
+    const std::string message = R"( [2, "19223201", "BootNotification", {"reason": "PowerUp", "chargingStation":
+        {"model": "SingleSocketCharger", "vendorName": "VendorX", "firmwareVersion": "1.0\n\"beta\"\t\/"},
+        "numbers": [0, -1, 18446744073709551615, -9223372036854775808, 1.5, -2.5e-3, 1E+2, 123456789012345678901234],
+        "literals": [true, false, null], "empty": [{}, [], ""],
+        "unicode": "\u00e4\u20AC\ud83d\ude00 ä€😀"}] )";
+    const auto expected = json::parse(message);
+
+    IncrementalJsonParser parser;
+    for (std::size_t fragment_size = 1; fragment_size <= message.size(); fragment_size++) {
+        SCOPED_TRACE("fragment_size " + std::to_string(fragment_size));
+        const auto parsed = parse_in_fragments(parser, message, fragment_size);
+        ASSERT_EQ(parsed, expected);
+        ASSERT_EQ(parsed.dump(), expected.dump());
+    }
+}
+
+TEST(IncrementalJsonParserTest, test_numbers_out_of_double_range_match_json_parse) {
+    const std::string message = "[1e-400, -1e-400, 2.2250738585072014e-308, 4.9e-324]";
+    IncrementalJsonParser parser;
+    parser.feed(message);
+    EXPECT_EQ(parser.finish().dump(), json::parse(message).dump());
+
+    for (const std::string overflow : {"1e400", "-1e400"}) {
+        EXPECT_FALSE(json::accept(overflow));
+        parser.reset();
+        EXPECT_THROW(
+            {
+                parser.feed(overflow);
+                parser.finish();
+            },
+            JsonParseException);
+    }
+}
+
+TEST(IncrementalJsonParserTest, test_numbers_do_not_depend_on_locale) {
+    // a locale with a decimal comma
+    const std::string previous_locale = std::setlocale(LC_NUMERIC, nullptr);
+    bool locale_set = false;
+    for (const auto locale : {"de_DE.UTF-8", "de_DE.utf8", "de_DE"}) {
+        if (std::setlocale(LC_NUMERIC, locale) != nullptr) {
+            locale_set = true;
+            break;
+        }
+    }
+    if (!locale_set) {
+        GTEST_SKIP() << "No German locale installed";
+    }
+
+    IncrementalJsonParser parser;
+    parser.feed(R"({"value": 1.5, "exponent": -2.5e-3})");
+    const auto parsed = parser.finish();
+    std::setlocale(LC_NUMERIC, previous_locale.c_str());
+
+    EXPECT_EQ(parsed.at("value").get<double>(), 1.5);
+    EXPECT_EQ(parsed.at("exponent").get<double>(), -2.5e-3);
+}
+
+TEST(IncrementalJsonParserTest, test_top_level_scalars) {
+    IncrementalJsonParser parser;
+    parser.feed("4");
+    parser.feed("2");
+    EXPECT_EQ(parser.finish(), json(42));
+
+    parser.feed(" \"text\" ");
+    EXPECT_EQ(parser.finish(), json("text"));
+
+    parser.feed("nu");
+    parser.feed("ll");
+    EXPECT_EQ(parser.finish(), json(nullptr));
+}
+
+TEST(IncrementalJsonParserTest, test_duplicate_keys_keep_last_value) {
+    const std::string message = R"({"key": 1, "key": [2]})";
+    IncrementalJsonParser parser;
+    parser.feed(message);
+    EXPECT_EQ(parser.finish(), json::parse(message));
+}
+
+TEST(IncrementalJsonParserTest, test_invalid_documents_throw) {
+    for (const std::string message :
+         {"", "[", "[1,]", "[1 2]", "{\"key\" 1}", "{1: 2}", "[1}", "{\"a\": 1]", "01", "1.", "-", "1e", "tru",
+          "trux", "[true] x", "\"unterminated", "\"\\x\"", "\"\\u12G4\"", "\"\\ud83d\"", "\"\\ude00\"", "\"a\tb\"",
+          "\"\xff\"", "\"\xc3\""}) {
+        SCOPED_TRACE(message);
+        EXPECT_FALSE(json::accept(message));
+
+        IncrementalJsonParser parser;
+        EXPECT_THROW(
+            {
+                parser.feed(message);
+                parser.finish();
+            },
+            JsonParseException);
+    }
+}
+
+TEST(IncrementalJsonParserTest, test_reset_after_error) {
+    IncrementalJsonParser parser;
+    EXPECT_THROW(parser.feed("[1,,"), JsonParseException);
+
+    parser.reset();
+    EXPECT_EQ(parser.get_parsed_bytes(), 0);
+    parser.feed("[1, 2]");
+    EXPECT_EQ(parser.get_parsed_bytes(), 6);
+    EXPECT_EQ(parser.finish(), json::array({1, 2}));
+}
+
+/// \brief Receives a multi-megabyte message in websocket sized fragments
+TEST(IncrementalJsonParserTest, test_large_message_in_fragments) {
+    const auto message = create_large_message(20000);
+    ASSERT_GT(message.size(), 4 * 1024 * 1024);
+
+    IncrementalJsonParser parser;
+    EXPECT_EQ(parse_in_fragments(parser, message, 4096), json::parse(message));
+}
+
+} // namespace ocpp
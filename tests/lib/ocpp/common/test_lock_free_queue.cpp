@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ocpp/common/lock_free_queue.hpp>
+
+namespace ocpp {
+
+using namespace std::chrono_literals;
+
+TEST(LockFreeQueueTest, test_fifo_order) {
+    LockFreeQueue<std::string> queue(4);
+    EXPECT_TRUE(queue.empty());
+
+    queue.push(std::string("first"));
+    queue.push(std::string("second"));
+    EXPECT_FALSE(queue.empty());
+
+    EXPECT_EQ(queue.try_pop().value(), "first");
+    EXPECT_EQ(queue.try_pop().value(), "second");
+    EXPECT_FALSE(queue.try_pop().has_value());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(LockFreeQueueTest, test_capacity_is_rounded_up) {
+    LockFreeQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8);
+
+    for (int i = 0; i < 8; i++) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(8));
+
+    // the ring buffer wraps around once elements are popped
+    EXPECT_EQ(queue.try_pop().value(), 0);
+    EXPECT_TRUE(queue.try_push(8));
+    for (int i = 1; i <= 8; i++) {
+        EXPECT_EQ(queue.try_pop().value(), i);
+    }
+}
+
+TEST(LockFreeQueueTest, test_clear_releases_elements) {
+    auto element = std::make_shared<int>(42);
+    LockFreeQueue<std::shared_ptr<int>> queue(4);
+    queue.push(element);
+    queue.push(element);
+    EXPECT_EQ(element.use_count(), 3);
+
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(element.use_count(), 1);
+}
+
+TEST(LockFreeQueueTest, test_push_waits_while_full) {
+    LockFreeQueue<int> queue(2);
+    queue.push(0);
+    queue.push(1);
+
+    std::thread producer([&queue]() { queue.push(2); });
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(queue.try_pop().value(), 0);
+    producer.join();
+
+    EXPECT_EQ(queue.try_pop().value(), 1);
+    EXPECT_EQ(queue.try_pop().value(), 2);
+}
+
+TEST(LockFreeQueueTest, test_wait_on_queue_element_wakes_up) {
+    LockFreeQueue<int> queue;
+
+    std::thread producer([&queue]() {
+        std::this_thread::sleep_for(20ms);
+        queue.push(1);
+    });
+    queue.wait_on_queue_element();
+    EXPECT_EQ(queue.try_pop().value(), 1);
+    producer.join();
+}
+
+TEST(LockFreeQueueTest, test_wait_on_custom_event_wakes_up_on_notify) {
+    LockFreeQueue<int> queue;
+    std::atomic_bool event{false};
+
+    std::thread notifier([&]() {
+        std::this_thread::sleep_for(20ms);
+        event = true;
+        queue.notify_waiting_thread();
+    });
+    queue.wait_on_custom_event([&]() { return event.load(); }, 10s);
+    EXPECT_TRUE(event);
+    notifier.join();
+}
+
+TEST(LockFreeQueueTest, test_multiple_producers_multiple_consumers) {
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int per_producer = 20000;
+    LockFreeQueue<int> queue(64);
+
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<int> popped{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&queue]() {
+            for (int i = 1; i <= per_producer; i++) {
+                queue.push(i);
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&]() {
+            while (popped.load() < producers * per_producer) {
+                if (auto value = queue.try_pop()) {
+                    sum += value.value();
+                    popped++;
+                } else {
+                    queue.wait_on_queue_element(1ms);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(popped.load(), producers * per_producer);
+    EXPECT_EQ(sum.load(), static_cast<std::int64_t>(producers) * per_producer * (per_producer + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+} // namespace ocpp
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2020 - 2023 Pionix GmbH and Contributors to EVerest
+#include <boost/asio/executor_work_guard.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
@@ -160,6 +161,7 @@ protected:
     std::condition_variable call_marker_cond_var;
     testing::MockFunction<bool(json message)> send_callback_mock;
     Everest::SteadyTimer reception_timer;
+    boost::asio::io_context io_context;
     std::unique_ptr<MessageQueue<TestMessageType>> message_queue;
 
     int get_call_count() {
@@ -206,6 +208,10 @@ protected:
         return identifier;
     }
 
+    static std::size_t serialized_size(const TestMessageType& message_type, const std::string& identifier) {
+        return json{2, identifier, to_string(message_type), json{{"data", identifier}}}.dump().size();
+    }
+
     void init_message_queue() {
         message_queue = std::make_unique<MessageQueue<TestMessageType>>(send_callback_mock.AsStdFunction(), config, db);
         message_queue->start();
@@ -480,4 +486,256 @@ TEST_F(MessageQueueTest, test_clean_up_transactional_queue) {
     wait_for_calls(expected_sent_messages);
 }
 
+// \brief Test that the byte threshold drops the oldest non-transactional messages one by one
+TEST_F(MessageQueueTest, test_byte_threshold_drops_non_transactional_messages) {
+    config.queues_total_size_threshold = 1000;
+    config.queues_total_size_threshold_bytes = 5 * serialized_size(TestMessageType::NON_TRANSACTIONAL, "nt_0");
+    config.queue_all_messages = true;
+    restart_message_queue();
+
+    message_queue->pause();
+
+    testing::Sequence s;
+    for (int i = 0; i < 8; i++) {
+        const auto msg_id = push_message_call(TestMessageType::NON_TRANSACTIONAL, "nt_" + std::to_string(i));
+        if (i >= 3) {
+            EXPECT_CALL(send_callback_mock, Call(json{2, msg_id, to_string(TestMessageType::NON_TRANSACTIONAL),
+                                                      json{{"data", msg_id}}}))
+                .InSequence(s)
+                .WillOnce(MarkAndReturn(true, true));
+        }
+    }
+    EXPECT_EQ(message_queue->get_queued_message_bytes(), config.queues_total_size_threshold_bytes);
+
+    message_queue->resume(std::chrono::seconds(0));
+
+    wait_for_calls(5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(5, get_call_count());
+    EXPECT_EQ(message_queue->get_queued_message_bytes(), 0);
+}
+
+// \brief Test that the byte threshold thins out transaction update messages by time and keeps the messages starting
+// and ending a transaction
+TEST_F(MessageQueueTest, test_byte_threshold_thins_transaction_updates) {
+    const auto start_size = serialized_size(TestMessageType::TRANSACTIONAL, "tx_s");
+    const auto update_size = serialized_size(TestMessageType::TRANSACTIONAL_UPDATE, "tx_0");
+    config.queues_total_size_threshold = 1000;
+    config.queues_total_size_threshold_bytes = 2 * start_size + 2 * update_size;
+    config.transaction_update_thinning_resolution_seconds = 60;
+    restart_message_queue();
+
+    message_queue->pause();
+
+    // all updates are pushed within the same minute, so only the first one and the latest one survive
+    const std::vector<std::string> expected_sent = {"tx_s", "tx_0", "tx_5", "tx_e"};
+    testing::Sequence s;
+    for (const auto& msg_id : expected_sent) {
+        const auto type = msg_id == "tx_s" or msg_id == "tx_e" ? TestMessageType::TRANSACTIONAL
+                                                                : TestMessageType::TRANSACTIONAL_UPDATE;
+        EXPECT_CALL(send_callback_mock, Call(json{2, msg_id, to_string(type), json{{"data", msg_id}}}))
+            .InSequence(s)
+            .WillOnce(MarkAndReturn(true, true));
+    }
+
+    push_message_call(TestMessageType::TRANSACTIONAL, "tx_s");
+    for (int i = 0; i < 6; i++) {
+        push_message_call(TestMessageType::TRANSACTIONAL_UPDATE, "tx_" + std::to_string(i));
+    }
+    push_message_call(TestMessageType::TRANSACTIONAL, "tx_e");
+
+    message_queue->resume(std::chrono::seconds(0));
+
+    wait_for_calls(4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(4, get_call_count());
+}
+
+// \brief Test that an offline backlog of large transaction update messages stays below the byte threshold
+TEST_F(MessageQueueTest, test_byte_threshold_offline_backlog_memory) {
+    const std::size_t threshold_bytes = 64 * 1024;
+    config.queues_total_size_threshold = 100000;
+    config.queues_total_size_threshold_bytes = threshold_bytes;
+    config.transaction_update_thinning_resolution_seconds = 1;
+    restart_message_queue();
+
+    int dropped_messages = 0;
+    EXPECT_CALL(*db, remove_message_queue_message(testing::_, QueueType::Transaction))
+        .WillRepeatedly(
+            testing::Invoke([&dropped_messages](const std::string&, const QueueType) { dropped_messages++; }));
+
+    message_queue->pause();
+
+    // a TransactionEvent with signed meter data is easily 20 times the size of a Heartbeat
+    const std::string signed_meter_value(400, 'x');
+    std::size_t pushed_bytes = 0;
+    for (int transaction = 0; transaction < 10; transaction++) {
+        const auto id = std::to_string(transaction);
+        push_message_call(TestMessageType::TRANSACTIONAL, "start_" + id);
+        for (int i = 0; i < 200; i++) {
+            Call<TestRequest> call;
+            call.msg.type = TestMessageType::TRANSACTIONAL_UPDATE;
+            call.msg.data = signed_meter_value;
+            call.uniqueId = "update_" + id + "_" + std::to_string(i);
+            pushed_bytes += json(call).dump().size();
+            message_queue->push_call(call);
+        }
+        push_message_call(TestMessageType::TRANSACTIONAL, "end_" + id);
+    }
+
+    EXPECT_GT(pushed_bytes, threshold_bytes);
+    EXPECT_LE(message_queue->get_queued_message_bytes(), threshold_bytes);
+    EXPECT_GT(dropped_messages, 0);
+}
+
+// \brief Test that a queued message is accounted with the size of its serialized form
+TEST_F(MessageQueueTest, test_queued_message_bytes_match_serialized_size) {
+    config.queues_total_size_threshold_bytes = 64 * 1024;
+    restart_message_queue();
+    message_queue->pause();
+
+    Call<TestRequest> call;
+    call.msg.type = TestMessageType::TRANSACTIONAL;
+    call.msg.data = "some data";
+    call.uniqueId = "call_0";
+    message_queue->push_call(call);
+
+    EXPECT_EQ(message_queue->get_queued_message_bytes(), json(call).dump().size());
+}
+
+// \brief Test that with pipelining enabled, multiple non-transactional messages are in flight at the same time
+TEST_F(MessageQueueTest, test_pipelining_of_non_transactional_messages) {
+    config.max_messages_in_flight = 3;
+    config.queues_total_size_threshold = 10;
+    restart_message_queue();
+
+    // no responses are sent, so every message stays in flight
+    EXPECT_CALL(send_callback_mock, Call(testing::_)).Times(3).WillRepeatedly(MarkAndReturn(true));
+
+    for (int i = 0; i < 5; i++) {
+        push_message_call(TestMessageType::NON_TRANSACTIONAL);
+    }
+
+    wait_for_calls(3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // the window is full, so no further messages are sent
+    EXPECT_EQ(3, get_call_count());
+}
+
+// \brief Test that with pipelining enabled, transactional messages are still sent one at a time
+TEST_F(MessageQueueTest, test_pipelining_keeps_transactional_messages_in_order) {
+    config.max_messages_in_flight = 3;
+    config.queues_total_size_threshold = 10;
+    restart_message_queue();
+
+    EXPECT_CALL(*db, insert_message_queue_message(testing::_, testing::_)).Times(2);
+    EXPECT_CALL(send_callback_mock, Call(json{2, "tx_0", "transactional", json{{"data", "tx_0"}}}))
+        .WillOnce(MarkAndReturn(true));
+    EXPECT_CALL(send_callback_mock, Call(json{2, "non_tx", "non_transactional", json{{"data", "non_tx"}}}))
+        .WillOnce(MarkAndReturn(true));
+
+    push_message_call(TestMessageType::TRANSACTIONAL, "tx_0");
+    push_message_call(TestMessageType::TRANSACTIONAL, "tx_1");
+    push_message_call(TestMessageType::NON_TRANSACTIONAL, "non_tx");
+
+    wait_for_calls(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // tx_1 is held back until tx_0 is answered
+    EXPECT_EQ(2, get_call_count());
+}
+
+// \brief Test that a received CALL is parsed once and not duplicated into call_message
+TEST_F(MessageQueueTest, test_receive_call) {
+    const auto message = json{2, "csms_call", "non_transactional", json{{"data", "csms_call"}}}.dump();
+
+    const auto enhanced_message = message_queue->receive(message);
+
+    EXPECT_EQ(enhanced_message.messageTypeId, MessageTypeId::CALL);
+    EXPECT_EQ(enhanced_message.messageType, TestMessageType::NON_TRANSACTIONAL);
+    EXPECT_EQ(enhanced_message.uniqueId, "csms_call");
+    EXPECT_EQ(enhanced_message.message_size, message.size());
+    EXPECT_EQ(enhanced_message.message.at(3).at("data"), "csms_call");
+    EXPECT_TRUE(enhanced_message.call_message.is_null());
+}
+
+// \brief Test that an already parsed message is taken over, and left untouched if it is invalid
+TEST_F(MessageQueueTest, test_receive_parsed_message) {
+    json message = json{2, "csms_call", "non_transactional", json{{"data", "csms_call"}}};
+    const auto enhanced_message = message_queue->receive(std::move(message), 42);
+
+    EXPECT_EQ(enhanced_message.messageTypeId, MessageTypeId::CALL);
+    EXPECT_EQ(enhanced_message.messageType, TestMessageType::NON_TRANSACTIONAL);
+    EXPECT_EQ(enhanced_message.uniqueId, "csms_call");
+    EXPECT_EQ(enhanced_message.message_size, 42);
+    EXPECT_EQ(enhanced_message.message.at(3).at("data"), "csms_call");
+
+    json invalid_message = json{2};
+    EXPECT_THROW(message_queue->receive(std::move(invalid_message), 3), json::exception);
+    EXPECT_EQ(invalid_message, json{2});
+}
+
+// \brief Test that a received CALLRESULT carries the original CALL
+TEST_F(MessageQueueTest, test_receive_call_result_contains_original_call) {
+    EXPECT_CALL(send_callback_mock, Call(testing::_)).WillOnce(MarkAndReturn(true));
+    push_message_call(TestMessageType::NON_TRANSACTIONAL, "call_0");
+    wait_for_calls(1);
+
+    const auto enhanced_message = message_queue->receive(json{3, "call_0", json::object()}.dump());
+
+    EXPECT_EQ(enhanced_message.messageTypeId, MessageTypeId::CALLRESULT);
+    EXPECT_EQ(enhanced_message.messageType, TestMessageType::NON_TRANSACTIONAL_RESPONSE);
+    EXPECT_EQ(enhanced_message.call_message, (json{2, "call_0", "non_transactional", json{{"data", "call_0"}}}));
+}
+
+// \brief Test that a queue processed on an event loop sends its messages in order from the loop thread, each one after
+// the response to the previous one has been received on the loop
+TEST_F(MessageQueueTest, test_event_loop_processing) {
+    const int message_count = 20;
+    config.queues_total_size_threshold = message_count;
+    message_queue->stop();
+
+    auto work = boost::asio::make_work_guard(io_context);
+    std::thread loop_thread([this]() { this->io_context.run(); });
+    const auto loop_thread_id = loop_thread.get_id();
+
+    message_queue = std::make_unique<MessageQueue<TestMessageType>>(send_callback_mock.AsStdFunction(), config, db);
+    message_queue->start(io_context);
+    message_queue->set_registration_status_accepted();
+    message_queue->resume(std::chrono::seconds(0));
+    EXPECT_FALSE(message_queue->is_event_loop_thread());
+
+    std::vector<std::string> sent_ids;
+    std::promise<void> all_sent;
+    auto all_sent_future = all_sent.get_future();
+    EXPECT_CALL(send_callback_mock, Call(testing::_))
+        .Times(message_count)
+        .WillRepeatedly(testing::Invoke([&](const json& message) {
+            EXPECT_EQ(std::this_thread::get_id(), loop_thread_id);
+            EXPECT_TRUE(this->message_queue->is_event_loop_thread());
+            sent_ids.push_back(message.at(MESSAGE_ID));
+            if (static_cast<int>(sent_ids.size()) == message_count) {
+                all_sent.set_value();
+            }
+            // in event loop mode the websocket dispatches the response on the loop as well
+            boost::asio::post(io_context, [this, unique_id = message.at(MESSAGE_ID)]() {
+                this->message_queue->receive(json{3, unique_id, ""}.dump());
+            });
+            return true;
+        }));
+
+    std::vector<std::string> pushed_ids;
+    for (int i = 0; i < message_count; i++) {
+        pushed_ids.push_back(push_message_call(TestMessageType::NON_TRANSACTIONAL));
+    }
+
+    EXPECT_EQ(all_sent_future.wait_for(std::chrono::seconds(3)), std::future_status::ready);
+    message_queue->stop();
+    work.reset();
+    loop_thread.join();
+
+    EXPECT_EQ(sent_ids, pushed_ids);
+}
+
 } // namespace ocpp
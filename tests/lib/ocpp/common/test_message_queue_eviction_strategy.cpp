@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include <ocpp/common/message_queue_eviction_strategy.hpp>
+
+namespace ocpp {
+
+struct EvictionTestMessage {
+    int id;
+    DateTime timestamp;
+    std::size_t message_size;
+    bool update;
+
+    bool is_transaction_update_message() const {
+        return update;
+    }
+};
+
+class MessageQueueEvictionStrategyTest : public ::testing::Test {
+protected:
+    std::deque<std::shared_ptr<EvictionTestMessage>> queue;
+    const DateTime now{};
+
+    void push_message(bool update, std::chrono::seconds offset = std::chrono::seconds(0),
+                      std::size_t message_size = 100) {
+        queue.push_back(std::make_shared<EvictionTestMessage>(EvictionTestMessage{
+            static_cast<int>(queue.size()), DateTime(now.to_time_point() + offset), message_size, update}));
+    }
+
+    /// \brief Pushes a transaction with \p updates update messages that are \p interval apart
+    void push_transaction(int updates, std::chrono::seconds interval, std::chrono::seconds start) {
+        push_message(false, start);
+        for (int i = 0; i < updates; i++) {
+            push_message(true, start + interval * i);
+        }
+        push_message(false, start + interval * updates);
+    }
+
+    std::vector<int> ids(const std::vector<std::size_t>& indices) {
+        std::vector<int> result;
+        for (const auto index : indices) {
+            result.push_back(queue.at(index)->id);
+        }
+        return result;
+    }
+};
+
+TEST_F(MessageQueueEvictionStrategyTest, test_drop_every_other_update) {
+    push_transaction(4, std::chrono::seconds(10), std::chrono::seconds(0));
+
+    DropEveryOtherUpdateEvictionStrategy<EvictionTestMessage> strategy;
+
+    // the update right before the last message is kept
+    EXPECT_EQ(ids(strategy.select_transaction_messages_to_drop(queue, {1, 0})), (std::vector<int>{1, 3}));
+}
+
+TEST_F(MessageQueueEvictionStrategyTest, test_thin_updates_keeps_one_update_per_resolution) {
+    // updates at 0s, 10s, ..., 110s
+    push_transaction(12, std::chrono::seconds(10), std::chrono::seconds(0));
+
+    ThinUpdatesByTimeEvictionStrategy<EvictionTestMessage> strategy(std::chrono::seconds(30));
+
+    // at 30s the updates at 0s, 30s, 60s and 90s are kept
+    EXPECT_EQ(ids(strategy.select_transaction_messages_to_drop(queue, {0, 1})),
+              (std::vector<int>{2, 3, 5, 6, 8, 9, 11, 12}));
+
+    // the resolution is coarsened until enough messages are selected
+    EXPECT_EQ(strategy.select_transaction_messages_to_drop(queue, {10, 0}).size(), 10);
+    EXPECT_EQ(strategy.select_transaction_messages_to_drop(queue, {0, 1000}).size(), 10);
+}
+
+TEST_F(MessageQueueEvictionStrategyTest, test_thin_updates_keeps_started_and_ended) {
+    push_transaction(3, std::chrono::seconds(1), std::chrono::seconds(0));
+    push_transaction(3, std::chrono::seconds(1), std::chrono::seconds(5));
+
+    ThinUpdatesByTimeEvictionStrategy<EvictionTestMessage> strategy(std::chrono::seconds(60));
+
+    // the first update of every transaction is kept
+    EXPECT_EQ(ids(strategy.select_transaction_messages_to_drop(queue, {0, 1})), (std::vector<int>{2, 3, 7, 8}));
+
+    queue.erase(queue.begin() + 7, queue.begin() + 9);
+    queue.erase(queue.begin() + 2, queue.begin() + 4);
+
+    // nothing left to drop
+    EXPECT_TRUE(strategy.select_transaction_messages_to_drop(queue, {0, 1}).empty());
+}
+
+TEST_F(MessageQueueEvictionStrategyTest, test_thin_updates_reaches_byte_target) {
+    // small updates followed by large ones, e.g. with signed meter values
+    push_message(false);
+    for (int i = 0; i < 10; i++) {
+        push_message(true, std::chrono::seconds(i), i < 5 ? 100 : 2000);
+    }
+    push_message(false, std::chrono::seconds(10));
+
+    ThinUpdatesByTimeEvictionStrategy<EvictionTestMessage> strategy(std::chrono::seconds(2));
+
+    std::size_t selected_bytes = 0;
+    for (const auto index : strategy.select_transaction_messages_to_drop(queue, {0, 5000})) {
+        selected_bytes += queue.at(index)->message_size;
+    }
+    EXPECT_GE(selected_bytes, 5000);
+}
+
+} // namespace ocpp
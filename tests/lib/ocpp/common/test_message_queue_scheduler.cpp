@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+
+#include <ocpp/common/message_queue_scheduler.hpp>
+
+namespace ocpp {
+
+struct ScheduledTestMessage {
+    int id;
+    DateTime timestamp;
+    bool stall_until_accepted;
+};
+
+class MessageQueueSchedulerTest : public ::testing::Test {
+protected:
+    MessageQueueScheduler<ScheduledTestMessage> scheduler;
+    const DateTime now{};
+
+    std::shared_ptr<ScheduledTestMessage> make_message(int id, std::chrono::seconds delay = std::chrono::seconds(0),
+                                                       bool stall_until_accepted = false) {
+        return std::make_shared<ScheduledTestMessage>(
+            ScheduledTestMessage{id, DateTime(now.to_time_point() + delay), stall_until_accepted});
+    }
+
+    /// \brief Takes all messages that are ready at \p time and returns their ids in the order they were selected
+    std::vector<int> drain(const DateTime& time) {
+        std::vector<int> ids;
+        while (auto message = scheduler.next_ready(time)) {
+            ids.push_back(message->id);
+            scheduler.erase(message);
+        }
+        return ids;
+    }
+
+    /// \brief Fills the scheduler with \p count messages and checks that draining it returns all of them in order
+    void run_backlog(int count) {
+        for (int i = 0; i < count; i++) {
+            // every tenth message is a retry that is due in the future
+            const auto delay = i % 10 == 0 ? std::chrono::seconds(60) : std::chrono::seconds(0);
+            scheduler.push_back(make_message(i, delay, i % 7 == 0));
+        }
+        scheduler.set_registration_status_accepted();
+
+        const auto ready_ids = drain(now);
+        const auto later_ids = drain(DateTime(now.to_time_point() + std::chrono::seconds(61)));
+
+        EXPECT_EQ(ready_ids.size() + later_ids.size(), static_cast<std::size_t>(count));
+        EXPECT_TRUE(std::is_sorted(ready_ids.begin(), ready_ids.end()));
+        EXPECT_TRUE(std::is_sorted(later_ids.begin(), later_ids.end()));
+        EXPECT_TRUE(scheduler.empty());
+    }
+};
+
+TEST_F(MessageQueueSchedulerTest, test_keeps_queue_order) {
+    scheduler.push_back(make_message(1));
+    scheduler.push_back(make_message(2));
+    scheduler.push_front(make_message(0));
+
+    EXPECT_EQ(scheduler.size(), 3);
+    EXPECT_EQ(scheduler.front()->id, 0);
+    EXPECT_EQ(drain(now), (std::vector<int>{0, 1, 2}));
+    EXPECT_TRUE(scheduler.empty());
+}
+
+TEST_F(MessageQueueSchedulerTest, test_delayed_message_is_skipped_until_due) {
+    scheduler.push_front(make_message(0, std::chrono::seconds(10)));
+    scheduler.push_back(make_message(1));
+
+    EXPECT_EQ(drain(now), (std::vector<int>{1}));
+    EXPECT_EQ(scheduler.size(), 1);
+    EXPECT_EQ(drain(DateTime(now.to_time_point() + std::chrono::seconds(10))), (std::vector<int>{0}));
+}
+
+TEST_F(MessageQueueSchedulerTest, test_stalled_message_is_released_when_accepted) {
+    scheduler.push_back(make_message(0, std::chrono::seconds(0), true));
+    scheduler.push_back(make_message(1));
+
+    EXPECT_EQ(drain(now), (std::vector<int>{1}));
+
+    scheduler.set_registration_status_accepted();
+    EXPECT_EQ(drain(now), (std::vector<int>{0}));
+}
+
+TEST_F(MessageQueueSchedulerTest, test_pop_front_and_erase) {
+    const auto first = make_message(0, std::chrono::seconds(10));
+    const auto second = make_message(1);
+    scheduler.push_back(first);
+    scheduler.push_back(second);
+    scheduler.push_back(make_message(2));
+
+    scheduler.pop_front();
+    EXPECT_TRUE(scheduler.erase(second));
+    EXPECT_FALSE(scheduler.erase(first));
+    EXPECT_EQ(drain(DateTime(now.to_time_point() + std::chrono::seconds(10))), (std::vector<int>{2}));
+}
+
+TEST_F(MessageQueueSchedulerTest, test_requeued_message_moves_to_front) {
+    const auto message = make_message(2);
+    scheduler.push_back(make_message(1));
+    scheduler.push_back(message);
+
+    scheduler.push_front(message);
+
+    EXPECT_EQ(scheduler.size(), 2);
+    EXPECT_EQ(drain(now), (std::vector<int>{2, 1}));
+}
+
+TEST_F(MessageQueueSchedulerTest, test_backlog) {
+    run_backlog(10000);
+}
+
+} // namespace ocpp
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+
+#include <ocpp/common/websocket/reconnect_backoff.hpp>
+
+namespace ocpp {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+ReconnectBackoffOptions get_default_options() {
+    ReconnectBackoffOptions options;
+    options.wait_minimum = 3s;
+    options.random_range = 2s;
+    options.repeat_times = 3;
+    return options;
+}
+
+/// \brief Result of a simulated CSMS outage
+struct OutageSimulation {
+    std::size_t peak_attempts_per_second = 0;    ///< Highest number of connection attempts within one second
+    std::size_t attempts = 0;                    ///< Number of connection attempts of all stations
+    std::chrono::milliseconds last_reconnect{0}; ///< Time at which the last station is connected again
+};
+
+/// \brief Simulates \p stations that lose the connection to the CSMS at the same time. Every connection attempt fails
+/// until the CSMS is back after \p outage
+OutageSimulation simulate_outage(const ReconnectBackoffOptions& options, int stations,
+                                 std::chrono::milliseconds outage) {
+    std::map<std::chrono::seconds::rep, std::size_t> attempts_per_second;
+    OutageSimulation result;
+
+    for (int i = 0; i < stations; i++) {
+        ReconnectBackoff backoff(options, "cp" + std::to_string(i));
+        std::chrono::milliseconds time{0};
+        do {
+            time += backoff.next_delay();
+            attempts_per_second[std::chrono::duration_cast<std::chrono::seconds>(time).count()]++;
+            result.attempts++;
+        } while (time < outage);
+        result.last_reconnect = std::max(result.last_reconnect, time);
+    }
+
+    for (const auto& [second, count] : attempts_per_second) {
+        result.peak_attempts_per_second = std::max(result.peak_attempts_per_second, count);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(ReconnectBackoffTest, test_delay_doubles_until_repeat_times) {
+    auto options = get_default_options();
+    options.random_range = 0s;
+    ReconnectBackoff backoff(options, "cp");
+
+    EXPECT_EQ(backoff.next_delay(), 3s);
+    EXPECT_EQ(backoff.next_delay(), 6s);
+    EXPECT_EQ(backoff.next_delay(), 12s);
+    EXPECT_EQ(backoff.next_delay(), 24s);
+    EXPECT_EQ(backoff.next_delay(), 24s);
+    EXPECT_EQ(backoff.next_delay(), 24s);
+
+    backoff.reset();
+    EXPECT_EQ(backoff.next_delay(), 3s);
+}
+
+TEST(ReconnectBackoffTest, test_random_part_is_within_range) {
+    const auto options = get_default_options();
+    ReconnectBackoff backoff(options, "cp");
+
+    auto previous = backoff.next_delay();
+    EXPECT_GE(previous, 3s);
+    EXPECT_LE(previous, 5s);
+    for (int i = 0; i < options.repeat_times; i++) {
+        const auto delay = backoff.next_delay();
+        EXPECT_GE(delay, previous * 2);
+        EXPECT_LE(delay, previous * 2 + 2s);
+        previous = delay;
+    }
+}
+
+TEST(ReconnectBackoffTest, test_delay_is_capped) {
+    auto options = get_default_options();
+    options.maximum = 10s;
+    ReconnectBackoff backoff(options, "cp");
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_LE(backoff.next_delay(), 10s);
+    }
+
+    options.decorrelated_jitter = true;
+    backoff = ReconnectBackoff(options, "cp");
+    for (int i = 0; i < 10; i++) {
+        const auto delay = backoff.next_delay();
+        EXPECT_GE(delay, 3s);
+        EXPECT_LE(delay, 10s);
+    }
+}
+
+TEST(ReconnectBackoffTest, test_spread_offset_is_seeded_per_station) {
+    auto options = get_default_options();
+    options.spread = 60s;
+
+    const ReconnectBackoff backoff_1(options, "cp1");
+    const ReconnectBackoff backoff_1_again(options, "cp1");
+    const ReconnectBackoff backoff_2(options, "cp2");
+
+    EXPECT_LE(backoff_1.get_spread_offset(), 60s);
+    EXPECT_EQ(backoff_1.get_spread_offset(), backoff_1_again.get_spread_offset());
+    EXPECT_NE(backoff_1.get_spread_offset(), backoff_2.get_spread_offset());
+
+    // The offset is only added to the first delay and kept after a reset
+    ReconnectBackoff backoff(options, "cp1");
+    const auto first = backoff.next_delay();
+    EXPECT_GE(first, 3s + backoff.get_spread_offset());
+    EXPECT_LE(first, 5s + backoff.get_spread_offset());
+    EXPECT_LE(backoff.next_delay(), 5s * 2 + 2s);
+    backoff.reset();
+    EXPECT_GE(backoff.next_delay(), 3s + backoff.get_spread_offset());
+}
+
+/// \brief All stations lose the connection at the same time. With the default backoff their first connection attempts
+/// fall into the same two seconds. Jitter and the spread distribute the attempts evenly over the outage
+TEST(ReconnectBackoffTest, test_reconnect_storm_is_flattened) {
+    constexpr int stations = 2000;
+    constexpr auto outage = 120s;
+
+    const auto default_options = get_default_options();
+
+    auto jitter_options = default_options;
+    jitter_options.decorrelated_jitter = true;
+    jitter_options.maximum = 60s;
+    jitter_options.spread = 60s;
+
+    const auto deterministic = simulate_outage(default_options, stations, outage);
+    const auto jittered = simulate_outage(jitter_options, stations, outage);
+
+    // The first attempts of all stations hit the CSMS within two seconds
+    EXPECT_GT(deterministic.peak_attempts_per_second, stations / 3);
+    EXPECT_LT(jittered.peak_attempts_per_second * 4, deterministic.peak_attempts_per_second);
+    // No second sees much more than the average number of attempts
+    const auto average_attempts_per_second = jittered.attempts / std::chrono::seconds(outage).count();
+    EXPECT_LT(jittered.peak_attempts_per_second, average_attempts_per_second * 2);
+    // The cap bounds how long a station stays disconnected after the CSMS is back
+    EXPECT_LE(jittered.last_reconnect, outage + jitter_options.maximum);
+}
+
+} // namespace ocpp
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <ocpp/common/websocket/tls_session_cache.hpp>
+
+namespace ocpp {
+
+namespace {
+
+struct SslCtxDeleter {
+    void operator()(SSL_CTX* ctx) const {
+        SSL_CTX_free(ctx);
+    }
+};
+using SslCtxPtr = std::unique_ptr<SSL_CTX, SslCtxDeleter>;
+
+/// \brief Self-signed RSA certificate that is used by the test server and as client certificate
+struct TestCertificate {
+    EVP_PKEY* key = nullptr;
+    X509* certificate = nullptr;
+
+    TestCertificate() {
+        EVP_PKEY_CTX* key_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr);
+        EVP_PKEY_keygen_init(key_ctx);
+        EVP_PKEY_CTX_set_rsa_keygen_bits(key_ctx, 2048);
+        EVP_PKEY_keygen(key_ctx, &this->key);
+        EVP_PKEY_CTX_free(key_ctx);
+
+        this->certificate = X509_new();
+        X509_set_version(this->certificate, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(this->certificate), 1);
+        X509_gmtime_adj(X509_getm_notBefore(this->certificate), 0);
+        X509_gmtime_adj(X509_getm_notAfter(this->certificate), 60 * 60);
+        X509_NAME* name = X509_get_subject_name(this->certificate);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1,
+                                   -1, 0);
+        X509_set_issuer_name(this->certificate, name);
+        X509_set_pubkey(this->certificate, this->key);
+        X509_sign(this->certificate, this->key, EVP_sha256());
+    }
+
+    ~TestCertificate() {
+        X509_free(this->certificate);
+        EVP_PKEY_free(this->key);
+    }
+};
+
+/// \brief Result of a single client connection to the test server
+struct HandshakeResult {
+    bool connected = false;
+    bool session_reused = false;
+};
+
+class TlsSessionCacheTest : public ::testing::TestWithParam<int> {
+protected:
+    TestCertificate certificate;
+    SslCtxPtr server_ctx;
+
+    void SetUp() override {
+        // The server requires a client certificate like a CSMS in security profile 3
+        this->server_ctx.reset(SSL_CTX_new(TLS_server_method()));
+        SSL_CTX_set_min_proto_version(this->server_ctx.get(), GetParam());
+        SSL_CTX_set_max_proto_version(this->server_ctx.get(), GetParam());
+        SSL_CTX_use_certificate(this->server_ctx.get(), this->certificate.certificate);
+        SSL_CTX_use_PrivateKey(this->server_ctx.get(), this->certificate.key);
+        SSL_CTX_set_verify(this->server_ctx.get(), SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+                           [](int, X509_STORE_CTX*) { return 1; });
+        // Sessions of authenticated clients can only be resumed with a session id context
+        const std::string session_id_context = "ocpp";
+        SSL_CTX_set_session_id_context(this->server_ctx.get(),
+                                       reinterpret_cast<const unsigned char*>(session_id_context.data()),
+                                       session_id_context.size());
+    }
+
+    /// \brief Creates a client SSL_CTX like the websocket does on every connection attempt
+    SslCtxPtr create_client_ctx() {
+        SslCtxPtr ctx(SSL_CTX_new(TLS_client_method()));
+        SSL_CTX_use_certificate(ctx.get(), this->certificate.certificate);
+        SSL_CTX_use_PrivateKey(ctx.get(), this->certificate.key);
+        X509_STORE_add_cert(SSL_CTX_get_cert_store(ctx.get()), this->certificate.certificate);
+        SSL_CTX_set_verify(ctx.get(), SSL_VERIFY_PEER, nullptr);
+        return ctx;
+    }
+
+    /// \brief Connects a client with \p client_ctx to the test server and waits for the data the server sends after the
+    /// handshake, so that a TLS 1.3 client has received the session tickets
+    HandshakeResult connect(SSL_CTX* client_ctx) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            return {};
+        }
+
+        std::thread server([this, fd = fds[1]]() {
+            SSL* ssl = SSL_new(this->server_ctx.get());
+            SSL_set_fd(ssl, fd);
+            if (SSL_accept(ssl) == 1) {
+                SSL_write(ssl, "x", 1);
+                char buffer;
+                SSL_read(ssl, &buffer, 1);
+                SSL_shutdown(ssl);
+            }
+            SSL_free(ssl);
+            close(fd);
+        });
+
+        HandshakeResult result;
+        SSL* ssl = SSL_new(client_ctx);
+        SSL_set_fd(ssl, fds[0]);
+        SSL_set_tlsext_host_name(ssl, "localhost");
+
+        char buffer;
+        result.connected = SSL_connect(ssl) == 1 and SSL_read(ssl, &buffer, 1) == 1;
+        result.session_reused = SSL_session_reused(ssl) == 1;
+
+        // The server answers the close_notify, so the socket is closed only after the server is done
+        SSL_shutdown(ssl);
+        server.join();
+        SSL_free(ssl);
+        close(fds[0]);
+        return result;
+    }
+};
+
+} // namespace
+
+TEST_P(TlsSessionCacheTest, test_resumes_session_with_new_ssl_ctx) {
+    auto cache = std::make_shared<TlsSessionCache>();
+
+    auto client_ctx = this->create_client_ctx();
+    cache->attach(client_ctx.get(), "context");
+    auto result = this->connect(client_ctx.get());
+    ASSERT_TRUE(result.connected);
+    EXPECT_FALSE(result.session_reused);
+    EXPECT_EQ(cache->size(), 1u);
+
+    // The websocket creates a new SSL_CTX on reconnect, the session is kept by the cache
+    client_ctx = this->create_client_ctx();
+    cache->attach(client_ctx.get(), "context");
+    result = this->connect(client_ctx.get());
+    ASSERT_TRUE(result.connected);
+    EXPECT_TRUE(result.session_reused);
+
+    cache->clear();
+    result = this->connect(client_ctx.get());
+    ASSERT_TRUE(result.connected);
+    EXPECT_FALSE(result.session_reused);
+}
+
+TEST_P(TlsSessionCacheTest, test_does_not_resume_session_of_other_context) {
+    auto cache = std::make_shared<TlsSessionCache>();
+
+    auto client_ctx = this->create_client_ctx();
+    cache->attach(client_ctx.get(), "certificate_1");
+    ASSERT_TRUE(this->connect(client_ctx.get()).connected);
+
+    // e.g. the client certificate has been renewed
+    client_ctx = this->create_client_ctx();
+    cache->attach(client_ctx.get(), "certificate_2");
+    const auto result = this->connect(client_ctx.get());
+    ASSERT_TRUE(result.connected);
+    EXPECT_FALSE(result.session_reused);
+}
+
+TEST_P(TlsSessionCacheTest, test_resumes_restored_session) {
+    std::map<std::string, std::vector<std::uint8_t>> stored_sessions;
+    {
+        auto cache = std::make_shared<TlsSessionCache>();
+        cache->register_session_stored_callback(
+            [&stored_sessions](const std::string& key, const std::vector<std::uint8_t>& session) {
+                stored_sessions[key] = session;
+            });
+        auto client_ctx = this->create_client_ctx();
+        cache->attach(client_ctx.get(), "context");
+        ASSERT_TRUE(this->connect(client_ctx.get()).connected);
+    }
+    ASSERT_EQ(stored_sessions.size(), 1u);
+
+    // e.g. after a restart
+    auto cache = std::make_shared<TlsSessionCache>();
+    for (const auto& [key, session] : stored_sessions) {
+        EXPECT_TRUE(cache->restore(key, session));
+    }
+    EXPECT_FALSE(cache->restore("invalid", {0x30, 0x00}));
+
+    auto client_ctx = this->create_client_ctx();
+    cache->attach(client_ctx.get(), "context");
+    const auto result = this->connect(client_ctx.get());
+    ASSERT_TRUE(result.connected);
+    EXPECT_TRUE(result.session_reused);
+}
+
+/// \brief A TLS 1.3 session ticket is used once, so every reconnect has to store the new session for the next one
+TEST_P(TlsSessionCacheTest, test_resumes_every_reconnect) {
+    auto cache = std::make_shared<TlsSessionCache>();
+    auto client_ctx = this->create_client_ctx();
+    cache->attach(client_ctx.get(), "context");
+    ASSERT_TRUE(this->connect(client_ctx.get()).connected);
+
+    for (int i = 0; i < 5; i++) {
+        client_ctx = this->create_client_ctx();
+        cache->attach(client_ctx.get(), "context");
+        const auto result = this->connect(client_ctx.get());
+        ASSERT_TRUE(result.connected);
+        EXPECT_TRUE(result.session_reused);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(TlsVersions, TlsSessionCacheTest, ::testing::Values(TLS1_2_VERSION, TLS1_3_VERSION),
+                         [](const ::testing::TestParamInfo<int>& info) {
+                             return info.param == TLS1_3_VERSION ? "TLS1_3" : "TLS1_2";
+                         });
+
+} // namespace ocpp
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+#include <ocpp/common/types.hpp>
+#include <ocpp/common/websocket/websocket_base.hpp>
+
+namespace ocpp {
+
+namespace {
+
+/// \brief Compresses messages the way the permessage-deflate extension does (RFC 7692 7.2.1): raw deflate with a sync
+/// flush per message and the trailing 0x00 0x00 0xff 0xff removed
+class PerMessageDeflater {
+private:
+    z_stream stream{};
+    bool no_context_takeover;
+
+public:
+    PerMessageDeflater(int window_bits, bool no_context_takeover) : no_context_takeover(no_context_takeover) {
+        // zlib does not support raw deflate with a window of 2^8, it uses 2^9 instead
+        deflateInit2(&this->stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -std::max(window_bits, 9), 8,
+                     Z_DEFAULT_STRATEGY);
+    }
+
+    ~PerMessageDeflater() {
+        deflateEnd(&this->stream);
+    }
+
+    std::string compress(const std::string& message) {
+        std::string compressed(deflateBound(&this->stream, message.size()) + 16, '\0');
+        this->stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(message.data()));
+        this->stream.avail_in = message.size();
+        this->stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+        this->stream.avail_out = compressed.size();
+        deflate(&this->stream, Z_SYNC_FLUSH);
+        compressed.resize(compressed.size() - this->stream.avail_out - 4);
+
+        if (this->no_context_takeover) {
+            deflateReset(&this->stream);
+        }
+        return compressed;
+    }
+};
+
+class PerMessageInflater {
+private:
+    z_stream stream{};
+
+public:
+    PerMessageInflater() {
+        inflateInit2(&this->stream, -15);
+    }
+
+    ~PerMessageInflater() {
+        inflateEnd(&this->stream);
+    }
+
+    std::string decompress(std::string compressed) {
+        compressed.append("\x00\x00\xff\xff", 4);
+        this->stream.next_in = reinterpret_cast<Bytef*>(compressed.data());
+        this->stream.avail_in = compressed.size();
+
+        std::string message;
+        char chunk[4096];
+        do {
+            this->stream.next_out = reinterpret_cast<Bytef*>(chunk);
+            this->stream.avail_out = sizeof(chunk);
+            inflate(&this->stream, Z_SYNC_FLUSH);
+            message.append(chunk, sizeof(chunk) - this->stream.avail_out);
+        } while (this->stream.avail_out == 0);
+        return message;
+    }
+};
+
+/// \returns the size of a masked client frame with a payload of \p payload_size bytes
+std::size_t frame_size(std::size_t payload_size) {
+    std::size_t header_size = 2 + 4;
+    if (payload_size > 0xffff) {
+        header_size += 8;
+    } else if (payload_size > 125) {
+        header_size += 2;
+    }
+    return header_size + payload_size;
+}
+
+/// \brief Typical charging session traffic: periodic TransactionEvent(Updated) and MeterValues.req messages
+std::vector<std::string> create_transaction_traffic(int count) {
+    std::vector<std::string> messages;
+    DateTime timestamp;
+    for (int i = 0; i < count; i++) {
+        const auto energy = std::to_string(1000.0 + i * 12.5);
+        const json sampled_values = json::array({
+            {{"value", energy}, {"measurand", "Energy.Active.Import.Register"}, {"unitOfMeasure", {{"unit", "Wh"}}}},
+            {{"value", 11000 + i % 7}, {"measurand", "Power.Active.Import"}, {"unitOfMeasure", {{"unit", "W"}}}},
+            {{"value", 16.1}, {"measurand", "Current.Import"}, {"phase", "L1"}, {"unitOfMeasure", {{"unit", "A"}}}},
+            {{"value", 230.4}, {"measurand", "Voltage"}, {"phase", "L1-N"}, {"unitOfMeasure", {{"unit", "V"}}}},
+            {{"value", 45 + i % 3}, {"measurand", "SoC"}, {"unitOfMeasure", {{"unit", "Percent"}}}},
+        });
+        const auto unique_id = "8f0c3b1e-" + std::to_string(100000 + i);
+        if (i % 2 == 0) {
+            messages.push_back(json::array({2, unique_id, "TransactionEvent",
+                                            {{"eventType", "Updated"},
+                                             {"timestamp", timestamp.to_rfc3339()},
+                                             {"triggerReason", "MeterValuePeriodic"},
+                                             {"seqNo", i},
+                                             {"transactionInfo", {{"transactionId", "a7d3c2f0-5d6b-4a51-9fa1"}}},
+                                             {"evse", {{"id", 1}, {"connectorId", 1}}},
+                                             {"meterValue", json::array({{{"timestamp", timestamp.to_rfc3339()},
+                                                                          {"sampledValue", sampled_values}}})}}})
+                                   .dump());
+        } else {
+            json v16_sampled_values = json::array();
+            for (const auto& sampled_value : sampled_values) {
+                v16_sampled_values.push_back({{"value", sampled_value.at("value").dump()},
+                                              {"context", "Sample.Periodic"},
+                                              {"measurand", sampled_value.at("measurand")},
+                                              {"unit", sampled_value.at("unitOfMeasure").at("unit")}});
+            }
+            messages.push_back(json::array({2, unique_id, "MeterValues",
+                                            {{"connectorId", 1},
+                                             {"transactionId", 42},
+                                             {"meterValue", json::array({{{"timestamp", timestamp.to_rfc3339()},
+                                                                          {"sampledValue", v16_sampled_values}}})}}})
+                                   .dump());
+        }
+    }
+    return messages;
+}
+
+} // namespace
+
+TEST(PerMessageDeflateTest, test_offer) {
+    EXPECT_EQ(get_permessage_deflate_offer({}),
+              "permessage-deflate; client_max_window_bits=15; server_max_window_bits=15");
+    EXPECT_EQ(get_permessage_deflate_offer({true, true, 10, 12}),
+              "permessage-deflate; client_no_context_takeover; server_no_context_takeover; "
+              "client_max_window_bits=10; server_max_window_bits=12");
+    // out of range window sizes are clamped
+    EXPECT_EQ(get_permessage_deflate_offer({false, false, 4, 20}),
+              "permessage-deflate; client_max_window_bits=8; server_max_window_bits=15");
+}
+
+/// \brief Round trips typical transaction traffic with different permessage-deflate settings, each of them has to
+/// reduce the bytes on the wire
+TEST(PerMessageDeflateTest, test_transaction_traffic_round_trip) {
+    const auto messages = create_transaction_traffic(200);
+
+    std::size_t uncompressed_bytes = 0;
+    for (const auto& message : messages) {
+        uncompressed_bytes += frame_size(message.size());
+    }
+
+    struct Setting {
+        int window_bits;
+        bool no_context_takeover;
+    };
+    for (const auto& setting : std::vector<Setting>{{15, false}, {10, false}, {15, true}}) {
+        PerMessageDeflater deflater(setting.window_bits, setting.no_context_takeover);
+        PerMessageInflater inflater;
+
+        std::size_t compressed_bytes = 0;
+        for (const auto& message : messages) {
+            const auto compressed = deflater.compress(message);
+            compressed_bytes += frame_size(compressed.size());
+            ASSERT_EQ(inflater.decompress(compressed), message);
+        }
+        EXPECT_LT(compressed_bytes, uncompressed_bytes);
+    }
+}
+
+} // namespace ocpp
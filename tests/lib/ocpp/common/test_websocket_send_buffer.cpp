@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <ocpp/common/websocket/websocket_base.hpp>
+
+namespace ocpp {
+
+TEST(WebsocketSendBufferTest, test_json_is_serialized_behind_headroom) {
+    const json message = json::array({2, "unique-id", "Heartbeat", {{"key", "välue"}, {"number", 1.5}}});
+
+    WebsocketSendBuffer buffer(16);
+    buffer.assign(message);
+
+    EXPECT_EQ(buffer.headroom(), 16);
+    EXPECT_EQ(buffer.payload(), message.dump());
+    EXPECT_EQ(buffer.size(), message.dump().size());
+    EXPECT_EQ(buffer.payload_data(), buffer.payload().data());
+}
+
+TEST(WebsocketSendBufferTest, test_assign_replaces_payload) {
+    WebsocketSendBuffer buffer(16);
+    buffer.assign(json::array({2, "first", "Heartbeat", json::object()}));
+    buffer.assign(std::string("ping"));
+
+    EXPECT_EQ(buffer.payload(), "ping");
+    EXPECT_EQ(buffer.headroom(), 16);
+}
+
+TEST(WebsocketSendBufferTest, test_size_hint_avoids_reallocation) {
+    const json message = json::array({2, "unique-id", "Heartbeat", json::object()});
+    const auto size = message.dump().size();
+
+    WebsocketSendBuffer buffer(16, size);
+    const auto* data = buffer.payload_data();
+    buffer.assign(message);
+
+    // the payload was serialized into the initial allocation
+    EXPECT_EQ(buffer.payload_data(), data);
+}
+
+TEST(WebsocketSendBufferTest, test_fragment_without_limit_is_whole_payload) {
+    WebsocketSendBuffer buffer(16);
+    buffer.assign(std::string("payload"));
+
+    const auto fragment = buffer.fragment(0, 0);
+    EXPECT_EQ(fragment.data, buffer.payload_data());
+    EXPECT_EQ(fragment.size, 7);
+    EXPECT_TRUE(fragment.first);
+    EXPECT_TRUE(fragment.last);
+}
+
+/// \brief Streams a multi-megabyte message fragment by fragment the way the libwebsockets implementation does: the
+/// frame header of every fragment is written into the bytes in front of it before the fragment is consumed
+TEST(WebsocketSendBufferTest, test_fragmented_multi_megabyte_payload) {
+    constexpr std::size_t headroom = 16;
+    constexpr std::size_t fragment_size = 64 * 1024;
+
+    // e.g. a large NotifyReport
+    json report_data = json::array();
+    for (int i = 0; i < 40000; i++) {
+        report_data.push_back({{"component", {{"name", "Connector"}, {"evse", {{"id", i % 4}}}}},
+                               {"variable", {{"name", "AvailabilityState"}}},
+                               {"variableAttribute", json::array({{{"value", "Available"}}})}});
+    }
+    const json message = json::array({2, "unique-id", "NotifyReport", {{"requestId", 1}, {"reportData", report_data}}});
+    const auto expected = message.dump();
+    ASSERT_GT(expected.size(), 4 * 1024 * 1024);
+
+    WebsocketSendBuffer buffer(headroom, expected.size());
+    buffer.assign(message);
+    const auto* data = buffer.payload_data();
+
+    std::string received;
+    std::size_t sent_bytes = 0;
+    std::size_t fragments = 0;
+    while (sent_bytes < buffer.size()) {
+        const auto fragment = buffer.fragment(sent_bytes, fragment_size);
+        EXPECT_EQ(fragment.first, sent_bytes == 0);
+        EXPECT_LE(fragment.size, fragment_size);
+
+        // frame header
+        ASSERT_GE(fragment.data - headroom, data - headroom);
+        std::memset(fragment.data - headroom, 'X', headroom);
+
+        received.append(fragment.data, fragment.size);
+        sent_bytes += fragment.size;
+        fragments++;
+        EXPECT_EQ(fragment.last, sent_bytes == buffer.size());
+    }
+
+    EXPECT_EQ(received, expected);
+    EXPECT_EQ(fragments, (expected.size() + fragment_size - 1) / fragment_size);
+    // the fragments are views into the one buffer the message was serialized into
+    EXPECT_EQ(buffer.payload_data(), data);
+}
+
+} // namespace ocpp
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
+
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include <evse_security_mock.hpp>
+#include <ocpp/common/websocket/websocket_libwebsockets.hpp>
+
+namespace ocpp {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// \brief Minimal plain websocket server that accepts the OCPP 1.6 subprotocol and echoes the first text message of
+/// every connection
+class EchoServer {
+public:
+    /// \brief Handshake of a connection as the server received it
+    struct Handshake {
+        std::string path;
+        bool offered_permessage_deflate = false;
+    };
+
+    explicit EchoServer(int connections) {
+        this->listen_socket = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        ::bind(this->listen_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        ::listen(this->listen_socket, connections);
+
+        socklen_t length = sizeof(address);
+        ::getsockname(this->listen_socket, reinterpret_cast<sockaddr*>(&address), &length);
+        this->port = ntohs(address.sin_port);
+
+        this->accept_thread = std::thread([this, connections]() {
+            for (int i = 0; i < connections; i++) {
+                const int client = ::accept(this->listen_socket, nullptr, nullptr);
+                if (client < 0) {
+                    return;
+                }
+                this->connection_threads.emplace_back(&EchoServer::serve, this, client);
+            }
+        });
+    }
+
+    ~EchoServer() {
+        ::shutdown(this->listen_socket, SHUT_RDWR);
+        ::close(this->listen_socket);
+        this->accept_thread.join();
+        for (auto& thread : this->connection_threads) {
+            thread.join();
+        }
+    }
+
+    int get_port() const {
+        return this->port;
+    }
+
+    std::vector<Handshake> get_handshakes() {
+        std::lock_guard lock(this->mutex);
+        return this->handshakes;
+    }
+
+private:
+    void serve(int client) {
+        std::string request;
+        char buffer[1024];
+
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            const auto received = ::recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                ::close(client);
+                return;
+            }
+            request.append(buffer, received);
+        }
+
+        Handshake handshake;
+        handshake.path = request.substr(4, request.find(' ', 4) - 4);
+        handshake.offered_permessage_deflate = request.find("permessage-deflate") != std::string::npos;
+        {
+            std::lock_guard lock(this->mutex);
+            this->handshakes.push_back(handshake);
+        }
+
+        const auto response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                              "Sec-WebSocket-Protocol: ocpp1.6\r\nSec-WebSocket-Accept: " +
+                              get_accept(get_header(request, "Sec-WebSocket-Key")) + "\r\n\r\n";
+        ::send(client, response.data(), response.size(), MSG_NOSIGNAL);
+
+        // Client frames are masked, the test messages are short enough for a 7 bit length
+        unsigned char header[6];
+        if (read_exactly(client, header, sizeof(header)) and (header[1] & 0x7f) < 126) {
+            std::string payload(header[1] & 0x7f, '\0');
+            if (read_exactly(client, reinterpret_cast<unsigned char*>(payload.data()), payload.size())) {
+                for (std::size_t i = 0; i < payload.size(); i++) {
+                    payload[i] ^= header[2 + i % 4];
+                }
+
+                const std::string frame = std::string{'\x81', static_cast<char>(payload.size())} + payload;
+                ::send(client, frame.data(), frame.size(), MSG_NOSIGNAL);
+            }
+        }
+
+        // Keep the connection open until the client closes it
+        while (::recv(client, buffer, sizeof(buffer), 0) > 0) {
+        }
+        ::close(client);
+    }
+
+    static bool read_exactly(int client, unsigned char* data, std::size_t size) {
+        std::size_t read = 0;
+        while (read < size) {
+            const auto received = ::recv(client, data + read, size - read, 0);
+            if (received <= 0) {
+                return false;
+            }
+            read += received;
+        }
+        return true;
+    }
+
+    static std::string get_header(const std::string& request, const std::string& name) {
+        const auto start = request.find(name + ": ");
+        if (start == std::string::npos) {
+            return {};
+        }
+        const auto value = start + name.size() + 2;
+        return request.substr(value, request.find("\r\n", value) - value);
+    }
+
+    static std::string get_accept(const std::string& key) {
+        const auto accept_source = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        unsigned char digest[SHA_DIGEST_LENGTH];
+        SHA1(reinterpret_cast<const unsigned char*>(accept_source.data()), accept_source.size(), digest);
+
+        unsigned char encoded[4 * ((SHA_DIGEST_LENGTH + 2) / 3) + 1];
+        EVP_EncodeBlock(encoded, digest, SHA_DIGEST_LENGTH);
+        return reinterpret_cast<char*>(encoded);
+    }
+
+    int listen_socket;
+    int port;
+    std::thread accept_thread;
+    std::vector<std::thread> connection_threads;
+
+    std::mutex mutex;
+    std::vector<Handshake> handshakes;
+};
+
+/// \brief Connection on the shared context with the promises its callbacks fulfill
+struct SharedConnection {
+    std::unique_ptr<WebsocketLibwebsockets> websocket;
+    std::promise<void> connected;
+    std::promise<std::string> received;
+};
+
+} // namespace
+
+class WebsocketSharedContextTest : public ::testing::Test {
+protected:
+    std::shared_ptr<EvseSecurityMock> evse_security = std::make_shared<EvseSecurityMock>();
+
+    std::unique_ptr<SharedConnection> create_connection(int port, const std::string& charge_point_id,
+                                                        bool permessage_deflate) {
+        WebsocketConnectionOptions options{};
+        options.ocpp_versions = {OcppProtocolVersion::v16};
+        options.csms_uri = Uri::parse_and_validate("ws://127.0.0.1:" + std::to_string(port) + "/ocpp/",
+                                                   charge_point_id, 0);
+        options.security_profile = 0;
+        options.retry_backoff_random_range_s = 1;
+        options.retry_backoff_repeat_times = 1;
+        options.retry_backoff_wait_minimum_s = 1;
+        options.max_connection_attempts = 1;
+        options.shared_context = true;
+        if (permessage_deflate) {
+            options.permessage_deflate = PerMessageDeflateOptions{};
+        }
+
+        auto connection = std::make_unique<SharedConnection>();
+        connection->websocket = std::make_unique<WebsocketLibwebsockets>(options, this->evse_security);
+        connection->websocket->register_connected_callback(
+            [raw = connection.get()](OcppProtocolVersion) { raw->connected.set_value(); });
+        connection->websocket->register_message_callback(
+            [raw = connection.get()](const std::string& message) { raw->received.set_value(message); });
+        connection->websocket->register_disconnected_callback([]() {});
+        connection->websocket->register_stopped_connecting_callback([](WebsocketCloseReason) {});
+        return connection;
+    }
+};
+
+/// \brief Two connections with different settings get a vhost each on the shared context, both connect to the server
+/// and exchange a message over the single service thread
+TEST_F(WebsocketSharedContextTest, test_two_vhosts_connect_to_server) {
+    EchoServer server(2);
+
+    auto plain = this->create_connection(server.get_port(), "cp-plain", false);
+    auto deflate = this->create_connection(server.get_port(), "cp-deflate", true);
+
+    auto plain_connected = plain->connected.get_future();
+    auto deflate_connected = deflate->connected.get_future();
+    auto plain_received = plain->received.get_future();
+    auto deflate_received = deflate->received.get_future();
+
+    ASSERT_TRUE(plain->websocket->start_connecting());
+    ASSERT_TRUE(deflate->websocket->start_connecting());
+
+    ASSERT_EQ(plain_connected.wait_for(10s), std::future_status::ready);
+    ASSERT_EQ(deflate_connected.wait_for(10s), std::future_status::ready);
+
+    EXPECT_TRUE(plain->websocket->send("[2,\"1\",\"Heartbeat\",{}]"));
+    EXPECT_TRUE(deflate->websocket->send("[2,\"2\",\"Heartbeat\",{}]"));
+
+    ASSERT_EQ(plain_received.wait_for(10s), std::future_status::ready);
+    ASSERT_EQ(deflate_received.wait_for(10s), std::future_status::ready);
+    EXPECT_EQ(plain_received.get(), "[2,\"1\",\"Heartbeat\",{}]");
+    EXPECT_EQ(deflate_received.get(), "[2,\"2\",\"Heartbeat\",{}]");
+
+    // Only the connection on the vhost with the extension offered it
+    const auto handshakes = server.get_handshakes();
+    ASSERT_EQ(handshakes.size(), 2);
+    for (const auto& handshake : handshakes) {
+        EXPECT_EQ(handshake.offered_permessage_deflate, handshake.path == "/ocpp/cp-deflate");
+    }
+
+    plain->websocket->close(WebsocketCloseReason::Normal, "test finished");
+    deflate->websocket->close(WebsocketCloseReason::Normal, "test finished");
+}
+
+} // namespace ocpp
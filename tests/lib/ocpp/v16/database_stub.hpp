@@ -66,6 +66,14 @@ struct SQLiteStatementTest : public ocpp::common::SQLiteStatementInterface {
     virtual int bind_null(const std::string& param) {
         return 0;
     }
+    virtual int bind_blob(const int idx, const std::vector<std::uint8_t>& val,
+                          SQLiteString lifetime = SQLiteString::Static) {
+        return 0;
+    }
+    virtual int bind_blob(const std::string& param, const std::vector<std::uint8_t>& val,
+                          SQLiteString lifetime = SQLiteString::Static) {
+        return 0;
+    }
     virtual int get_number_of_rows() override {
         return 0;
     }
@@ -87,6 +95,9 @@ struct SQLiteStatementTest : public ocpp::common::SQLiteStatementInterface {
     virtual double column_double(const int idx) {
         return 0.0;
     }
+    virtual std::vector<std::uint8_t> column_blob(const int idx) {
+        return {};
+    }
 };
 
 struct DatabaseConnectionTest : public common::DatabaseConnectionInterface {
@@ -99,6 +110,9 @@ struct DatabaseConnectionTest : public common::DatabaseConnectionInterface {
     virtual std::unique_ptr<ocpp::common::DatabaseTransactionInterface> begin_transaction() {
         return std::unique_ptr<ocpp::common::DatabaseTransactionInterface>{};
     }
+    virtual bool is_transaction_owner() const override {
+        return false;
+    }
     virtual bool commit_transaction() {
         return true;
     }
@@ -125,6 +139,8 @@ struct DatabaseConnectionTest : public common::DatabaseConnectionInterface {
     virtual uint32_t get_user_version() override {
         return 0;
     }
+    virtual void set_tuning_profile(const ocpp::common::DatabaseTuningProfile& profile) override {
+    }
 };
 
 class DbTestBase : public testing::Test {
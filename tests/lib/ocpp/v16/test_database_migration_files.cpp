@@ -78,4 +78,45 @@ TEST_P(DatabaseMigrationFilesTestV16, V16_MigrationFile2) {
     EXPECT_EQ(stmt->step(), SQLITE_ROW);
     EXPECT_EQ(stmt->column_int(0), 55);
     EXPECT_EQ(stmt->step(), SQLITE_DONE);
-}
\ No newline at end of file
+}
+TEST_P(DatabaseMigrationFilesTestV16, V16_MigrationFile4) {
+    DatabaseSchemaUpdater updater{this->database.get()};
+
+    EXPECT_TRUE(updater.apply_migration_files(this->migration_files_path, 3));
+    this->ExpectUserVersion(3);
+
+    EXPECT_FALSE(this->DoesColumnExist("NORMAL_QUEUE", "MESSAGE_FORMAT"));
+    EXPECT_FALSE(this->DoesColumnExist("TRANSACTION_QUEUE", "MESSAGE_FORMAT"));
+
+    EXPECT_TRUE(this->database->execute_statement(
+        "INSERT INTO NORMAL_QUEUE (UNIQUE_ID, MESSAGE, MESSAGE_TYPE, MESSAGE_ATTEMPTS, MESSAGE_TIMESTAMP) VALUES "
+        "(\"text\", \"[]\", \"Heartbeat\", 0, \"\")"));
+
+    EXPECT_TRUE(updater.apply_migration_files(this->migration_files_path, 4));
+    this->ExpectUserVersion(4);
+
+    EXPECT_TRUE(this->DoesColumnExist("NORMAL_QUEUE", "MESSAGE_FORMAT"));
+    EXPECT_TRUE(this->DoesColumnExist("TRANSACTION_QUEUE", "MESSAGE_FORMAT"));
+
+    // Existing messages are stored as JSON text
+    auto stmt = this->database->new_statement("SELECT UNIQUE_ID FROM NORMAL_QUEUE WHERE MESSAGE_FORMAT='JSON';");
+    EXPECT_EQ(stmt->step(), SQLITE_ROW);
+    EXPECT_EQ(stmt->column_text(0), "text");
+    EXPECT_EQ(stmt->step(), SQLITE_DONE);
+
+    EXPECT_TRUE(this->database->execute_statement("INSERT INTO NORMAL_QUEUE (UNIQUE_ID, MESSAGE, MESSAGE_TYPE, "
+                                                  "MESSAGE_ATTEMPTS, MESSAGE_TIMESTAMP, MESSAGE_FORMAT) VALUES "
+                                                  "(\"binary\", x'80', \"Heartbeat\", 0, \"\", \"CBOR\")"));
+
+    EXPECT_TRUE(updater.apply_migration_files(this->migration_files_path, 3));
+    this->ExpectUserVersion(3);
+
+    EXPECT_FALSE(this->DoesColumnExist("NORMAL_QUEUE", "MESSAGE_FORMAT"));
+    EXPECT_FALSE(this->DoesColumnExist("TRANSACTION_QUEUE", "MESSAGE_FORMAT"));
+
+    // Binary encoded messages can not be read by the older version and are removed
+    stmt = this->database->new_statement("SELECT UNIQUE_ID FROM NORMAL_QUEUE;");
+    EXPECT_EQ(stmt->step(), SQLITE_ROW);
+    EXPECT_EQ(stmt->column_text(0), "text");
+    EXPECT_EQ(stmt->step(), SQLITE_DONE);
+}
@@ -205,6 +205,7 @@ bool DeviceModelTestHelper::set_variable_attribute_value_null(const std::string&
         return false;
     }
 
+    this->device_model = create_device_model(false);
     return true;
 }
 
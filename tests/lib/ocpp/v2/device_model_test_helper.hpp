@@ -88,6 +88,9 @@ public:
     /// \param attribute_enum       The variable attribute.
     /// \return True on success.
     ///
+    /// \note After using this function, request a new device model with DeviceModelTestHelper::get_device_model(),
+    ///       because the device model keeps the values of the variable attributes in memory.
+    ///
     bool set_variable_attribute_value_null(const std::string& component_name,
                                            const std::optional<std::string>& component_instance,
                                            const std::optional<uint32_t>& evse_id,
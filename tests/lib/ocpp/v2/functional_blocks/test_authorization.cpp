@@ -34,7 +34,7 @@ class AuthorizationTest : public ::testing::Test {
 public:
 protected: // Members
     DeviceModelTestHelper device_model_test_helper;
-    MockMessageDispatcher mock_dispatcher;
+    ::testing::NiceMock<MockMessageDispatcher> mock_dispatcher;
     DeviceModel* device_model;
     ::testing::NiceMock<ConnectivityManagerMock> connectivity_manager;
     ::testing::NiceMock<ocpp::v2::DatabaseHandlerMock> database_handler_mock;
@@ -34,7 +34,7 @@ DataTransferRequest create_example_request() {
 class DataTransferTest : public ::testing::Test {
 public:
 protected: // Members
-    MockMessageDispatcher mock_dispatcher;
+    ::testing::NiceMock<MockMessageDispatcher> mock_dispatcher;
     DeviceModel* device_model;
     ::testing::NiceMock<ConnectivityManagerMock> connectivity_manager;
     ::testing::NiceMock<DatabaseHandlerMock> database_handler_mock;
@@ -142,6 +142,20 @@ TEST_F(DataTransferTest, DataTransferReq_Timeout) {
     EXPECT_FALSE(response.has_value());
 }
 
+TEST_F(DataTransferTest, DataTransferReq_OnEventLoop) {
+    DataTransfer data_transfer(functional_block_context, std::nullopt, ocpp::DEFAULT_WAIT_FOR_FUTURE_TIMEOUT);
+
+    DataTransferRequest request = create_example_request();
+
+    // waiting for the response on the event loop would never return, so the request is not sent at all
+    EXPECT_CALL(mock_dispatcher, can_wait_for_response()).WillOnce(Return(false));
+    EXPECT_CALL(mock_dispatcher, dispatch_call_async(_, _)).Times(0);
+
+    auto response = data_transfer.data_transfer_req(request);
+
+    EXPECT_FALSE(response.has_value());
+}
+
 TEST_F(DataTransferTest, DataTransferReq_Accepted) {
     DataTransfer data_transfer(functional_block_context, std::nullopt, ocpp::DEFAULT_WAIT_FOR_FUTURE_TIMEOUT);
 
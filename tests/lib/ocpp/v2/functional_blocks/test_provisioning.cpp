@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "availability_mock.hpp"
+#include "component_state_manager_mock.hpp"
+#include "connectivity_manager_mock.hpp"
+#include "diagnostics_mock.hpp"
+#include "evse_manager_fake.hpp"
+#include "evse_security_mock.hpp"
+#include "message_dispatcher_mock.hpp"
+#include "meter_values_mock.hpp"
+#include "mocks/database_handler_mock.hpp"
+#include "ocsp_updater_mock.hpp"
+#include "security_mock.hpp"
+#include "transaction_mock.hpp"
+
+#include <device_model_test_helper.hpp>
+
+#include <ocpp/common/database/database_connection.hpp>
+#include <ocpp/common/message_queue.hpp>
+#include <ocpp/v2/ctrlr_component_variables.hpp>
+#include <ocpp/v2/device_model.hpp>
+#include <ocpp/v2/device_model_storage_sqlite.hpp>
+#include <ocpp/v2/functional_blocks/functional_block_context.hpp>
+#include <ocpp/v2/functional_blocks/provisioning.hpp>
+#include <ocpp/v2/messages/SetVariables.hpp>
+
+using namespace ocpp::v2;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::MockFunction;
+using ::testing::NiceMock;
+
+class ProvisioningTest : public ::testing::Test {
+protected:
+    ProvisioningTest() :
+        device_model_test_helper(),
+        device_model(device_model_test_helper.get_device_model()),
+        evse_manager(1),
+        functional_block_context{this->mock_dispatcher,        *this->device_model,         this->connectivity_manager,
+                                 this->evse_manager,           this->database_handler_mock, this->evse_security,
+                                 this->component_state_manager},
+        message_queue([](json) { return true; }, ocpp::MessageQueueConfig<MessageType>{}, nullptr),
+        registration_status(RegistrationStatusEnum::Accepted),
+        provisioning(functional_block_context, message_queue, ocsp_updater, availability, meter_values, security,
+                     diagnostics, transaction, std::nullopt, std::nullopt, std::nullopt,
+                     [](const std::optional<const int32_t>, const ResetEnum&) { return true; },
+                     [](const std::optional<const int32_t>, const ResetEnum&) {},
+                     [](const int32_t, const ReasonEnum&) { return RequestStartStopStatusEnum::Accepted; },
+                     variable_changed_callback_mock.AsStdFunction(), registration_status) {
+    }
+
+    ///
+    /// \brief Create a SetVariables request from the CSMS.
+    /// \param set_variable_data    The values to set.
+    /// \return The request message.
+    ///
+    static ocpp::EnhancedMessage<MessageType>
+    create_set_variables_request(const std::vector<SetVariableData>& set_variable_data) {
+        SetVariablesRequest request;
+        request.setVariableData = set_variable_data;
+        ocpp::Call<SetVariablesRequest> call(request);
+        ocpp::EnhancedMessage<MessageType> enhanced_message;
+        enhanced_message.messageType = MessageType::SetVariables;
+        enhanced_message.message = call;
+        return enhanced_message;
+    }
+
+    ///
+    /// \brief Get the value of a variable as it is written in the database.
+    /// \param component_variable   The variable.
+    /// \return The value of the Actual attribute.
+    ///
+    static std::optional<std::string> get_stored_value(const ComponentVariable& component_variable) {
+        DeviceModelStorageSqlite storage(DEVICE_MODEL_DB_IN_MEMORY_PATH);
+        const auto attribute = storage.get_variable_attribute(
+            component_variable.component, component_variable.variable.value(), AttributeEnum::Actual);
+        if (!attribute.has_value() or !attribute->value.has_value()) {
+            return std::nullopt;
+        }
+        return attribute->value->get();
+    }
+
+    DeviceModelTestHelper device_model_test_helper;
+    DeviceModel* device_model;
+    NiceMock<MockMessageDispatcher> mock_dispatcher;
+    NiceMock<ConnectivityManagerMock> connectivity_manager;
+    NiceMock<DatabaseHandlerMock> database_handler_mock;
+    ocpp::EvseSecurityMock evse_security;
+    EvseManagerFake evse_manager;
+    ComponentStateManagerMock component_state_manager;
+    FunctionalBlockContext functional_block_context;
+    ocpp::MessageQueue<MessageType> message_queue;
+    NiceMock<OcspUpdaterMock> ocsp_updater;
+    NiceMock<AvailabilityMock> availability;
+    NiceMock<MeterValuesMock> meter_values;
+    NiceMock<SecurityMock> security;
+    NiceMock<DiagnosticsMock> diagnostics;
+    NiceMock<TransactionMock> transaction;
+    MockFunction<void(const SetVariableData& set_variable_data)> variable_changed_callback_mock;
+    std::atomic<RegistrationStatusEnum> registration_status;
+    Provisioning provisioning;
+
+    const ComponentVariable& tx_ended_interval = ControllerComponentVariables::SampledDataTxEndedInterval;
+    const ComponentVariable& tx_updated_interval = ControllerComponentVariables::SampledDataTxUpdatedInterval;
+    const ComponentVariable& ev_connection_time_out = ControllerComponentVariables::EVConnectionTimeOut;
+};
+
+TEST_F(ProvisioningTest, handle_set_variables_req_storage_failure_rejects_every_value) {
+    // The database fails to write one of the values
+    ocpp::common::DatabaseConnection database_connection(DEVICE_MODEL_DB_IN_MEMORY_PATH);
+    ASSERT_TRUE(database_connection.open_connection());
+    ASSERT_TRUE(database_connection.execute_statement(
+        "CREATE TRIGGER FAIL_UPDATE BEFORE UPDATE ON VARIABLE_ATTRIBUTE WHEN NEW.VALUE = '1234' "
+        "BEGIN SELECT RAISE(ABORT, 'write failed'); END"));
+
+    const std::vector<SetVariableData> set_variable_data{
+        {"30", tx_ended_interval.component, tx_ended_interval.variable.value()},
+        {"1234", tx_updated_interval.component, tx_updated_interval.variable.value()},
+        {"45", ev_connection_time_out.component, ev_connection_time_out.variable.value()},
+        {"1", tx_ended_interval.component, {"UnknownVariable"}}};
+
+    EXPECT_CALL(mock_dispatcher, dispatch_call_result(_)).WillOnce(Invoke([&](const json& call_result) {
+        const auto response = call_result[ocpp::CALLRESULT_PAYLOAD].get<SetVariablesResponse>();
+        ASSERT_EQ(response.setVariableResult.size(), set_variable_data.size());
+        for (const auto& result : response.setVariableResult) {
+            if (result.variable.name == "UnknownVariable") {
+                EXPECT_EQ(result.attributeStatus, SetVariableStatusEnum::UnknownVariable);
+            } else {
+                // The values are written together, so the values that could be written are rejected as well
+                EXPECT_EQ(result.attributeStatus, SetVariableStatusEnum::Rejected);
+            }
+        }
+    }));
+    EXPECT_CALL(variable_changed_callback_mock, Call(_)).Times(0);
+
+    provisioning.handle_message(create_set_variables_request(set_variable_data));
+
+    EXPECT_EQ(device_model->get_optional_value<int>(tx_ended_interval), 60);
+    EXPECT_EQ(device_model->get_optional_value<int>(tx_updated_interval), 120);
+    EXPECT_EQ(device_model->get_optional_value<int>(ev_connection_time_out), 120);
+    EXPECT_EQ(get_stored_value(tx_ended_interval), "60");
+    EXPECT_EQ(get_stored_value(ev_connection_time_out), "120");
+
+    EXPECT_TRUE(database_connection.execute_statement("DROP TRIGGER FAIL_UPDATE"));
+}
+
+TEST_F(ProvisioningTest, handle_set_variables_req_variables_changed_after_all_values_are_written) {
+    const std::vector<SetVariableData> set_variable_data{
+        {"30", tx_ended_interval.component, tx_ended_interval.variable.value()},
+        {"90", tx_updated_interval.component, tx_updated_interval.variable.value()},
+        {"45", ev_connection_time_out.component, ev_connection_time_out.variable.value()}};
+
+    bool response_sent = false;
+    EXPECT_CALL(mock_dispatcher, dispatch_call_result(_)).WillOnce(Invoke([&](const json& call_result) {
+        const auto response = call_result[ocpp::CALLRESULT_PAYLOAD].get<SetVariablesResponse>();
+        ASSERT_EQ(response.setVariableResult.size(), set_variable_data.size());
+        for (const auto& result : response.setVariableResult) {
+            EXPECT_EQ(result.attributeStatus, SetVariableStatusEnum::Accepted);
+        }
+        response_sent = true;
+    }));
+
+    // Every listener sees all values of the request in the database, not only the value it is called for
+    EXPECT_CALL(variable_changed_callback_mock, Call(_))
+        .Times(set_variable_data.size())
+        .WillRepeatedly(Invoke([&](const SetVariableData&) {
+            EXPECT_TRUE(response_sent);
+            EXPECT_EQ(get_stored_value(tx_ended_interval), "30");
+            EXPECT_EQ(get_stored_value(tx_updated_interval), "90");
+            EXPECT_EQ(get_stored_value(ev_connection_time_out), "45");
+        }));
+
+    provisioning.handle_message(create_set_variables_request(set_variable_data));
+
+    EXPECT_EQ(device_model->get_optional_value<int>(tx_ended_interval), 30);
+    EXPECT_EQ(device_model->get_optional_value<int>(tx_updated_interval), 90);
+    EXPECT_EQ(device_model->get_optional_value<int>(ev_connection_time_out), 45);
+}
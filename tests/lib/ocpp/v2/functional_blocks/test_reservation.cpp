@@ -172,7 +172,7 @@ protected: // Members
     // DatabaseConnection as member so the database keeps open and is not destroyed (because this is an in memory
     // database).
     std::unique_ptr<ocpp::common::DatabaseConnection> database_connection;
-    MockMessageDispatcher mock_dispatcher;
+    ::testing::NiceMock<MockMessageDispatcher> mock_dispatcher;
     EvseManagerFake evse_manager{NR_OF_EVSES};
     // Device model is a unique ptr here because of the database: it is stored in memory so as soon as the handle to
     // the database closes, the database is removed. So the handle should be opened before creating the devide model.
@@ -38,7 +38,7 @@ public:
 protected: // Members
     DeviceModelTestHelper device_model_test_helper;
     DeviceModel* device_model;
-    MockMessageDispatcher mock_dispatcher;
+    ::testing::NiceMock<MockMessageDispatcher> mock_dispatcher;
     ocpp::MessageLogging logging;
     ocpp::EvseSecurityMock evse_security;
     ConnectivityManagerMock connectivity_manager;
@@ -131,7 +131,7 @@ protected:
 
     // Default values used within the tests
     DeviceModelTestHelper device_model_test_helper;
-    MockMessageDispatcher mock_dispatcher;
+    ::testing::NiceMock<MockMessageDispatcher> mock_dispatcher;
     std::unique_ptr<EvseManagerFake> evse_manager = std::make_unique<EvseManagerFake>(NR_OF_TWO_EVSES);
 
     sqlite3* db_handle;
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include "gmock/gmock.h"
+
+#include <ocpp/v2/functional_blocks/availability.hpp>
+
+namespace ocpp::v2 {
+class AvailabilityMock : public AvailabilityInterface {
+public:
+    MOCK_METHOD(void, handle_message, (const ocpp::EnhancedMessage<MessageType>& message));
+    MOCK_METHOD(void, status_notification_req,
+                (const int32_t evse_id, const int32_t connector_id, const ConnectorStatusEnum status,
+                 const bool initiated_by_trigger_message));
+    MOCK_METHOD(void, heartbeat_req, (const bool initiated_by_trigger_message));
+    MOCK_METHOD(void, handle_scheduled_change_availability_requests, (const int32_t evse_id));
+    MOCK_METHOD(void, set_scheduled_change_availability_requests,
+                (const int32_t evse_id, AvailabilityChange availability_change));
+    MOCK_METHOD(void, set_heartbeat_timer_interval, (const std::chrono::seconds& interval));
+    MOCK_METHOD(void, stop_heartbeat_timer, ());
+};
+} // namespace ocpp::v2
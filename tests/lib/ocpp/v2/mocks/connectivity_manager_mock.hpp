@@ -26,6 +26,7 @@ public:
     MOCK_METHOD(void, connect, (std::optional<int32_t> network_profile_slot));
     MOCK_METHOD(void, disconnect, ());
     MOCK_METHOD(bool, send_to_websocket, (const std::string& message));
+    MOCK_METHOD(bool, send_to_websocket, (const json& message));
     MOCK_METHOD(void, on_network_disconnected, (OCPPInterfaceEnum ocpp_interface));
     MOCK_METHOD(void, on_charging_station_certificate_changed, ());
     MOCK_METHOD(void, confirm_successful_connection, ());
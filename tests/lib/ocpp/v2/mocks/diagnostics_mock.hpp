@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include "gmock/gmock.h"
+
+#include <ocpp/v2/functional_blocks/diagnostics.hpp>
+
+namespace ocpp::v2 {
+class DiagnosticsMock : public DiagnosticsInterface {
+public:
+    MOCK_METHOD(void, handle_message, (const ocpp::EnhancedMessage<MessageType>& message));
+    MOCK_METHOD(void, notify_event_req, (const std::vector<EventData>& events));
+    MOCK_METHOD(void, stop_monitoring, ());
+    MOCK_METHOD(void, start_monitoring, ());
+    MOCK_METHOD(void, process_triggered_monitors, ());
+};
+} // namespace ocpp::v2
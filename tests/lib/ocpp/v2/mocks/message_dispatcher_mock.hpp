@@ -11,9 +11,14 @@ using namespace ocpp::v2;
 
 class MockMessageDispatcher : public ocpp::MessageDispatcherInterface<MessageType> {
 public:
+    MockMessageDispatcher() {
+        ON_CALL(*this, can_wait_for_response()).WillByDefault(testing::Return(true));
+    }
+
     MOCK_METHOD(void, dispatch_call, (const json& call, bool triggered), (override));
     MOCK_METHOD(std::future<ocpp::EnhancedMessage<MessageType>>, dispatch_call_async,
                 (const json& call, bool triggered), (override));
+    MOCK_METHOD(bool, can_wait_for_response, (), (const, override));
     MOCK_METHOD(void, dispatch_call_result, (const json& call_result), (override));
     MOCK_METHOD(void, dispatch_call_error, (const json& call_error), (override));
 };
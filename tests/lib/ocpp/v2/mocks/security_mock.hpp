@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include "gmock/gmock.h"
+
+#include <ocpp/v2/functional_blocks/security.hpp>
+#include <ocpp/v2/messages/Get15118EVCertificate.hpp>
+
+namespace ocpp::v2 {
+class SecurityMock : public SecurityInterface {
+public:
+    MOCK_METHOD(void, handle_message, (const ocpp::EnhancedMessage<MessageType>& message));
+    MOCK_METHOD(void, security_event_notification_req,
+                (const CiString<50>& event_type, const std::optional<CiString<255>>& tech_info,
+                 const bool triggered_internally, const bool critical, const std::optional<DateTime>& timestamp));
+    MOCK_METHOD(void, sign_certificate_req,
+                (const ocpp::CertificateSigningUseEnum& certificate_signing_use,
+                 const bool initiated_by_trigger_message));
+    MOCK_METHOD(void, stop_certificate_signed_timer, ());
+    MOCK_METHOD(void, init_certificate_expiration_check_timers, ());
+    MOCK_METHOD(void, stop_certificate_expiration_check_timers, ());
+    MOCK_METHOD(Get15118EVCertificateResponse, on_get_15118_ev_certificate_request,
+                (const Get15118EVCertificateRequest& request));
+};
+} // namespace ocpp::v2
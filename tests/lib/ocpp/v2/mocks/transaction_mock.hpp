@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include "gmock/gmock.h"
+
+#include <ocpp/v2/functional_blocks/transaction.hpp>
+
+namespace ocpp::v2 {
+class TransactionMock : public TransactionInterface {
+public:
+    MOCK_METHOD(void, handle_message, (const ocpp::EnhancedMessage<MessageType>& message));
+    MOCK_METHOD(void, on_transaction_started,
+                (const int32_t evse_id, const int32_t connector_id, const std::string& session_id,
+                 const DateTime& timestamp, const TriggerReasonEnum trigger_reason, const MeterValue& meter_start,
+                 const std::optional<IdToken>& id_token, const std::optional<IdToken>& group_id_token,
+                 const std::optional<int32_t>& reservation_id, const std::optional<int32_t>& remote_start_id,
+                 const ChargingStateEnum charging_state));
+    MOCK_METHOD(void, on_transaction_finished,
+                (const int32_t evse_id, const DateTime& timestamp, const MeterValue& meter_stop,
+                 const ReasonEnum reason, const TriggerReasonEnum trigger_reason,
+                 const std::optional<IdToken>& id_token, const std::optional<std::string>& signed_meter_value,
+                 const ChargingStateEnum charging_state));
+    MOCK_METHOD(void, transaction_event_req,
+                (const TransactionEventEnum& event_type, const DateTime& timestamp, const Transaction& transaction,
+                 const TriggerReasonEnum& trigger_reason, const int32_t seq_no,
+                 const std::optional<int32_t>& cable_max_current, const std::optional<EVSE>& evse,
+                 const std::optional<IdToken>& id_token, const std::optional<std::vector<MeterValue>>& meter_value,
+                 const std::optional<int32_t>& number_of_phases_used, const bool offline,
+                 const std::optional<int32_t>& reservation_id, const bool initiated_by_trigger_message));
+    MOCK_METHOD(void, set_remote_start_id_for_evse,
+                (const int32_t evse_id, const IdToken id_token, const int32_t remote_start_id));
+    MOCK_METHOD(void, schedule_reset, (const std::optional<int32_t> reset_scheduled_evseid));
+};
+} // namespace ocpp::v2
@@ -149,7 +149,7 @@ public:
 
     std::unique_ptr<EvseManagerFake> evse_manager;
     DeviceModelTestHelper device_model_test_helper;
-    MockMessageDispatcher mock_dispatcher;
+    ::testing::NiceMock<MockMessageDispatcher> mock_dispatcher;
     DeviceModel* device_model;
     ::testing::NiceMock<ConnectivityManagerMock> connectivity_manager;
     ocpp::EvseSecurityMock evse_security;
@@ -167,6 +167,117 @@ TEST_F(DatabaseHandlerTest, TransactionDeleteNotFound) {
     EXPECT_NO_THROW(this->database_handler.transaction_delete("txIdNotFound"));
 }
 
+TEST_F(DatabaseHandlerTest, TransactionWriteBehindUpdatesAreVisibleToReads) {
+    constexpr int32_t evse_id = 1;
+    this->database_handler.set_transaction_write_behind_config({true, 1000});
+
+    auto transaction = default_transaction();
+    transaction->id_token_sent = false;
+    this->database_handler.transaction_insert(*transaction, evse_id);
+
+    for (int32_t seq_no = 11; seq_no <= 60; seq_no++) {
+        this->database_handler.transaction_update_seq_no(transaction->transactionId, seq_no);
+    }
+    this->database_handler.transaction_update_charging_state(transaction->transactionId, ChargingStateEnum::Charging);
+    this->database_handler.transaction_update_id_token_sent(transaction->transactionId, true);
+
+    // Reads wait for the queued updates, which are written in the order they were requested
+    auto transaction_get = this->database_handler.transaction_get(evse_id);
+    ASSERT_NE(transaction_get, nullptr);
+    EXPECT_EQ(transaction_get->seq_no, 60);
+    EXPECT_EQ(transaction_get->chargingState, ChargingStateEnum::Charging);
+    EXPECT_TRUE(transaction_get->id_token_sent);
+    EXPECT_EQ(this->database_handler.get_transaction_write_behind_queue_depth(), 0);
+    EXPECT_GE(this->database_handler.get_transaction_write_behind_peak_queue_depth(), 1);
+}
+
+TEST_F(DatabaseHandlerTest, TransactionWriteBehindMeterValues) {
+    this->database_handler.set_transaction_write_behind_config({true, 1000});
+
+    for (int i = 0; i < 3; i++) {
+        SampledValue sampled_value;
+        sampled_value.value = static_cast<float>(i);
+        sampled_value.context = ReadingContextEnum::Sample_Periodic;
+        sampled_value.measurand = MeasurandEnum::Energy_Active_Import_Register;
+        MeterValue meter_value;
+        meter_value.timestamp = DateTime{"2024-07-15T08:01:0" + std::to_string(i) + "Z"};
+        meter_value.sampledValue.push_back(sampled_value);
+        this->database_handler.transaction_metervalues_insert("txId", meter_value);
+    }
+
+    // Validation still happens on the calling thread
+    SampledValue without_context;
+    without_context.value = 1.0;
+    MeterValue mixed_contexts;
+    mixed_contexts.sampledValue = {without_context, without_context};
+    mixed_contexts.sampledValue.at(0).context = ReadingContextEnum::Sample_Periodic;
+    EXPECT_THROW(this->database_handler.transaction_metervalues_insert("txId", mixed_contexts), std::invalid_argument);
+
+    const auto meter_values = this->database_handler.transaction_metervalues_get_all("txId");
+    ASSERT_EQ(meter_values.size(), 3);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(meter_values.at(i).sampledValue.size(), 1);
+        EXPECT_EQ(meter_values.at(i).sampledValue.at(0).value, static_cast<float>(i));
+    }
+}
+
+TEST_F(DatabaseHandlerTest, TransactionWriteBehindQueueIsBounded) {
+    constexpr int32_t evse_id = 1;
+    auto transaction = default_transaction();
+    this->database_handler.transaction_insert(*transaction, evse_id);
+
+    this->database_handler.set_transaction_write_behind_config({true, 2});
+    for (int32_t seq_no = 11; seq_no <= 200; seq_no++) {
+        this->database_handler.transaction_update_seq_no(transaction->transactionId, seq_no);
+    }
+    this->database_handler.flush_transaction_updates();
+
+    EXPECT_EQ(this->database_handler.get_transaction_write_behind_queue_depth(), 0);
+    // At most a full queue and a full batch that is being written
+    EXPECT_LE(this->database_handler.get_transaction_write_behind_peak_queue_depth(), 4);
+    EXPECT_EQ(this->database_handler.transaction_get(evse_id)->seq_no, 200);
+}
+
+TEST_F(DatabaseHandlerTest, TransactionWriteBehindDisableWritesQueuedUpdates) {
+    constexpr int32_t evse_id = 1;
+    auto transaction = default_transaction();
+    this->database_handler.transaction_insert(*transaction, evse_id);
+
+    this->database_handler.set_transaction_write_behind_config({true, 1000});
+    this->database_handler.transaction_update_seq_no(transaction->transactionId, 11);
+    this->database_handler.set_transaction_write_behind_config({false, 1000});
+    EXPECT_EQ(this->database_handler.transaction_get(evse_id)->seq_no, 11);
+
+    this->database_handler.transaction_update_seq_no(transaction->transactionId, 12);
+    EXPECT_EQ(this->database_handler.get_transaction_write_behind_queue_depth(), 0);
+    EXPECT_EQ(this->database_handler.transaction_get(evse_id)->seq_no, 12);
+}
+
+TEST_F(DatabaseHandlerTest, TransactionWriteBehindFailureIsReportedSeparately) {
+    constexpr int32_t evse_id = 1;
+    auto transaction = default_transaction();
+    this->database_handler.transaction_insert(*transaction, evse_id);
+    this->database_handler
+        .new_statement("CREATE TRIGGER REJECT_SEQ_NO BEFORE UPDATE OF SEQ_NO ON TRANSACTIONS WHEN NEW.SEQ_NO = 12 "
+                       "BEGIN SELECT RAISE(ABORT, 'rejected'); END")
+        ->step();
+
+    this->database_handler.set_transaction_write_behind_config({true, 1000});
+    this->database_handler.transaction_update_seq_no(transaction->transactionId, 11);
+    this->database_handler.transaction_update_seq_no(transaction->transactionId, 12);
+    this->database_handler.transaction_update_charging_state(transaction->transactionId, ChargingStateEnum::Charging);
+
+    // Reads are not affected by the failure, the caller of the failed update has already returned
+    const auto transaction_get = this->database_handler.transaction_get(evse_id);
+    ASSERT_NE(transaction_get, nullptr);
+    EXPECT_EQ(transaction_get->seq_no, 11);
+    EXPECT_EQ(transaction_get->chargingState, ChargingStateEnum::Charging);
+
+    // The failure is reported once
+    EXPECT_EQ(this->database_handler.get_transaction_write_behind_errors().size(), 1);
+    EXPECT_TRUE(this->database_handler.get_transaction_write_behind_errors().empty());
+}
+
 TEST_F(DatabaseHandlerTest, KO1_FR27_DatabaseWithNoData_InsertProfile) {
     ChargingProfile profile;
     profile.id = 1;
@@ -1,8 +1,10 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <device_model_storage_interface_mock.hpp>
 #include <device_model_test_helper.hpp>
 
 #include <ocpp/v2/ctrlr_component_variables.hpp>
@@ -73,6 +75,238 @@ TEST_F(DeviceModelTest, test_min_limit_and_allow_zero) {
     ASSERT_EQ(r, 0);
 }
 
+/// \brief Test that set_value writes through to the storage and that get_value returns the new value
+TEST_F(DeviceModelTest, test_set_value_writes_through_to_storage) {
+    auto sv_result = dm->set_value(cv.component, cv.variable.value(), AttributeEnum::Actual, "42", "test");
+    ASSERT_EQ(sv_result, SetVariableStatusEnum::Accepted);
+    EXPECT_EQ(dm->get_value<int>(cv, AttributeEnum::Actual), 42);
+
+    DeviceModelStorageSqlite storage(DEVICE_MODEL_DB_IN_MEMORY_PATH);
+    const auto attribute = storage.get_variable_attribute(cv.component, cv.variable.value(), AttributeEnum::Actual);
+    ASSERT_TRUE(attribute.has_value());
+    ASSERT_TRUE(attribute->value.has_value());
+    EXPECT_EQ(attribute->value->get(), "42");
+
+    // A rejected value must neither change the storage nor the value returned by the device model
+    sv_result = dm->set_value(cv.component, cv.variable.value(), AttributeEnum::Actual, "not a number", "test");
+    ASSERT_EQ(sv_result, SetVariableStatusEnum::Rejected);
+    EXPECT_EQ(dm->get_value<int>(cv, AttributeEnum::Actual), 42);
+
+    // A new device model reads the value from the storage
+    EXPECT_EQ(DeviceModel(std::make_unique<DeviceModelStorageSqlite>(DEVICE_MODEL_DB_IN_MEMORY_PATH))
+                  .get_value<int>(cv, AttributeEnum::Actual),
+              42);
+}
+
+/// \brief Test that get_value is served from memory: the storage is read once when the device model is created and
+/// only written by set_value
+TEST(DeviceModelStorageAccessTest, test_get_value_does_not_query_storage) {
+    const RequiredComponentVariable& cv = ControllerComponentVariables::AlignedDataInterval;
+
+    VariableMetaData meta_data;
+    meta_data.characteristics.dataType = DataEnum::integer;
+    meta_data.characteristics.supportsMonitoring = false;
+    VariableAttribute attribute;
+    attribute.type = AttributeEnum::Actual;
+    attribute.value = "900";
+    attribute.mutability = MutabilityEnum::ReadWrite;
+
+    // Any other call to the storage fails the test
+    auto storage = std::make_unique<testing::StrictMock<DeviceModelStorageMock>>();
+    EXPECT_CALL(*storage, get_device_model())
+        .WillOnce(testing::Return(DeviceModelMap{{cv.component, {{cv.variable.value(), meta_data}}}}));
+    EXPECT_CALL(*storage, get_variable_attributes(cv.component, cv.variable.value(), testing::_))
+        .WillOnce(testing::Return(std::vector<VariableAttribute>{attribute}));
+    EXPECT_CALL(*storage,
+                set_variable_attribute_value(cv.component, cv.variable.value(), AttributeEnum::Actual, "60", "test"))
+        .WillOnce(testing::Return(true));
+
+    DeviceModel device_model(std::move(storage));
+
+    const RequiredComponentVariable copy = cv;
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(device_model.get_value<int>(cv, AttributeEnum::Actual), 900);
+        ASSERT_EQ(device_model.get_value<int>(copy, AttributeEnum::Actual), 900);
+    }
+
+    ASSERT_EQ(device_model.set_value(cv.component, cv.variable.value(), AttributeEnum::Actual, "60", "test"),
+              SetVariableStatusEnum::Accepted);
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(device_model.get_value<int>(cv, AttributeEnum::Actual), 60);
+    }
+}
+
+/// \brief Test that every variable of ControllerComponentVariables has its own id and variables defined elsewhere have
+/// none
+TEST_F(DeviceModelTest, test_controller_component_variable_id) {
+    std::vector<bool> ids(ControllerComponentVariables::number_of_variables, false);
+    for (const ControllerComponentVariable& component_variable : ControllerComponentVariables::all) {
+        ASSERT_TRUE(component_variable.id.has_value());
+        ASSERT_LT(component_variable.id.value(), ids.size());
+        EXPECT_FALSE(ids.at(component_variable.id.value())) << component_variable;
+        ids.at(component_variable.id.value()) = true;
+    }
+
+    const RequiredComponentVariable copy = ControllerComponentVariables::AlignedDataInterval;
+    EXPECT_EQ(copy.id, ControllerComponentVariables::AlignedDataInterval.id);
+    const RequiredComponentVariable other = {ControllerComponents::AlignedDataCtrlr, Variable{"Interval"}};
+    EXPECT_FALSE(other.id.has_value());
+}
+
+/// \brief Test that a variable of ControllerComponentVariables and a copy of it read the same value
+TEST_F(DeviceModelTest, test_get_value_by_id) {
+    const ComponentVariable copy = ControllerComponentVariables::AlignedDataInterval;
+    EXPECT_EQ(dm->get_value<int>(ControllerComponentVariables::AlignedDataInterval), 900);
+    EXPECT_EQ(dm->get_optional_value<int>(copy), 900);
+
+    ASSERT_EQ(dm->set_value(copy.component, copy.variable.value(), AttributeEnum::Actual, "60", "test"),
+              SetVariableStatusEnum::Accepted);
+    EXPECT_EQ(dm->get_value<int>(ControllerComponentVariables::AlignedDataInterval), 60);
+    EXPECT_EQ(dm->get_optional_value<int>(copy), 60);
+
+    // Attributes that are not in the device model
+    EXPECT_FALSE(
+        dm->get_optional_value<int>(ControllerComponentVariables::AlignedDataInterval, AttributeEnum::MaxSet));
+}
+
+/// \brief Test that request_values returns the same results as request_value for every variable of the request
+TEST_F(DeviceModelTest, test_request_values) {
+    std::vector<GetVariableData> get_variable_data;
+    get_variable_data.push_back({cv.component, cv.variable.value()});
+    get_variable_data.push_back({cv.component, cv.variable.value(), AttributeEnum::MaxSet});
+    get_variable_data.push_back({{"UnknownCtrlr"}, cv.variable.value()});
+    get_variable_data.push_back({cv.component, {"UnknownVariable"}});
+    get_variable_data.push_back({ControllerComponentVariables::SampledDataTxUpdatedInterval.component,
+                                 ControllerComponentVariables::SampledDataTxUpdatedInterval.variable.value(),
+                                 AttributeEnum::Actual});
+
+    const auto results = dm->request_values(get_variable_data);
+    ASSERT_EQ(results.size(), get_variable_data.size());
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const auto& data = get_variable_data.at(i);
+        const auto attribute_enum = data.attributeType.value_or(AttributeEnum::Actual);
+        const auto response = dm->request_value<std::string>(data.component, data.variable, attribute_enum);
+        EXPECT_EQ(results.at(i).component, data.component);
+        EXPECT_EQ(results.at(i).variable, data.variable);
+        EXPECT_EQ(results.at(i).attributeType, attribute_enum);
+        EXPECT_EQ(results.at(i).attributeStatus, response.status);
+        EXPECT_EQ(results.at(i).attributeValue.has_value(), response.value.has_value());
+        if (response.value.has_value()) {
+            EXPECT_EQ(results.at(i).attributeValue->get(), response.value.value());
+        }
+    }
+
+    EXPECT_EQ(results.at(0).attributeValue->get(), "900");
+    EXPECT_EQ(results.at(1).attributeStatus, GetVariableStatusEnum::NotSupportedAttributeType);
+    EXPECT_EQ(results.at(2).attributeStatus, GetVariableStatusEnum::UnknownComponent);
+    EXPECT_EQ(results.at(3).attributeStatus, GetVariableStatusEnum::UnknownVariable);
+    EXPECT_EQ(results.at(4).attributeValue->get(), "120");
+}
+
+/// \brief Test that set_values returns the status of every value and writes the accepted values to the storage
+TEST_F(DeviceModelTest, test_set_values) {
+    const auto& tx_updated_interval = ControllerComponentVariables::SampledDataTxUpdatedInterval;
+    const auto& available = ControllerComponentVariables::AlignedDataCtrlrAvailable;
+
+    std::vector<SetVariableData> set_variable_data;
+    set_variable_data.push_back({"60", cv.component, cv.variable.value()});
+    set_variable_data.push_back({"not a number", tx_updated_interval.component, tx_updated_interval.variable.value()});
+    set_variable_data.push_back({"false", available.component, available.variable.value()});
+    set_variable_data.push_back({"1", {"UnknownCtrlr"}, cv.variable.value()});
+    set_variable_data.push_back({"1", cv.component, {"UnknownVariable"}});
+    set_variable_data.push_back({"1", cv.component, cv.variable.value(), AttributeEnum::MaxSet});
+    set_variable_data.push_back({"30", tx_updated_interval.component, tx_updated_interval.variable.value()});
+
+    const auto statuses = dm->set_values(set_variable_data, "test");
+    const std::vector<SetVariableStatusEnum> expected_statuses{
+        SetVariableStatusEnum::Accepted,        SetVariableStatusEnum::Rejected,
+        SetVariableStatusEnum::Rejected,        SetVariableStatusEnum::UnknownComponent,
+        SetVariableStatusEnum::UnknownVariable, SetVariableStatusEnum::NotSupportedAttributeType,
+        SetVariableStatusEnum::Accepted};
+    EXPECT_EQ(statuses, expected_statuses);
+
+    EXPECT_EQ(dm->get_value<int>(cv), 60);
+    EXPECT_EQ(dm->get_value<int>(tx_updated_interval), 30);
+
+    DeviceModelStorageSqlite storage(DEVICE_MODEL_DB_IN_MEMORY_PATH);
+    const auto attribute = storage.get_variable_attribute(cv.component, cv.variable.value(), AttributeEnum::Actual);
+    ASSERT_TRUE(attribute.has_value() and attribute->value.has_value());
+    EXPECT_EQ(attribute->value->get(), "60");
+
+    // Read-only values can be set if they are allowed
+    EXPECT_EQ(dm->set_values({set_variable_data.at(2)}, "test", true),
+              std::vector<SetVariableStatusEnum>{SetVariableStatusEnum::Accepted});
+    EXPECT_EQ(dm->get_optional_value<bool>(available), false);
+}
+
+/// \brief Creates a device model map with \p nr_of_evses EVSEs with two connectors each and \p nr_of_controllers
+/// controllers, each component having \p nr_of_variables variables
+static DeviceModelMap create_device_model_map(const int32_t nr_of_evses, const int32_t nr_of_controllers,
+                                              const int32_t nr_of_variables) {
+    std::vector<Component> components;
+    for (int32_t evse_id = 1; evse_id <= nr_of_evses; evse_id++) {
+        components.push_back({"EVSE", EVSE{evse_id}});
+        for (int32_t connector_id = 1; connector_id <= 2; connector_id++) {
+            components.push_back({"Connector", EVSE{evse_id, connector_id}});
+        }
+    }
+    for (int32_t controller = 0; controller < nr_of_controllers; controller++) {
+        components.push_back({"Ctrlr" + std::to_string(controller)});
+    }
+
+    DeviceModelMap device_model_map;
+    for (const auto& component : components) {
+        for (int32_t variable = 0; variable < nr_of_variables; variable++) {
+            device_model_map[component][{"Variable" + std::to_string(variable)}] = VariableMetaData{};
+        }
+    }
+    return device_model_map;
+}
+
+/// \brief Test that every variable of a device model with many components is found by a copy of its component and
+/// variable and is part of the full inventory report
+TEST(DeviceModelLookupTest, test_request_value_in_large_device_model) {
+    const auto device_model_map = create_device_model_map(10, 10, 10);
+    VariableAttribute attribute;
+    attribute.type = AttributeEnum::Actual;
+    attribute.value = "1";
+    attribute.mutability = MutabilityEnum::ReadWrite;
+
+    auto storage = std::make_unique<testing::NiceMock<DeviceModelStorageMock>>();
+    ON_CALL(*storage, get_device_model()).WillByDefault(testing::Return(device_model_map));
+    ON_CALL(*storage, get_variable_attributes(testing::_, testing::_, testing::_))
+        .WillByDefault(testing::Return(std::vector<VariableAttribute>{attribute}));
+    DeviceModel dm(std::move(storage));
+
+    // Copies, as the component and variable of a request from the CSMS
+    std::size_t nr_of_variables = 0;
+    for (const auto& [component, variable_map] : device_model_map) {
+        for (const auto& [variable, variable_meta_data] : variable_map) {
+            const Component component_copy = component;
+            const Variable variable_copy = variable;
+            const auto response = dm.request_value<std::string>(component_copy, variable_copy, AttributeEnum::Actual);
+            ASSERT_EQ(response.status, GetVariableStatusEnum::Accepted);
+            EXPECT_EQ(response.value, "1");
+            nr_of_variables++;
+        }
+    }
+
+    EXPECT_EQ(dm.get_base_report_data(ReportBaseEnum::FullInventory).size(), nr_of_variables);
+
+    // Unknown components and variables are still reported as such
+    EXPECT_EQ(dm.request_value<std::string>({"UnknownCtrlr"}, {"Variable0"}, AttributeEnum::Actual).status,
+              GetVariableStatusEnum::UnknownComponent);
+    EXPECT_EQ(dm.request_value<std::string>({"Ctrlr0"}, {"UnknownVariable"}, AttributeEnum::Actual).status,
+              GetVariableStatusEnum::UnknownVariable);
+    EXPECT_EQ(dm.request_value<std::string>({"Ctrlr0", std::nullopt, "instance"}, {"Variable0"}, AttributeEnum::Actual)
+                  .status,
+              GetVariableStatusEnum::UnknownComponent);
+    EXPECT_EQ(dm.request_value<std::string>({"EVSE", EVSE{1, 1}}, {"Variable0"}, AttributeEnum::Actual).status,
+              GetVariableStatusEnum::UnknownComponent);
+    EXPECT_EQ(dm.request_value<std::string>({"Ctrlr0"}, {"Variable0"}, AttributeEnum::Target).status,
+              GetVariableStatusEnum::NotSupportedAttributeType);
+}
+
 TEST_F(DeviceModelTest, test_component_as_key_in_map) {
     std::map<Component, int32_t> components_to_ints;
 
@@ -387,6 +621,7 @@ TEST_F(DeviceModelTest, test_check_integrity_invalid_missing_required_variable_v
     device_model_test_helper.set_variable_attribute_value_null("SecurityCtrlr", std::nullopt, std::nullopt,
                                                                std::nullopt, "OrganizationName", std::nullopt,
                                                                AttributeEnum::Actual);
+    dm = device_model_test_helper.get_device_model();
     // This should throw an exception.
     EXPECT_THROW(dm->check_integrity(evse_connector_structure), DeviceModelError);
 }
@@ -43,5 +43,25 @@ TEST_F(DeviceModelStorageSQLiteTest, test_check_integrity_invalid) {
     EXPECT_NO_THROW(dm.check_integrity());
 }
 
+/// \brief Tests set_variable_attribute_values sets all values that are present
+TEST_F(DeviceModelStorageSQLiteTest, test_set_variable_attribute_values) {
+    DeviceModelStorageSqlite dm(DATABASE_PATH, "", "", false);
+    const Component component{"UnitTestCtrlr", EVSE{2, 3}};
+
+    const std::vector<VariableAttributeUpdate> updates{
+        {component, {"UnitTestPropertyAName"}, AttributeEnum::Actual, "true", "test"},
+        {component, {"UnknownVariable"}, AttributeEnum::Actual, "1", "test"},
+        {component, {"UnitTestPropertyCName"}, AttributeEnum::Actual, "42", "test"}};
+
+    EXPECT_EQ(dm.set_variable_attribute_values(updates), (std::vector<bool>{true, false, true}));
+
+    const auto property_a = dm.get_variable_attribute(component, {"UnitTestPropertyAName"}, AttributeEnum::Actual);
+    ASSERT_TRUE(property_a.has_value() and property_a->value.has_value());
+    EXPECT_EQ(property_a->value->get(), "true");
+    const auto property_c = dm.get_variable_attribute(component, {"UnitTestPropertyCName"}, AttributeEnum::Actual);
+    ASSERT_TRUE(property_c.has_value() and property_c->value.has_value());
+    EXPECT_EQ(property_c->value->get(), "42");
+}
+
 } // namespace v2
 } // namespace ocpp
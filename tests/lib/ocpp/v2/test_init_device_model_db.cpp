@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2020 - 2024 Pionix GmbH and Contributors to EVerest
 
+#include <fstream>
+
 #include <gtest/gtest.h>
 
 #include <ocpp/v2/device_model_storage_sqlite.hpp>
@@ -406,6 +408,135 @@ TEST_F(InitDeviceModelDbTest, init_db) {
     EXPECT_FALSE(component_exists("UnitTestCtrlr", std::nullopt, 1, 5));
 }
 
+TEST_F(InitDeviceModelDbTest, skip_unchanged_component_configs) {
+    /* The config files are hashed when the database is initialized. When the database is initialized again with the
+     * same config, it is not compared with the config at all. When only some files have changed, only the components
+     * of those files are compared. To see if a component was compared, the value of an attribute is changed in the
+     * database without changing its source, which would be reset to the value of the config otherwise.
+     */
+    const std::filesystem::path config_path =
+        std::filesystem::temp_directory_path() / "libocpp_test_skip_unchanged_component_configs";
+    std::filesystem::remove_all(config_path);
+    std::filesystem::copy(CONFIGS_PATH, config_path, std::filesystem::copy_options::recursive);
+
+    InitDeviceModelDb db(DATABASE_PATH, MIGRATION_FILES_PATH);
+    db.database_exists = false;
+    ASSERT_NO_THROW(db.initialize_database(config_path, true));
+
+    {
+        auto statement = this->database->new_statement("SELECT COUNT(*) FROM COMPONENT_CONFIG_HASH");
+        ASSERT_EQ(statement->step(), SQLITE_ROW);
+        EXPECT_EQ(statement->column_int(0), 1);
+        statement = this->database->new_statement("SELECT COUNT(*) FROM COMPONENT WHERE CONFIG_HASH IS NULL");
+        ASSERT_EQ(statement->step(), SQLITE_ROW);
+        EXPECT_EQ(statement->column_int(0), 0);
+    }
+
+    const std::string change_max_power =
+        "UPDATE VARIABLE_ATTRIBUTE SET VALUE = '1' WHERE TYPE_ID = " +
+        std::to_string(static_cast<int>(AttributeEnum::MaxSet)) +
+        " AND VARIABLE_ID IN (SELECT v.ID FROM VARIABLE v JOIN COMPONENT c ON v.COMPONENT_ID = c.ID WHERE c.NAME = "
+        "'EVSE' AND v.NAME = 'Power')";
+    ASSERT_TRUE(this->database->execute_statement(change_max_power));
+
+    // Nothing changed, the database is not compared with the config.
+    InitDeviceModelDb db2(DATABASE_PATH, MIGRATION_FILES_PATH);
+    db2.database_exists = true;
+    ASSERT_NO_THROW(db2.initialize_database(config_path, false));
+    EXPECT_TRUE(
+        attribute_has_value("EVSE", std::nullopt, 1, std::nullopt, "Power", std::nullopt, AttributeEnum::MaxSet, "1"));
+    EXPECT_TRUE(
+        attribute_has_value("EVSE", std::nullopt, 2, std::nullopt, "Power", std::nullopt, AttributeEnum::MaxSet, "1"));
+
+    // Only the file of EVSE 2 changed, so only EVSE 2 is compared with the config.
+    std::ofstream(config_path / "custom" / "EVSE_2.json", std::ios::app) << "\n";
+    InitDeviceModelDb db3(DATABASE_PATH, MIGRATION_FILES_PATH);
+    db3.database_exists = true;
+    ASSERT_NO_THROW(db3.initialize_database(config_path, false));
+    EXPECT_TRUE(
+        attribute_has_value("EVSE", std::nullopt, 1, std::nullopt, "Power", std::nullopt, AttributeEnum::MaxSet, "1"));
+    EXPECT_TRUE(attribute_has_value("EVSE", std::nullopt, 2, std::nullopt, "Power", std::nullopt, AttributeEnum::MaxSet,
+                                    "22000"));
+
+    std::filesystem::remove_all(config_path);
+}
+
+TEST_F(InitDeviceModelDbTest, initialize_existing_database_only_writes_changed_components) {
+    /* Every row that is written to the device model tables is logged by a trigger. Initializing an existing database
+     * with an unchanged config must not write any row, and when one config file changed, only rows of its component
+     * may be written.
+     */
+    const std::filesystem::path config_path =
+        std::filesystem::temp_directory_path() / "libocpp_test_initialize_existing_database";
+    std::filesystem::remove_all(config_path);
+    std::filesystem::copy(CONFIGS_PATH, config_path, std::filesystem::copy_options::recursive);
+
+    const auto initialize = [this, &config_path](const bool database_exists) {
+        InitDeviceModelDb db(DATABASE_PATH, MIGRATION_FILES_PATH);
+        db.database_exists = database_exists;
+        db.initialize_database(config_path, !database_exists);
+    };
+    // Returns the component of every written row, or std::nullopt if the row does not exist anymore
+    const auto get_components_of_written_rows = [this]() {
+        std::vector<std::optional<int>> components;
+        auto statement = this->database->new_statement(
+            "SELECT CASE w.TABLE_NAME WHEN 'COMPONENT' THEN (SELECT ID FROM COMPONENT WHERE ID = w.ROW_ID) "
+            "WHEN 'VARIABLE' THEN (SELECT COMPONENT_ID FROM VARIABLE WHERE ID = w.ROW_ID) "
+            "WHEN 'VARIABLE_ATTRIBUTE' THEN (SELECT v.COMPONENT_ID FROM VARIABLE_ATTRIBUTE a JOIN VARIABLE v ON "
+            "a.VARIABLE_ID = v.ID WHERE a.ID = w.ROW_ID) "
+            "WHEN 'VARIABLE_CHARACTERISTICS' THEN (SELECT v.COMPONENT_ID FROM VARIABLE_CHARACTERISTICS c JOIN "
+            "VARIABLE v ON c.VARIABLE_ID = v.ID WHERE c.ID = w.ROW_ID) END FROM WRITTEN_ROWS w");
+        while (statement->step() == SQLITE_ROW) {
+            components.push_back(statement->column_type(0) == SQLITE_NULL
+                                     ? std::nullopt
+                                     : std::optional<int>(statement->column_int(0)));
+        }
+        return components;
+    };
+    const auto get_count = [this](const std::string& query) {
+        auto statement = this->database->new_statement(query);
+        EXPECT_EQ(statement->step(), SQLITE_ROW);
+        return statement->column_int(0);
+    };
+
+    ASSERT_NO_THROW(initialize(false));
+    const int evse_1_id = get_count("SELECT ID FROM COMPONENT WHERE NAME = 'EVSE' AND EVSE_ID = 1");
+
+    ASSERT_TRUE(this->database->execute_statement("CREATE TABLE WRITTEN_ROWS (TABLE_NAME TEXT, ROW_ID INTEGER)"));
+    for (const std::string table : {"COMPONENT", "VARIABLE", "VARIABLE_ATTRIBUTE", "VARIABLE_CHARACTERISTICS"}) {
+        for (const std::string event : {"INSERT", "UPDATE", "DELETE"}) {
+            const std::string row = event == "DELETE" ? "OLD" : "NEW";
+            ASSERT_TRUE(this->database->execute_statement(
+                "CREATE TRIGGER LOG_" + event + "_" + table + " AFTER " + event + " ON " + table +
+                " BEGIN INSERT INTO WRITTEN_ROWS VALUES ('" + table + "', " + row + ".rowid); END"));
+        }
+    }
+
+    // Nothing changed, no row is written.
+    ASSERT_NO_THROW(initialize(true));
+    EXPECT_EQ(get_count("SELECT COUNT(*) FROM WRITTEN_ROWS"), 0);
+
+    // Only the file of EVSE 1 changed, so only rows of EVSE 1 are written, at least its config hash.
+    std::ofstream(config_path / "custom" / "EVSE_1.json", std::ios::app) << "\n";
+    ASSERT_NO_THROW(initialize(true));
+    EXPECT_EQ(get_count("SELECT COUNT(*) FROM WRITTEN_ROWS WHERE TABLE_NAME = 'COMPONENT' AND ROW_ID = " +
+                        std::to_string(evse_1_id)),
+              1);
+    for (const auto& component : get_components_of_written_rows()) {
+        EXPECT_EQ(component, evse_1_id);
+    }
+
+    // Without config hashes, every component is compared and gets its config hash written.
+    ASSERT_TRUE(this->database->execute_statement("UPDATE COMPONENT SET CONFIG_HASH = NULL"));
+    ASSERT_TRUE(this->database->execute_statement("DELETE FROM COMPONENT_CONFIG_HASH"));
+    ASSERT_TRUE(this->database->execute_statement("DELETE FROM WRITTEN_ROWS"));
+    ASSERT_NO_THROW(initialize(true));
+    EXPECT_EQ(get_count("SELECT COUNT(DISTINCT ROW_ID) FROM WRITTEN_ROWS WHERE TABLE_NAME = 'COMPONENT'"),
+              get_count("SELECT COUNT(*) FROM COMPONENT"));
+
+    std::filesystem::remove_all(config_path);
+}
+
 TEST_F(InitDeviceModelDbTest, wrong_migration_file_path) {
     InitDeviceModelDb db(DATABASE_PATH, "/tmp/thisdoesnotexisthopefully");
     // The migration script is not correct (there is none in the given folder), this should throw an exception.
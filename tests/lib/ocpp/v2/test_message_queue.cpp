@@ -5,6 +5,7 @@
 
 #include <ocpp/common/message_queue.hpp>
 #include <ocpp/v2/messages/Authorize.hpp>
+#include <ocpp/v2/messages/TransactionEvent.hpp>
 
 namespace ocpp {
 
@@ -45,5 +46,276 @@ TEST_F(ControlMessageV2Test, test_is_transactional_update) {
                       .is_transaction_update_message()));
 }
 
+/// \brief Keeps the persisted transaction queue in memory, so the queue content can be inspected without sending
+class MessageQueueDatabaseFake : public common::DatabaseHandlerCommon {
+private:
+    void init_sql() override {
+    }
+
+public:
+    std::map<std::string, json> messages;
+    std::map<std::string, int32_t> seq_no_offsets;
+    // returned as the persisted transaction queue by get_message_queue_messages
+    std::vector<common::DBTransactionMessage> persisted_messages;
+
+    MessageQueueDatabaseFake() : common::DatabaseHandlerCommon(nullptr, "", 1) {
+    }
+
+    std::vector<common::DBTransactionMessage> get_message_queue_messages(const QueueType queue_type) override {
+        if (queue_type == QueueType::Transaction) {
+            return this->persisted_messages;
+        }
+        return {};
+    }
+
+    void clear_message_queue(const QueueType) override {
+    }
+
+    void insert_message_queue_message(const common::DBTransactionMessage& message, const QueueType) override {
+        this->messages[message.unique_id] = message.json_message;
+    }
+
+    void remove_message_queue_message(const std::string& unique_id, const QueueType) override {
+        this->messages.erase(unique_id);
+    }
+
+    void insert_or_update_transaction_seq_no_offset(const std::string& transaction_id, const int32_t offset) override {
+        this->seq_no_offsets[transaction_id] = offset;
+    }
+
+    std::map<std::string, int32_t> get_transaction_seq_no_offsets() override {
+        return this->seq_no_offsets;
+    }
+
+    void remove_transaction_seq_no_offset(const std::string& transaction_id) override {
+        this->seq_no_offsets.erase(transaction_id);
+    }
+};
+
+class MessageQueueCompactionV2Test : public ::testing::Test {
+protected:
+    MessageQueueConfig<v2::MessageType> config{1, 1, 1000, false};
+    std::shared_ptr<MessageQueueDatabaseFake> db = std::make_shared<MessageQueueDatabaseFake>();
+    std::unique_ptr<MessageQueue<v2::MessageType>> message_queue;
+    const DateTime start{"2024-01-01T00:00:00Z"};
+    int message_count = 0;
+
+    void SetUp() override {
+        config.transaction_message_compaction_threshold = 4;
+        config.transaction_message_compaction_interval_seconds = 900;
+        // the queue is paused initially, so all messages stay queued
+        message_queue = std::make_unique<MessageQueue<v2::MessageType>>([](json) { return true; }, config, db);
+    }
+
+    TransactionEventRequest transaction_event(const std::string& transaction_id, TransactionEventEnum event_type,
+                                              int32_t seq_no, std::chrono::seconds offset,
+                                              TriggerReasonEnum trigger_reason,
+                                              std::optional<SignedMeterValue> signed_meter_value) {
+        const DateTime timestamp(start.to_time_point() + offset);
+        TransactionEventRequest request;
+        request.eventType = event_type;
+        request.timestamp = timestamp;
+        request.triggerReason = trigger_reason;
+        request.seqNo = seq_no;
+        request.transactionInfo.transactionId = transaction_id;
+
+        SampledValue energy;
+        energy.value = static_cast<float>(offset.count());
+        energy.measurand = MeasurandEnum::Energy_Active_Import_Register;
+        energy.signedMeterValue = signed_meter_value;
+        SampledValue power;
+        power.value = static_cast<float>(offset.count() % 120 == 0 ? 1000 : 3000);
+        power.measurand = MeasurandEnum::Power_Active_Import;
+        request.meterValue = std::vector<MeterValue>{{{energy, power}, timestamp}};
+        return request;
+    }
+
+    std::string push_transaction_event(const std::string& transaction_id, TransactionEventEnum event_type,
+                                       int32_t seq_no, std::chrono::seconds offset,
+                                       TriggerReasonEnum trigger_reason = TriggerReasonEnum::MeterValuePeriodic,
+                                       std::optional<SignedMeterValue> signed_meter_value = std::nullopt) {
+        const auto message_id = "message_" + std::to_string(message_count++);
+        message_queue->push_call(Call<TransactionEventRequest>(
+            transaction_event(transaction_id, event_type, seq_no, offset, trigger_reason, signed_meter_value),
+            message_id));
+        return message_id;
+    }
+
+    json payload(const std::string& message_id) {
+        return db->messages.at(message_id).at(CALL_PAYLOAD);
+    }
+};
+
+TEST_F(MessageQueueCompactionV2Test, test_merges_periodic_updates_and_renumbers) {
+    // compact once the transaction has ended
+    config.transaction_message_compaction_threshold = 8;
+    message_queue = std::make_unique<MessageQueue<v2::MessageType>>([](json) { return true; }, config, db);
+
+    const auto started = push_transaction_event("tx1", TransactionEventEnum::Started, 0, std::chrono::seconds(0));
+    const auto first_update = push_transaction_event("tx1", TransactionEventEnum::Updated, 1, std::chrono::seconds(60));
+    for (int i = 2; i <= 6; i++) {
+        push_transaction_event("tx1", TransactionEventEnum::Updated, i, std::chrono::seconds(60 * i));
+    }
+    const auto ended = push_transaction_event("tx1", TransactionEventEnum::Ended, 7, std::chrono::seconds(420));
+
+    ASSERT_EQ(db->messages.size(), 3);
+    EXPECT_EQ(payload(started).at("seqNo"), 0);
+    EXPECT_EQ(payload(first_update).at("seqNo"), 1);
+    EXPECT_EQ(payload(ended).at("seqNo"), 2);
+
+    // all samples are within one interval: the register keeps its latest value and the power is averaged
+    const auto meter_values = payload(first_update).at("meterValue");
+    ASSERT_EQ(meter_values.size(), 1);
+    const auto last_timestamp = DateTime(start.to_time_point() + std::chrono::seconds(360)).to_rfc3339();
+    EXPECT_EQ(meter_values.at(0).at("timestamp"), last_timestamp);
+    EXPECT_EQ(meter_values.at(0).at("sampledValue").at(0).at("value"), 360);
+    EXPECT_EQ(meter_values.at(0).at("sampledValue").at(1).at("value"), 2000);
+    EXPECT_EQ(payload(first_update).at("timestamp"), last_timestamp);
+}
+
+TEST_F(MessageQueueCompactionV2Test, test_keeps_non_periodic_updates_and_other_transactions) {
+    push_transaction_event("tx1", TransactionEventEnum::Updated, 1, std::chrono::seconds(0));
+    const auto other = push_transaction_event("tx2", TransactionEventEnum::Updated, 1, std::chrono::seconds(10));
+    const auto merged = push_transaction_event("tx1", TransactionEventEnum::Updated, 2, std::chrono::seconds(20));
+    const auto state_change = push_transaction_event("tx1", TransactionEventEnum::Updated, 3, std::chrono::seconds(30),
+                                                     TriggerReasonEnum::ChargingStateChanged);
+    const auto next = push_transaction_event("tx1", TransactionEventEnum::Updated, 4, std::chrono::seconds(40));
+
+    // the update of tx2 in between does not prevent merging, the state change does
+    EXPECT_EQ(db->messages.size(), 4);
+    EXPECT_EQ(db->messages.count(merged), 0);
+    EXPECT_EQ(payload(other).at("seqNo"), 1);
+    EXPECT_EQ(payload(state_change).at("seqNo"), 2);
+    EXPECT_EQ(payload(next).at("seqNo"), 3);
+
+    // messages of tx1 queued later are renumbered as well
+    const auto later = push_transaction_event("tx1", TransactionEventEnum::Ended, 5, std::chrono::seconds(50));
+    EXPECT_EQ(payload(later).at("seqNo"), 4);
+}
+
+TEST_F(MessageQueueCompactionV2Test, test_keeps_signed_meter_values) {
+    SignedMeterValue signed_meter_value;
+    signed_meter_value.signedMeterData = "signed";
+    signed_meter_value.signingMethod = "method";
+    signed_meter_value.encodingMethod = "encoding";
+    signed_meter_value.publicKey = "key";
+
+    const auto first_update = push_transaction_event("tx1", TransactionEventEnum::Updated, 1, std::chrono::seconds(0),
+                                                     TriggerReasonEnum::MeterValuePeriodic, signed_meter_value);
+    for (int i = 2; i <= 4; i++) {
+        push_transaction_event("tx1", TransactionEventEnum::Updated, i, std::chrono::seconds(60 * i),
+                               TriggerReasonEnum::MeterValuePeriodic, signed_meter_value);
+    }
+
+    ASSERT_EQ(db->messages.size(), 1);
+    EXPECT_EQ(payload(first_update).at("meterValue").size(), 4);
+}
+
+TEST_F(MessageQueueCompactionV2Test, test_does_not_aggregate_compacted_meter_values_again) {
+    const auto first_update = push_transaction_event("tx1", TransactionEventEnum::Updated, 1, std::chrono::seconds(0));
+    for (int i = 2; i <= 4; i++) {
+        push_transaction_event("tx1", TransactionEventEnum::Updated, i, std::chrono::seconds(60 * (i - 1)));
+    }
+    ASSERT_EQ(db->messages.size(), 1);
+    const auto compacted_meter_value = payload(first_update).at("meterValue").at(0);
+    // 1000 W at 0s and 120s, 3000 W at 60s and 180s
+    EXPECT_EQ(compacted_meter_value.at("sampledValue").at(1).at("value"), 2000);
+
+    // the next compaction only aggregates the newly merged samples of the same interval
+    for (int i = 5; i <= 8; i++) {
+        push_transaction_event("tx1", TransactionEventEnum::Updated, i, std::chrono::seconds(60 * (i - 1)));
+    }
+    ASSERT_EQ(db->messages.size(), 1);
+    const auto meter_values = payload(first_update).at("meterValue");
+    ASSERT_EQ(meter_values.size(), 2);
+    EXPECT_EQ(meter_values.at(0), compacted_meter_value);
+    EXPECT_EQ(meter_values.at(1).at("sampledValue").at(1).at("value"), 2000);
+    EXPECT_EQ(meter_values.at(1).at("sampledValue").at(0).at("value"), 420);
+}
+
+TEST_F(MessageQueueCompactionV2Test, test_keeps_last_register_reading) {
+    // register readings, energy per sampling interval and power of four periodic updates within one interval; the
+    // last update has no register reading
+    const std::vector<std::vector<std::pair<MeasurandEnum, float>>> samples = {
+        {{MeasurandEnum::Energy_Active_Import_Register, 1000},
+         {MeasurandEnum::Energy_Active_Import_Interval, 10},
+         {MeasurandEnum::Power_Active_Import, 1000}},
+        {{MeasurandEnum::Energy_Active_Import_Register, 1010},
+         {MeasurandEnum::Energy_Active_Import_Interval, 10},
+         {MeasurandEnum::Power_Active_Import, 3000}},
+        {{MeasurandEnum::Energy_Active_Import_Register, 1030},
+         {MeasurandEnum::Energy_Active_Import_Interval, 20},
+         {MeasurandEnum::Power_Active_Import, 1000}},
+        {{MeasurandEnum::Energy_Active_Import_Interval, 15}, {MeasurandEnum::Power_Active_Import, 3000}}};
+
+    std::string first_update;
+    for (std::size_t i = 0; i < samples.size(); i++) {
+        auto request = transaction_event("tx1", TransactionEventEnum::Updated, static_cast<int32_t>(i + 1),
+                                         std::chrono::seconds(60 * i), TriggerReasonEnum::MeterValuePeriodic,
+                                         std::nullopt);
+        auto& meter_value = request.meterValue.value().at(0);
+        meter_value.sampledValue.clear();
+        for (const auto& [measurand, value] : samples.at(i)) {
+            SampledValue sampled_value;
+            sampled_value.value = value;
+            sampled_value.measurand = measurand;
+            meter_value.sampledValue.push_back(sampled_value);
+        }
+        const auto message_id = "message_" + std::to_string(message_count++);
+        message_queue->push_call(Call<TransactionEventRequest>(request, message_id));
+        if (i == 0) {
+            first_update = message_id;
+        }
+    }
+
+    ASSERT_EQ(db->messages.size(), 1);
+    const auto meter_values = payload(first_update).at("meterValue");
+    ASSERT_EQ(meter_values.size(), 1);
+    const auto sampled_values = meter_values.at(0).at("sampledValue");
+    ASSERT_EQ(sampled_values.size(), 3);
+    EXPECT_EQ(sampled_values.at(0).at("measurand"), "Energy.Active.Import.Register");
+    EXPECT_EQ(sampled_values.at(0).at("value"), 1030);
+    EXPECT_EQ(sampled_values.at(1).at("measurand"), "Energy.Active.Import.Interval");
+    EXPECT_EQ(sampled_values.at(1).at("value"), 55);
+    EXPECT_EQ(sampled_values.at(2).at("measurand"), "Power.Active.Import");
+    EXPECT_EQ(sampled_values.at(2).at("value"), 2000);
+}
+
+TEST_F(MessageQueueCompactionV2Test, test_restores_seq_no_offsets) {
+    for (int i = 1; i <= 4; i++) {
+        push_transaction_event("tx1", TransactionEventEnum::Updated, i, std::chrono::seconds(60 * i));
+    }
+    ASSERT_EQ(db->messages.size(), 1);
+    EXPECT_EQ(db->seq_no_offsets.at("tx1"), 3);
+
+    // the transaction continues after a restart
+    message_queue = std::make_unique<MessageQueue<v2::MessageType>>([](json) { return true; }, config, db);
+    message_queue->get_persisted_messages_from_db();
+    const auto ended = push_transaction_event("tx1", TransactionEventEnum::Ended, 5, std::chrono::seconds(300));
+    EXPECT_EQ(payload(ended).at("seqNo"), 2);
+    EXPECT_EQ(db->seq_no_offsets.count("tx1"), 0);
+}
+
+TEST_F(MessageQueueCompactionV2Test, test_does_not_merge_into_sent_message) {
+    // a message at the front of the queue that timed out and is retried after a restart
+    const auto retried = transaction_event("tx1", TransactionEventEnum::Updated, 1, std::chrono::seconds(0),
+                                           TriggerReasonEnum::MeterValuePeriodic, std::nullopt);
+    db->persisted_messages.push_back(
+        {Call<TransactionEventRequest>(retried, "retried"), "TransactionEvent", 1, start, "retried"});
+    db->messages["retried"] = Call<TransactionEventRequest>(retried, "retried");
+    message_queue = std::make_unique<MessageQueue<v2::MessageType>>([](json) { return true; }, config, db);
+    message_queue->get_persisted_messages_from_db();
+
+    const auto first_update = push_transaction_event("tx1", TransactionEventEnum::Updated, 2, std::chrono::seconds(60));
+    for (int i = 3; i <= 4; i++) {
+        push_transaction_event("tx1", TransactionEventEnum::Updated, i, std::chrono::seconds(60 * (i - 1)));
+    }
+
+    ASSERT_EQ(db->messages.size(), 2);
+    EXPECT_EQ(payload("retried"), json(retried));
+    EXPECT_EQ(payload(first_update).at("seqNo"), 2);
+    EXPECT_EQ(payload(first_update).at("meterValue").size(), 1);
+}
+
 } // namespace v2
 } // namespace ocpp